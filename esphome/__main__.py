@@ -14,6 +14,7 @@ from esphome.const import (
     CONF_BAUD_RATE,
     CONF_BROKER,
     CONF_DEASSERT_RTS_DTR,
+    CONF_DELTA_UPDATES,
     CONF_LOGGER,
     CONF_NAME,
     CONF_OTA,
@@ -273,7 +274,12 @@ def upload_program(config, args, host):
     ota_conf = config[CONF_OTA]
     remote_port = ota_conf[CONF_PORT]
     password = ota_conf.get(CONF_PASSWORD, "")
-    return espota2.run_ota(host, remote_port, password, CORE.firmware_bin)
+    archive_dir = None
+    if ota_conf.get(CONF_DELTA_UPDATES):
+        archive_dir = CORE.relative_build_path("ota_firmwares")
+    return espota2.run_ota(
+        host, remote_port, password, CORE.firmware_bin, archive_dir=archive_dir
+    )
 
 
 def show_logs(config, args, port):
@@ -10,6 +10,7 @@ namespace airthings_ble {
 
 class AirthingsListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  AirthingsListener() { this->add_match_manufacturer_uuid(esp32_ble_tracker::ESPBTUUID::from_uint16(0x0334)); }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
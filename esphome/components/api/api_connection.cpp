@@ -4,7 +4,9 @@
 #include "esphome/components/network/util.h"
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/profiler.h"
 #include <cerrno>
+#include <algorithm>
 
 #ifdef USE_DEEP_SLEEP
 #include "esphome/components/deep_sleep/deep_sleep_component.h"
@@ -92,6 +94,7 @@ void APIConnection::loop() {
 
   this->list_entities_iterator_.advance();
   this->initial_state_iterator_.advance();
+  this->flush_pending_states_();
 
   const uint32_t keepalive = 60000;
   const uint32_t now = millis();
@@ -110,7 +113,8 @@ void APIConnection::loop() {
 #ifdef USE_ESP32_CAMERA
   if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
     uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
+    // fixed32 key, length delimited data and bool done
+    auto buffer = this->create_buffer(5 + ProtoSize::length_delimited(1, to_send) + 2);
     // fixed32 key = 1;
     buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
     // bytes data = 2;
@@ -171,7 +175,7 @@ bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary
   resp.key = binary_sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !binary_sensor->has_state();
-  return this->send_binary_sensor_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor) {
   ListEntitiesBinarySensorResponse msg;
@@ -202,7 +206,7 @@ bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (traits.get_supports_tilt())
     resp.tilt = cover->tilt;
   resp.current_operation = static_cast<enums::CoverOperation>(cover->current_operation);
-  return this->send_cover_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_cover_info(cover::Cover *cover) {
   auto traits = cover->get_traits();
@@ -265,7 +269,7 @@ bool APIConnection::send_fan_state(fan::Fan *fan) {
   }
   if (traits.supports_direction())
     resp.direction = static_cast<enums::FanDirection>(fan->direction);
-  return this->send_fan_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_fan_info(fan::Fan *fan) {
   auto traits = fan->get_traits();
@@ -327,7 +331,7 @@ bool APIConnection::send_light_state(light::LightState *light) {
   resp.warm_white = values.get_warm_white();
   if (light->supports_effects())
     resp.effect = light->get_effect_name();
-  return this->send_light_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_light_info(light::LightState *light) {
   auto traits = light->get_traits();
@@ -409,7 +413,7 @@ bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
   resp.key = sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !sensor->has_state();
-  return this->send_sensor_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
   ListEntitiesSensorResponse msg;
@@ -439,7 +443,7 @@ bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
   resp.state = state;
-  return this->send_switch_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
   ListEntitiesSwitchResponse msg;
@@ -476,7 +480,7 @@ bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor,
   resp.key = text_sensor->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !text_sensor->has_state();
-  return this->send_text_sensor_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor) {
   ListEntitiesTextSensorResponse msg;
@@ -523,7 +527,7 @@ bool APIConnection::send_climate_state(climate::Climate *climate) {
     resp.custom_preset = climate->custom_preset.value();
   if (traits.get_supports_swing_modes())
     resp.swing_mode = static_cast<enums::ClimateSwingMode>(climate->swing_mode);
-  return this->send_climate_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_climate_info(climate::Climate *climate) {
   auto traits = climate->get_traits();
@@ -600,7 +604,7 @@ bool APIConnection::send_number_state(number::Number *number, float state) {
   resp.key = number->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !number->has_state();
-  return this->send_number_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_number_info(number::Number *number) {
   ListEntitiesNumberResponse msg;
@@ -640,7 +644,7 @@ bool APIConnection::send_select_state(select::Select *select, std::string state)
   resp.key = select->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !select->has_state();
-  return this->send_select_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_select_info(select::Select *select) {
   ListEntitiesSelectResponse msg;
@@ -698,7 +702,7 @@ bool APIConnection::send_lock_state(lock::Lock *a_lock, lock::LockState state) {
   LockStateResponse resp{};
   resp.key = a_lock->get_object_id_hash();
   resp.state = static_cast<enums::LockState>(state);
-  return this->send_lock_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_lock_info(lock::Lock *a_lock) {
   ListEntitiesLockResponse msg;
@@ -743,7 +747,7 @@ bool APIConnection::send_media_player_state(media_player::MediaPlayer *media_pla
   resp.state = static_cast<enums::MediaPlayerState>(media_player->state);
   resp.volume = media_player->volume;
   resp.muted = media_player->is_muted();
-  return this->send_media_player_state_response(resp);
+  return this->send_state_message_(resp);
 }
 bool APIConnection::send_media_player_info(media_player::MediaPlayer *media_player) {
   ListEntitiesMediaPlayerResponse msg;
@@ -828,11 +832,12 @@ bool APIConnection::send_log_message(int level, const char *tag, const char *lin
     return false;
 
   // Send raw so that we don't copy too much
-  auto buffer = this->create_buffer();
+  size_t line_length = strlen(line);
+  auto buffer = this->create_buffer(2 + ProtoSize::length_delimited(1, line_length));
   // LogLevel level = 1;
   buffer.encode_uint32(1, static_cast<uint32_t>(level));
   // string message = 3;
-  buffer.encode_string(3, line, strlen(line));
+  buffer.encode_string(3, line, line_length);
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
@@ -847,6 +852,8 @@ HelloResponse APIConnection::hello(const HelloRequest &msg) {
   resp.api_version_minor = 6;
   resp.server_info = App.get_name() + " (esphome v" ESPHOME_VERSION ")";
   resp.name = App.get_name();
+  this->batch_frames_ = msg.supports_batched_frames && this->parent_->get_batch_delay() > 0;
+  resp.batched_frames = this->batch_frames_;
 
   this->connection_state_ = ConnectionState::CONNECTED;
   return resp;
@@ -910,6 +917,28 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
+#ifdef USE_PROFILER
+ProfileResponse APIConnection::profile(const ProfileRequest &msg) {
+  ProfileResponse resp;
+  const ProfileSnapshot snapshot = global_profiler.snapshot(msg.reset);
+  resp.duration_ms = snapshot.duration_ms;
+  resp.entries.reserve(snapshot.entries.size());
+  for (const auto &entry : snapshot.entries) {
+    ProfileResponseEntry out;
+    out.component = entry.component != nullptr ? entry.component->get_component_source() : "<null>";
+    out.source = static_cast<enums::ProfileSource>(entry.source);
+    out.name_hash = entry.name_hash;
+    out.count = entry.stats.count;
+    out.total_us = entry.stats.total_us;
+    out.max_us = entry.stats.max_us;
+    out.p50_us = entry.stats.percentile_us(50);
+    out.p99_us = entry.stats.percentile_us(99);
+    out.buckets.assign(entry.stats.buckets, entry.stats.buckets + PROFILE_BUCKET_COUNT);
+    resp.entries.push_back(std::move(out));
+  }
+  return resp;
+}
+#endif
 bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
   if (this->remove_)
     return false;
@@ -931,7 +960,7 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  APIError err = this->helper_->write_protobuf_packet(message_type, buffer);
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
@@ -946,6 +975,104 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
   // Do not set last_traffic_ on send
   return true;
 }
+template<class C> bool APIConnection::send_state_message_(const C &msg) {
+  if (this->remove_)
+    return false;
+  // Don't overtake older states that are still queued
+  if (!this->batch_frames_ && this->pending_count_ == 0 && this->send_message_<C>(msg, C::MESSAGE_TYPE))
+    return true;
+  if (this->remove_)
+    return false;
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "queue state: %s", msg.dump().c_str());
+#endif
+  return this->queue_state_(msg.key, C::MESSAGE_TYPE, msg);
+}
+bool APIConnection::queue_state_(uint32_t key, uint16_t message_type, const ProtoMessage &msg) {
+  PendingState *entry;
+  const uint64_t index_key = pending_state_key_(key, message_type);
+  auto it = this->pending_index_.find(index_key);
+  if (it != this->pending_index_.end()) {
+    // The pending states are in the order of their sequence numbers
+    entry = &this->pending_states_[it->second - (this->pending_seq_ - this->pending_count_)];
+    this->coalesced_states_++;
+  } else {
+    if (this->pending_count_ >= this->parent_->get_state_entity_count()) {
+      if (this->dropped_states_++ == 0)
+        ESP_LOGW(TAG, "%s: Too many pending states, dropping states", this->client_info_.c_str());
+      return false;
+    }
+    if (this->pending_count_ == 0)
+      this->pending_start_ = millis();
+    if (this->pending_count_ == this->pending_states_.size())
+      this->pending_states_.emplace_back();
+    entry = &this->pending_states_[this->pending_count_++];
+    entry->key = key;
+    entry->message_type = message_type;
+    this->pending_index_[index_key] = this->pending_seq_++;
+  }
+  entry->data.clear();
+  ProtoWriteBuffer buffer{&entry->data};
+  msg.encode(buffer);
+  return true;
+}
+void APIConnection::flush_pending_states_() {
+  if (this->pending_count_ == 0 || this->remove_)
+    return;
+  if (this->batch_frames_ && millis() - this->pending_start_ < this->parent_->get_batch_delay())
+    return;
+
+  // Keep every frame within a single TCP segment on a typical MTU
+  static const size_t MAX_BATCH_FRAME_SIZE = 1300;
+  const uint8_t header_padding = this->helper_->frame_header_padding();
+  const uint8_t footer_size = this->helper_->frame_footer_size();
+  size_t sent = 0;
+  while (sent < this->pending_count_ && this->helper_->can_write_without_blocking()) {
+    this->pending_packets_.clear();
+    this->proto_write_buffer_.clear();
+    this->proto_write_buffer_.reserve(MAX_BATCH_FRAME_SIZE + footer_size);
+    size_t end = sent;
+    for (; end < this->pending_count_; end++) {
+      const PendingState &entry = this->pending_states_[end];
+      size_t offset = this->proto_write_buffer_.size();
+      // Clients that didn't negotiate batched frames get one message per frame
+      if (end != sent && (!this->batch_frames_ || offset + header_padding + entry.data.size() > MAX_BATCH_FRAME_SIZE))
+        break;
+      this->pending_packets_.push_back(
+          PacketInfo{entry.message_type, static_cast<uint32_t>(offset), static_cast<uint32_t>(entry.data.size())});
+      this->proto_write_buffer_.resize(offset + header_padding);
+      this->proto_write_buffer_.insert(this->proto_write_buffer_.end(), entry.data.begin(), entry.data.end());
+    }
+    this->proto_write_buffer_.reserve(this->proto_write_buffer_.size() + footer_size);
+
+    APIError err = this->helper_->write_protobuf_packets(ProtoWriteBuffer{&this->proto_write_buffer_},
+                                                         this->pending_packets_);
+    if (err == APIError::WOULD_BLOCK)
+      break;
+    if (err != APIError::OK) {
+      on_fatal_error();
+      if (err == APIError::SOCKET_WRITE_FAILED && errno == ECONNRESET) {
+        ESP_LOGW(TAG, "%s: Connection reset", client_info_.c_str());
+      } else {
+        ESP_LOGW(TAG, "%s: Packet write failed %s errno=%d", client_info_.c_str(), api_error_to_str(err), errno);
+      }
+      this->pending_count_ = 0;
+      this->pending_index_.clear();
+      return;
+    }
+    ESP_LOGVV(TAG, "Sent %u pending states", (unsigned) (end - sent));
+    sent = end;
+  }
+
+  for (size_t i = 0; i < sent; i++) {
+    const PendingState &entry = this->pending_states_[i];
+    this->pending_index_.erase(pending_state_key_(entry.key, entry.message_type));
+  }
+  // Move the unsent entries to the front, the sent ones are re-used for later states
+  std::rotate(this->pending_states_.begin(), this->pending_states_.begin() + sent,
+              this->pending_states_.begin() + this->pending_count_);
+  this->pending_count_ -= sent;
+}
 void APIConnection::on_unauthenticated_access() {
   this->on_fatal_error();
   ESP_LOGD(TAG, "%s: tried to access without authentication.", this->client_info_.c_str());
@@ -7,6 +7,8 @@
 #include "api_server.h"
 #include "api_frame_helper.h"
 
+#include <unordered_map>
+
 namespace esphome {
 namespace api {
 
@@ -134,6 +136,9 @@ class APIConnection : public APIServerConnection {
     return {};
   }
   void execute_service(const ExecuteServiceRequest &msg) override;
+#ifdef USE_PROFILER
+  ProfileResponse profile(const ProfileRequest &msg) override;
+#endif
   bool is_authenticated() override { return this->connection_state_ == ConnectionState::AUTHENTICATED; }
   bool is_connection_setup() override {
     return this->connection_state_ == ConnectionState ::CONNECTED || this->is_authenticated();
@@ -141,18 +146,47 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size) override {
     // FIXME: ensure no recursive writes can happen
     this->proto_write_buffer_.clear();
+    // Reserve space for the frame header and footer too, so that the frame helper can
+    // wrap the message in place without moving or copying it.
+    uint8_t header_padding = this->helper_->frame_header_padding();
+    this->proto_write_buffer_.reserve(header_padding + reserve_size + this->helper_->frame_footer_size());
+    this->proto_write_buffer_.resize(header_padding);
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
+  /// Number of state updates that were replaced by a newer state of the same entity before being sent.
+  uint32_t get_coalesced_states() const { return this->coalesced_states_; }
+  /// Number of state updates that couldn't be queued, because of more distinct keys than registered entities.
+  uint32_t get_dropped_states() const { return this->dropped_states_; }
 
  protected:
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
 
+  /// Encoded state response waiting to be sent, the latest one of its entity.
+  struct PendingState {
+    uint32_t key;
+    uint16_t message_type;
+    std::vector<uint8_t> data;
+  };
+
+  /** Send a state response, or queue it if it can't be sent right now or batching is enabled.
+   *
+   * Only the latest state of every entity is queued, an older queued state of the same entity is replaced.
+   * The queue holds one entry per registered entity, so every entity keeps its latest state. Returns false
+   * only if the queue is full regardless, so that the initial state iterator retries later.
+   */
+  template<class C> bool send_state_message_(const C &msg);
+  bool queue_state_(uint32_t key, uint16_t message_type, const ProtoMessage &msg);
+  static uint64_t pending_state_key_(uint32_t key, uint16_t message_type) {
+    return (uint64_t(message_type) << 32) | key;
+  }
+  void flush_pending_states_();
+
   enum class ConnectionState {
     WAITING_FOR_HELLO,
     CONNECTED,
@@ -166,6 +200,20 @@ class APIConnection : public APIServerConnection {
   std::vector<uint8_t> proto_write_buffer_;
   std::unique_ptr<APIFrameHelper> helper_;
 
+  // Latest states waiting for the socket to become writable (or for the batch delay to expire), only the
+  // first pending_count_ entries are in use. Entries are re-used to keep the capacity of their data buffers.
+  std::vector<PendingState> pending_states_;
+  size_t pending_count_{0};
+  /// Sequence number of the pending state of every (message type, key), see pending_state_key_().
+  std::unordered_map<uint64_t, uint32_t> pending_index_;
+  /// Sequence number of the next queued state, the pending states have the pending_count_ numbers before it.
+  uint32_t pending_seq_{0};
+  uint32_t pending_start_{0};
+  bool batch_frames_{false};
+  std::vector<PacketInfo> pending_packets_;
+  uint32_t coalesced_states_{0};
+  uint32_t dropped_states_{0};
+
   std::string client_info_;
 #ifdef USE_ESP32_CAMERA
   esp32_camera::CameraImageReader image_reader_;
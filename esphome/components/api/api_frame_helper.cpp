@@ -467,7 +467,21 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+APIError APINoiseFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  if (raw_buffer->size() < this->frame_header_padding()) {
+    HELPER_LOG("Buffer is missing space for the frame header");
+    return APIError::BAD_ARG;
+  }
+  PacketInfo packet{type, 0, static_cast<uint32_t>(raw_buffer->size() - this->frame_header_padding())};
+  return this->write_packets_(buffer, &packet, 1);
+}
+APIError APINoiseFrameHelper::write_protobuf_packets(ProtoWriteBuffer buffer, const std::vector<PacketInfo> &packets) {
+  if (packets.empty())
+    return APIError::OK;
+  return this->write_packets_(buffer, packets.data(), packets.size());
+}
+APIError APINoiseFrameHelper::write_packets_(ProtoWriteBuffer buffer, const PacketInfo *packets, size_t packet_count) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -479,31 +493,42 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
-  size_t padding = 0;
-  size_t msg_len = 4 + payload_len + padding;
-  size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  uint8_t *buf_start = raw_buffer->data();
+  const uint8_t header_padding = this->frame_header_padding();
+  const uint8_t msg_offset = 3;
+
+  // Every record is uint16 type, uint16 data_len, data. The first payload is already in place, the following
+  // ones only need to be moved down by the part of their padding that isn't used for the record header.
+  size_t pos = msg_offset;
+  for (size_t i = 0; i < packet_count; i++) {
+    const PacketInfo &packet = packets[i];
+    buf_start[pos + 0] = (uint8_t)(packet.message_type >> 8);  // type
+    buf_start[pos + 1] = (uint8_t) packet.message_type;
+    buf_start[pos + 2] = (uint8_t)(packet.payload_size >> 8);  // data_len
+    buf_start[pos + 3] = (uint8_t) packet.payload_size;
+    pos += 4;
+    const size_t payload_start = packet.offset + header_padding;
+    if (payload_start != pos)
+      memmove(buf_start + pos, buf_start + payload_start, packet.payload_size);
+    pos += packet.payload_size;
+  }
+  size_t msg_len = pos - msg_offset;
+  size_t mac_len = noise_cipherstate_get_mac_length(send_cipher_);
+  if (3 + msg_len + mac_len > 0xFFFF) {
+    HELPER_LOG("Packet too large to send: size %zu", msg_len);
+    return APIError::BAD_ARG;
   }
+  // the capacity for the MAC has been reserved when the buffer was created, so this doesn't move the payload
+  raw_buffer->resize(pos + mac_len);
+  buf_start = raw_buffer->data();
 
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
-  const uint8_t msg_offset = 3;
-  const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t)(type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t)(payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
-  // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  buf_start[0] = 0x01;  // indicator
+  // buf_start[1], buf_start[2] to be set later
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
+  noise_buffer_set_inout(mbuf, buf_start + msg_offset, msg_len, msg_len + mac_len);
   err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
   if (err != 0) {
     state_ = State::FAILED;
@@ -512,11 +537,11 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   }
 
   size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t)(mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
+  buf_start[1] = (uint8_t)(mbuf.size >> 8);
+  buf_start[2] = (uint8_t) mbuf.size;
 
   struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
+  iov.iov_base = buf_start;
   iov.iov_len = total_len;
 
   // write raw to not have two packets sent if NAGLE disabled
@@ -900,23 +925,67 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+APIError APIPlaintextFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  if (raw_buffer->size() < this->frame_header_padding()) {
+    HELPER_LOG("Buffer is missing space for the frame header");
+    return APIError::BAD_ARG;
+  }
+  PacketInfo packet{type, 0, static_cast<uint32_t>(raw_buffer->size() - this->frame_header_padding())};
+  return this->write_packets_(buffer, &packet, 1);
+}
+APIError APIPlaintextFrameHelper::write_protobuf_packets(ProtoWriteBuffer buffer,
+                                                         const std::vector<PacketInfo> &packets) {
+  if (packets.empty())
+    return APIError::OK;
+  return this->write_packets_(buffer, packets.data(), packets.size());
+}
+APIError APIPlaintextFrameHelper::write_packets_(ProtoWriteBuffer buffer, const PacketInfo *packets,
+                                                 size_t packet_count) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(payload_len).encode(header);
-  ProtoVarInt(type).encode(header);
+  uint8_t *buf_start = buffer.get_buffer()->data();
+  const uint8_t header_padding = this->frame_header_padding();
+
+  // The header of the first packet is right-aligned in the padding so that it directly precedes the payload,
+  // following packets are moved down to directly follow the previous one.
+  size_t start = 0;
+  size_t pos = 0;
+  for (size_t i = 0; i < packet_count; i++) {
+    const PacketInfo &packet = packets[i];
+    uint32_t size_len = ProtoSize::varint(packet.payload_size);
+    uint32_t type_len = ProtoSize::varint(static_cast<uint32_t>(packet.message_type));
+    uint32_t header_len = 1 + size_len + type_len;
+    if (header_len > header_padding) {
+      HELPER_LOG("Packet too large to send: size %u type %u", packet.payload_size, packet.message_type);
+      return APIError::BAD_ARG;
+    }
+    if (i == 0) {
+      start = packet.offset + header_padding - header_len;
+      pos = start;
+    }
 
-  struct iovec iov[2];
-  iov[0].iov_base = &header[0];
-  iov[0].iov_len = header.size();
-  iov[1].iov_base = const_cast<uint8_t *>(payload);
-  iov[1].iov_len = payload_len;
+    buf_start[pos++] = 0x00;  // indicator
+    uint32_t varint = packet.payload_size;
+    for (uint32_t j = 0; j < size_len; j++, varint >>= 7)
+      buf_start[pos++] = (varint & 0x7F) | (j + 1 < size_len ? 0x80 : 0x00);
+    varint = packet.message_type;
+    for (uint32_t j = 0; j < type_len; j++, varint >>= 7)
+      buf_start[pos++] = (varint & 0x7F) | (j + 1 < type_len ? 0x80 : 0x00);
+
+    const size_t payload_start = packet.offset + header_padding;
+    if (payload_start != pos)
+      memmove(buf_start + pos, buf_start + payload_start, packet.payload_size);
+    pos += packet.payload_size;
+  }
 
-  return write_raw_(iov, 2);
+  struct iovec iov;
+  iov.iov_base = buf_start + start;
+  iov.iov_len = pos - start;
+
+  return write_raw_(&iov, 1);
 }
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
@@ -12,6 +12,7 @@
 
 #include "esphome/components/socket/socket.h"
 #include "api_noise_context.h"
+#include "proto.h"
 
 namespace esphome {
 namespace api {
@@ -23,6 +24,14 @@ struct ReadPacketBuffer {
   size_t data_len;
 };
 
+/// Position of one encoded message in a buffer passed to APIFrameHelper::write_protobuf_packets().
+struct PacketInfo {
+  uint16_t message_type;
+  /// Offset of the frame_header_padding() bytes in front of the message.
+  uint32_t offset;
+  uint32_t payload_size;
+};
+
 struct PacketBuffer {
   const std::vector<uint8_t> container;
   uint16_t type;
@@ -65,7 +74,22 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /** Frame and send an encoded protobuf message.
+   *
+   * The buffer must start with frame_header_padding() bytes of unused space followed by the encoded message,
+   * the frame header is written into that space (and the footer appended) without moving the payload.
+   */
+  virtual APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) = 0;
+  /** Send several encoded messages at once (only for clients that negotiated batched frames).
+   *
+   * Every message in the buffer is preceded by frame_header_padding() bytes, see PacketInfo. The messages
+   * are compacted in place and sent with a single write (and for Noise, a single encrypted frame).
+   */
+  virtual APIError write_protobuf_packets(ProtoWriteBuffer buffer, const std::vector<PacketInfo> &packets) = 0;
+  /// Number of bytes to reserve in front of the message for the frame header.
+  virtual uint8_t frame_header_padding() = 0;
+  /// Number of bytes the frame footer (if any) adds after the message.
+  virtual uint8_t frame_footer_size() = 0;
   virtual std::string getpeername() = 0;
   virtual APIError close() = 0;
   virtual APIError shutdown(int how) = 0;
@@ -83,7 +107,12 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  APIError write_protobuf_packets(ProtoWriteBuffer buffer, const std::vector<PacketInfo> &packets) override;
+  // 3 bytes frame header, 2 bytes message type, 2 bytes data length
+  uint8_t frame_header_padding() override { return 7; }
+  // MAC of the ChaChaPoly cipher
+  uint8_t frame_footer_size() override { return 16; }
   std::string getpeername() override { return socket_->getpeername(); }
   APIError close() override;
   APIError shutdown(int how) override;
@@ -95,6 +124,7 @@ class APINoiseFrameHelper : public APIFrameHelper {
     std::vector<uint8_t> msg;
   };
 
+  APIError write_packets_(ProtoWriteBuffer buffer, const PacketInfo *packets, size_t packet_count);
   APIError state_action_();
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
@@ -143,7 +173,11 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  APIError write_protobuf_packets(ProtoWriteBuffer buffer, const std::vector<PacketInfo> &packets) override;
+  // 1 byte indicator, up to 3 bytes data length varint, up to 2 bytes message type varint
+  uint8_t frame_header_padding() override { return 6; }
+  uint8_t frame_footer_size() override { return 0; }
   std::string getpeername() override { return socket_->getpeername(); }
   APIError close() override;
   APIError shutdown(int how) override;
@@ -155,6 +189,7 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
     std::vector<uint8_t> msg;
   };
 
+  APIError write_packets_(ProtoWriteBuffer buffer, const PacketInfo *packets, size_t packet_count);
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
   APIError write_raw_(const struct iovec *iov, int iovcnt);
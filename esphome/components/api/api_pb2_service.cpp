@@ -328,6 +328,16 @@ bool APIServerConnectionBase::send_media_player_state_response(const MediaPlayer
 #endif
 #ifdef USE_MEDIA_PLAYER
 #endif
+#ifdef USE_PROFILER
+#endif
+#ifdef USE_PROFILER
+bool APIServerConnectionBase::send_profile_response(const ProfileResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_profile_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<ProfileResponse>(msg, 67);
+}
+#endif
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -592,6 +602,17 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       ESP_LOGVV(TAG, "on_media_player_command_request: %s", msg.dump().c_str());
 #endif
       this->on_media_player_command_request(msg);
+#endif
+      break;
+    }
+    case 66: {
+#ifdef USE_PROFILER
+      ProfileRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_profile_request: %s", msg.dump().c_str());
+#endif
+      this->on_profile_request(msg);
 #endif
       break;
     }
@@ -855,6 +876,22 @@ void APIServerConnection::on_media_player_command_request(const MediaPlayerComma
   this->media_player_command(msg);
 }
 #endif
+#ifdef USE_PROFILER
+void APIServerConnection::on_profile_request(const ProfileRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  ProfileResponse ret = this->profile(msg);
+  if (!this->send_profile_response(ret)) {
+    this->on_fatal_error();
+  }
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
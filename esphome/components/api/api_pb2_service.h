@@ -153,6 +153,12 @@ class APIServerConnectionBase : public ProtoService {
 #endif
 #ifdef USE_MEDIA_PLAYER
   virtual void on_media_player_command_request(const MediaPlayerCommandRequest &value){};
+#endif
+#ifdef USE_PROFILER
+  virtual void on_profile_request(const ProfileRequest &value){};
+#endif
+#ifdef USE_PROFILER
+  bool send_profile_response(const ProfileResponse &msg);
 #endif
  protected:
   bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
@@ -204,6 +210,9 @@ class APIServerConnection : public APIServerConnectionBase {
 #endif
 #ifdef USE_MEDIA_PLAYER
   virtual void media_player_command(const MediaPlayerCommandRequest &msg) = 0;
+#endif
+#ifdef USE_PROFILER
+  virtual ProfileResponse profile(const ProfileRequest &msg) = 0;
 #endif
  protected:
   void on_hello_request(const HelloRequest &msg) override;
@@ -251,6 +260,9 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_MEDIA_PLAYER
   void on_media_player_command_request(const MediaPlayerCommandRequest &msg) override;
 #endif
+#ifdef USE_PROFILER
+  void on_profile_request(const ProfileRequest &msg) override;
+#endif
 };
 
 }  // namespace api
@@ -24,7 +24,7 @@ static const char *const TAG = "api";
 void APIServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Home Assistant API server...");
   this->setup_controller();
-  socket_ = socket::socket_ip(SOCK_STREAM, 0);
+  socket_ = socket::socket_ip_loop_monitored(SOCK_STREAM, 0);
   if (socket_ == nullptr) {
     ESP_LOGW(TAG, "Could not create socket.");
     this->mark_failed();
@@ -77,6 +77,45 @@ void APIServer::setup() {
   }
 #endif
 
+  // Every entity has at most one queued state per connection
+  this->state_entity_count_ = 0;
+#ifdef USE_BINARY_SENSOR
+  this->state_entity_count_ += App.get_binary_sensors().size();
+#endif
+#ifdef USE_COVER
+  this->state_entity_count_ += App.get_covers().size();
+#endif
+#ifdef USE_FAN
+  this->state_entity_count_ += App.get_fans().size();
+#endif
+#ifdef USE_LIGHT
+  this->state_entity_count_ += App.get_lights().size();
+#endif
+#ifdef USE_SENSOR
+  this->state_entity_count_ += App.get_sensors().size();
+#endif
+#ifdef USE_SWITCH
+  this->state_entity_count_ += App.get_switches().size();
+#endif
+#ifdef USE_TEXT_SENSOR
+  this->state_entity_count_ += App.get_text_sensors().size();
+#endif
+#ifdef USE_CLIMATE
+  this->state_entity_count_ += App.get_climates().size();
+#endif
+#ifdef USE_NUMBER
+  this->state_entity_count_ += App.get_numbers().size();
+#endif
+#ifdef USE_SELECT
+  this->state_entity_count_ += App.get_selects().size();
+#endif
+#ifdef USE_LOCK
+  this->state_entity_count_ += App.get_locks().size();
+#endif
+#ifdef USE_MEDIA_PLAYER
+  this->state_entity_count_ += App.get_media_players().size();
+#endif
+
   this->last_connected_ = millis();
 
 #ifdef USE_ESP32_CAMERA
@@ -111,7 +150,10 @@ void APIServer::loop() {
                                 [](const std::unique_ptr<APIConnection> &conn) { return !conn->remove_; });
   // print disconnection messages
   for (auto it = new_end; it != this->clients_.end(); ++it) {
-    ESP_LOGV(TAG, "Removing connection to %s", (*it)->client_info_.c_str());
+    ESP_LOGD(TAG, "Removing connection to %s (coalesced states: %u, dropped states: %u)",
+             (*it)->client_info_.c_str(), (*it)->get_coalesced_states(), (*it)->get_dropped_states());
+    this->coalesced_states_ += (*it)->get_coalesced_states();
+    this->dropped_states_ += (*it)->get_dropped_states();
   }
   // resize vector
   this->clients_.erase(new_end, this->clients_.end());
@@ -142,6 +184,14 @@ void APIServer::dump_config() {
 #else
   ESP_LOGCONFIG(TAG, "  Using noise encryption: NO");
 #endif
+  uint32_t coalesced = this->coalesced_states_;
+  uint32_t dropped = this->dropped_states_;
+  for (auto &client : this->clients_) {
+    coalesced += client->get_coalesced_states();
+    dropped += client->get_dropped_states();
+  }
+  ESP_LOGCONFIG(TAG, "  Coalesced states: %u", coalesced);
+  ESP_LOGCONFIG(TAG, "  Dropped states: %u", dropped);
 }
 bool APIServer::uses_password() const { return !this->password_.empty(); }
 bool APIServer::check_password(const std::string &password) const {
@@ -29,6 +29,10 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  void set_batch_delay(uint32_t batch_delay) { this->batch_delay_ = batch_delay; }
+  uint32_t get_batch_delay() const { return this->batch_delay_; }
+  /// Number of entities whose state is sent to clients, which bounds the states a connection has to queue.
+  size_t get_state_entity_count() const { return this->state_entity_count_; }
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -95,6 +99,11 @@ class APIServer : public Component, public Controller {
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  uint32_t batch_delay_{0};
+  size_t state_entity_count_{0};
+  /// State updates coalesced and dropped by the connections that were closed already.
+  uint32_t coalesced_states_{0};
+  uint32_t dropped_states_{0};
   uint32_t last_connected_{0};
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
@@ -70,7 +70,7 @@ class ProtoVarInt {
     }
   }
   void encode(std::vector<uint8_t> &out) {
-    uint32_t val = this->value_;
+    uint64_t val = this->value_;
     if (val <= 0x7F) {
       out.push_back(val);
       return;
@@ -141,12 +141,132 @@ class Proto64Bit {
   const uint64_t value_;
 };
 
+/// Helpers to calculate the encoded size of a message before encoding it.
+class ProtoSize {
+ public:
+  static inline uint32_t varint(uint32_t value) {
+    if (value < (1u << 7))
+      return 1;
+    if (value < (1u << 14))
+      return 2;
+    if (value < (1u << 21))
+      return 3;
+    if (value < (1u << 28))
+      return 4;
+    return 5;
+  }
+  static inline uint32_t varint(uint64_t value) {
+    if (value <= UINT32_MAX)
+      return varint(static_cast<uint32_t>(value));
+    uint32_t size = 5;
+    value >>= 35;
+    while (value) {
+      size++;
+      value >>= 7;
+    }
+    return size;
+  }
+  static inline uint32_t length_delimited(uint32_t field_id_size, uint32_t len) {
+    return field_id_size + varint(len) + len;
+  }
+
+  static inline void add_uint32_field(uint32_t &total_size, uint32_t field_id_size, uint32_t value, bool force) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + varint(value);
+  }
+  static inline void add_int32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value, bool force) {
+    if (value < 0) {
+      // negative int32 is always 10 byte long
+      add_int64_field(total_size, field_id_size, value, force);
+      return;
+    }
+    add_uint32_field(total_size, field_id_size, static_cast<uint32_t>(value), force);
+  }
+  static inline void add_sint32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value, bool force) {
+    add_uint32_field(total_size, field_id_size, encode_zigzag32(value), force);
+  }
+  static inline void add_uint64_field(uint32_t &total_size, uint32_t field_id_size, uint64_t value, bool force) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + varint(value);
+  }
+  static inline void add_int64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value, bool force) {
+    add_uint64_field(total_size, field_id_size, static_cast<uint64_t>(value), force);
+  }
+  static inline void add_sint64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value, bool force) {
+    add_uint64_field(total_size, field_id_size, encode_zigzag64(value), force);
+  }
+  static inline void add_enum_field(uint32_t &total_size, uint32_t field_id_size, uint32_t value, bool force) {
+    add_uint32_field(total_size, field_id_size, value, force);
+  }
+  static inline void add_bool_field(uint32_t &total_size, uint32_t field_id_size, bool value, bool force) {
+    if (!value && !force)
+      return;
+    total_size += field_id_size + 1;
+  }
+  template<uint32_t NumBytes>
+  static inline void add_fixed_field(uint32_t &total_size, uint32_t field_id_size, bool is_nonzero, bool force) {
+    if (!is_nonzero && !force)
+      return;
+    total_size += field_id_size + NumBytes;
+  }
+  static inline void add_string_field(uint32_t &total_size, uint32_t field_id_size, const std::string &str,
+                                      bool force) {
+    if (str.empty() && !force)
+      return;
+    total_size += length_delimited(field_id_size, str.size());
+  }
+  template<class C>
+  static inline void add_message_object(uint32_t &total_size, uint32_t field_id_size, const C &message, bool force) {
+    uint32_t nested_size = 0;
+    message.calculate_size(nested_size);
+    // Nested messages are always encoded, even when empty
+    total_size += length_delimited(field_id_size, nested_size);
+  }
+
+  static inline uint32_t encode_zigzag32(int32_t value) {
+    return value < 0 ? ~(static_cast<uint32_t>(value) << 1) : static_cast<uint32_t>(value) << 1;
+  }
+  static inline uint64_t encode_zigzag64(int64_t value) {
+    return value < 0 ? ~(static_cast<uint64_t>(value) << 1) : static_cast<uint64_t>(value) << 1;
+  }
+};
+
+/** Encodes protobuf fields into a std::vector.
+ *
+ * Messages calculate their size first (see ProtoSize) so that the vector can be reserved once, after that
+ * every field is appended in place without any further allocations.
+ */
 class ProtoWriteBuffer {
  public:
   ProtoWriteBuffer(std::vector<uint8_t> *buffer) : buffer_(buffer) {}
   void write(uint8_t value) { this->buffer_->push_back(value); }
-  void encode_varint_raw(ProtoVarInt value) { value.encode(*this->buffer_); }
-  void encode_varint_raw(uint32_t value) { this->encode_varint_raw(ProtoVarInt(value)); }
+  void encode_varint_raw(ProtoVarInt value) { this->encode_varint_raw_64(value.as_uint64()); }
+  void encode_varint_raw(uint32_t value) {
+    if (value < 0x80) {
+      this->buffer_->push_back(value);
+      return;
+    }
+    uint8_t *data = this->extend_(ProtoSize::varint(value));
+    while (value >= 0x80) {
+      *data++ = (value & 0x7F) | 0x80;
+      value >>= 7;
+    }
+    *data = value;
+  }
+  void encode_varint_raw_64(uint64_t value) {
+    if (value <= UINT32_MAX) {
+      this->encode_varint_raw(static_cast<uint32_t>(value));
+      return;
+    }
+    uint8_t *data = this->extend_(ProtoSize::varint(value));
+    while (value >= 0x80) {
+      *data++ = (value & 0x7F) | 0x80;
+      value >>= 7;
+    }
+    *data = value;
+  }
   void encode_field_raw(uint32_t field_id, uint32_t type) {
     uint32_t val = (field_id << 3) | (type & 0b111);
     this->encode_varint_raw(val);
@@ -158,11 +278,10 @@ class ProtoWriteBuffer {
     this->encode_field_raw(field_id, 2);
     this->encode_varint_raw(len);
     auto *data = reinterpret_cast<const uint8_t *>(string);
-    for (size_t i = 0; i < len; i++)
-      this->write(data[i]);
+    this->buffer_->insert(this->buffer_->end(), data, data + len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
-    this->encode_string(field_id, value.data(), value.size());
+    this->encode_string(field_id, value.data(), value.size(), force);
   }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
@@ -177,37 +296,33 @@ class ProtoWriteBuffer {
     if (value == 0 && !force)
       return;
     this->encode_field_raw(field_id, 0);
-    this->encode_varint_raw(ProtoVarInt(value));
+    this->encode_varint_raw_64(value);
   }
   void encode_bool(uint32_t field_id, bool value, bool force = false) {
     if (!value && !force)
       return;
     this->encode_field_raw(field_id, 0);
-    this->write(0x01);
+    this->write(value ? 0x01 : 0x00);
   }
   void encode_fixed32(uint32_t field_id, uint32_t value, bool force = false) {
     if (value == 0 && !force)
       return;
 
     this->encode_field_raw(field_id, 5);
-    this->write((value >> 0) & 0xFF);
-    this->write((value >> 8) & 0xFF);
-    this->write((value >> 16) & 0xFF);
-    this->write((value >> 24) & 0xFF);
+    uint8_t *data = this->extend_(4);
+    data[0] = (value >> 0) & 0xFF;
+    data[1] = (value >> 8) & 0xFF;
+    data[2] = (value >> 16) & 0xFF;
+    data[3] = (value >> 24) & 0xFF;
   }
   void encode_fixed64(uint32_t field_id, uint64_t value, bool force = false) {
     if (value == 0 && !force)
       return;
 
-    this->encode_field_raw(field_id, 5);
-    this->write((value >> 0) & 0xFF);
-    this->write((value >> 8) & 0xFF);
-    this->write((value >> 16) & 0xFF);
-    this->write((value >> 24) & 0xFF);
-    this->write((value >> 32) & 0xFF);
-    this->write((value >> 40) & 0xFF);
-    this->write((value >> 48) & 0xFF);
-    this->write((value >> 56) & 0xFF);
+    this->encode_field_raw(field_id, 1);
+    uint8_t *data = this->extend_(8);
+    for (uint8_t i = 0; i < 8; i++)
+      data[i] = (value >> (i * 8)) & 0xFF;
   }
   template<typename T> void encode_enum(uint32_t field_id, T value, bool force = false) {
     this->encode_uint32(field_id, static_cast<uint32_t>(value), force);
@@ -221,7 +336,7 @@ class ProtoWriteBuffer {
       uint32_t raw;
     } val{};
     val.value = value;
-    this->encode_fixed32(field_id, val.raw);
+    this->encode_fixed32(field_id, val.raw, force);
   }
   void encode_int32(uint32_t field_id, int32_t value, bool force = false) {
     if (value < 0) {
@@ -235,38 +350,29 @@ class ProtoWriteBuffer {
     this->encode_uint64(field_id, static_cast<uint64_t>(value), force);
   }
   void encode_sint32(uint32_t field_id, int32_t value, bool force = false) {
-    uint32_t uvalue;
-    if (value < 0) {
-      uvalue = ~(value << 1);
-    } else {
-      uvalue = value << 1;
-    }
-    this->encode_uint32(field_id, uvalue, force);
+    this->encode_uint32(field_id, ProtoSize::encode_zigzag32(value), force);
   }
   void encode_sint64(uint32_t field_id, int64_t value, bool force = false) {
-    uint64_t uvalue;
-    if (value < 0) {
-      uvalue = ~(value << 1);
-    } else {
-      uvalue = value << 1;
-    }
-    this->encode_uint64(field_id, uvalue, force);
+    this->encode_uint64(field_id, ProtoSize::encode_zigzag64(value), force);
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // Write the length up front so the nested message doesn't have to be shifted afterwards
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
  protected:
+  /// Grow the buffer by len bytes and return a pointer to the first new byte.
+  uint8_t *extend_(size_t len) {
+    size_t pos = this->buffer_->size();
+    this->buffer_->resize(pos + len);
+    return this->buffer_->data() + pos;
+  }
+
   std::vector<uint8_t> *buffer_;
 };
 
@@ -274,6 +380,7 @@ class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
@@ -297,12 +404,18 @@ class ProtoService {
   virtual void on_fatal_error() = 0;
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
-  virtual ProtoWriteBuffer create_buffer() = 0;
+  /** Create a buffer to encode a message into.
+   *
+   * @param reserve_size The encoded size of the message, used to allocate the buffer only once.
+   */
+  virtual ProtoWriteBuffer create_buffer(uint32_t reserve_size) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
-    auto buffer = this->create_buffer();
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
+    auto buffer = this->create_buffer(msg_size);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
@@ -32,6 +32,8 @@ class BLEPresenceDevice : public binary_sensor::BinarySensorInitiallyOff,
   void set_ibeacon_uuid(uint8_t *uuid) {
     this->match_by_ = MATCH_BY_IBEACON_UUID;
     this->ibeacon_uuid_ = esp32_ble_tracker::ESPBTUUID::from_raw(uuid);
+    // iBeacons are sent as Apple manufacturer data
+    this->add_match_manufacturer_uuid(esp32_ble_tracker::ESPBTUUID::from_uint16(0x004C));
   }
   void set_ibeacon_major(uint16_t major) {
     this->check_ibeacon_major_ = true;
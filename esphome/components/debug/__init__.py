@@ -13,6 +13,7 @@ CODEOWNERS = ["@OttoWinter"]
 DEPENDENCIES = ["logger"]
 
 CONF_DEBUG_ID = "debug_id"
+CONF_PROFILER = "profiler"
 debug_ns = cg.esphome_ns.namespace("debug")
 DebugComponent = debug_ns.class_("DebugComponent", cg.PollingComponent)
 
@@ -35,6 +36,7 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(CONF_LOOP_TIME): cv.invalid(
             "The 'loop_time' option has been moved to the 'debug' sensor component"
         ),
+        cv.Optional(CONF_PROFILER, default=False): cv.boolean,
     }
 ).extend(cv.polling_component_schema("60s"))
 
@@ -42,3 +44,6 @@ CONFIG_SCHEMA = cv.Schema(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+
+    if config[CONF_PROFILER]:
+        cg.add_define("USE_PROFILER")
@@ -1,5 +1,7 @@
 #include "display_buffer.h"
 
+#include <cstring>
+#include <iterator>
 #include <utility>
 #include "esphome/core/application.h"
 #include "esphome/core/color.h"
@@ -15,6 +17,9 @@ static const char *const TAG = "display";
 const Color COLOR_OFF(0, 0, 0, 0);
 const Color COLOR_ON(255, 255, 255, 255);
 
+/// Edge length of the tiles for_each_changed_window_() compares.
+static const int DIRTY_TILE_SIZE = 16;
+
 void DisplayBuffer::init_internal_(uint32_t buffer_length) {
   ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
   this->buffer_ = allocator.allocate(buffer_length);
@@ -49,23 +54,30 @@ int DisplayBuffer::get_height() {
   }
 }
 void DisplayBuffer::set_rotation(DisplayRotation rotation) { this->rotation_ = rotation; }
-void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
+void HOT DisplayBuffer::transform_to_absolute_(int *x, int *y) {
   switch (this->rotation_) {
     case DISPLAY_ROTATION_0_DEGREES:
       break;
     case DISPLAY_ROTATION_90_DEGREES:
-      std::swap(x, y);
-      x = this->get_width_internal() - x - 1;
+      std::swap(*x, *y);
+      *x = this->get_width_internal() - *x - 1;
       break;
     case DISPLAY_ROTATION_180_DEGREES:
-      x = this->get_width_internal() - x - 1;
-      y = this->get_height_internal() - y - 1;
+      *x = this->get_width_internal() - *x - 1;
+      *y = this->get_height_internal() - *y - 1;
       break;
     case DISPLAY_ROTATION_270_DEGREES:
-      std::swap(x, y);
-      y = this->get_height_internal() - y - 1;
+      std::swap(*x, *y);
+      *y = this->get_height_internal() - *y - 1;
       break;
   }
+}
+bool DisplayBuffer::is_inside_(int x, int y, int width, int height) {
+  return x >= 0 && y >= 0 && x + width <= this->get_width_internal() && y + height <= this->get_height_internal();
+}
+void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
+  this->transform_to_absolute_(&x, &y);
+  this->mark_dirty_(x, y, x, y);
   this->draw_absolute_pixel_internal(x, y, color);
   App.feed_wdt();
 }
@@ -90,14 +102,10 @@ void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
   }
 }
 void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  this->filled_rectangle(x, y, width, 1, color);
 }
 void HOT DisplayBuffer::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
+  this->filled_rectangle(x, y, 1, height, color);
 }
 void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color) {
   this->horizontal_line(x1, y1, width, color);
@@ -105,11 +113,29 @@ void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color
   this->vertical_line(x1, y1, height, color);
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
-void DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
-  for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
-  }
+void HOT DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
+  if (width <= 0 || height <= 0)
+    return;
+  // A rotated rectangle is still a rectangle, so fill it row by row in absolute coordinates
+  int x2 = x1 + width - 1;
+  int y2 = y1 + height - 1;
+  this->transform_to_absolute_(&x1, &y1);
+  this->transform_to_absolute_(&x2, &y2);
+  if (x1 > x2)
+    std::swap(x1, x2);
+  if (y1 > y2)
+    std::swap(y1, y2);
+  x1 = std::max(x1, 0);
+  y1 = std::max(y1, 0);
+  x2 = std::min(x2, this->get_width_internal() - 1);
+  y2 = std::min(y2, this->get_height_internal() - 1);
+  if (x1 > x2 || y1 > y2)
+    return;
+
+  this->mark_dirty_(x1, y1, x2, y2);
+  for (int y = y1; y <= y2; y++)
+    this->fill_span_internal(x1, y, x2 - x1 + 1, color);
+  App.feed_wdt();
 }
 void HOT DisplayBuffer::circle(int center_x, int center_xy, int radius, Color color) {
   int dx = -radius;
@@ -176,10 +202,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
       if (!font->get_glyphs().empty()) {
         uint8_t glyph_width = font->get_glyphs()[0].glyph_data_->width;
-        for (int glyph_x = 0; glyph_x < glyph_width; glyph_x++) {
-          for (int glyph_y = 0; glyph_y < height; glyph_y++)
-            this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-        }
+        this->filled_rectangle(x_at, y_start, glyph_width, height, color);
         x_at += glyph_width;
       }
 
@@ -188,22 +211,73 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
     }
 
     const Glyph &glyph = font->get_glyphs()[glyph_n];
-    int scan_x1, scan_y1, scan_width, scan_height;
-    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-    for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
-      for (int glyph_y = scan_y1; glyph_y < scan_y1 + scan_height; glyph_y++) {
-        if (glyph.get_pixel(glyph_x, glyph_y)) {
-          this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-        }
-      }
-    }
+    this->draw_glyph_(x_at, y_start, glyph, color);
 
     x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
 
     i += match_length;
   }
 }
+void DisplayBuffer::draw_glyph_(int x, int y, const Glyph &glyph, Color color) {
+  const GlyphData *data = glyph.glyph_data_;
+  if (data->width <= 0 || data->height <= 0)
+    return;
+  const int glyph_x1 = x + data->offset_x;
+  const int glyph_y1 = y + data->offset_y;
+  if (this->rotation_ == DISPLAY_ROTATION_0_DEGREES &&
+      this->is_inside_(glyph_x1, glyph_y1, data->width, data->height)) {
+    this->mark_dirty_(glyph_x1, glyph_y1, glyph_x1 + data->width - 1, glyph_y1 + data->height - 1);
+    this->blit_bitmap_1bpp_internal(glyph_x1, glyph_y1, data->width, data->height, data->data, color, COLOR_OFF, true);
+    return;
+  }
+
+  // Rotated or clipped glyphs are drawn as runs of set pixels. Clipped runs go through filled_rectangle(), the others
+  // are rotated here, so that the dirty region only has to be extended once.
+  const bool inside = glyph_x1 >= 0 && glyph_y1 >= 0 && glyph_x1 + data->width <= this->get_width() &&
+                      glyph_y1 + data->height <= this->get_height();
+  if (inside) {
+    int x1 = glyph_x1, y1 = glyph_y1;
+    int x2 = glyph_x1 + data->width - 1, y2 = glyph_y1 + data->height - 1;
+    this->transform_to_absolute_(&x1, &y1);
+    this->transform_to_absolute_(&x2, &y2);
+    this->mark_dirty_(std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2));
+  }
+  const uint32_t stride = (data->width + 7u) / 8u;
+  for (int row = 0; row < data->height; row++) {
+    const uint8_t *line = data->data + row * stride;
+    int run_start = -1;
+    uint8_t bits = 0;
+    for (int col = 0; col <= data->width; col++) {
+      if (col % 8 == 0 && col < data->width)
+        bits = progmem_read_byte(line + col / 8);
+      const bool set = col < data->width && (bits & (0x80 >> (col % 8)));
+      if (set && run_start < 0) {
+        run_start = col;
+      } else if (!set && run_start >= 0) {
+        if (inside) {
+          this->draw_glyph_run_(glyph_x1 + run_start, glyph_y1 + row, col - run_start, color);
+        } else {
+          this->filled_rectangle(glyph_x1 + run_start, glyph_y1 + row, col - run_start, 1, color);
+        }
+        run_start = -1;
+      }
+    }
+  }
+  App.feed_wdt();
+}
+void DisplayBuffer::draw_glyph_run_(int x, int y, int width, Color color) {
+  int x1 = x, y1 = y;
+  int x2 = x + width - 1, y2 = y;
+  this->transform_to_absolute_(&x1, &y1);
+  this->transform_to_absolute_(&x2, &y2);
+  if (y1 == y2) {
+    this->fill_span_internal(std::min(x1, x2), y1, width, color);
+    return;
+  }
+  // Rotated by 90 or 270 degrees, the run is a column
+  for (int abs_y = std::min(y1, y2); abs_y <= std::max(y1, y2); abs_y++)
+    this->draw_absolute_pixel_internal(x1, abs_y, color);
+}
 void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign align, const char *format, va_list arg) {
   char buffer[256];
   int ret = vsnprintf(buffer, sizeof(buffer), format, arg);
@@ -212,6 +286,26 @@ void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign al
 }
 
 void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color color_off) {
+  const int width = image->get_width();
+  const int height = image->get_height();
+  if (this->rotation_ == DISPLAY_ROTATION_0_DEGREES && width > 0 && height > 0 &&
+      this->is_inside_(x, y, width, height)) {
+    switch (image->get_type()) {
+      case IMAGE_TYPE_BINARY:
+      case IMAGE_TYPE_TRANSPARENT_BINARY:
+        this->mark_dirty_(x, y, x + width - 1, y + height - 1);
+        this->blit_bitmap_1bpp_internal(x, y, width, height, image->get_data_start(), color_on, color_off,
+                                        image->get_type() == IMAGE_TYPE_TRANSPARENT_BINARY);
+        return;
+      case IMAGE_TYPE_RGB565:
+        this->mark_dirty_(x, y, x + width - 1, y + height - 1);
+        this->blit_rgb565_internal(x, y, width, height, image->get_data_start());
+        return;
+      default:
+        break;
+    }
+  }
+
   switch (image->get_type()) {
     case IMAGE_TYPE_BINARY:
       for (int img_x = 0; img_x < image->get_width(); img_x++) {
@@ -252,6 +346,90 @@ void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color colo
   }
 }
 
+void DisplayBuffer::fill_span_internal(int x, int y, int width, Color color) {
+  for (int i = x; i < x + width; i++)
+    this->draw_absolute_pixel_internal(i, y, color);
+}
+void DisplayBuffer::blit_bitmap_1bpp_internal(int x, int y, int width, int height, const uint8_t *data,
+                                              Color color_on, Color color_off, bool transparent) {
+  const uint32_t stride = (width + 7u) / 8u;
+  for (int row = 0; row < height; row++) {
+    const uint8_t *line = data + row * stride;
+    for (int col = 0; col < width; col++) {
+      if (progmem_read_byte(line + col / 8u) & (0x80 >> (col % 8u))) {
+        this->draw_absolute_pixel_internal(x + col, y + row, color_on);
+      } else if (!transparent) {
+        this->draw_absolute_pixel_internal(x + col, y + row, color_off);
+      }
+    }
+  }
+  App.feed_wdt();
+}
+void DisplayBuffer::blit_rgb565_internal(int x, int y, int width, int height, const uint8_t *data) {
+  for (int row = 0; row < height; row++) {
+    for (int col = 0; col < width; col++) {
+      uint16_t rgb565 = progmem_read_byte(data) << 8 | progmem_read_byte(data + 1);
+      data += 2;
+      this->draw_absolute_pixel_internal(x + col, y + row, ColorUtil::rgb565_to_color(rgb565));
+    }
+  }
+  App.feed_wdt();
+}
+void DisplayBuffer::for_each_changed_window_(uint8_t bytes_per_pixel,
+                                             const std::function<void(int, int, int, int)> &f) {
+  const int width = this->get_width_internal();
+  const int height = this->get_height_internal();
+  const int x1 = std::max(this->dirty_x1_, 0);
+  const int y1 = std::max(this->dirty_y1_, 0);
+  const int x2 = std::min(this->dirty_x2_, width - 1);
+  const int y2 = std::min(this->dirty_y2_, height - 1);
+  this->dirty_x1_ = this->dirty_y1_ = INT16_MAX;
+  this->dirty_x2_ = this->dirty_y2_ = -1;
+  if (this->buffer_ == nullptr || x1 > x2 || y1 > y2)
+    return;
+
+  const int tiles_x = (width + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE;
+  const int tiles_y = (height + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE;
+  // Before the first transfer the display content isn't known, so every tile counts as changed
+  const bool known = this->tile_hashes_.size() == size_t(tiles_x * tiles_y);
+  if (!known)
+    this->tile_hashes_.assign(tiles_x * tiles_y, 0);
+
+  for (int tile_y = y1 / DIRTY_TILE_SIZE; tile_y <= y2 / DIRTY_TILE_SIZE; tile_y++) {
+    const int y = tile_y * DIRTY_TILE_SIZE;
+    const int tile_height = std::min(DIRTY_TILE_SIZE, height - y);
+    int run_start = -1;
+    for (int tile_x = x1 / DIRTY_TILE_SIZE; tile_x <= x2 / DIRTY_TILE_SIZE + 1; tile_x++) {
+      bool changed = false;
+      if (tile_x <= x2 / DIRTY_TILE_SIZE) {
+        const int x = tile_x * DIRTY_TILE_SIZE;
+        const size_t row_bytes = size_t(std::min(DIRTY_TILE_SIZE, width - x)) * bytes_per_pixel;
+        // 32 bit FNV-1a over the tile
+        uint32_t hash = 2166136261UL;
+        for (int row = y; row < y + tile_height; row++) {
+          const uint8_t *data = this->buffer_ + (size_t(row) * width + x) * bytes_per_pixel;
+          for (size_t i = 0; i < row_bytes; i++) {
+            hash ^= data[i];
+            hash *= 16777619UL;
+          }
+        }
+        uint32_t &stored = this->tile_hashes_[tile_y * tiles_x + tile_x];
+        changed = !known || stored != hash;
+        stored = hash;
+      }
+      if (changed && run_start < 0) {
+        run_start = tile_x;
+      } else if (!changed && run_start >= 0) {
+        // Transfer adjacent changed tiles as one window
+        const int x = run_start * DIRTY_TILE_SIZE;
+        f(x, y, std::min(tile_x * DIRTY_TILE_SIZE, width) - x, tile_height);
+        run_start = -1;
+      }
+    }
+    App.feed_wdt();
+  }
+}
+
 #ifdef USE_GRAPH
 void DisplayBuffer::graph(int x, int y, graph::Graph *graph, Color color_on) { graph->draw(this, x, y, color_on); }
 void DisplayBuffer::legend(int x, int y, graph::Graph *graph, Color color_on) {
@@ -434,7 +612,84 @@ void Glyph::scan_area(int *x1, int *y1, int *width, int *height) const {
   *width = this->glyph_data_->width;
   *height = this->glyph_data_->height;
 }
+/// Length of the UTF-8 character starting with `lead`, 0 for bytes that can't start a multi byte character.
+static int utf8_length(uint8_t lead) {
+  if ((lead & 0xE0) == 0xC0)
+    return 2;
+  if ((lead & 0xF0) == 0xE0)
+    return 3;
+  if ((lead & 0xF8) == 0xF0)
+    return 4;
+  return 0;
+}
+static uint32_t index_hash(uint32_t key) { return key * 2654435761UL; }
+
+void Font::build_index_() {
+  std::fill(std::begin(this->ascii_index_), std::end(this->ascii_index_), -1);
+  std::vector<IndexEntry> others;
+  for (size_t i = 0; i < this->glyphs_.size(); i++) {
+    const auto *a_char = reinterpret_cast<const uint8_t *>(this->glyphs_[i].get_char());
+    const size_t len = strlen(this->glyphs_[i].get_char());
+    if (len == 1 && a_char[0] < 0x80) {
+      this->ascii_index_[a_char[0]] = i;
+      continue;
+    }
+    // Glyphs of multiple characters can only be matched by comparing strings
+    if (len < 2 || utf8_length(a_char[0]) != int(len) || i > INT16_MAX)
+      return;
+    uint32_t key = 0;
+    for (size_t j = 0; j < len; j++)
+      key = (key << 8) | a_char[j];
+    others.push_back(IndexEntry{key, int16_t(i)});
+  }
+
+  if (!others.empty()) {
+    // Keep the table at most half full
+    size_t size = 4;
+    while (size < others.size() * 2)
+      size *= 2;
+    this->index_.assign(size, IndexEntry{0, -1});
+    for (auto &entry : others) {
+      size_t pos = index_hash(entry.key) & (size - 1);
+      while (this->index_[pos].key != 0)
+        pos = (pos + 1) & (size - 1);
+      this->index_[pos] = entry;
+    }
+  }
+  this->indexed_ = true;
+}
 int Font::match_next_glyph(const char *str, int *match_length) {
+  *match_length = 0;
+  if (!this->indexed_)
+    return this->bisect_glyph_(str, match_length);
+
+  const auto lead = static_cast<uint8_t>(str[0]);
+  if (lead < 0x80) {
+    const int glyph = this->ascii_index_[lead];
+    if (glyph >= 0)
+      *match_length = 1;
+    return glyph;
+  }
+
+  const int len = utf8_length(lead);
+  if (len == 0 || this->index_.empty())
+    return -1;
+  uint32_t key = lead;
+  for (int i = 1; i < len; i++) {
+    if (str[i] == '\0')
+      return -1;
+    key = (key << 8) | static_cast<uint8_t>(str[i]);
+  }
+  const size_t mask = this->index_.size() - 1;
+  for (size_t pos = index_hash(key) & mask; this->index_[pos].key != 0; pos = (pos + 1) & mask) {
+    if (this->index_[pos].key == key) {
+      *match_length = len;
+      return this->index_[pos].glyph;
+    }
+  }
+  return -1;
+}
+int Font::bisect_glyph_(const char *str, int *match_length) {
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
   while (lo != hi) {
@@ -453,6 +708,20 @@ int Font::match_next_glyph(const char *str, int *match_length) {
 void Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height) {
   *baseline = this->baseline_;
   *height = this->bottom_;
+
+  const size_t len = strlen(str);
+  MeasureCacheEntry *oldest = &this->measure_cache_[0];
+  for (auto &entry : this->measure_cache_) {
+    if (entry.text.size() == len && memcmp(entry.text.data(), str, len) == 0) {
+      entry.last_used = ++this->measure_counter_;
+      *width = entry.width;
+      *x_offset = entry.x_offset;
+      return;
+    }
+    if (entry.last_used < oldest->last_used)
+      oldest = &entry;
+  }
+
   int i = 0;
   int min_x = 0;
   bool has_char = false;
@@ -481,11 +750,17 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   }
   *x_offset = min_x;
   *width = x - min_x;
+
+  oldest->text.assign(str, len);
+  oldest->width = *width;
+  oldest->x_offset = *x_offset;
+  oldest->last_used = ++this->measure_counter_;
 }
 const std::vector<Glyph> &Font::get_glyphs() const { return this->glyphs_; }
 Font::Font(const GlyphData *data, int data_nr, int baseline, int bottom) : baseline_(baseline), bottom_(bottom) {
   for (int i = 0; i < data_nr; ++i)
     glyphs_.emplace_back(data + i);
+  this->build_index_();
 }
 
 bool Image::get_pixel(int x, int y) const {
@@ -510,10 +785,7 @@ Color Image::get_rgb565_pixel(int x, int y) const {
   const uint32_t pos = (x + y * this->width_) * 2;
   uint16_t rgb565 =
       progmem_read_byte(this->data_start_ + pos + 0) << 8 | progmem_read_byte(this->data_start_ + pos + 1);
-  auto r = (rgb565 & 0xF800) >> 11;
-  auto g = (rgb565 & 0x07E0) >> 5;
-  auto b = rgb565 & 0x001F;
-  return Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+  return ColorUtil::rgb565_to_color(rgb565);
 }
 Color Image::get_grayscale_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
@@ -525,6 +797,7 @@ Color Image::get_grayscale_pixel(int x, int y) const {
 int Image::get_width() const { return this->width_; }
 int Image::get_height() const { return this->height_; }
 ImageType Image::get_type() const { return this->type_; }
+const uint8_t *Image::get_data_start() const { return this->data_start_; }
 Image::Image(const uint8_t *data_start, int width, int height, ImageType type)
     : width_(width), height_(height), type_(type), data_start_(data_start) {}
 
@@ -559,10 +832,7 @@ Color Animation::get_rgb565_pixel(int x, int y) const {
   const uint32_t pos = (x + y * this->width_ + frame_index) * 2;
   uint16_t rgb565 =
       progmem_read_byte(this->data_start_ + pos + 0) << 8 | progmem_read_byte(this->data_start_ + pos + 1);
-  auto r = (rgb565 & 0xF800) >> 11;
-  auto g = (rgb565 & 0x07E0) >> 5;
-  auto b = rgb565 & 0x001F;
-  return Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+  return ColorUtil::rgb565_to_color(rgb565);
 }
 Color Animation::get_grayscale_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
@@ -576,6 +846,20 @@ Color Animation::get_grayscale_pixel(int x, int y) const {
 }
 Animation::Animation(const uint8_t *data_start, int width, int height, uint32_t animation_frame_count, ImageType type)
     : Image(data_start, width, height, type), current_frame_(0), animation_frame_count_(animation_frame_count) {}
+const uint8_t *Animation::get_data_start() const {
+  switch (this->type_) {
+    case IMAGE_TYPE_BINARY:
+    case IMAGE_TYPE_TRANSPARENT_BINARY:
+      return this->data_start_ + (this->width_ + 7u) / 8u * this->height_ * this->current_frame_;
+    case IMAGE_TYPE_RGB565:
+      return this->data_start_ + this->width_ * this->height_ * 2 * this->current_frame_;
+    case IMAGE_TYPE_RGB24:
+      return this->data_start_ + this->width_ * this->height_ * 3 * this->current_frame_;
+    case IMAGE_TYPE_GRAYSCALE:
+    default:
+      return this->data_start_ + this->width_ * this->height_ * this->current_frame_;
+  }
+}
 int Animation::get_animation_frame_count() const { return this->animation_frame_count_; }
 int Animation::get_current_frame() const { return this->current_frame_; }
 void Animation::next_frame() {
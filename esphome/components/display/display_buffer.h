@@ -4,7 +4,10 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/automation.h"
 #include "display_color_utils.h"
+#include <algorithm>
 #include <cstdarg>
+#include <string>
+#include <vector>
 
 #ifdef USE_TIME
 #include "esphome/components/time/real_time_clock.h"
@@ -99,6 +102,7 @@ enum DisplayRotation {
 };
 
 class Font;
+class Glyph;
 class Image;
 class DisplayBuffer;
 class DisplayPage;
@@ -377,6 +381,43 @@ class DisplayBuffer {
 
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  // Block drawing primitives in absolute (unrotated) coordinates. The default implementations draw pixel by pixel
+  // with draw_absolute_pixel_internal(), displays with a local buffer can override them to write whole runs at once.
+  // The area is always fully inside the display and has already been added to the dirty region.
+
+  /// Fill `width` pixels of row `y` starting at `x`.
+  virtual void fill_span_internal(int x, int y, int width, Color color);
+  /// Draw a 1 bit per pixel bitmap (MSB first, rows padded to full bytes) from flash, optionally skipping off pixels.
+  virtual void blit_bitmap_1bpp_internal(int x, int y, int width, int height, const uint8_t *data, Color color_on,
+                                         Color color_off, bool transparent);
+  /// Draw a big-endian RGB565 bitmap from flash.
+  virtual void blit_rgb565_internal(int x, int y, int width, int height, const uint8_t *data);
+
+  /// Draw a glyph with its origin at [x,y].
+  void draw_glyph_(int x, int y, const Glyph &glyph, Color color);
+  /// Draw a horizontal run of a glyph that lies fully on the display, in rotated coordinates.
+  void draw_glyph_run_(int x, int y, int width, Color color);
+
+  /// Apply the display rotation to the given coordinates.
+  void transform_to_absolute_(int *x, int *y);
+  /// Whether the rectangle in absolute coordinates lies fully on the display.
+  bool is_inside_(int x, int y, int width, int height);
+
+  /// Extend the dirty region, the area (absolute, inclusive coordinates) that was drawn to since the last update.
+  void mark_dirty_(int x1, int y1, int x2, int y2) {
+    this->dirty_x1_ = std::min(this->dirty_x1_, x1);
+    this->dirty_y1_ = std::min(this->dirty_y1_, y1);
+    this->dirty_x2_ = std::max(this->dirty_x2_, x2);
+    this->dirty_y2_ = std::max(this->dirty_y2_, y2);
+  }
+  /** Call `f(x, y, width, height)` for all windows of the dirty region whose content differs from what was
+   * transferred the last time, and reset the dirty region.
+   *
+   * The region is split into tiles whose hashes are remembered, so that drawing the same content again (for example
+   * after auto clear) doesn't cause a transfer. `bytes_per_pixel` describes the row-major layout of `buffer_`.
+   */
+  void for_each_changed_window_(uint8_t bytes_per_pixel, const std::function<void(int, int, int, int)> &f);
+
   void init_internal_(uint32_t buffer_length);
 
   void do_update_();
@@ -388,6 +429,12 @@ class DisplayBuffer {
   DisplayPage *previous_page_{nullptr};
   std::vector<DisplayOnPageChangeTrigger *> on_page_change_triggers_;
   bool auto_clear_enabled_{true};
+  int dirty_x1_{INT16_MAX};
+  int dirty_y1_{INT16_MAX};
+  int dirty_x2_{-1};
+  int dirty_y2_{-1};
+  /// Hash of every tile as it was last transferred by for_each_changed_window_().
+  std::vector<uint32_t> tile_hashes_;
 };
 
 class DisplayPage {
@@ -455,9 +502,37 @@ class Font {
   const std::vector<Glyph> &get_glyphs() const;
 
  protected:
+  static const size_t MEASURE_CACHE_SIZE = 8;
+
+  struct IndexEntry {
+    /// The UTF-8 bytes of the glyph, 0 for empty slots.
+    uint32_t key;
+    int16_t glyph;
+  };
+  struct MeasureCacheEntry {
+    std::string text;
+    // Empty entries hold the measurements of the empty string
+    int width{0};
+    int x_offset{0};
+    uint32_t last_used{0};
+  };
+
+  /// Index the glyphs by their character, if all of them are a single UTF-8 character.
+  void build_index_();
+  /// Find the glyph by bisecting the sorted glyphs, for fonts that can't be indexed.
+  int bisect_glyph_(const char *str, int *match_length);
+
   std::vector<Glyph> glyphs_;
   int baseline_;
   int bottom_;
+  bool indexed_{false};
+  /// Glyph of every ASCII character, -1 if the font doesn't have it.
+  int16_t ascii_index_[128];
+  /// Open addressing hash table of the glyphs for all other characters.
+  std::vector<IndexEntry> index_;
+  /// The widths of the most recently measured texts, dashboards redraw mostly the same texts on every update.
+  MeasureCacheEntry measure_cache_[MEASURE_CACHE_SIZE];
+  uint32_t measure_counter_{0};
 };
 
 class Image {
@@ -470,6 +545,8 @@ class Image {
   int get_width() const;
   int get_height() const;
   ImageType get_type() const;
+  /// Get the pixel data of the image (or of the current animation frame).
+  virtual const uint8_t *get_data_start() const;
 
  protected:
   int width_;
@@ -485,6 +562,7 @@ class Animation : public Image {
   Color get_color_pixel(int x, int y) const override;
   Color get_rgb565_pixel(int x, int y) const override;
   Color get_grayscale_pixel(int x, int y) const override;
+  const uint8_t *get_data_start() const override;
 
   int get_animation_frame_count() const;
   int get_current_frame() const;
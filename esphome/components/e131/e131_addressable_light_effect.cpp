@@ -62,26 +62,27 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
   ESP_LOGV(TAG, "Applying data for '%s' on %d universe, for %d-%d.", get_name().c_str(), universe, output_offset,
            output_end);
 
+  auto outputs = it->range(output_offset, output_end);
   switch (channels_) {
     case E131_MONO:
-      for (; output_offset < output_end; output_offset++, input_data++) {
-        auto output = (*it)[output_offset];
+      for (auto output : outputs) {
         output.set(Color(input_data[0], input_data[0], input_data[0], input_data[0]));
+        input_data++;
       }
       break;
 
     case E131_RGB:
-      for (; output_offset < output_end; output_offset++, input_data += 3) {
-        auto output = (*it)[output_offset];
+      for (auto output : outputs) {
         output.set(
             Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3));
+        input_data += 3;
       }
       break;
 
     case E131_RGBW:
-      for (; output_offset < output_end; output_offset++, input_data += 4) {
-        auto output = (*it)[output_offset];
+      for (auto output : outputs) {
         output.set(Color(input_data[0], input_data[1], input_data[2], input_data[3]));
+        input_data += 4;
       }
       break;
   }
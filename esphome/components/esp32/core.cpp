@@ -35,7 +35,12 @@ void arch_restart() {
   }
 }
 
+static TaskHandle_t wake_task_handle = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
 void arch_init() {
+  // Remember the loop task (from which we're currently running) so that it can be woken by arch_wake_loop()
+  wake_task_handle = xTaskGetCurrentTaskHandle();
+
   // Enable the task watchdog only on the loop task (from which we're currently running)
 #if defined(USE_ESP_IDF)
   esp_task_wdt_add(nullptr);
@@ -52,6 +57,19 @@ void arch_init() {
 #endif
 }
 void IRAM_ATTR HOT arch_feed_wdt() { esp_task_wdt_reset(); }
+void arch_wait_for_wake(uint32_t ms) { ulTaskNotifyTake(pdTRUE, ms / portTICK_PERIOD_MS); }
+void IRAM_ATTR HOT arch_wake_loop() {
+  if (wake_task_handle == nullptr)
+    return;
+  if (xPortInIsrContext()) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(wake_task_handle, &higher_priority_task_woken);
+    if (higher_priority_task_woken)
+      portYIELD_FROM_ISR();
+  } else {
+    xTaskNotifyGive(wake_task_handle);
+  }
+}
 
 uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
 uint32_t arch_get_cpu_cycle_count() {
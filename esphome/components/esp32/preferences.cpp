@@ -19,6 +19,33 @@ struct NVSData {
 };
 
 static std::vector<NVSData> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+/** Values known to be stored in NVS (loaded or written since boot), so that sync() doesn't have to read them back.
+ *
+ * This costs a copy of every cached value plus its key and vector overhead in RAM, about 40 bytes for the typical
+ * preference of a few bytes. Only values up to MAX_STORED_SIZE bytes are cached, larger ones are read back from NVS
+ * on every sync() like before, so the cache stays below that size times the number of preferences.
+ */
+static std::vector<NVSData> s_stored;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static const size_t MAX_STORED_SIZE = 64;
+
+static void remember_stored(const std::string &key, const uint8_t *data, size_t len) {
+  for (auto it = s_stored.begin(); it != s_stored.end(); ++it) {
+    if (it->key != key)
+      continue;
+    if (len > MAX_STORED_SIZE) {
+      s_stored.erase(it);
+    } else {
+      it->data.assign(data, data + len);
+    }
+    return;
+  }
+  if (len > MAX_STORED_SIZE)
+    return;
+  NVSData stored{};
+  stored.key = key;
+  stored.data.assign(data, data + len);
+  s_stored.emplace_back(std::move(stored));
+}
 
 class ESP32PreferenceBackend : public ESPPreferenceBackend {
  public:
@@ -69,6 +96,7 @@ class ESP32PreferenceBackend : public ESPPreferenceBackend {
     } else {
       ESP_LOGVV(TAG, "nvs_get_blob: key: %s, len: %d", key.c_str(), len);
     }
+    remember_stored(key, data, len);
     return true;
   }
 };
@@ -131,6 +159,7 @@ class ESP32Preferences : public ESPPreferences {
           last_key = save.key;
           continue;
         }
+        remember_stored(save.key, save.data.data(), save.data.size());
         written++;
       } else {
         ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", save.key.c_str(), save.data.size());
@@ -155,6 +184,11 @@ class ESP32Preferences : public ESPPreferences {
     return failed == 0;
   }
   bool is_changed(const uint32_t nvs_handle, const NVSData &to_save) {
+    for (const auto &obj : s_stored) {
+      if (obj.key == to_save.key)
+        return obj.data != to_save.data;
+    }
+
     NVSData stored_data{};
     size_t actual_len;
     esp_err_t err = nvs_get_blob(nvs_handle, to_save.key.c_str(), nullptr, &actual_len);
@@ -168,6 +202,7 @@ class ESP32Preferences : public ESPPreferences {
       ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", to_save.key.c_str(), esp_err_to_name(err));
       return true;
     }
+    remember_stored(to_save.key, stored_data.data.data(), stored_data.data.size());
     return to_save.data != stored_data.data;
   }
 };
@@ -222,11 +222,15 @@ async def to_code(config):
 
 async def register_ble_device(var, config):
     paren = await cg.get_variable(config[CONF_ESP32_BLE_ID])
+    if CONF_MAC_ADDRESS in config:
+        cg.add(var.add_match_address(config[CONF_MAC_ADDRESS].as_hex))
     cg.add(paren.register_listener(var))
     return var
 
 
 async def register_client(var, config):
     paren = await cg.get_variable(config[CONF_ESP32_BLE_ID])
+    if CONF_MAC_ADDRESS in config:
+        cg.add(var.add_match_address(config[CONF_MAC_ADDRESS].as_hex))
     cg.add(paren.register_client(var))
     return var
@@ -15,6 +15,8 @@
 #include <esp_gap_ble_api.h>
 #include <esp_bt_defs.h>
 
+#include <algorithm>
+
 #ifdef USE_ARDUINO
 #include <esp32-hal-bt.h>
 #endif
@@ -85,17 +87,23 @@ void ESP32BLETracker::loop() {
     if (index >= 16) {
       ESP_LOGW(TAG, "Too many BLE events to process. Some devices may not show up.");
     }
+    if (index > 0 && this->index_dirty_)
+      this->build_index_();
     for (size_t i = 0; i < index; i++) {
       ESPBTDevice device;
       device.parse_scan_rst(this->scan_result_buffer_[i]);
 
       bool found = false;
-      for (auto *listener : this->listeners_) {
+      this->listener_index_.find(device, this->matches_);
+      for (auto *listener : this->matches_) {
         if (listener->parse_device(device))
           found = true;
       }
 
-      for (auto *client : this->clients_) {
+      this->client_index_.find(device, this->matches_);
+      for (auto *listener : this->matches_) {
+        // Only clients are added to the client index
+        auto *client = static_cast<ESPBTClient *>(listener);
         if (client->parse_device(device)) {
           found = true;
           if (client->state() == ClientState::DISCOVERED) {
@@ -238,6 +246,71 @@ void ESP32BLETracker::start_scan_(bool first) {
 void ESP32BLETracker::register_client(ESPBTClient *client) {
   client->app_id = ++this->app_id_;
   this->clients_.push_back(client);
+  this->index_dirty_ = true;
+}
+
+void ESP32BLETracker::build_index_() {
+  this->listener_index_.clear();
+  for (auto *listener : this->listeners_)
+    this->listener_index_.add(listener);
+  this->client_index_.clear();
+  for (auto *client : this->clients_)
+    this->client_index_.add(client);
+  this->index_dirty_ = false;
+}
+
+uint64_t make_match_key(MatchKeyType type, uint64_t address) {
+  return (uint64_t(type) << 56) | (address & 0xFFFFFFFFFFFFULL);
+}
+uint64_t make_match_key(MatchKeyType type, const ESPBTUUID &uuid) {
+  // 16 and 32 bit UUIDs compare equal to their 128 bit form, so always hash that (64 bit FNV-1a)
+  esp_bt_uuid_t raw = uuid.as_128bit().get_uuid();
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for (uint8_t i = 0; i < ESP_UUID_LEN_128; i++) {
+    hash ^= raw.uuid.uuid128[i];
+    hash *= 0x100000001B3ULL;
+  }
+  return (uint64_t(type) << 56) | (hash & 0x00FFFFFFFFFFFFFFULL);
+}
+
+void ESPBTListenerIndex::clear() {
+  this->by_key_.clear();
+  this->wildcard_.clear();
+}
+void ESPBTListenerIndex::add(ESPBTDeviceListener *listener) {
+  const auto &keys = listener->get_match_keys();
+  if (keys.empty()) {
+    this->wildcard_.push_back(listener);
+    return;
+  }
+  for (uint64_t key : keys) {
+    auto &listeners = this->by_key_[key];
+    if (std::find(listeners.begin(), listeners.end(), listener) == listeners.end())
+      listeners.push_back(listener);
+  }
+}
+void ESPBTListenerIndex::find(const ESPBTDevice &device, std::vector<ESPBTDeviceListener *> &matches) const {
+  matches = this->wildcard_;
+  if (this->by_key_.empty())
+    return;
+
+  size_t wildcard_count = matches.size();
+  this->find_key_(make_match_key(MatchKeyType::ADDRESS, device.address_uint64()), matches);
+  for (auto &service_data : device.get_service_datas())
+    this->find_key_(make_match_key(MatchKeyType::SERVICE_DATA_UUID, service_data.uuid), matches);
+  for (auto &manufacturer_data : device.get_manufacturer_datas())
+    this->find_key_(make_match_key(MatchKeyType::MANUFACTURER_ID, manufacturer_data.uuid), matches);
+
+  // A listener with several keys can match more than once, wildcard listeners are never indexed
+  if (matches.size() - wildcard_count > 1) {
+    std::sort(matches.begin() + wildcard_count, matches.end());
+    matches.erase(std::unique(matches.begin() + wildcard_count, matches.end()), matches.end());
+  }
+}
+void ESPBTListenerIndex::find_key_(uint64_t key, std::vector<ESPBTDeviceListener *> &matches) const {
+  auto it = this->by_key_.find(key);
+  if (it != this->by_key_.end())
+    matches.insert(matches.end(), it->second.begin(), it->second.end());
 }
 
 void ESP32BLETracker::gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
@@ -716,12 +789,8 @@ void ESP32BLETracker::dump_config() {
   ESP_LOGCONFIG(TAG, "  Scan Type: %s", this->scan_active_ ? "ACTIVE" : "PASSIVE");
 }
 void ESP32BLETracker::print_bt_device_info(const ESPBTDevice &device) {
-  const uint64_t address = device.address_uint64();
-  for (auto &disc : this->already_discovered_) {
-    if (disc == address)
-      return;
-  }
-  this->already_discovered_.push_back(address);
+  if (!this->already_discovered_.insert(device.address_uint64()).second)
+    return;
 
   ESP_LOGD(TAG, "Found device %s RSSI=%d", device.address_str().c_str(), device.get_rssi());
 
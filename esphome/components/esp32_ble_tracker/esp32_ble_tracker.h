@@ -8,6 +8,8 @@
 
 #include <string>
 #include <array>
+#include <unordered_map>
+#include <unordered_set>
 #include <esp_gap_ble_api.h>
 #include <esp_gattc_api.h>
 #include <esp_bt_defs.h>
@@ -128,14 +130,57 @@ class ESPBTDevice {
 
 class ESP32BLETracker;
 
+/// The advertisement properties a listener can declare interest in, see ESPBTDeviceListener.
+enum class MatchKeyType : uint8_t {
+  ADDRESS = 1,
+  SERVICE_DATA_UUID = 2,
+  MANUFACTURER_ID = 3,
+};
+
+/// Build the key the tracker indexes listeners by. UUIDs are hashed, so keys are not necessarily unique.
+uint64_t make_match_key(MatchKeyType type, uint64_t address);
+uint64_t make_match_key(MatchKeyType type, const ESPBTUUID &uuid);
+
 class ESPBTDeviceListener {
  public:
   virtual void on_scan_end() {}
   virtual bool parse_device(const ESPBTDevice &device) = 0;
   void set_parent(ESP32BLETracker *parent) { parent_ = parent; }
 
+  /** Only pass advertisements that match at least one of the registered keys to parse_device().
+   *
+   * This is just a pre-filter so that the tracker doesn't have to call every listener for every advertisement,
+   * parse_device() still has to check the device itself. Listeners without any keys see every advertisement.
+   */
+  void add_match_address(uint64_t address) {
+    this->match_keys_.push_back(make_match_key(MatchKeyType::ADDRESS, address));
+  }
+  void add_match_service_data_uuid(const ESPBTUUID &uuid) {
+    this->match_keys_.push_back(make_match_key(MatchKeyType::SERVICE_DATA_UUID, uuid));
+  }
+  void add_match_manufacturer_uuid(const ESPBTUUID &uuid) {
+    this->match_keys_.push_back(make_match_key(MatchKeyType::MANUFACTURER_ID, uuid));
+  }
+  const std::vector<uint64_t> &get_match_keys() const { return this->match_keys_; }
+
  protected:
   ESP32BLETracker *parent_{nullptr};
+  std::vector<uint64_t> match_keys_;
+};
+
+/// Listeners indexed by their match keys, with a fallback list for listeners that want every advertisement.
+class ESPBTListenerIndex {
+ public:
+  void clear();
+  void add(ESPBTDeviceListener *listener);
+  /// Collect all listeners that may be interested in this device, each listener is returned at most once.
+  void find(const ESPBTDevice &device, std::vector<ESPBTDeviceListener *> &matches) const;
+
+ protected:
+  void find_key_(uint64_t key, std::vector<ESPBTDeviceListener *> &matches) const;
+
+  std::unordered_map<uint64_t, std::vector<ESPBTDeviceListener *>> by_key_;
+  std::vector<ESPBTDeviceListener *> wildcard_;
 };
 
 enum class ClientState {
@@ -182,6 +227,7 @@ class ESP32BLETracker : public Component {
   void register_listener(ESPBTDeviceListener *listener) {
     listener->set_parent(this);
     this->listeners_.push_back(listener);
+    this->index_dirty_ = true;
   }
 
   void register_client(ESPBTClient *client);
@@ -204,17 +250,25 @@ class ESP32BLETracker : public Component {
   void gap_scan_start_complete_(const esp_ble_gap_cb_param_t::ble_scan_start_cmpl_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_STOP_COMPLETE_EVT` event is received.
   void gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_scan_stop_cmpl_evt_param &param);
+  /// Rebuild the listener and client indices from their currently registered match keys.
+  void build_index_();
 
   int app_id_;
   /// Callback that will handle all GATTC events and redistribute them to other callbacks.
   static void gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if, esp_ble_gattc_cb_param_t *param);
   void real_gattc_event_handler_(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if, esp_ble_gattc_cb_param_t *param);
 
-  /// Vector of addresses that have already been printed in print_bt_device_info
-  std::vector<uint64_t> already_discovered_;
+  /// Set of addresses that have already been printed in print_bt_device_info
+  std::unordered_set<uint64_t> already_discovered_;
   std::vector<ESPBTDeviceListener *> listeners_;
   /// Client parameters.
   std::vector<ESPBTClient *> clients_;
+  ESPBTListenerIndex listener_index_;
+  ESPBTListenerIndex client_index_;
+  /// Set when listeners or clients are registered, the indices are rebuilt before the next advertisement.
+  bool index_dirty_{true};
+  /// Scratch buffer for the listeners matching the current advertisement.
+  std::vector<ESPBTDeviceListener *> matches_;
   /// A structure holding the ESP BLE scan parameters.
   esp_ble_scan_params_t scan_params_;
   /// The interval in seconds to perform scans.
@@ -116,6 +116,8 @@ CONF_AGC_GAIN_CEILING = "agc_gain_ceiling"
 CONF_WB_MODE = "wb_mode"
 # test pattern
 CONF_TEST_PATTERN = "test_pattern"
+# framebuffers
+CONF_FRAME_BUFFER_COUNT = "frame_buffer_count"
 # framerates
 CONF_MAX_FRAMERATE = "max_framerate"
 CONF_IDLE_FRAMERATE = "idle_framerate"
@@ -184,6 +186,10 @@ CONFIG_SCHEMA = cv.ENTITY_BASE_SCHEMA.extend(
         cv.Optional(CONF_WB_MODE, default="AUTO"): cv.enum(ENUM_WB_MODE, upper=True),
         # test pattern
         cv.Optional(CONF_TEST_PATTERN, default=False): cv.boolean,
+        # framebuffers, defaults to 2 if PSRAM is found at runtime and 1 otherwise.
+        # With a single one, a slow stream client holds the only frame and stalls
+        # the others.
+        cv.Optional(CONF_FRAME_BUFFER_COUNT): cv.int_range(min=1, max=2),
         # framerates
         cv.Optional(CONF_MAX_FRAMERATE, default="10 fps"): cv.All(
             cv.framerate, cv.Range(min=0, min_included=False, max=60)
@@ -237,6 +243,8 @@ SETTERS = {
     CONF_WB_MODE: "set_wb_mode",
     # test pattern
     CONF_TEST_PATTERN: "set_test_pattern",
+    # framebuffers
+    CONF_FRAME_BUFFER_COUNT: "set_frame_buffer_count",
 }
 
 
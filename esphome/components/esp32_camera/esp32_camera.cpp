@@ -4,6 +4,7 @@
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 
+#include <esp_heap_caps.h>
 #include <freertos/task.h>
 
 namespace esphome {
@@ -18,6 +19,10 @@ void ESP32Camera::setup() {
   /* initialize time to now */
   this->last_update_ = millis();
 
+  /* a second framebuffer keeps frames coming while a slow client still holds one, if there's PSRAM for it */
+  if (this->config_.fb_count == 0)
+    this->config_.fb_count = heap_caps_get_free_size(MALLOC_CAP_SPIRAM) > 0 ? 2 : 1;
+
   /* initialize camera */
   esp_err_t err = esp_camera_init(&this->config_);
   if (err != ESP_OK) {
@@ -32,7 +37,7 @@ void ESP32Camera::setup() {
 
   /* initialize RTOS */
   this->framebuffer_get_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
-  this->framebuffer_return_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
+  this->framebuffer_return_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
   xTaskCreatePinnedToCore(&ESP32Camera::framebuffer_task,
                           "framebuffer_task",  // name
                           1024,                // stack size
@@ -99,7 +104,7 @@ void ESP32Camera::dump_config() {
   sensor_t *s = esp_camera_sensor_get();
   auto st = s->status;
   ESP_LOGCONFIG(TAG, "  JPEG Quality: %u", st.quality);
-  // ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", conf.fb_count);
+  ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", conf.fb_count);
   ESP_LOGCONFIG(TAG, "  Contrast: %d", st.contrast);
   ESP_LOGCONFIG(TAG, "  Brightness: %d", st.brightness);
   ESP_LOGCONFIG(TAG, "  Saturation: %d", st.saturation);
@@ -125,13 +130,7 @@ void ESP32Camera::dump_config() {
 }
 
 void ESP32Camera::loop() {
-  // check if we can return the image
-  if (this->can_return_image_()) {
-    // return image
-    auto *fb = this->current_image_->get_raw_buffer();
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    this->current_image_.reset();
-  }
+  this->return_images_();
 
   // request idle image every idle_update_interval
   const uint32_t now = millis();
@@ -143,8 +142,8 @@ void ESP32Camera::loop() {
   // Check if we should fetch a new image
   if (!this->has_requested_image_())
     return;
-  if (this->current_image_.use_count() > 1) {
-    // image is still in use
+  if (this->images_.size() >= static_cast<size_t>(this->config_.fb_count)) {
+    // all framebuffers are still in use
     return;
   }
   if (now - this->last_update_ <= this->max_update_interval_)
@@ -163,10 +162,11 @@ void ESP32Camera::loop() {
     xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
     return;
   }
-  this->current_image_ = std::make_shared<CameraImage>(fb, this->single_requesters_ | this->stream_requesters_);
+  auto image = std::make_shared<CameraImage>(fb, this->single_requesters_ | this->stream_requesters_);
+  this->images_.push_back(image);
 
   ESP_LOGD(TAG, "Got Image: len=%u", fb->len);
-  this->new_image_callback_.call(this->current_image_);
+  this->new_image_callback_.call(std::move(image));
   this->last_update_ = now;
   this->single_requesters_ = 0;
 }
@@ -183,7 +183,7 @@ ESP32Camera::ESP32Camera(const std::string &name) : EntityBase(name) {
   this->config_.pixel_format = PIXFORMAT_JPEG;
   this->config_.frame_size = FRAMESIZE_VGA;  // 640x480
   this->config_.jpeg_quality = 10;
-  this->config_.fb_count = 1;
+  this->config_.fb_count = 0;  // chosen in setup()
 
   global_esp32_camera = this;
 }
@@ -270,6 +270,8 @@ void ESP32Camera::set_agc_gain_ceiling(ESP32AgcGainCeiling gain_ceiling) { this-
 void ESP32Camera::set_wb_mode(ESP32WhiteBalanceMode mode) { this->wb_mode_ = mode; }
 /* set test mode */
 void ESP32Camera::set_test_pattern(bool test_pattern) { this->test_pattern_ = test_pattern; }
+/* set framebuffers */
+void ESP32Camera::set_frame_buffer_count(uint8_t count) { this->config_.fb_count = count; }
 /* set fps */
 void ESP32Camera::set_max_update_interval(uint32_t max_update_interval) {
   this->max_update_interval_ = max_update_interval;
@@ -323,14 +325,38 @@ void ESP32Camera::update_camera_parameters() {
 
 /* ---------------- Internal methods ---------------- */
 bool ESP32Camera::has_requested_image_() const { return this->single_requesters_ || this->stream_requesters_; }
-bool ESP32Camera::can_return_image_() const { return this->current_image_.use_count() == 1; }
+void ESP32Camera::return_images_() {
+  // an image that is only referenced by us isn't used by any consumer anymore
+  auto it = this->images_.begin();
+  while (it != this->images_.end()) {
+    if (it->use_count() > 1) {
+      ++it;
+      continue;
+    }
+    auto *fb = (*it)->get_raw_buffer();
+    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+    it = this->images_.erase(it);
+  }
+}
 void ESP32Camera::framebuffer_task(void *pv) {
+  const uint8_t fb_count = global_esp32_camera->config_.fb_count;
+  uint8_t in_use = 0;
   while (true) {
-    camera_fb_t *framebuffer = esp_camera_fb_get();
-    xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
-    // return is no-op for config with 1 fb
-    xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, portMAX_DELAY);
-    esp_camera_fb_return(framebuffer);
+    camera_fb_t *framebuffer;
+    if (in_use < fb_count) {
+      framebuffer = esp_camera_fb_get();
+      xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
+      in_use++;
+    }
+    // only block for a returned framebuffer when all of them are in use, as the driver would otherwise capture
+    // into a buffer that is still being read
+    TickType_t wait = in_use < fb_count ? 0 : portMAX_DELAY;
+    while (xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, wait) == pdTRUE) {
+      // return is no-op for config with 1 fb
+      esp_camera_fb_return(framebuffer);
+      in_use--;
+      wait = 0;
+    }
   }
 }
 
@@ -9,6 +9,7 @@
 #include <esp_camera.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
+#include <vector>
 
 namespace esphome {
 namespace esp32_camera {
@@ -130,6 +131,8 @@ class ESP32Camera : public Component, public EntityBase {
   void set_wb_mode(ESP32WhiteBalanceMode mode);
   /* -- test */
   void set_test_pattern(bool test_pattern);
+  /* -- framebuffers, by default 2 if there is PSRAM and 1 otherwise */
+  void set_frame_buffer_count(uint8_t count);
   /* -- framerates */
   void set_max_update_interval(uint32_t max_update_interval);
   void set_idle_update_interval(uint32_t idle_update_interval);
@@ -152,7 +155,7 @@ class ESP32Camera : public Component, public EntityBase {
  protected:
   /* internal methods */
   bool has_requested_image_() const;
-  bool can_return_image_() const;
+  void return_images_();
 
   static void framebuffer_task(void *pv);
 
@@ -184,7 +187,8 @@ class ESP32Camera : public Component, public EntityBase {
   uint32_t idle_update_interval_{15000};
 
   esp_err_t init_error_{ESP_OK};
-  std::shared_ptr<CameraImage> current_image_;
+  /// Images that have been handed out and not returned yet, at most one per framebuffer.
+  std::vector<std::shared_ptr<CameraImage>> images_;
   uint8_t single_requesters_{0};
   uint8_t stream_requesters_{0};
   QueueHandle_t framebuffer_get_queue_;
@@ -7,14 +7,17 @@
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <esp_http_server.h>
+#include <sys/socket.h>
 #include <utility>
 
 namespace esphome {
 namespace esp32_camera_web_server {
 
 static const int IMAGE_REQUEST_TIMEOUT = 5000;
+static const int MAX_STREAM_CLIENTS = 3;
 static const char *const TAG = "esp32_camera_web_server";
 
 #define PART_BOUNDARY "123456789000000000000987654321"
@@ -46,11 +49,12 @@ void CameraWebServer::setup() {
   }
 
   this->semaphore_ = xSemaphoreCreateBinary();
+  this->stream_lock_ = xSemaphoreCreateMutex();
 
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
   config.server_port = this->port_;
   config.ctrl_port = this->port_;
-  config.max_open_sockets = 1;
+  config.max_open_sockets = this->mode_ == STREAM ? MAX_STREAM_CLIENTS : 1;
   config.backlog_conn = 2;
   config.lru_purge_enable = true;
 
@@ -68,7 +72,15 @@ void CameraWebServer::setup() {
   httpd_register_uri_handler(this->httpd_, &uri);
 
   esp32_camera::global_esp32_camera->add_image_callback([this](std::shared_ptr<esp32_camera::CameraImage> image) {
-    if (this->running_ && image->was_requested_by(esp32_camera::WEB_REQUESTER)) {
+    if (!image->was_requested_by(esp32_camera::WEB_REQUESTER))
+      return;
+    if (this->streaming_) {
+      // all stream clients share the newest frame, clients still busy with an older one skip to it
+      xSemaphoreTake(this->stream_lock_, portMAX_DELAY);
+      this->stream_image_ = std::move(image);
+      this->stream_image_id_++;
+      xSemaphoreGive(this->stream_lock_);
+    } else if (this->running_) {
       this->image_ = std::move(image);
       xSemaphoreGive(this->semaphore_);
     }
@@ -82,6 +94,8 @@ void CameraWebServer::on_shutdown() {
   this->httpd_ = nullptr;
   vSemaphoreDelete(this->semaphore_);
   this->semaphore_ = nullptr;
+  vSemaphoreDelete(this->stream_lock_);
+  this->stream_lock_ = nullptr;
 }
 
 void CameraWebServer::dump_config() {
@@ -104,6 +118,18 @@ void CameraWebServer::loop() {
   if (!this->running_) {
     this->image_ = nullptr;
   }
+
+  if (!this->streaming_) {
+    this->high_freq_.stop();
+    return;
+  }
+  this->high_freq_.start();
+  // The streams are sent from the HTTP server task, as that's where their sessions can be closed
+  if (!this->send_queued_.exchange(true)) {
+    auto work = [](void *arg) { static_cast<CameraWebServer *>(arg)->send_streams_(); };
+    if (httpd_queue_work(this->httpd_, work, this) != ESP_OK)
+      this->send_queued_ = false;
+  }
 }
 
 std::shared_ptr<esphome::esp32_camera::CameraImage> CameraWebServer::wait_for_image_() {
@@ -120,21 +146,12 @@ std::shared_ptr<esphome::esp32_camera::CameraImage> CameraWebServer::wait_for_im
 }
 
 esp_err_t CameraWebServer::handler_(struct httpd_req *req) {
-  esp_err_t res = ESP_FAIL;
+  if (this->mode_ == STREAM)
+    return this->streaming_handler_(req);
 
   this->image_ = nullptr;
   this->running_ = true;
-
-  switch (this->mode_) {
-    case STREAM:
-      res = this->streaming_handler_(req);
-      break;
-
-    case SNAPSHOT:
-      res = this->snapshot_handler_(req);
-      break;
-  }
-
+  esp_err_t res = this->snapshot_handler_(req);
   this->running_ = false;
   this->image_ = nullptr;
   return res;
@@ -155,59 +172,130 @@ static esp_err_t httpd_send_all(httpd_req_t *r, const char *buf, size_t buf_len)
 }
 
 esp_err_t CameraWebServer::streaming_handler_(struct httpd_req *req) {
-  esp_err_t res = ESP_OK;
-  char part_buf[64];
-
   // This manually constructs HTTP response to avoid chunked encoding
   // which is not supported by some clients
 
-  res = httpd_send_all(req, STREAM_HEADER, strlen(STREAM_HEADER));
+  esp_err_t res = httpd_send_all(req, STREAM_HEADER, strlen(STREAM_HEADER));
   if (res != ESP_OK) {
     ESP_LOGW(TAG, "STREAM: failed to set HTTP header");
     return res;
   }
 
-  uint32_t last_frame = millis();
-  uint32_t frames = 0;
+  // The session stays open after the handler returned, the frames are sent by send_streams_()
+  auto *client = new StreamClient();  // NOLINT(cppcoreguidelines-owning-memory)
+  client->server = this;
+  client->fd = httpd_req_to_sockfd(req);
+  client->last_frame = millis();
+  req->sess_ctx = client;
+  req->free_ctx = [](void *ctx) {
+    auto *client = static_cast<StreamClient *>(ctx);
+    client->server->remove_stream_client_(client);
+  };
+
+  if (this->stream_clients_.empty())
+    esp32_camera::global_esp32_camera->start_stream(esphome::esp32_camera::WEB_REQUESTER);
+  this->stream_clients_.push_back(client);
+  this->streaming_ = true;
+  ESP_LOGI(TAG, "STREAM: opened. Clients: %u", this->stream_clients_.size());
+  return ESP_OK;
+}
+
+void CameraWebServer::remove_stream_client_(StreamClient *client) {
+  ESP_LOGI(TAG, "STREAM: closed. Frames: %u", client->frames);
+  this->stream_clients_.erase(std::remove(this->stream_clients_.begin(), this->stream_clients_.end(), client),
+                              this->stream_clients_.end());
+  delete client;  // NOLINT(cppcoreguidelines-owning-memory)
+  if (!this->stream_clients_.empty())
+    return;
 
-  esp32_camera::global_esp32_camera->start_stream(esphome::esp32_camera::WEB_REQUESTER);
+  this->streaming_ = false;
+  esp32_camera::global_esp32_camera->stop_stream(esphome::esp32_camera::WEB_REQUESTER);
+  xSemaphoreTake(this->stream_lock_, portMAX_DELAY);
+  this->stream_image_ = nullptr;
+  xSemaphoreGive(this->stream_lock_);
+}
 
-  while (res == ESP_OK && this->running_) {
-    auto image = this->wait_for_image_();
+void CameraWebServer::send_streams_() {
+  this->send_queued_ = false;
 
-    if (!image) {
-      ESP_LOGW(TAG, "STREAM: failed to acquire frame");
-      res = ESP_FAIL;
+  xSemaphoreTake(this->stream_lock_, portMAX_DELAY);
+  auto image = this->stream_image_;
+  const uint32_t image_id = this->stream_image_id_;
+  xSemaphoreGive(this->stream_lock_);
+
+  bool all_taken = true;
+  for (auto *client : this->stream_clients_) {
+    this->send_stream_(client, image, image_id);
+    all_taken &= client->image_id == image_id;
+  }
+  if (image && all_taken) {
+    // Don't keep the framebuffer from being reused once every client is sending it
+    xSemaphoreTake(this->stream_lock_, portMAX_DELAY);
+    if (this->stream_image_id_ == image_id)
+      this->stream_image_ = nullptr;
+    xSemaphoreGive(this->stream_lock_);
+  }
+}
+
+void CameraWebServer::send_stream_(StreamClient *client, const std::shared_ptr<esp32_camera::CameraImage> &image,
+                                   uint32_t image_id) {
+  const size_t boundary_len = strlen(STREAM_BOUNDARY);
+  while (!client->failed) {
+    if (!client->image) {
+      if (!image || client->image_id == image_id) {
+        // Every frame has to arrive in time, a camera that stopped delivering must not keep the session open
+        if (millis() - client->last_frame > IMAGE_REQUEST_TIMEOUT) {
+          ESP_LOGW(TAG, "STREAM: failed to acquire frame %u", client->frames + 1);
+          httpd_socket_send(this->httpd_, client->fd, STREAM_ERROR, strlen(STREAM_ERROR), MSG_DONTWAIT);
+          client->failed = true;
+          httpd_sess_trigger_close(this->httpd_, client->fd);
+        }
+        return;
+      }
+      // Frames that arrived while this client was busy are skipped
+      client->image = image;
+      client->image_id = image_id;
+      client->offset = 0;
+      client->part_len = snprintf(client->part, sizeof(client->part), STREAM_PART, image->get_data_length());
     }
-    if (res == ESP_OK) {
-      size_t hlen = snprintf(part_buf, 64, STREAM_PART, image->get_data_length());
-      res = httpd_send_all(req, part_buf, hlen);
+
+    // A frame consists of the part header, the image and the boundary
+    const size_t data_len = client->image->get_data_length();
+    size_t offset = client->offset;
+    const char *buf;
+    size_t len;
+    if (offset < client->part_len) {
+      buf = client->part + offset;
+      len = client->part_len - offset;
+    } else if ((offset -= client->part_len) < data_len) {
+      buf = (const char *) client->image->get_data_buffer() + offset;
+      len = data_len - offset;
+    } else {
+      offset -= data_len;
+      buf = STREAM_BOUNDARY + offset;
+      len = boundary_len - offset;
     }
-    if (res == ESP_OK) {
-      res = httpd_send_all(req, (const char *) image->get_data_buffer(), image->get_data_length());
+
+    int ret = httpd_socket_send(this->httpd_, client->fd, buf, len, MSG_DONTWAIT);
+    if (ret == HTTPD_SOCK_ERR_TIMEOUT || ret == 0) {
+      // socket buffer is full, continue with the next call
+      return;
     }
-    if (res == ESP_OK) {
-      res = httpd_send_all(req, STREAM_BOUNDARY, strlen(STREAM_BOUNDARY));
+    if (ret < 0) {
+      client->failed = true;
+      httpd_sess_trigger_close(this->httpd_, client->fd);
+      return;
     }
-    if (res == ESP_OK) {
-      frames++;
-      int64_t frame_time = millis() - last_frame;
-      last_frame = millis();
 
-      ESP_LOGD(TAG, "MJPG: %uB %ums (%.1ffps)", (uint32_t) image->get_data_length(), (uint32_t) frame_time,
-               1000.0 / (uint32_t) frame_time);
+    client->offset += ret;
+    if (client->offset == client->part_len + data_len + boundary_len) {
+      client->frames++;
+      const uint32_t frame_time = millis() - client->last_frame;
+      client->last_frame = millis();
+      ESP_LOGD(TAG, "MJPG: %uB %ums (%.1ffps)", (uint32_t) data_len, frame_time, 1000.0 / frame_time);
+      client->image = nullptr;
     }
   }
-
-  if (!frames) {
-    res = httpd_send_all(req, STREAM_ERROR, strlen(STREAM_ERROR));
-  }
-
-  esp32_camera::global_esp32_camera->stop_stream(esphome::esp32_camera::WEB_REQUESTER);
-
-  ESP_LOGI(TAG, "STREAM: closed. Frames: %u", frames);
-
-  return res;
 }
 
 esp_err_t CameraWebServer::snapshot_handler_(struct httpd_req *req) {
@@ -5,6 +5,9 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 
+#include <atomic>
+#include <vector>
+
 #include "esphome/components/esp32_camera/esp32_camera.h"
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
@@ -31,10 +34,30 @@ class CameraWebServer : public Component {
   void loop() override;
 
  protected:
+  /// State of a stream connection. It's owned by the HTTP session and only used from the HTTP server task.
+  struct StreamClient {
+    CameraWebServer *server;
+    int fd;
+    /// Frame that is currently being sent, and its id
+    std::shared_ptr<esphome::esp32_camera::CameraImage> image;
+    uint32_t image_id{0};
+    /// Bytes of the frame that have been sent, including the part header
+    size_t offset{0};
+    char part[64];
+    size_t part_len{0};
+    uint32_t frames{0};
+    uint32_t last_frame{0};
+    bool failed{false};
+  };
+
   std::shared_ptr<esphome::esp32_camera::CameraImage> wait_for_image_();
   esp_err_t handler_(struct httpd_req *req);
   esp_err_t streaming_handler_(struct httpd_req *req);
   esp_err_t snapshot_handler_(struct httpd_req *req);
+  void send_streams_();
+  void send_stream_(StreamClient *client, const std::shared_ptr<esphome::esp32_camera::CameraImage> &image,
+                    uint32_t image_id);
+  void remove_stream_client_(StreamClient *client);
 
   uint16_t port_{0};
   void *httpd_{nullptr};
@@ -42,6 +65,15 @@ class CameraWebServer : public Component {
   std::shared_ptr<esphome::esp32_camera::CameraImage> image_;
   bool running_{false};
   Mode mode_{STREAM};
+
+  /// Newest frame for the stream clients, set from the main loop and guarded by stream_lock_
+  SemaphoreHandle_t stream_lock_;
+  std::shared_ptr<esphome::esp32_camera::CameraImage> stream_image_;
+  uint32_t stream_image_id_{0};
+  std::vector<StreamClient *> stream_clients_;
+  std::atomic<bool> streaming_{false};
+  std::atomic<bool> send_queued_{false};
+  HighFrequencyLoopRequester high_freq_;
 };
 
 }  // namespace esp32_camera_web_server
@@ -20,12 +20,17 @@ from esphome.helpers import copy_file_if_changed
 from .const import (
     CONF_RESTORE_FROM_FLASH,
     CONF_EARLY_PIN_INIT,
+    CONF_PREFERENCES_FLASH_SECTORS,
     KEY_BOARD,
     KEY_ESP8266,
     KEY_PIN_INITIAL_STATES,
     esp8266_ns,
 )
-from .boards import ESP8266_FLASH_SIZES, ESP8266_LD_SCRIPTS
+from .boards import (
+    ESP8266_FLASH_SIZES,
+    ESP8266_LD_SCRIPTS,
+    ESP8266_LD_SCRIPTS_WITH_FS,
+)
 
 from .gpio import PinInitialState, add_pin_initial_states_array
 
@@ -142,6 +147,30 @@ ARDUINO_FRAMEWORK_SCHEMA = cv.All(
 )
 
 
+def _validate_preferences_flash_sectors(config):
+    if config[CONF_PREFERENCES_FLASH_SECTORS] == 1:
+        return config
+    # Without restore_from_flash, the flash preferences are hardly ever written, and
+    # the flash layout shouldn't lose its filesystem area for them.
+    if not config[CONF_RESTORE_FROM_FLASH]:
+        raise cv.Invalid(
+            f"{CONF_PREFERENCES_FLASH_SECTORS} requires {CONF_RESTORE_FROM_FLASH}",
+            path=[CONF_PREFERENCES_FLASH_SECTORS],
+        )
+    # The preferences log is stored at the end of the filesystem area of the flash
+    # layout, a layout with such an area is only selected for the known boards.
+    if config[CONF_BOARD] not in ESP8266_FLASH_SIZES:
+        _LOGGER.warning(
+            "The flash layout of board %s is unknown, %s only takes effect if "
+            "it has a filesystem area of at least %s sectors, which then can't be "
+            "used as filesystem. Otherwise a single sector is used.",
+            config[CONF_BOARD],
+            CONF_PREFERENCES_FLASH_SECTORS,
+            config[CONF_PREFERENCES_FLASH_SECTORS] - 1,
+        )
+    return config
+
+
 BUILD_FLASH_MODES = ["qio", "qout", "dio", "dout"]
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
@@ -149,6 +178,12 @@ CONFIG_SCHEMA = cv.All(
             cv.Required(CONF_BOARD): cv.string_strict,
             cv.Optional(CONF_FRAMEWORK, default={}): ARDUINO_FRAMEWORK_SCHEMA,
             cv.Optional(CONF_RESTORE_FROM_FLASH, default=False): cv.boolean,
+            # More than one sector (only with restore_from_flash) selects a flash layout
+            # with a filesystem area and stores the preferences log at its end,
+            # LittleFS/SPIFFS can't be used then.
+            cv.Optional(CONF_PREFERENCES_FLASH_SECTORS, default=1): cv.int_range(
+                min=1, max=16
+            ),
             cv.Optional(CONF_EARLY_PIN_INIT, default=True): cv.boolean,
             cv.Optional(CONF_BOARD_FLASH_MODE, default="dout"): cv.one_of(
                 *BUILD_FLASH_MODES, lower=True
@@ -156,6 +191,7 @@ CONFIG_SCHEMA = cv.All(
         }
     ),
     set_core_data,
+    _validate_preferences_flash_sectors,
 )
 
 
@@ -199,6 +235,15 @@ async def to_code(config):
     if config[CONF_RESTORE_FROM_FLASH]:
         cg.add_define("USE_ESP8266_PREFERENCES_FLASH")
 
+    use_preferences_log = (
+        config[CONF_RESTORE_FROM_FLASH] and config[CONF_PREFERENCES_FLASH_SECTORS] > 1
+    )
+    if use_preferences_log:
+        cg.add_define(
+            "USE_ESP8266_PREFERENCES_LOG_SECTORS",
+            config[CONF_PREFERENCES_FLASH_SECTORS],
+        )
+
     if config[CONF_EARLY_PIN_INIT]:
         cg.add_define("USE_ESP8266_EARLY_PIN_INIT")
 
@@ -220,7 +265,10 @@ async def to_code(config):
 
     if config[CONF_BOARD] in ESP8266_FLASH_SIZES:
         flash_size = ESP8266_FLASH_SIZES[config[CONF_BOARD]]
-        ld_scripts = ESP8266_LD_SCRIPTS[flash_size]
+        if use_preferences_log:
+            ld_scripts = ESP8266_LD_SCRIPTS_WITH_FS[flash_size]
+        else:
+            ld_scripts = ESP8266_LD_SCRIPTS[flash_size]
 
         if ver <= cv.Version(2, 3, 0):
             # No ld script support
@@ -55,6 +55,15 @@ ESP8266_LD_SCRIPTS = {
     FLASH_SIZE_4_MB: ("eagle.flash.4m.ld", "eagle.flash.4m.ld"),
     FLASH_SIZE_16_MB: ("eagle.flash.16m.ld", "eagle.flash.16m14m.ld"),
 }
+# Layouts with a filesystem area of at least 64KB for preferences_flash_sectors > 1.
+# The preferences log takes the last sectors of that area, the filesystem can't be used.
+ESP8266_LD_SCRIPTS_WITH_FS = {
+    FLASH_SIZE_512_KB: ("eagle.flash.512k64.ld", "eagle.flash.512k64.ld"),
+    FLASH_SIZE_1_MB: ("eagle.flash.1m64.ld", "eagle.flash.1m64.ld"),
+    FLASH_SIZE_2_MB: ("eagle.flash.2m.ld", "eagle.flash.2m64.ld"),
+    FLASH_SIZE_4_MB: ("eagle.flash.4m.ld", "eagle.flash.4m1m.ld"),
+    FLASH_SIZE_16_MB: ("eagle.flash.16m.ld", "eagle.flash.16m14m.ld"),
+}
 
 ESP8266_BASE_PINS = {
     "A0": 17,
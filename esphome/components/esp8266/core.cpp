@@ -27,6 +27,17 @@ void IRAM_ATTR HOT arch_feed_wdt() {
   ESP.wdtFeed();  // NOLINT(readability-static-accessed-through-instance)
 }
 
+static volatile bool wake_requested = false;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void arch_wait_for_wake(uint32_t ms) {
+  // There's no task to block on, sleep in 1ms steps (which still lets the SDK idle) until woken
+  const uint32_t start = millis();
+  while (!wake_requested && millis() - start < ms)
+    ::delay(1);
+  wake_requested = false;
+}
+void IRAM_ATTR HOT arch_wake_loop() { wake_requested = true; }
+
 uint8_t progmem_read_byte(const uint8_t *addr) {
   return pgm_read_byte(addr);  // NOLINT
 }
@@ -12,6 +12,10 @@ extern "C" {
 #include "esphome/core/log.h"
 #include "esphome/core/defines.h"
 
+#ifdef USE_ESP8266_PREFERENCES_LOG_SECTORS
+#include "esphome/components/preferences/log_store.h"
+#endif
+
 namespace esphome {
 namespace esp8266 {
 
@@ -65,6 +69,42 @@ static uint32_t get_esp8266_flash_sector() {
 }
 static uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
 
+#ifdef USE_ESP8266_PREFERENCES_LOG_SECTORS
+extern "C" uint32_t _SPIFFS_start;  // NOLINT
+
+/** The log occupies the preferences sector and the sectors right before it, at the end of the filesystem area.
+ *
+ * The code generator selects a flash layout with a filesystem area for known boards, which then can't be used for
+ * LittleFS/SPIFFS. Layouts without one leave no room, so a single sector is used.
+ */
+class ESP8266LogStoreFlash : public preferences::LogStoreFlash {
+ public:
+  ESP8266LogStoreFlash(uint32_t first_sector) : first_sector_(first_sector) {}
+  bool erase_sector(uint32_t sector) override {
+    InterruptLock lock;
+    return spi_flash_erase_sector(this->first_sector_ + sector) == SPI_FLASH_RESULT_OK;
+  }
+  bool write(uint32_t address, const uint32_t *data, size_t words) override {
+    InterruptLock lock;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    return spi_flash_write(this->first_sector_ * SPI_FLASH_SEC_SIZE + address, const_cast<uint32_t *>(data),
+                           words * 4) == SPI_FLASH_RESULT_OK;
+  }
+  bool read(uint32_t address, uint32_t *data, size_t words) override {
+    InterruptLock lock;
+    return spi_flash_read(this->first_sector_ * SPI_FLASH_SEC_SIZE + address, data, words * 4) ==
+           SPI_FLASH_RESULT_OK;
+  }
+
+ protected:
+  uint32_t first_sector_;
+};
+
+static preferences::LogStore *s_log_store = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+/// Whether s_flash_storage holds the single sector layout, which is only the case until the log is first written.
+static bool s_flash_storage_valid = false;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+
 template<class It> uint32_t calculate_crc(It first, It last, uint32_t type) {
   uint32_t crc = type;
   while (first != last) {
@@ -124,6 +164,12 @@ class ESP8266PreferenceBackend : public ESPPreferenceBackend {
     if ((len + 3) / 4 != length_words) {
       return false;
     }
+#ifdef USE_ESP8266_PREFERENCES_LOG_SECTORS
+    if (in_flash && s_log_store != nullptr) {
+      s_log_store->set(type, data, len);
+      return true;
+    }
+#endif
     std::vector<uint32_t> buffer;
     buffer.resize(length_words + 1);
     memcpy(buffer.data(), data, len);
@@ -139,6 +185,15 @@ class ESP8266PreferenceBackend : public ESPPreferenceBackend {
     if ((len + 3) / 4 != length_words) {
       return false;
     }
+#ifdef USE_ESP8266_PREFERENCES_LOG_SECTORS
+    if (in_flash && s_log_store != nullptr) {
+      if (s_log_store->get(type, data, len))
+        return true;
+      // Before the first log sector was written, values are still read from the single sector layout
+      if (!s_flash_storage_valid)
+        return false;
+    }
+#endif
     std::vector<uint32_t> buffer;
     buffer.resize(length_words + 1);
     bool ret;
@@ -156,6 +211,11 @@ class ESP8266PreferenceBackend : public ESPPreferenceBackend {
     }
 
     memcpy(data, buffer.data(), len);
+#ifdef USE_ESP8266_PREFERENCES_LOG_SECTORS
+    // Migrate the value to the log with the next sync
+    if (in_flash && s_log_store != nullptr)
+      s_log_store->set(type, data, len);
+#endif
     return true;
   }
 };
@@ -173,6 +233,23 @@ class ESP8266Preferences : public ESPPreferences {
       InterruptLock lock;
       spi_flash_read(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
     }
+
+#ifdef USE_ESP8266_PREFERENCES_LOG_SECTORS
+    const uint32_t sectors = USE_ESP8266_PREFERENCES_LOG_SECTORS;
+    const uint32_t first_sector = get_esp8266_flash_sector() + 1 - sectors;
+    union {
+      uint32_t *ptr;
+      uint32_t uint;
+    } fs_start{};
+    fs_start.ptr = &_SPIFFS_start;
+    if (first_sector * SPI_FLASH_SEC_SIZE < fs_start.uint - 0x40200000) {
+      ESP_LOGE(TAG, "Flash layout has no room for %u preference sectors, using a single sector", sectors);
+      return;
+    }
+    s_log_store = new preferences::LogStore(  // NOLINT(cppcoreguidelines-owning-memory)
+        new ESP8266LogStoreFlash(first_sector), SPI_FLASH_SEC_SIZE, sectors);  // NOLINT
+    s_flash_storage_valid = !s_log_store->load();
+#endif
   }
 
   ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
@@ -228,6 +305,16 @@ class ESP8266Preferences : public ESPPreferences {
   }
 
   bool sync() override {
+#ifdef USE_ESP8266_PREFERENCES_LOG_SECTORS
+    if (s_log_store != nullptr) {
+      if (!s_log_store->has_pending())
+        return true;
+      if (s_prevent_write)
+        return false;
+      ESP_LOGD(TAG, "Saving preferences to flash...");
+      return s_log_store->sync();
+    }
+#endif
     if (!s_flash_dirty)
       return true;
     if (s_prevent_write)
@@ -228,6 +228,14 @@ class FastLEDLightOutput : public light::AddressableLight {
     return {&this->leds_[index].r,      &this->leds_[index].g, &this->leds_[index].b, nullptr,
             &this->effect_data_[index], &this->correction_};
   }
+  bool get_pixel_buffer_(light::ESPPixelBuffer *buffer) const override {
+    // CRGB is stored as red, green and blue bytes
+    buffer->data = reinterpret_cast<uint8_t *>(this->leds_);
+    buffer->stride = 3;
+    buffer->effect_data = this->effect_data_;
+    buffer->correction = &this->correction_;
+    return true;
+  }
 
   CLEDController *controller_{nullptr};
   CRGB *leds_{nullptr};
@@ -85,50 +85,49 @@ void ILI9341Display::update() {
 }
 
 void ILI9341Display::display_() {
-  // we will only update the changed window to the display
-  uint16_t w = this->x_high_ - this->x_low_ + 1;
-  uint16_t h = this->y_high_ - this->y_low_ + 1;
+  // we will only update the changed windows to the display
+  this->for_each_changed_window_(1, [this](int x, int y, int w, int h) { this->write_window_(x, y, w, h); });
+}
 
-  set_addr_window_(this->x_low_, this->y_low_, w, h);
+void ILI9341Display::write_window_(int x, int y, int w, int h) {
+  set_addr_window_(x, y, w, h);
   this->start_data_();
-  uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
+  uint32_t start_pos = ((y * this->width_) + x);
+  uint8_t current = 0;
   for (uint16_t row = 0; row < h; row++) {
     uint32_t pos = start_pos + (row * width_);
     uint32_t rem = w;
 
     while (rem > 0) {
-      uint32_t sz = buffer_to_transfer_(pos, rem);
-      this->write_array(transfer_buffer_, 2 * sz);
+      // convert the next chunk while the previous one is still being sent from the other buffer
+      uint8_t *transfer_buffer = this->transfer_buffer_[current];
+      uint32_t sz = buffer_to_transfer_(pos, rem, transfer_buffer);
+      this->wait_async();
+      this->write_array_async(transfer_buffer, 2 * sz);
+      current ^= 1;
       pos += sz;
       rem -= sz;
     }
   }
   this->end_data_();
-
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
 }
 
 void ILI9341Display::fill(Color color) {
   uint8_t color332 = display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
   memset(this->buffer_, color332, this->get_buffer_length_());
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  this->mark_dirty_(0, 0, this->get_width_internal() - 1, this->get_height_internal() - 1);
 }
 
 void ILI9341Display::fill_internal_(Color color) {
+  uint8_t *transfer_buffer = this->transfer_buffer_[0];
+  const size_t transfer_buffer_size = sizeof(this->transfer_buffer_[0]);
   if (color.raw_32 == Color::BLACK.raw_32) {
-    memset(transfer_buffer_, 0, sizeof(transfer_buffer_));
+    memset(transfer_buffer, 0, transfer_buffer_size);
   } else {
-    uint8_t *dst = transfer_buffer_;
+    uint8_t *dst = transfer_buffer;
     auto color565 = display::ColorUtil::color_to_565(color);
 
-    while (dst < transfer_buffer_ + sizeof(transfer_buffer_)) {
+    while (dst < transfer_buffer + transfer_buffer_size) {
       *dst++ = (uint8_t)(color565 >> 8);
       *dst++ = (uint8_t) color565;
     }
@@ -140,8 +139,9 @@ void ILI9341Display::fill_internal_(Color color) {
   this->start_data_();
 
   while (rem > 0) {
-    size_t sz = rem <= sizeof(transfer_buffer_) ? rem : sizeof(transfer_buffer_);
-    this->write_array(transfer_buffer_, sz);
+    // the same buffer is sent over and over, so the transfers can be queued back to back
+    size_t sz = rem <= transfer_buffer_size ? rem : transfer_buffer_size;
+    this->write_array_async(transfer_buffer, sz);
     rem -= sz;
   }
 
@@ -150,23 +150,53 @@ void ILI9341Display::fill_internal_(Color color) {
   memset(buffer_, 0, (this->get_width_internal()) * (this->get_height_internal()));
 }
 
+uint8_t ILI9341Display::color_to_buffer_(Color color) {
+  if (this->buffer_color_mode_ == BITS_8) {
+    return display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
+  } else {  // if (this->buffer_color_mode_ == BITS_8_INDEXED) {
+    return display::ColorUtil::color_to_index8_palette888(color, this->palette_);
+  }
+}
+
 void HOT ILI9341Display::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
     return;
 
-  // low and high watermark may speed up drawing from buffer
-  this->x_low_ = (x < this->x_low_) ? x : this->x_low_;
-  this->y_low_ = (y < this->y_low_) ? y : this->y_low_;
-  this->x_high_ = (x > this->x_high_) ? x : this->x_high_;
-  this->y_high_ = (y > this->y_high_) ? y : this->y_high_;
-
   uint32_t pos = (y * width_) + x;
-  if (this->buffer_color_mode_ == BITS_8) {
-    uint8_t color332 = display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
-    buffer_[pos] = color332;
-  } else {  // if (this->buffer_color_mode_ == BITS_8_INDEXED) {
-    uint8_t index = display::ColorUtil::color_to_index8_palette888(color, this->palette_);
-    buffer_[pos] = index;
+  buffer_[pos] = this->color_to_buffer_(color);
+}
+
+void HOT ILI9341Display::fill_span_internal(int x, int y, int width, Color color) {
+  memset(this->buffer_ + (y * width_) + x, this->color_to_buffer_(color), width);
+}
+
+void HOT ILI9341Display::blit_bitmap_1bpp_internal(int x, int y, int width, int height, const uint8_t *data,
+                                                   Color color_on, Color color_off, bool transparent) {
+  // convert both colors once instead of for every pixel
+  const uint8_t on = this->color_to_buffer_(color_on);
+  const uint8_t off = transparent ? 0 : this->color_to_buffer_(color_off);
+  const uint32_t stride = (width + 7u) / 8u;
+  for (int row = 0; row < height; row++) {
+    const uint8_t *src = data + row * stride;
+    uint8_t *dst = this->buffer_ + ((y + row) * width_) + x;
+    for (int col = 0; col < width; col++) {
+      if (progmem_read_byte(src + col / 8u) & (0x80 >> (col % 8u))) {
+        dst[col] = on;
+      } else if (!transparent) {
+        dst[col] = off;
+      }
+    }
+  }
+}
+
+void HOT ILI9341Display::blit_rgb565_internal(int x, int y, int width, int height, const uint8_t *data) {
+  for (int row = 0; row < height; row++) {
+    uint8_t *dst = this->buffer_ + ((y + row) * width_) + x;
+    for (int col = 0; col < width; col++) {
+      uint16_t rgb565 = progmem_read_byte(data) << 8 | progmem_read_byte(data + 1);
+      data += 2;
+      dst[col] = this->color_to_buffer_(display::ColorUtil::rgb565_to_color(rgb565));
+    }
   }
 }
 
@@ -223,12 +253,11 @@ void ILI9341Display::invert_display_(bool invert) { this->command(invert ? ILI93
 int ILI9341Display::get_width_internal() { return this->width_; }
 int ILI9341Display::get_height_internal() { return this->height_; }
 
-uint32_t ILI9341Display::buffer_to_transfer_(uint32_t pos, uint32_t sz) {
+uint32_t ILI9341Display::buffer_to_transfer_(uint32_t pos, uint32_t sz, uint8_t *dst) {
   uint8_t *src = buffer_ + pos;
-  uint8_t *dst = transfer_buffer_;
 
-  if (sz > sizeof(transfer_buffer_) / 2) {
-    sz = sizeof(transfer_buffer_) / 2;
+  if (sz > sizeof(transfer_buffer_[0]) / 2) {
+    sz = sizeof(transfer_buffer_[0]) / 2;
   }
 
   for (uint32_t i = 0; i < sz; ++i) {
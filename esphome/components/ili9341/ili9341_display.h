@@ -53,6 +53,10 @@ class ILI9341Display : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_bitmap_1bpp_internal(int x, int y, int width, int height, const uint8_t *data, Color color_on,
+                                 Color color_off, bool transparent) override;
+  void blit_rgb565_internal(int x, int y, int width, int height, const uint8_t *data) override;
   void setup_pins_();
 
   void init_lcd_(const uint8_t *init_cmd);
@@ -61,14 +65,12 @@ class ILI9341Display : public PollingComponent,
   void reset_();
   void fill_internal_(Color color);
   void display_();
+  void write_window_(int x, int y, int w, int h);
+  uint8_t color_to_buffer_(Color color);
 
   ILI9341Model model_;
   int16_t width_{320};   ///< Display width as modified by current rotation
   int16_t height_{240};  ///< Display height as modified by current rotation
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
   const uint8_t *palette_;
 
   ILI9341ColorMode buffer_color_mode_{BITS_8};
@@ -82,9 +84,10 @@ class ILI9341Display : public PollingComponent,
   void start_data_();
   void end_data_();
 
-  uint8_t transfer_buffer_[64];
+  /// Two buffers, so one can be filled while the other one is being sent.
+  uint8_t transfer_buffer_[2][128];
 
-  uint32_t buffer_to_transfer_(uint32_t pos, uint32_t sz);
+  uint32_t buffer_to_transfer_(uint32_t pos, uint32_t sz, uint8_t *dst);
 
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *led_pin_{nullptr};
@@ -14,6 +14,12 @@ namespace json {
 static const char *const TAG = "json";
 
 static std::vector<char> global_json_build_buffer;  // NOLINT
+/** Document size to request in the next build_json() call.
+ *
+ * It's the memory the last document actually used plus a quarter of slack (at least 512 bytes), as most documents
+ * are built over and over with about the same size. A document that needs more doubles the request until it fits.
+ */
+static size_t global_json_build_size = 512;  // NOLINT
 
 std::string build_json(const json_build_t &f) {
   // Here we are allocating up to 5kb of memory,
@@ -26,7 +32,8 @@ std::string build_json(const json_build_t &f) {
   const size_t free_heap = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
 #endif
 
-  size_t request_size = std::min(free_heap, (size_t) 512);
+  // Start with the size the previous document needed, so that repeated documents don't have to be rebuilt
+  size_t request_size = std::min(free_heap, global_json_build_size);
   while (true) {
     ESP_LOGV(TAG, "Attempting to allocate %u bytes for JSON serialization", request_size);
     DynamicJsonDocument json_document(request_size);
@@ -47,6 +54,8 @@ std::string build_json(const json_build_t &f) {
       request_size = std::min(request_size * 2, free_heap);
       continue;
     }
+    const size_t used = json_document.memoryUsage();
+    global_json_build_size = std::max(used + used / 4, (size_t) 512);
     json_document.shrinkToFit();
     ESP_LOGV(TAG, "Size after shrink %u bytes", json_document.capacity());
     std::string output;
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "esphome/core/helpers.h"
+#include "json_writer.h"
 
 #define ARDUINOJSON_ENABLE_STD_STRING 1  // NOLINT
 
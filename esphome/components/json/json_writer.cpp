@@ -0,0 +1,126 @@
+#include "json_writer.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace esphome {
+namespace json {
+
+/// Output length of the last write_json() call, used to reserve the output string.
+static size_t global_json_write_size = 64;  // NOLINT
+
+void JsonWriter::separator_() {
+  if (this->output_.empty())
+    return;
+  char last = this->output_.back();
+  if (last != '{' && last != '[' && last != ':')
+    this->output_.push_back(',');
+}
+void JsonWriter::key_(const char *key) {
+  this->separator_();
+  this->value_(key);
+  this->output_.push_back(':');
+}
+void JsonWriter::begin_object() {
+  this->separator_();
+  this->output_.push_back('{');
+}
+void JsonWriter::begin_object(const char *key) {
+  this->key_(key);
+  this->output_.push_back('{');
+}
+void JsonWriter::begin_array(const char *key) {
+  this->key_(key);
+  this->output_.push_back('[');
+}
+void JsonWriter::add_raw_members(const std::string &object) {
+  size_t begin = object.find('{');
+  size_t end = object.rfind('}');
+  if (begin == std::string::npos || end == std::string::npos || end <= begin + 1)
+    return;
+  this->separator_();
+  this->output_.append(object, begin + 1, end - begin - 1);
+}
+void JsonWriter::value_(const char *value, size_t length) {
+  this->output_.push_back('"');
+  const char *unescaped = value;
+  const char *end = value + length;
+  for (const char *it = value; it != end; it++) {
+    char c = *it;
+    if (c != '"' && c != '\\' && static_cast<uint8_t>(c) >= 0x20)
+      continue;
+    this->output_.append(unescaped, it - unescaped);
+    unescaped = it + 1;
+    switch (c) {
+      case '"':
+        this->output_.append("\\\"");
+        break;
+      case '\\':
+        this->output_.append("\\\\");
+        break;
+      case '\n':
+        this->output_.append("\\n");
+        break;
+      case '\r':
+        this->output_.append("\\r");
+        break;
+      case '\t':
+        this->output_.append("\\t");
+        break;
+      default: {
+        char buf[7];
+        snprintf(buf, sizeof(buf), "\\u%04x", static_cast<uint8_t>(c));
+        this->output_.append(buf);
+        break;
+      }
+    }
+  }
+  this->output_.append(unescaped, end - unescaped);
+  this->output_.push_back('"');
+}
+void JsonWriter::value_(float value) { this->number_(value, 6, 9); }
+void JsonWriter::value_(double value) { this->number_(value, 15, 17); }
+void JsonWriter::number_(double value, int precision, int round_trip_precision) {
+  if (std::isnan(value) || std::isinf(value)) {
+    this->output_.append("null");
+    return;
+  }
+  // Use the short representation if it parses back to the same value, otherwise the exact one
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.*g", precision, value);
+  bool exact = precision == 6 ? strtof(buf, nullptr) == static_cast<float>(value) : strtod(buf, nullptr) == value;
+  if (!exact)
+    snprintf(buf, sizeof(buf), "%.*g", round_trip_precision, value);
+  this->output_.append(buf);
+}
+void JsonWriter::signed_(int64_t value) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%" PRId64, value);
+  this->output_.append(buf);
+}
+void JsonWriter::unsigned_(uint64_t value) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%" PRIu64, value);
+  this->output_.append(buf);
+}
+
+std::string write_json(const json_write_t &f) {
+  std::string output;
+  output.reserve(global_json_write_size);
+  write_json(output, f);
+  global_json_write_size = output.size();
+  return output;
+}
+
+void write_json(std::string &output, const json_write_t &f) {
+  output.clear();
+  JsonWriter writer(output);
+  writer.begin_object();
+  f(writer);
+  writer.end_object();
+}
+
+}  // namespace json
+}  // namespace esphome
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace json {
+
+/** Streaming JSON writer that appends directly to a string, without building a document first.
+ *
+ * Objects and arrays must be closed in the order they were opened. Keys and values are escaped, NaN and infinite
+ * floats are written as null (like ArduinoJson does).
+ *
+ * \code
+ * writer.begin_object();
+ * writer.add("id", "sensor-temperature");
+ * writer.add("value", 23.5f);
+ * writer.begin_array("options");
+ * writer.add_value("a");
+ * writer.end_array();
+ * writer.end_object();
+ * \endcode
+ */
+class JsonWriter {
+ public:
+  explicit JsonWriter(std::string &output) : output_(output) {}
+
+  void begin_object();
+  void begin_object(const char *key);
+  void end_object() { this->output_.push_back('}'); }
+  void begin_array(const char *key);
+  void end_array() { this->output_.push_back(']'); }
+
+  /// Add a member to the current object.
+  template<typename T> void add(const char *key, T value) {
+    this->key_(key);
+    this->value_(value);
+  }
+  void add(const char *key, const std::string &value) {
+    this->key_(key);
+    this->value_(value.c_str(), value.size());
+  }
+
+  /// Add the members of an already serialized JSON object (e.g. from build_json()) to the current object.
+  void add_raw_members(const std::string &object);
+
+  /// Add an element to the current array.
+  template<typename T> void add_value(T value) {
+    this->separator_();
+    this->value_(value);
+  }
+  void add_value(const std::string &value) {
+    this->separator_();
+    this->value_(value.c_str(), value.size());
+  }
+
+ protected:
+  void separator_();
+  void key_(const char *key);
+  void value_(const char *value) { this->value_(value, strlen(value)); }
+  void value_(const char *value, size_t length);
+  void value_(bool value) { this->output_.append(value ? "true" : "false"); }
+  void value_(float value);
+  void value_(double value);
+  template<typename T, enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value, int> = 0>
+  void value_(T value) {
+    this->signed_(value);
+  }
+  template<typename T, enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value, int> = 0>
+  void value_(T value) {
+    this->unsigned_(value);
+  }
+  void signed_(int64_t value);
+  void unsigned_(uint64_t value);
+  void number_(double value, int precision, int round_trip_precision);
+
+  std::string &output_;
+};
+
+/// Callback function typedef for writing JSON with a JsonWriter.
+using json_write_t = std::function<void(JsonWriter &)>;
+
+/// Build a JSON object string in a single pass with the provided json write function.
+std::string write_json(const json_write_t &f);
+
+/** Write a JSON object into the provided string with the provided json write function.
+ *
+ * The string is cleared first, but keeps its capacity, so a buffer that's reused for documents of about the same
+ * size doesn't need any allocation after the first one.
+ */
+void write_json(std::string &output, const json_write_t &f);
+
+}  // namespace json
+}  // namespace esphome
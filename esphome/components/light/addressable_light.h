@@ -83,6 +83,7 @@ class AddressableLight : public LightOutput, public Component {
 
  protected:
   friend class AddressableLightTransformer;
+  friend class ESPRangeView;
 
   void mark_shown_() {
 #ifdef USE_POWER_SUPPLY
@@ -96,6 +97,8 @@ class AddressableLight : public LightOutput, public Component {
 #endif
   }
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
+  /// Outputs that store all LEDs in one array can describe it here, so that ranges can work on it directly.
+  virtual bool get_pixel_buffer_(ESPPixelBuffer *buffer) const { return false; }
 
   bool effect_active_{false};
   ESPColorCorrection correction_{};
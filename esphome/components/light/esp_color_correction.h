@@ -9,7 +9,12 @@ class ESPColorCorrection {
  public:
   ESPColorCorrection() : max_brightness_(255, 255, 255, 255) {}
   void set_max_brightness(const Color &max_brightness) { this->max_brightness_ = max_brightness; }
-  void set_local_brightness(uint8_t local_brightness) { this->local_brightness_ = local_brightness; }
+  void set_local_brightness(uint8_t local_brightness) {
+    if (local_brightness == this->local_brightness_)
+      return;
+    this->local_brightness_ = local_brightness;
+    this->calculate_brightness_table_();
+  }
   void calculate_gamma_table(float gamma);
   inline Color color_correct(Color color) const ALWAYS_INLINE {
     // corrected = (uncorrected * max_brightness * local_brightness) ^ gamma
@@ -17,20 +22,16 @@ class ESPColorCorrection {
                  this->color_correct_blue(color.blue), this->color_correct_white(color.white));
   }
   inline uint8_t color_correct_red(uint8_t red) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(red, this->max_brightness_.red), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->brightness_table_[esp_scale8(red, this->max_brightness_.red)];
   }
   inline uint8_t color_correct_green(uint8_t green) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(green, this->max_brightness_.green), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->brightness_table_[esp_scale8(green, this->max_brightness_.green)];
   }
   inline uint8_t color_correct_blue(uint8_t blue) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(blue, this->max_brightness_.blue), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->brightness_table_[esp_scale8(blue, this->max_brightness_.blue)];
   }
   inline uint8_t color_correct_white(uint8_t white) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(white, this->max_brightness_.white), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->brightness_table_[esp_scale8(white, this->max_brightness_.white)];
   }
   inline Color color_uncorrect(Color color) const ALWAYS_INLINE {
     // uncorrected = corrected^(1/gamma) / (max_brightness * local_brightness)
@@ -38,37 +39,36 @@ class ESPColorCorrection {
                  this->color_uncorrect_blue(color.blue), this->color_uncorrect_white(color.white));
   }
   inline uint8_t color_uncorrect_red(uint8_t red) const ALWAYS_INLINE {
-    if (this->max_brightness_.red == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[red] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.red) * 255UL) / this->local_brightness_;
-    return res;
+    return this->color_uncorrect_(red, this->max_brightness_.red);
   }
   inline uint8_t color_uncorrect_green(uint8_t green) const ALWAYS_INLINE {
-    if (this->max_brightness_.green == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[green] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.green) * 255UL) / this->local_brightness_;
-    return res;
+    return this->color_uncorrect_(green, this->max_brightness_.green);
   }
   inline uint8_t color_uncorrect_blue(uint8_t blue) const ALWAYS_INLINE {
-    if (this->max_brightness_.blue == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[blue] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.blue) * 255UL) / this->local_brightness_;
-    return res;
+    return this->color_uncorrect_(blue, this->max_brightness_.blue);
   }
   inline uint8_t color_uncorrect_white(uint8_t white) const ALWAYS_INLINE {
-    if (this->max_brightness_.white == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[white] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.white) * 255UL) / this->local_brightness_;
-    return res;
+    return this->color_uncorrect_(white, this->max_brightness_.white);
   }
 
  protected:
+  void calculate_brightness_table_();
+  inline uint8_t color_uncorrect_(uint8_t value, uint8_t max_brightness) const ALWAYS_INLINE {
+    if (max_brightness == 0 || this->local_brightness_ == 0)
+      return 0;
+    uint32_t uncorrected = this->gamma_reverse_table_[value] * 255UL;
+    // skip the divisions for the common case of full brightness
+    if (max_brightness != 255)
+      uncorrected = (uncorrected / max_brightness) * 255UL;
+    if (this->local_brightness_ != 255)
+      return uncorrected / this->local_brightness_;
+    return uncorrected / 255UL;
+  }
+
   uint8_t gamma_table_[256];
   uint8_t gamma_reverse_table_[256];
+  /// gamma_table_ with local_brightness_ applied, so correcting a color takes one lookup per channel
+  uint8_t brightness_table_[256];
   Color max_brightness_;
   uint8_t local_brightness_{255};
 };
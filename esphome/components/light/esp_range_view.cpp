@@ -1,9 +1,29 @@
 #include "esp_range_view.h"
 #include "addressable_light.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace light {
 
+// The following operate on all four channels of a color packed into 32 bits at once, with the same results as the
+// corresponding Color operators.
+static inline uint32_t scale8_packed(uint32_t color, uint8_t scale) {
+  const uint32_t factor = uint32_t(scale) + 1;
+  // the products of two 8-bit channels fit into 16 bits, so two channels can share a multiplication
+  const uint32_t red_blue = (((color & 0x00FF00FF) * factor) >> 8) & 0x00FF00FF;
+  const uint32_t green_white = (((color >> 8) & 0x00FF00FF) * factor) & 0xFF00FF00;
+  return red_blue | green_white;
+}
+static inline uint32_t add_packed(uint32_t a, uint32_t b) {
+  // add the lower 7 bits of each channel, then saturate the channels that carry out of their highest bit
+  const uint32_t low = (a & 0x7F7F7F7F) + (b & 0x7F7F7F7F);
+  const uint32_t carry = ((a & b) | ((a | b) & low)) & 0x80808080;
+  const uint32_t sum = low ^ ((a ^ b) & 0x80808080);
+  return sum | ((carry >> 7) * 0xFF);
+}
+static inline uint32_t subtract_packed(uint32_t a, uint32_t b) { return ~add_packed(~a, b); }
+
 int32_t HOT interpret_index(int32_t index, int32_t size) {
   if (index < 0)
     return size + index;
@@ -14,13 +34,60 @@ ESPColorView ESPRangeView::operator[](int32_t index) const {
   index = interpret_index(index, this->size()) + this->begin_;
   return (*this->parent_)[index];
 }
-ESPRangeIterator ESPRangeView::begin() { return {*this, this->begin_}; }
+ESPRangeIterator ESPRangeView::begin() {
+  ESPPixelBuffer buffer;
+  if (!this->get_pixel_buffer_(&buffer))
+    return {*this, this->begin_};
+  return {*this, this->begin_, buffer};
+}
 ESPRangeIterator ESPRangeView::end() { return {*this, this->end_}; }
 
+bool ESPRangeView::get_pixel_buffer_(ESPPixelBuffer *buffer) const {
+  return this->parent_->get_pixel_buffer_(buffer) && buffer->data != nullptr;
+}
+
+template<typename F> void ESPRangeView::transform_(F f) {
+  ESPPixelBuffer buffer;
+  if (!this->get_pixel_buffer_(&buffer)) {
+    for (auto c : *this)
+      c.set(f(c.get()));
+    return;
+  }
+
+  const ESPColorCorrection *correction = buffer.correction;
+  const uint8_t *offsets = buffer.offsets;
+  const bool has_white = buffer.has_white();
+  uint8_t *led = buffer.data + buffer.stride * this->begin_;
+  for (int32_t i = this->begin_; i < this->end_; i++, led += buffer.stride) {
+    Color color(correction->color_uncorrect_red(led[offsets[0]]), correction->color_uncorrect_green(led[offsets[1]]),
+                correction->color_uncorrect_blue(led[offsets[2]]),
+                has_white ? correction->color_uncorrect_white(led[offsets[3]]) : 0);
+    color = f(color);
+    led[offsets[0]] = correction->color_correct_red(color.red);
+    led[offsets[1]] = correction->color_correct_green(color.green);
+    led[offsets[2]] = correction->color_correct_blue(color.blue);
+    if (has_white)
+      led[offsets[3]] = correction->color_correct_white(color.white);
+  }
+}
+
 void ESPRangeView::set(const Color &color) {
-  for (int32_t i = this->begin_; i < this->end_; i++) {
-    (*this->parent_)[i] = color;
+  ESPPixelBuffer buffer;
+  if (!this->get_pixel_buffer_(&buffer)) {
+    for (int32_t i = this->begin_; i < this->end_; i++) {
+      (*this->parent_)[i] = color;
+    }
+    return;
   }
+
+  // all LEDs get the same bytes, so the color only has to be corrected once
+  const Color corrected = buffer.correction->color_correct(color);
+  uint8_t pattern[4];
+  for (uint8_t channel = 0; channel < buffer.stride; channel++)
+    pattern[buffer.offsets[channel]] = corrected.raw[channel];
+  uint8_t *led = buffer.data + buffer.stride * this->begin_;
+  for (int32_t i = this->begin_; i < this->end_; i++, led += buffer.stride)
+    memcpy(led, pattern, buffer.stride);
 }
 
 void ESPRangeView::set_red(uint8_t red) {
@@ -45,20 +112,38 @@ void ESPRangeView::set_effect_data(uint8_t effect_data) {
 }
 
 void ESPRangeView::fade_to_white(uint8_t amnt) {
-  for (auto c : *this)
-    c.fade_to_white(amnt);
+  this->transform_([amnt](Color color) {
+    color.raw_32 = 0xFFFFFFFF - scale8_packed(color.raw_32, amnt);
+    return color;
+  });
 }
 void ESPRangeView::fade_to_black(uint8_t amnt) {
-  for (auto c : *this)
-    c.fade_to_black(amnt);
+  this->transform_([amnt](Color color) {
+    color.raw_32 = scale8_packed(color.raw_32, amnt);
+    return color;
+  });
 }
 void ESPRangeView::lighten(uint8_t delta) {
-  for (auto c : *this)
-    c.lighten(delta);
+  const uint32_t add = delta * 0x01010101UL;
+  this->transform_([add](Color color) {
+    color.raw_32 = add_packed(color.raw_32, add);
+    return color;
+  });
 }
 void ESPRangeView::darken(uint8_t delta) {
-  for (auto c : *this)
-    c.darken(delta);
+  const uint32_t subtract = delta * 0x01010101UL;
+  this->transform_([subtract](Color color) {
+    color.raw_32 = subtract_packed(color.raw_32, subtract);
+    return color;
+  });
+}
+void ESPRangeView::lerp(const Color &color, uint8_t amnt) {
+  const uint32_t add = scale8_packed(color.raw_32, amnt);
+  const uint8_t inv_amnt = 255 - amnt;
+  this->transform_([add, inv_amnt](Color current) {
+    current.raw_32 = add_packed(add, scale8_packed(current.raw_32, inv_amnt));
+    return current;
+  });
 }
 ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {  // NOLINT
   // If size doesn't match, error (todo warning)
@@ -75,6 +160,14 @@ ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {  // NOLINT
   if (rhs.begin_ == this->begin_)
     return *this;
 
+  ESPPixelBuffer buffer;
+  if (this->get_pixel_buffer_(&buffer)) {
+    // Move the raw values, which also saves correcting them again
+    memmove(buffer.data + buffer.stride * this->begin_, buffer.data + buffer.stride * rhs.begin_,
+            buffer.stride * this->size());
+    return *this;
+  }
+
   if (rhs.begin_ > this->begin_) {
     // Copy from left
     for (int32_t i = 0; i < this->size(); i++) {
@@ -90,7 +183,7 @@ ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {  // NOLINT
   return *this;
 }
 
-ESPColorView ESPRangeIterator::operator*() const { return this->range_.parent_->get(this->i_); }
+ESPColorView ESPRangeIterator::get_parent_view_() const { return this->range_.parent_->get(this->i_); }
 
 }  // namespace light
 }  // namespace esphome
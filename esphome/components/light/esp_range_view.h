@@ -11,6 +11,30 @@ int32_t interpret_index(int32_t index, int32_t size);
 class AddressableLight;
 class ESPRangeIterator;
 
+/**
+ * Memory layout of an output that stores all its LEDs in one array, see AddressableLight::get_pixel_buffer_().
+ *
+ * Ranges use it to access the LEDs directly instead of through a virtual call per LED.
+ */
+struct ESPPixelBuffer {
+  uint8_t *data{nullptr};
+  /// Number of bytes per LED, 4 if the LEDs have a white channel.
+  uint8_t stride{3};
+  /// Offsets of the red, green, blue and white channels within a LED.
+  uint8_t offsets[4]{0, 1, 2, 3};
+  /// Effect data of each LED, can be nullptr.
+  uint8_t *effect_data{nullptr};
+  const ESPColorCorrection *correction{nullptr};
+
+  bool has_white() const { return this->stride == 4; }
+  ESPColorView get_view(int32_t index) const {
+    uint8_t *base = this->data + this->stride * index;
+    return ESPColorView(base + this->offsets[0], base + this->offsets[1], base + this->offsets[2],
+                        this->has_white() ? base + this->offsets[3] : nullptr,
+                        this->effect_data == nullptr ? nullptr : this->effect_data + index, this->correction);
+  }
+};
+
 /**
  * A half-open range of LEDs, inclusive of the begin index and exclusive of the end index, using zero-based numbering.
  */
@@ -37,6 +61,8 @@ class ESPRangeView : public ESPColorSettable {
   void fade_to_black(uint8_t amnt) override;
   void lighten(uint8_t delta) override;
   void darken(uint8_t delta) override;
+  /// Blend all LEDs towards color, by amnt/255.
+  void lerp(const Color &color, uint8_t amnt);
 
   ESPRangeView &operator=(const Color &rhs) {
     this->set(rhs);
@@ -55,6 +81,10 @@ class ESPRangeView : public ESPColorSettable {
  protected:
   friend ESPRangeIterator;
 
+  bool get_pixel_buffer_(ESPPixelBuffer *buffer) const;
+  /// Replace every LED by f(color), using the pixel buffer if the output has one.
+  template<typename F> void transform_(F f);
+
   AddressableLight *parent_;
   int32_t begin_;
   int32_t end_;
@@ -63,17 +93,26 @@ class ESPRangeView : public ESPColorSettable {
 class ESPRangeIterator {
  public:
   ESPRangeIterator(const ESPRangeView &range, int32_t i) : range_(range), i_(i) {}
+  ESPRangeIterator(const ESPRangeView &range, int32_t i, const ESPPixelBuffer &buffer)
+      : range_(range), i_(i), buffer_(buffer) {}
   ESPRangeIterator(const ESPRangeIterator &) = default;
   ESPRangeIterator operator++() {
     this->i_++;
     return *this;
   }
   bool operator!=(const ESPRangeIterator &other) const { return this->i_ != other.i_; }
-  ESPColorView operator*() const;
+  ESPColorView operator*() const {
+    if (this->buffer_.data != nullptr)
+      return this->buffer_.get_view(this->i_);
+    return this->get_parent_view_();
+  }
 
  protected:
+  ESPColorView get_parent_view_() const;
+
   ESPRangeView range_;
   int32_t i_;
+  ESPPixelBuffer buffer_{};
 };
 
 }  // namespace light
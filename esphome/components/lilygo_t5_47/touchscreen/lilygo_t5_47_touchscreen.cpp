@@ -1,5 +1,6 @@
 #include "lilygo_t5_47_touchscreen.h"
 
+#include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
@@ -23,7 +24,10 @@ static const uint8_t READ_TOUCH[1] = {0x07};
     return; \
   }
 
-void Store::gpio_intr(Store *store) { store->touch = true; }
+void Store::gpio_intr(Store *store) {
+  store->touch = true;
+  App.wake_loop();
+}
 
 void LilygoT547Touchscreen::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Lilygo T5 4.7 Touchscreen...");
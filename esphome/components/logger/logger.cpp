@@ -10,12 +10,59 @@
 #endif
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
+#include <algorithm>
+#include <cstdint>
 
 namespace esphome {
 namespace logger {
 
 static const char *const TAG = "logger";
 
+/// Header of a message in the async ring buffer, a size of 0 marks the rest of the buffer as unused.
+struct LogRecordHeader {
+  uint16_t size;
+  uint8_t level;
+  uint8_t tag_length;
+};
+/// Maximum number of queued messages written out per loop() call.
+static const size_t MAX_MESSAGES_PER_LOOP = 8;
+/// Size of the stack buffer that messages from other tasks and interrupts are formatted in.
+static const size_t MAX_TASK_MESSAGE_SIZE = 256;
+
+#ifdef USE_ESP32
+static portMUX_TYPE async_buffer_mux = portMUX_INITIALIZER_UNLOCKED;  // NOLINT
+#endif
+
+/** Protects the async ring buffer against concurrent log calls.
+ *
+ * InterruptLock only affects the executing core, so on ESP32 this takes a spinlock as well.
+ */
+class AsyncBufferLock {
+#ifdef USE_ESP32
+ public:
+  AsyncBufferLock() : in_isr_(xPortInIsrContext()) {
+    if (this->in_isr_) {
+      portENTER_CRITICAL_ISR(&async_buffer_mux);
+    } else {
+      portENTER_CRITICAL(&async_buffer_mux);
+    }
+  }
+  ~AsyncBufferLock() {
+    if (this->in_isr_) {
+      portEXIT_CRITICAL_ISR(&async_buffer_mux);
+    } else {
+      portEXIT_CRITICAL(&async_buffer_mux);
+    }
+  }
+
+ protected:
+  bool in_isr_;
+#else
+ protected:
+  InterruptLock lock_;
+#endif
+};
+
 static const char *const LOG_LEVEL_COLORS[] = {
     "",                                            // NONE
     ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED),       // ERROR
@@ -49,7 +96,14 @@ void Logger::write_header_(int level, const char *tag, int line) {
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+  if (this->async_buffer_ != nullptr && !this->in_main_loop_()) {
+    char buffer[MAX_TASK_MESSAGE_SIZE];
+    this->queue_vprintf_(level, tag, line, buffer, 0, format, args);
+    return;
+  }
+  if (recursion_guard_ || this->draining_)
     return;
 
   recursion_guard_ = true;
@@ -63,7 +117,25 @@ void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,
                           va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+  if (this->async_buffer_ != nullptr && !this->in_main_loop_()) {
+    char buffer[MAX_TASK_MESSAGE_SIZE];
+    // copy format string, leaving at least half of the buffer for the message
+    auto *format_pgm_p = reinterpret_cast<const uint8_t *>(format);
+    size_t len = 0;
+    char ch = '.';
+    while (len < MAX_TASK_MESSAGE_SIZE / 2 && ch != '\0') {
+      buffer[len++] = ch = (char) progmem_read_byte(format_pgm_p++);
+    }
+    if (ch != '\0') {
+      this->count_dropped_message_();
+      return;
+    }
+    this->queue_vprintf_(level, tag, line, buffer, len, buffer, args);
+    return;
+  }
+  if (recursion_guard_ || this->draining_)
     return;
 
   recursion_guard_ = true;
@@ -76,8 +148,10 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
     this->tx_buffer_[this->tx_buffer_at_++] = ch = (char) progmem_read_byte(format_pgm_p++);
   }
   // Buffer full form copying format
-  if (this->is_buffer_full_())
+  if (this->is_buffer_full_()) {
+    recursion_guard_ = false;
     return;
+  }
 
   // length of format string, includes null terminator
   uint32_t offset = this->tx_buffer_at_;
@@ -92,15 +166,19 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
 #endif
 
 int HOT Logger::level_for(const char *tag) {
-  // Uses std::vector<> for low memory footprint, though the vector
-  // could be sorted to minimize lookup times. This feature isn't used that
-  // much anyway so it doesn't matter too much.
-  for (auto &it : this->log_levels_) {
-    if (it.tag == tag) {
+  if (this->log_level_table_.empty())
+    return ESPHOME_LOG_LEVEL;
+
+  const uint32_t hash = fnv1_hash(tag);
+  const size_t mask = this->log_level_table_.size() - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    uint8_t index = this->log_level_table_[i];
+    if (index == 0)
+      return ESPHOME_LOG_LEVEL;
+    const LogLevelOverride &it = this->log_levels_[index - 1];
+    if (it.hash == hash && it.tag == tag)
       return it.level;
-    }
   }
-  return ESPHOME_LOG_LEVEL;
 }
 void HOT Logger::log_message_(int level, const char *tag, int offset) {
   // remove trailing newline
@@ -111,6 +189,21 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   this->set_null_terminator_();
 
   const char *msg = this->tx_buffer_ + offset;
+  if (this->async_buffer_ == nullptr) {
+    this->write_message_(level, tag, msg);
+    return;
+  }
+  if (this->queue_message_(level, tag, msg))
+    return;
+  // The buffer is full, but we're in the main loop: write out the queued messages now instead of losing any.
+  // This happens mostly during setup, before loop() gets called.
+  this->draining_ = true;
+  this->drain_queue_(SIZE_MAX);
+  this->draining_ = false;
+  if (!this->queue_message_(level, tag, msg))
+    this->write_message_(level, tag, msg);
+}
+void HOT Logger::write_message_(int level, const char *tag, const char *msg) {
   if (this->baud_rate_ > 0) {
 #ifdef USE_ARDUINO
     this->hw_serial_->println(msg);
@@ -147,6 +240,146 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
 
   this->log_callback_.call(level, tag, msg);
 }
+void HOT Logger::queue_vprintf_(int level, const char *tag, int line, char *buffer, size_t format_length,
+                                const char *format, va_list args) {
+  // Same format as write_header_(), the message is null-terminated at msg[len]
+  char *msg = buffer + format_length;
+  const size_t size = MAX_TASK_MESSAGE_SIZE - format_length - 1;
+  const int index = std::max(0, std::min(level, 7));
+  int ret = snprintf(msg, size + 1, "%s[%s][%s:%03u]: ", LOG_LEVEL_COLORS[index], LOG_LEVEL_LETTERS[index], tag, line);
+  size_t len = ret < 0 ? 0 : std::min((size_t) ret, size);
+  ret = vsnprintf(msg + len, size + 1 - len, format, args);
+  if (ret > 0)
+    len = std::min(len + ret, size);
+  for (const char *reset = ESPHOME_LOG_RESET_COLOR; *reset != '\0' && len < size; reset++)
+    msg[len++] = *reset;
+  // remove trailing newline
+  if (len > 0 && msg[len - 1] == '\n')
+    len--;
+  msg[len] = '\0';
+
+  if (!this->queue_message_(level, tag, msg))
+    this->count_dropped_message_();
+}
+bool HOT Logger::queue_message_(int level, const char *tag, const char *msg) {
+  size_t tag_length = std::min(strlen(tag), (size_t) 255);
+  size_t msg_length = strlen(msg);
+  size_t size = sizeof(LogRecordHeader) + tag_length + 1 + msg_length + 1;
+  // keep records aligned so that headers never straddle the end of the buffer
+  size = (size + 3) & ~3;
+  if (size > UINT16_MAX)
+    return false;
+
+  AsyncBufferLock lock;
+  const size_t capacity = this->async_buffer_size_;
+  const size_t head = this->async_head_;
+  const size_t tail = this->async_tail_;
+  size_t pos;
+  if (head >= tail) {
+    // Free space is at the end and in front of tail, one byte always stays free so that head == tail means empty
+    size_t end_free = capacity - head - (tail == 0 ? 1 : 0);
+    if (size <= end_free) {
+      pos = head;
+    } else if (size < tail) {
+      // mark the rest of the buffer as unused and continue at the start
+      if (capacity - head >= sizeof(LogRecordHeader)) {
+        LogRecordHeader marker{0, 0, 0};
+        memcpy(this->async_buffer_ + head, &marker, sizeof(marker));
+      }
+      pos = 0;
+    } else {
+      return false;
+    }
+  } else if (size < tail - head) {
+    pos = head;
+  } else {
+    return false;
+  }
+
+  LogRecordHeader header{static_cast<uint16_t>(size), static_cast<uint8_t>(level), static_cast<uint8_t>(tag_length)};
+  uint8_t *record = this->async_buffer_ + pos;
+  memcpy(record, &header, sizeof(header));
+  record += sizeof(header);
+  memcpy(record, tag, tag_length);
+  record[tag_length] = '\0';
+  record += tag_length + 1;
+  memcpy(record, msg, msg_length + 1);
+
+  pos += size;
+  this->async_head_ = pos == capacity ? 0 : pos;
+  return true;
+}
+void Logger::drain_queue_(size_t max_messages) {
+  size_t written = 0;
+  while (written < max_messages) {
+    size_t head;
+    {
+      AsyncBufferLock lock;
+      head = this->async_head_;
+    }
+    size_t tail = this->async_tail_;
+    if (tail == head)
+      break;
+
+    LogRecordHeader header{};
+    memcpy(&header, this->async_buffer_ + tail, sizeof(header));
+    if (header.size == 0) {
+      // rest of the buffer is unused, the next record is at the start
+      AsyncBufferLock lock;
+      this->async_tail_ = 0;
+      continue;
+    }
+
+    const char *tag = reinterpret_cast<const char *>(this->async_buffer_ + tail + sizeof(header));
+    const char *msg = tag + header.tag_length + 1;
+#ifdef USE_ARDUINO
+    // Don't block on a full UART, except for the first message so that the queue always makes progress
+    if (this->baud_rate_ > 0 && written != 0 && this->hw_serial_->availableForWrite() <= (int) strlen(msg))
+      break;
+#endif
+    this->write_message_(header.level, tag, msg);
+    written++;
+
+    AsyncBufferLock lock;
+    tail += header.size;
+    this->async_tail_ = tail == this->async_buffer_size_ ? 0 : tail;
+  }
+}
+void Logger::count_dropped_message_() {
+  AsyncBufferLock lock;
+  this->dropped_messages_++;
+}
+bool Logger::in_main_loop_() const {
+#ifdef USE_ESP32
+  return !xPortInIsrContext() && xTaskGetCurrentTaskHandle() == this->main_task_;
+#elif defined(USE_ESP8266)
+  // Interrupt handlers (and code that disabled interrupts) run at a raised interrupt level
+  uint32_t ps;
+  __asm__ __volatile__("rsr %0,ps" : "=a"(ps));
+  return (ps & 0x0F) == 0;
+#else
+  return true;
+#endif
+}
+void Logger::loop() {
+  if (this->async_buffer_ == nullptr)
+    return;
+  // Messages logged by the log callbacks from the main loop are not forwarded, same as for synchronous logging
+  this->draining_ = true;
+  this->drain_queue_(MAX_MESSAGES_PER_LOOP);
+  this->draining_ = false;
+
+  uint32_t dropped;
+  {
+    AsyncBufferLock lock;
+    dropped = this->dropped_messages_;
+  }
+  if (dropped != this->reported_dropped_messages_) {
+    ESP_LOGW(TAG, "Dropped %u log messages, consider increasing async_buffer_size",
+             dropped - this->reported_dropped_messages_);
+    this->reported_dropped_messages_ = dropped;
+  }
+}
 
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size, UARTSelection uart)
     : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size), uart_(uart) {
@@ -155,6 +388,14 @@ Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size, UARTSelection uart)
 }
 
 void Logger::pre_setup() {
+  if (this->async_buffer_size_ > 0) {
+    // records are 4-byte aligned
+    this->async_buffer_size_ = std::max(this->async_buffer_size_ & ~3, (size_t) 64);
+    this->async_buffer_ = new uint8_t[this->async_buffer_size_];  // NOLINT
+#ifdef USE_ESP32
+    this->main_task_ = xTaskGetCurrentTaskHandle();
+#endif
+  }
   if (this->baud_rate_ > 0) {
 #ifdef USE_ARDUINO
     switch (this->uart_) {
@@ -244,7 +485,32 @@ void Logger::pre_setup() {
 }
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
 void Logger::set_log_level(const std::string &tag, int log_level) {
-  this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  auto existing = std::find_if(this->log_levels_.begin(), this->log_levels_.end(),
+                               [&tag](const LogLevelOverride &it) { return it.tag == tag; });
+  if (existing != this->log_levels_.end()) {
+    existing->level = log_level;
+  } else if (this->log_levels_.size() < UINT8_MAX) {
+    this->log_levels_.push_back(LogLevelOverride{tag, fnv1_hash(tag), log_level});
+  } else {
+    ESP_LOGW(TAG, "Too many log level overrides, ignoring '%s'", tag.c_str());
+    return;
+  }
+
+  // Rebuild the hash table with at most 50% load, so lookups (also for tags without an override) stay short
+  size_t table_size = 4;
+  while (table_size < this->log_levels_.size() * 2)
+    table_size *= 2;
+  this->log_level_table_.assign(table_size, 0);
+  int all_tags_level = ESPHOME_LOG_LEVEL;
+  for (size_t i = 0; i < this->log_levels_.size(); i++) {
+    const LogLevelOverride &it = this->log_levels_[i];
+    size_t slot = it.hash & (table_size - 1);
+    while (this->log_level_table_[slot] != 0)
+      slot = (slot + 1) & (table_size - 1);
+    this->log_level_table_[slot] = i + 1;
+    all_tags_level = std::min(all_tags_level, it.level);
+  }
+  esp_log_all_tags_level_ = all_tags_level;
 }
 UARTSelection Logger::get_uart() const { return this->uart_; }
 void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
@@ -271,11 +537,17 @@ const char *const UART_SELECTIONS[] = {
 #ifdef USE_ESP8266
 const char *const UART_SELECTIONS[] = {"UART0", "UART1", "UART0_SWAP"};
 #endif  // USE_ESP8266
+#ifdef USE_HOST
+const char *const UART_SELECTIONS[] = {"UART0", "UART1"};
+#endif  // USE_HOST
 void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "Logger:");
   ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[ESPHOME_LOG_LEVEL]);
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %u", this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", UART_SELECTIONS[this->uart_]);
+  if (this->async_buffer_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Async Buffer Size: %u", (unsigned) this->async_buffer_size_);
+  }
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
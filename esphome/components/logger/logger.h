@@ -12,6 +12,10 @@
 #ifdef USE_ESP_IDF
 #include <driver/uart.h>
 #endif
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
 
 namespace esphome {
 
@@ -59,6 +63,17 @@ class Logger : public Component {
   /// Get the UART used by the logger.
   UARTSelection get_uart() const;
 
+  /** Write log messages out from loop() instead of in the log call, set to 0 to disable.
+   *
+   * Messages are still formatted in the log call (so the output format doesn't change), but then only copied
+   * into a ring buffer of this size. loop() writes them to the UART at the pace the UART accepts them and
+   * calls the log callbacks (API, MQTT, ...). Other tasks and interrupts only ever queue their messages, which are
+   * formatted on their own stack and truncated to 255 characters. Must be called before pre_setup().
+   */
+  void set_async_buffer_size(size_t async_buffer_size) { this->async_buffer_size_ = async_buffer_size; }
+  /// Number of log messages dropped because the async buffer was full (or they were too long for it).
+  uint32_t get_dropped_messages() const { return this->dropped_messages_; }
+
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
 
@@ -67,7 +82,9 @@ class Logger : public Component {
   /// Set up this component.
   void pre_setup();
   void dump_config() override;
+  void loop() override;
 
+  /// Log level of the given tag, only needs to be checked for levels above esp_log_all_tags_level_.
   int level_for(const char *tag);
 
   /// Register a callback that will be called for every log message sent
@@ -84,6 +101,23 @@ class Logger : public Component {
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+  void write_message_(int level, const char *tag, const char *msg);
+  /** Format a message on the stack and queue it, for log calls outside of the main loop.
+   *
+   * `buffer` holds the format string at its start if format_length is not 0, the message is formatted after it.
+   */
+  void queue_vprintf_(int level, const char *tag, int line, char *buffer, size_t format_length, const char *format,
+                      va_list args);
+  /// Copy a formatted message into the async ring buffer, returns false if there is no space.
+  bool queue_message_(int level, const char *tag, const char *msg);
+  void count_dropped_message_();
+  /// Write out queued messages, at most max_messages of them. Must only be called by the main loop.
+  void drain_queue_(size_t max_messages);
+  /** Whether the caller runs in the main loop, outside of an interrupt.
+   *
+   * Only the main loop uses tx_buffer_ and writes out queued messages, everything else just queues messages.
+   */
+  bool in_main_loop_() const;
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -128,6 +162,18 @@ class Logger : public Component {
   int tx_buffer_at_{0};
   int tx_buffer_size_{0};
   UARTSelection uart_{UART_SELECTION_UART0};
+  // Ring buffer of queued messages (see set_async_buffer_size()), nullptr if async logging is disabled.
+  // Every record is a LogRecordHeader followed by the null-terminated tag and message.
+  uint8_t *async_buffer_{nullptr};
+  size_t async_buffer_size_{0};
+  size_t async_head_{0};
+  size_t async_tail_{0};
+  /// Only changed with the async buffer lock held, messages can be dropped on any task.
+  uint32_t dropped_messages_{0};
+  uint32_t reported_dropped_messages_{0};
+#ifdef USE_ESP32
+  TaskHandle_t main_task_{nullptr};
+#endif
 #ifdef USE_ARDUINO
   Stream *hw_serial_{nullptr};
 #endif
@@ -136,12 +182,17 @@ class Logger : public Component {
 #endif
   struct LogLevelOverride {
     std::string tag;
+    uint32_t hash;
     int level;
   };
   std::vector<LogLevelOverride> log_levels_;
+  /// Open addressing hash table (by tag hash) of log_levels_ indices plus one, 0 marks an empty slot.
+  std::vector<uint8_t> log_level_table_;
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
-  /// Prevents recursive log calls, if true a log message is already being processed.
+  /// Prevents recursive log calls, if true a log message is already being processed. Main loop only.
   bool recursion_guard_ = false;
+  /// Set while the main loop writes out queued messages, messages logged by the log callbacks are not forwarded.
+  bool draining_ = false;
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
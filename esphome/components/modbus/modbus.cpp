@@ -2,75 +2,109 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace modbus {
 
 static const char *const TAG = "modbus";
 
+static const size_t MAX_FRAME_SIZE = 256;
+static const uint32_t MIN_FRAME_TIMEOUT = 2;
+
 void Modbus::setup() {
   if (this->flow_control_pin_ != nullptr) {
     this->flow_control_pin_->setup();
   }
+  this->rx_buffer_.reserve(MAX_FRAME_SIZE);
+  // Frames end with a silence of 3.5 characters of 11 bits, rounded up to whole milliseconds. The floor covers the
+  // resolution of millis() and the fixed 1.75 ms the specification uses above 19200 baud.
+  const uint32_t baud_rate = this->parent_->get_baud_rate();
+  if (baud_rate != 0)
+    this->frame_timeout_ = std::max<uint32_t>(MIN_FRAME_TIMEOUT, (11 * 3500 + baud_rate - 1) / baud_rate);
 }
 void Modbus::loop() {
   const uint32_t now = millis();
 
-  if (now - this->last_modbus_byte_ > 50) {
-    this->rx_buffer_.clear();
-    this->last_modbus_byte_ = now;
-  }
   // stop blocking new send commands after send_wait_time_ ms regardless if a response has been received since then
   if (now - this->last_send_ > send_wait_time_) {
     waiting_for_response = 0;
   }
 
-  while (this->available()) {
-    uint8_t byte;
-    this->read_byte(&byte);
-    if (this->parse_modbus_byte_(byte)) {
-      this->last_modbus_byte_ = now;
+  int available = this->available();
+  if (available <= 0) {
+    // Nothing arrived since the bytes seen last, so the line has been silent for at least this long. With data
+    // available the gap before it is unknown, as bytes are only seen once per loop() iteration.
+    if (!this->rx_buffer_.empty() && now - this->last_modbus_byte_ > this->frame_timeout_) {
+      ESP_LOGV(TAG, "Discarding incomplete frame: %s", format_hex_pretty(this->rx_buffer_).c_str());
+      this->reset_frame_();
+    }
+    return;
+  }
+  this->last_modbus_byte_ = now;
+
+  uint8_t buf[64];
+  while (available > 0) {
+    const size_t len = std::min<size_t>(available, sizeof(buf));
+    if (!this->read_array(buf, len))
+      break;
+    for (size_t i = 0; i < len; i++) {
+      if (!this->parse_modbus_byte_(buf[i]))
+        this->reset_frame_();
+    }
+    available -= len;
+  }
+}
+
+static uint16_t crc16_update(uint16_t crc, uint8_t byte) {
+  crc ^= byte;
+  for (uint8_t i = 0; i < 8; i++) {
+    if ((crc & 0x01) != 0) {
+      crc >>= 1;
+      crc ^= 0xA001;
     } else {
-      this->rx_buffer_.clear();
+      crc >>= 1;
     }
   }
+  return crc;
 }
 
 uint16_t crc16(const uint8_t *data, uint8_t len) {
   uint16_t crc = 0xFFFF;
-  while (len--) {
-    crc ^= *data++;
-    for (uint8_t i = 0; i < 8; i++) {
-      if ((crc & 0x01) != 0) {
-        crc >>= 1;
-        crc ^= 0xA001;
-      } else {
-        crc >>= 1;
-      }
-    }
-  }
+  while (len--)
+    crc = crc16_update(crc, *data++);
   return crc;
 }
 
+// Per https://modbus.org/docs/Modbus_Application_Protocol_V1_1b3.pdf Ch 5 User-Defined function codes
+static bool is_user_defined_function(uint8_t function_code) {
+  return (function_code >= 65 && function_code <= 72) || (function_code >= 100 && function_code <= 110);
+}
+
+void Modbus::reset_frame_() {
+  this->rx_buffer_.clear();
+  this->rx_crc_ = 0xFFFF;
+  this->rx_frame_len_ = 0;
+}
+
 bool Modbus::parse_modbus_byte_(uint8_t byte) {
   size_t at = this->rx_buffer_.size();
   this->rx_buffer_.push_back(byte);
+  // The CRC is updated with every byte, including the received CRC itself. Over a complete frame this results in 0.
+  this->rx_crc_ = crc16_update(this->rx_crc_, byte);
   const uint8_t *raw = &this->rx_buffer_[0];
-  ESP_LOGV(TAG, "Modbus received Byte  %d (0X%x)", byte, byte);
-  // Byte 0: modbus address (match all)
-  if (at == 0)
-    return true;
-  uint8_t address = raw[0];
-  uint8_t function_code = raw[1];
+  // Byte 0: modbus address (match all), byte 1: function code
   // Byte 2: Size (with modbus rtu function code 4/3)
   // See also https://en.wikipedia.org/wiki/Modbus
-  if (at == 2)
+  if (at < 2)
     return true;
+  uint8_t address = raw[0];
+  uint8_t function_code = raw[1];
 
   uint8_t data_len = raw[2];
   uint8_t data_offset = 3;
 
-  // Per https://modbus.org/docs/Modbus_Application_Protocol_V1_1b3.pdf Ch 5 User-Defined function codes
-  if (((function_code >= 65) && (function_code <= 72)) || ((function_code >= 100) && (function_code <= 110))) {
+  if (is_user_defined_function(function_code)) {
     // Handle user-defined function, since we don't know how big this ought to be,
     // ideally we should delegate the entire length detection to whatever handler is
     // installed, but wait, there is the CRC, and if we get a hit there is a good
@@ -78,18 +112,16 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
     // isn't but that is quite small given the purpose of the CRC in the first place
 
     // Fewer than 2 bytes can't calc CRC
-    if (at < 2)
-      return true;
+    if (at < 3 || this->rx_crc_ != 0) {
+      if (at + 1 < MAX_FRAME_SIZE)
+        return true;
+      ESP_LOGW(TAG, "Modbus user-defined function %02X exceeds the maximum frame size", function_code);
+      return false;
+    }
 
     data_len = at - 2;
     data_offset = 1;
 
-    uint16_t computed_crc = crc16(raw, data_offset + data_len);
-    uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
-
-    if (computed_crc != remote_crc)
-      return true;
-
     ESP_LOGD(TAG, "Modbus user-defined function %02X found", function_code);
 
   } else {
@@ -106,23 +138,21 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
       data_len = 1;
     }
 
-    // Byte data_offset..data_offset+data_len-1: Data
-    if (at < data_offset + data_len)
-      return true;
-
-    // Byte 3+data_len: CRC_LO (over all bytes)
-    if (at == data_offset + data_len)
+    // Data followed by CRC_LO and CRC_HI (over all bytes)
+    if (at == 2)
+      this->rx_frame_len_ = data_offset + data_len + 2;
+    if (at + 1 < this->rx_frame_len_)
       return true;
 
-    // Byte data_offset+len+1: CRC_HI (over all bytes)
-    uint16_t computed_crc = crc16(raw, data_offset + data_len);
-    uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
-    if (computed_crc != remote_crc) {
+    if (this->rx_crc_ != 0) {
+      uint16_t computed_crc = crc16(raw, data_offset + data_len);
+      uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
       ESP_LOGW(TAG, "Modbus CRC Check failed! %02X!=%02X", computed_crc, remote_crc);
       return false;
     }
   }
-  std::vector<uint8_t> data(this->rx_buffer_.begin() + data_offset, this->rx_buffer_.begin() + data_offset + data_len);
+  ESP_LOGV(TAG, "Modbus received: %s", format_hex_pretty(this->rx_buffer_).c_str());
+
   bool found = false;
   for (auto *device : this->devices_) {
     if (device->address_ == address) {
@@ -136,7 +166,7 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
           ESP_LOGD(TAG, "Ignoring Modbus error - not expecting a response");
         }
       } else {
-        device->on_modbus_data(data);
+        device->on_modbus_raw_data(raw + data_offset, data_len);
       }
       found = true;
     }
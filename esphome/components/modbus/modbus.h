@@ -33,8 +33,15 @@ class Modbus : public uart::UARTDevice, public Component {
   GPIOPin *flow_control_pin_{nullptr};
 
   bool parse_modbus_byte_(uint8_t byte);
+  void reset_frame_();
   uint16_t send_wait_time_{250};
   std::vector<uint8_t> rx_buffer_;
+  /// CRC over all bytes in rx_buffer_, 0 once the CRC at the end of a frame has been received correctly.
+  uint16_t rx_crc_{0xFFFF};
+  /// Length of the frame in rx_buffer_ as given by its header, 0 if unknown (user-defined function codes).
+  size_t rx_frame_len_{0};
+  /// Silence in ms after which an incomplete frame is discarded, 3.5 characters at the baud rate of the bus.
+  uint32_t frame_timeout_{4};
   uint32_t last_modbus_byte_{0};
   uint32_t last_send_{0};
   std::vector<ModbusDevice *> devices_;
@@ -46,7 +53,14 @@ class ModbusDevice {
  public:
   void set_parent(Modbus *parent) { parent_ = parent; }
   void set_address(uint8_t address) { address_ = address; }
-  virtual void on_modbus_data(const std::vector<uint8_t> &data) = 0;
+  virtual void on_modbus_data(const std::vector<uint8_t> &data) {}
+  /** Called with the data of a received response, which is only valid during the call.
+   *
+   * Passes a copy to on_modbus_data() by default, devices that don't need one can override this instead.
+   */
+  virtual void on_modbus_raw_data(const uint8_t *data, size_t len) {
+    this->on_modbus_data(std::vector<uint8_t>(data, data + len));
+  }
   virtual void on_modbus_error(uint8_t function_code, uint8_t exception_code) {}
   void send(uint8_t function, uint16_t start_address, uint16_t number_of_entities, uint8_t payload_len = 0,
             const uint8_t *payload = nullptr) {
@@ -1,8 +1,19 @@
 import binascii
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import modbus
-from esphome.const import CONF_ADDRESS, CONF_ID, CONF_NAME, CONF_LAMBDA, CONF_OFFSET
+from esphome.components import modbus, sensor
+from esphome.const import (
+    CONF_ADDRESS,
+    CONF_ID,
+    CONF_NAME,
+    CONF_LAMBDA,
+    CONF_OFFSET,
+    CONF_UPDATE_INTERVAL,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_MILLISECOND,
+)
 from esphome.cpp_helpers import logging
 from .const import (
     CONF_BITMASK,
@@ -10,17 +21,21 @@ from .const import (
     CONF_COMMAND_THROTTLE,
     CONF_CUSTOM_COMMAND,
     CONF_FORCE_NEW_RANGE,
+    CONF_MAX_REGISTER_GAP,
     CONF_MODBUS_CONTROLLER_ID,
     CONF_REGISTER_COUNT,
     CONF_REGISTER_TYPE,
+    CONF_REQUEST_RATE,
     CONF_RESPONSE_SIZE,
+    CONF_RESPONSE_TIME,
     CONF_SKIP_UPDATES,
+    CONF_TIMEOUTS,
     CONF_VALUE_TYPE,
 )
 
 CODEOWNERS = ["@martgras"]
 
-AUTO_LOAD = ["modbus"]
+AUTO_LOAD = ["modbus", "sensor"]
 
 MULTI_CONF = True
 
@@ -105,6 +120,29 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_COMMAND_THROTTLE, default="0ms"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_MAX_REGISTER_GAP, default=0): cv.int_range(
+                min=0, max=64
+            ),
+            cv.Optional(CONF_REQUEST_RATE): sensor.sensor_schema(
+                unit_of_measurement="req/s",
+                icon="mdi:swap-horizontal",
+                accuracy_decimals=1,
+                state_class=STATE_CLASS_MEASUREMENT,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
+            cv.Optional(CONF_TIMEOUTS): sensor.sensor_schema(
+                icon="mdi:timer-alert-outline",
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_TOTAL_INCREASING,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
+            cv.Optional(CONF_RESPONSE_TIME): sensor.sensor_schema(
+                unit_of_measurement=UNIT_MILLISECOND,
+                icon="mdi:timer-outline",
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
         }
     )
     .extend(cv.polling_component_schema("60s"))
@@ -112,6 +150,12 @@ CONFIG_SCHEMA = cv.All(
 )
 
 
+# Items can be polled on their own interval instead of the one of the controller
+validate_item_update_interval = cv.All(
+    cv.positive_time_period_milliseconds,
+    cv.Range(min=cv.TimePeriod(milliseconds=1)),
+)
+
 ModbusItemBaseSchema = cv.Schema(
     {
         cv.GenerateID(CONF_MODBUS_CONTROLLER_ID): cv.use_id(ModbusController),
@@ -129,6 +173,7 @@ ModbusItemBaseSchema = cv.Schema(
         ): cv.positive_int,
         cv.Optional(CONF_BITMASK, default=0xFFFFFFFF): cv.hex_uint32_t,
         cv.Optional(CONF_SKIP_UPDATES, default=0): cv.positive_int,
+        cv.Optional(CONF_UPDATE_INTERVAL): validate_item_update_interval,
         cv.Optional(CONF_FORCE_NEW_RANGE, default=False): cv.boolean,
         cv.Optional(CONF_LAMBDA): cv.returning_lambda,
         cv.Optional(CONF_RESPONSE_SIZE, default=0): cv.positive_int,
@@ -190,6 +235,9 @@ async def add_modbus_base_properties(
     if config[CONF_RESPONSE_SIZE] > 0:
         cg.add(var.set_register_size(config[CONF_RESPONSE_SIZE]))
 
+    if CONF_UPDATE_INTERVAL in config:
+        cg.add(var.set_update_interval(config[CONF_UPDATE_INTERVAL]))
+
     if CONF_LAMBDA in config:
         template_ = await cg.process_lambda(
             config[CONF_LAMBDA],
@@ -209,8 +257,18 @@ async def add_modbus_base_properties(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID], config[CONF_COMMAND_THROTTLE])
     cg.add(var.set_command_throttle(config[CONF_COMMAND_THROTTLE]))
+    cg.add(var.set_max_register_gap(config[CONF_MAX_REGISTER_GAP]))
     await register_modbus_device(var, config)
 
+    for key, setter in (
+        (CONF_REQUEST_RATE, var.set_request_rate_sensor),
+        (CONF_TIMEOUTS, var.set_timeouts_sensor),
+        (CONF_RESPONSE_TIME, var.set_response_time_sensor),
+    ):
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(setter(sens))
+
 
 async def register_modbus_device(var, config):
     cg.add(var.set_address(config[CONF_ADDRESS]))
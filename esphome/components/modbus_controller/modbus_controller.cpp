@@ -7,9 +7,13 @@ namespace modbus_controller {
 
 static const char *const TAG = "modbus_controller";
 
+// Maximum number of registers in a read command that is created by combining ranges
+static const uint16_t MAX_READ_REGISTERS = 125;
+
 void ModbusController::setup() {
   // Modbus::setup();
   this->create_register_ranges_();
+  this->statistics_start_ = millis();
 }
 
 /*
@@ -24,48 +28,59 @@ bool ModbusController::send_next_command_() {
   if ((last_send > this->command_throttle_) && !waiting_for_response() && !command_queue_.empty()) {
     auto &command = command_queue_.front();
 
+    // the command is still at the front of the queue if no response was received for the previous attempt
+    if (command->send_countdown < ModbusCommandItem::MAX_SEND_REPEATS)
+      this->timeouts_++;
+
     // remove from queue if command was sent too often
     if (command->send_countdown < 1) {
       ESP_LOGD(
           TAG,
           "Modbus command to device=%d register=0x%02X countdown=%d no response received - removed from send queue",
           this->address_, command->register_address, command->send_countdown);
-      command_queue_.pop_front();
+      this->release_command_(this->command_queue_);
     } else {
       ESP_LOGV(TAG, "Sending next modbus command to device %d register 0x%02X count %d", this->address_,
                command->register_address, command->register_count);
       command->send();
       this->last_command_timestamp_ = millis();
+      this->requests_++;
       // remove from queue if no handler is defined
       if (!command->on_data_func) {
-        command_queue_.pop_front();
+        this->release_command_(this->command_queue_);
       }
     }
   }
   return (!command_queue_.empty());
 }
 
-// Queue incoming response
-void ModbusController::on_modbus_data(const std::vector<uint8_t> &data) {
-  auto &current_command = this->command_queue_.front();
-  if (current_command != nullptr) {
-    // Move the commandItem to the response queue
-    current_command->payload = data;
-    this->incoming_queue_.push(std::move(current_command));
-    ESP_LOGV(TAG, "Modbus response queued");
-    command_queue_.pop_front();
-  }
+// Dispatch the response to the registered handler while the data is still in the receive buffer of the bus
+void ModbusController::on_modbus_raw_data(const uint8_t *data, size_t len) {
+  this->on_response_();
+  if (this->command_queue_.empty() || this->command_queue_.front() == nullptr)
+    return;
+  // Out of the queue first, the handler may queue new commands
+  this->response_command_.splice(this->response_command_.end(), this->command_queue_, this->command_queue_.begin());
+  const ModbusCommandItem *response = this->response_command_.front().get();
+  ESP_LOGV(TAG, "Process modbus response for address 0x%X size: %zu", response->register_address, len);
+  response->on_data_func(response->register_type, response->register_address, BytesView(data, len));
+  this->release_command_(this->response_command_);
 }
 
-// Dispatch the response to the registered handler
-void ModbusController::process_modbus_data_(const ModbusCommandItem *response) {
-  ESP_LOGV(TAG, "Process modbus response for address 0x%X size: %zu", response->register_address,
-           response->payload.size());
-  response->on_data_func(response->register_type, response->register_address, response->payload);
+void ModbusController::on_response_() {
+  this->responses_++;
+  this->response_time_sum_ += millis() - this->last_command_timestamp_;
+}
+
+void ModbusController::release_command_(std::list<std::unique_ptr<ModbusCommandItem>> &list) {
+  this->command_pool_.splice(this->command_pool_.end(), list, list.begin());
 }
 
 void ModbusController::on_modbus_error(uint8_t function_code, uint8_t exception_code) {
   ESP_LOGE(TAG, "Modbus error function code: 0x%X exception: %d ", function_code, exception_code);
+  this->on_response_();
+  if (this->command_queue_.empty())
+    return;
   // Remove pending command waiting for a response
   auto &current_command = this->command_queue_.front();
   if (current_command != nullptr) {
@@ -75,7 +90,7 @@ void ModbusController::on_modbus_error(uint8_t function_code, uint8_t exception_
              "payload size=%zu",
              function_code, current_command->register_address, current_command->register_count,
              current_command->payload.size());
-    command_queue_.pop_front();
+    this->release_command_(this->command_queue_);
   }
 }
 
@@ -93,8 +108,7 @@ SensorSet ModbusController::find_sensors_(ModbusRegisterType register_type, uint
   // not found
   return {};
 }
-void ModbusController::on_register_data(ModbusRegisterType register_type, uint16_t start_address,
-                                        const std::vector<uint8_t> &data) {
+void ModbusController::on_register_data(ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
   ESP_LOGV(TAG, "data for register address : 0x%X : ", start_address);
 
   // loop through all sensors with the same start address
@@ -117,36 +131,87 @@ void ModbusController::queue_command(const ModbusCommandItem &command) {
       return;
     }
   }
-  command_queue_.push_back(make_unique<ModbusCommandItem>(command));
+  if (this->command_pool_.empty()) {
+    command_queue_.push_back(make_unique<ModbusCommandItem>(command));
+  } else {
+    *this->command_pool_.front() = command;
+    this->command_queue_.splice(this->command_queue_.end(), this->command_pool_, this->command_pool_.begin());
+  }
+}
+
+bool ModbusController::is_queued_(const ModbusCommandItem &command) const {
+  for (const auto &item : this->command_queue_) {
+    if (item->is_equal(command))
+      return true;
+  }
+  return false;
 }
 
 void ModbusController::update_range_(RegisterRange &r) {
   ESP_LOGV(TAG, "Range : %X Size: %x (%d) skip: %d", r.start_address, r.register_count, (int) r.register_type,
            r.skip_updates_counter);
   if (r.skip_updates_counter == 0) {
-    // if a custom command is used the user supplied custom_data is only available in the SensorItem.
-    if (r.register_type == ModbusRegisterType::CUSTOM) {
-      auto sensors = this->find_sensors_(r.register_type, r.start_address);
-      if (!sensors.empty()) {
-        auto sensor = sensors.cbegin();
-        auto command_item = ModbusCommandItem::create_custom_command(
-            this, (*sensor)->custom_data,
-            [this](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
-              this->on_register_data(ModbusRegisterType::CUSTOM, start_address, data);
-            });
-        command_item.register_address = (*sensor)->start_address;
-        command_item.register_count = (*sensor)->register_count;
-        command_item.function_code = ModbusFunctionCode::CUSTOM;
-        queue_command(command_item);
-      }
-    } else {
-      queue_command(ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count));
-    }
+    ModbusCommandItem command_item;
+    if (this->create_range_command_(r, command_item))
+      queue_command(command_item);
     r.skip_updates_counter = r.skip_updates;  // reset counter to config value
   } else {
     r.skip_updates_counter--;
   }
 }
+
+bool ModbusController::create_range_command_(const RegisterRange &r, ModbusCommandItem &command) {
+  // if a custom command is used the user supplied custom_data is only available in the SensorItem.
+  if (r.register_type == ModbusRegisterType::CUSTOM) {
+    if (r.sensors.empty())
+      return false;
+    auto *sensor = *r.sensors.cbegin();
+    command = ModbusCommandItem::create_custom_command(
+        this, sensor->custom_data,
+        [this](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
+          this->on_register_data(ModbusRegisterType::CUSTOM, start_address, data);
+        });
+    command.register_address = sensor->start_address;
+    command.register_count = sensor->register_count;
+    command.function_code = ModbusFunctionCode::CUSTOM;
+  } else {
+    command = ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count);
+  }
+  return true;
+}
+
+void ModbusController::schedule_ranges_() {
+  const uint32_t now = millis();
+  if (static_cast<int32_t>(now - this->next_range_update_) < 0)
+    return;
+
+  this->due_ranges_.clear();
+  for (auto &r : this->register_ranges_) {
+    if (r.update_interval != 0 && static_cast<int32_t>(now - r.next_update) >= 0)
+      this->due_ranges_.push_back(&r);
+  }
+  std::sort(this->due_ranges_.begin(), this->due_ranges_.end(), [now](const RegisterRange *a, const RegisterRange *b) {
+    return now - a->next_update > now - b->next_update;
+  });
+
+  ModbusCommandItem command_item;
+  for (auto *r : this->due_ranges_) {
+    // a range that is polled faster than the bus can handle is only queued once
+    if (this->create_range_command_(*r, command_item) && !this->is_queued_(command_item))
+      this->queue_command(command_item);
+    r->next_update += r->update_interval;
+    // don't try to catch up after a longer delay
+    if (static_cast<int32_t>(now - r->next_update) >= 0)
+      r->next_update = now + r->update_interval;
+  }
+
+  this->next_range_update_ = now + UINT32_MAX / 2;
+  for (auto &r : this->register_ranges_) {
+    if (r.update_interval != 0 && static_cast<int32_t>(r.next_update - this->next_range_update_) < 0)
+      this->next_range_update_ = r.next_update;
+  }
+}
+
 //
 // Queue the modbus requests to be send.
 // Once we get a response to the command it is removed from the queue and the next command is send
@@ -159,9 +224,30 @@ void ModbusController::update() {
   }
 
   for (auto &r : this->register_ranges_) {
+    // ranges with their own update_interval are queued by schedule_ranges_()
+    if (r.update_interval != 0)
+      continue;
     ESP_LOGVV(TAG, "Updating range 0x%X", r.start_address);
     update_range_(r);
   }
+
+  this->publish_statistics_();
+}
+
+void ModbusController::publish_statistics_() {
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - this->statistics_start_;
+  if (this->request_rate_sensor_ != nullptr && elapsed > 0)
+    this->request_rate_sensor_->publish_state(this->requests_ * 1000.0f / elapsed);
+  if (this->timeouts_sensor_ != nullptr)
+    this->timeouts_sensor_->publish_state(this->timeouts_);
+  if (this->response_time_sensor_ != nullptr && this->responses_ > 0)
+    this->response_time_sensor_->publish_state(static_cast<float>(this->response_time_sum_) / this->responses_);
+
+  this->statistics_start_ = now;
+  this->requests_ = 0;
+  this->responses_ = 0;
+  this->response_time_sum_ = 0;
 }
 
 // walk through the sensors and determine the register ranges to read
@@ -191,6 +277,8 @@ size_t ModbusController::create_register_ranges_() {
       r.sensors.insert(curr);
       r.skip_updates = curr->skip_updates;
       r.skip_updates_counter = 0;
+      r.update_interval = curr->update_interval;
+      r.next_update = 0;
       buffer_offset = curr->get_register_size();
 
       ESP_LOGV(TAG, "Started new range");
@@ -198,7 +286,14 @@ size_t ModbusController::create_register_ranges_() {
       // this is not the first register in range so it might be possible
       // to reuse the last register or extend the current range
       if (!curr->force_new_range && r.register_type == curr->register_type &&
-          curr->register_type != ModbusRegisterType::CUSTOM) {
+          curr->register_type != ModbusRegisterType::CUSTOM && r.update_interval == curr->update_interval) {
+        const uint16_t range_end = r.start_address + r.register_count;
+        // unused registers between the range and this register that can be read along to save a command
+        const bool can_skip_gap = (r.register_type == ModbusRegisterType::HOLDING ||
+                                   r.register_type == ModbusRegisterType::READ) &&
+                                  curr->response_bytes == 0 && curr->start_address > range_end &&
+                                  curr->start_address - range_end <= this->max_register_gap_ &&
+                                  curr->start_address + curr->register_count - r.start_address <= MAX_READ_REGISTERS;
         if (curr->start_address == (r.start_address + r.register_count - prev->register_count) &&
             curr->register_count == prev->register_count && curr->get_register_size() == prev->get_register_size()) {
           // this register can re-use the data from the previous register
@@ -215,16 +310,18 @@ size_t ModbusController::create_register_ranges_() {
 
           ESP_LOGV(TAG, "Re-use previous register - change to register: 0x%X %d offset=%u", curr->start_address,
                    curr->register_count, curr->offset);
-        } else if (curr->start_address == (r.start_address + r.register_count)) {
+        } else if (curr->start_address == range_end || can_skip_gap) {
           // this register can extend the current range
+          const uint16_t gap = curr->start_address - range_end;
 
           // remove this sensore because start_address is changed (sort-order)
           ix = sensorset_.erase(ix);
 
           curr->start_address = r.start_address;
+          buffer_offset += gap * 2;
           curr->offset += buffer_offset;
           buffer_offset += curr->get_register_size();
-          r.register_count += curr->register_count;
+          r.register_count += gap + curr->register_count;
 
           sensorset_.insert(curr);
           // move iterator backwards because it will be incremented later
@@ -274,6 +371,12 @@ size_t ModbusController::create_register_ranges_() {
 void ModbusController::dump_config() {
   ESP_LOGCONFIG(TAG, "ModbusController:");
   ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
+  if (this->max_register_gap_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Max Register Gap: %u", this->max_register_gap_);
+  }
+  LOG_SENSOR("  ", "Request Rate", this->request_rate_sensor_);
+  LOG_SENSOR("  ", "Timeouts", this->timeouts_sensor_);
+  LOG_SENSOR("  ", "Response Time", this->response_time_sensor_);
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
   ESP_LOGCONFIG(TAG, "sensormap");
   for (auto &it : sensorset_) {
@@ -283,28 +386,21 @@ void ModbusController::dump_config() {
   }
   ESP_LOGCONFIG(TAG, "ranges");
   for (auto &it : register_ranges_) {
-    ESP_LOGCONFIG(TAG, "  Range type=%zu start=0x%X count=%d skip_updates=%d", static_cast<uint8_t>(it.register_type),
-                  it.start_address, it.register_count, it.skip_updates);
+    ESP_LOGCONFIG(TAG, "  Range type=%zu start=0x%X count=%d skip_updates=%d update_interval=%u",
+                  static_cast<uint8_t>(it.register_type), it.start_address, it.register_count, it.skip_updates,
+                  it.update_interval);
   }
 #endif
 }
 
 void ModbusController::loop() {
-  // Incoming data to process?
-  if (!incoming_queue_.empty()) {
-    auto &message = incoming_queue_.front();
-    if (message != nullptr)
-      process_modbus_data_(message.get());
-    incoming_queue_.pop();
-
-  } else {
-    // all messages processed send pending commands
-    send_next_command_();
-  }
+  // Responses are processed as they are received, send pending commands
+  this->schedule_ranges_();
+  send_next_command_();
 }
 
 void ModbusController::on_write_register_response(ModbusRegisterType register_type, uint16_t start_address,
-                                                  const std::vector<uint8_t> &data) {
+                                                  BytesView data) {
   ESP_LOGV(TAG, "Command ACK 0x%X %d ", get_data<uint16_t>(data, 0), get_data<int16_t>(data, 1));
 }
 
@@ -318,8 +414,7 @@ void ModbusController::dump_sensors_() {
 
 ModbusCommandItem ModbusCommandItem::create_read_command(
     ModbusController *modbusdevice, ModbusRegisterType register_type, uint16_t start_address, uint16_t register_count,
-    std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
-        &&handler) {
+    std::function<void(ModbusRegisterType register_type, uint16_t start_address, BytesView data)> &&handler) {
   ModbusCommandItem cmd;
   cmd.modbusdevice = modbusdevice;
   cmd.register_type = register_type;
@@ -339,8 +434,7 @@ ModbusCommandItem ModbusCommandItem::create_read_command(ModbusController *modbu
   cmd.function_code = modbus_register_read_function(register_type);
   cmd.register_address = start_address;
   cmd.register_count = register_count;
-  cmd.on_data_func = [modbusdevice](ModbusRegisterType register_type, uint16_t start_address,
-                                    const std::vector<uint8_t> &data) {
+  cmd.on_data_func = [modbusdevice](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
     modbusdevice->on_register_data(register_type, start_address, data);
   };
   return cmd;
@@ -355,8 +449,7 @@ ModbusCommandItem ModbusCommandItem::create_write_multiple_command(ModbusControl
   cmd.function_code = ModbusFunctionCode::WRITE_MULTIPLE_REGISTERS;
   cmd.register_address = start_address;
   cmd.register_count = register_count;
-  cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address,
-                                         const std::vector<uint8_t> &data) {
+  cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
     modbusdevice->on_write_register_response(cmd.register_type, start_address, data);
   };
   for (auto v : values) {
@@ -375,8 +468,7 @@ ModbusCommandItem ModbusCommandItem::create_write_single_coil(ModbusController *
   cmd.function_code = ModbusFunctionCode::WRITE_SINGLE_COIL;
   cmd.register_address = address;
   cmd.register_count = 1;
-  cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address,
-                                         const std::vector<uint8_t> &data) {
+  cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
     modbusdevice->on_write_register_response(cmd.register_type, start_address, data);
   };
   cmd.payload.push_back(value ? 0xFF : 0);
@@ -392,8 +484,7 @@ ModbusCommandItem ModbusCommandItem::create_write_multiple_coils(ModbusControlle
   cmd.function_code = ModbusFunctionCode::WRITE_MULTIPLE_COILS;
   cmd.register_address = start_address;
   cmd.register_count = values.size();
-  cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address,
-                                         const std::vector<uint8_t> &data) {
+  cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
     modbusdevice->on_write_register_response(cmd.register_type, start_address, data);
   };
 
@@ -424,8 +515,7 @@ ModbusCommandItem ModbusCommandItem::create_write_single_command(ModbusControlle
   cmd.function_code = ModbusFunctionCode::WRITE_SINGLE_REGISTER;
   cmd.register_address = start_address;
   cmd.register_count = 1;  // not used here anyways
-  cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address,
-                                         const std::vector<uint8_t> &data) {
+  cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
     modbusdevice->on_write_register_response(cmd.register_type, start_address, data);
   };
 
@@ -437,13 +527,12 @@ ModbusCommandItem ModbusCommandItem::create_write_single_command(ModbusControlle
 
 ModbusCommandItem ModbusCommandItem::create_custom_command(
     ModbusController *modbusdevice, const std::vector<uint8_t> &values,
-    std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
-        &&handler) {
+    std::function<void(ModbusRegisterType register_type, uint16_t start_address, BytesView data)> &&handler) {
   ModbusCommandItem cmd;
   cmd.modbusdevice = modbusdevice;
   cmd.function_code = ModbusFunctionCode::CUSTOM;
   if (handler == nullptr) {
-    cmd.on_data_func = [](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
+    cmd.on_data_func = [](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
       ESP_LOGI(TAG, "Custom Command sent");
     };
   } else {
@@ -456,13 +545,12 @@ ModbusCommandItem ModbusCommandItem::create_custom_command(
 
 ModbusCommandItem ModbusCommandItem::create_custom_command(
     ModbusController *modbusdevice, const std::vector<uint16_t> &values,
-    std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
-        &&handler) {
+    std::function<void(ModbusRegisterType register_type, uint16_t start_address, BytesView data)> &&handler) {
   ModbusCommandItem cmd = {};
   cmd.modbusdevice = modbusdevice;
   cmd.function_code = ModbusFunctionCode::CUSTOM;
   if (handler == nullptr) {
-    cmd.on_data_func = [](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
+    cmd.on_data_func = [](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
       ESP_LOGI(TAG, "Custom Command sent");
     };
   } else {
@@ -536,8 +624,7 @@ void number_to_payload(std::vector<uint16_t> &data, int64_t value, SensorValueTy
   }
 }
 
-int64_t payload_to_number(const std::vector<uint8_t> &data, SensorValueType sensor_value_type, uint8_t offset,
-                          uint32_t bitmask) {
+int64_t payload_to_number(BytesView data, SensorValueType sensor_value_type, uint8_t offset, uint32_t bitmask) {
   int64_t value = 0;  // int64_t because it can hold signed and unsigned 32 bits
 
   switch (sensor_value_type) {
@@ -3,10 +3,10 @@
 #include "esphome/core/component.h"
 
 #include "esphome/components/modbus/modbus.h"
+#include "esphome/components/sensor/sensor.h"
 #include "esphome/core/automation.h"
 
 #include <list>
-#include <queue>
 #include <set>
 #include <vector>
 
@@ -15,6 +15,29 @@ namespace modbus_controller {
 
 class ModbusController;
 
+/** The data of a received response, which isn't copied but only valid while the response is dispatched.
+ *
+ * It converts to a vector for the lambdas and handlers that take one, which then get a copy.
+ */
+class BytesView {
+ public:
+  BytesView() = default;
+  BytesView(const uint8_t *first, size_t count) : first_(first), count_(count) {}
+  BytesView(const std::vector<uint8_t> &buffer) : first_(buffer.data()), count_(buffer.size()) {}  // NOLINT
+
+  size_t size() const { return this->count_; }
+  bool empty() const { return this->count_ == 0; }
+  uint8_t operator[](size_t index) const { return this->first_[index]; }
+  const uint8_t *data() const { return this->first_; }
+  const uint8_t *begin() const { return this->first_; }
+  const uint8_t *end() const { return this->first_ + this->count_; }
+  operator std::vector<uint8_t>() const { return {this->begin(), this->end()}; }  // NOLINT
+
+ protected:
+  const uint8_t *first_{nullptr};
+  size_t count_{0};
+};
+
 enum class ModbusFunctionCode {
   CUSTOM = 0x00,
   READ_COILS = 0x01,
@@ -152,7 +175,7 @@ inline uint64_t qword_from_hex_str(const std::string &value, uint8_t pos) {
  * @param buffer_offset  offset in bytes.
  * @return value of type T extracted from buffer
  */
-template<typename T> T get_data(const std::vector<uint8_t> &data, size_t buffer_offset) {
+template<typename T> T get_data(BytesView data, size_t buffer_offset) {
   if (sizeof(T) == sizeof(uint8_t)) {
     return T(data[buffer_offset]);
   }
@@ -178,7 +201,7 @@ template<typename T> T get_data(const std::vector<uint8_t> &data, size_t buffer_
  * @param data modbus response buffer (uint8_t)
  * @return content of coil register
  */
-inline bool coil_from_vector(int coil, const std::vector<uint8_t> &data) {
+inline bool coil_from_vector(int coil, BytesView data) {
   auto data_byte = coil / 8;
   return (data[data_byte] & (1 << (coil % 8))) > 0;
 }
@@ -220,14 +243,13 @@ void number_to_payload(std::vector<uint16_t> &data, int64_t value, SensorValueTy
  * @param bitmask bitmask used for masking and shifting
  * @return 64-bit number of the payload
  */
-int64_t payload_to_number(const std::vector<uint8_t> &data, SensorValueType sensor_value_type, uint8_t offset,
-                          uint32_t bitmask);
+int64_t payload_to_number(BytesView data, SensorValueType sensor_value_type, uint8_t offset, uint32_t bitmask);
 
 class ModbusController;
 
 class SensorItem {
  public:
-  virtual void parse_and_publish(const std::vector<uint8_t> &data) = 0;
+  virtual void parse_and_publish(BytesView data) = 0;
 
   void set_custom_data(const std::vector<uint8_t> &data) { custom_data = data; }
   size_t virtual get_register_size() const {
@@ -239,6 +261,8 @@ class SensorItem {
   }
   // Override register size for modbus devices not using 1 register for one dword
   void set_register_size(uint8_t register_size) { response_bytes = register_size; }
+  // Poll this item on its own interval instead of the update interval of the controller
+  void set_update_interval(uint32_t interval) { update_interval = interval; }
   ModbusRegisterType register_type;
   SensorValueType sensor_value_type;
   uint16_t start_address;
@@ -247,6 +271,7 @@ class SensorItem {
   uint8_t register_count;
   uint8_t response_bytes{0};
   uint8_t skip_updates;
+  uint32_t update_interval{0};
   std::vector<uint8_t> custom_data{};
   bool force_new_range{false};
 };
@@ -266,6 +291,11 @@ class SensorItemsComparator {
       return lhs->force_new_range > rhs->force_new_range;
     }
 
+    // sensors polled on the same interval are grouped into ranges
+    if (lhs->update_interval != rhs->update_interval) {
+      return lhs->update_interval < rhs->update_interval;
+    }
+
     // sort by start address
     if (lhs->start_address != rhs->start_address) {
       return lhs->start_address < rhs->start_address;
@@ -291,6 +321,8 @@ struct RegisterRange {
   uint8_t skip_updates;          // the config value
   SensorSet sensors;             // all sensors of this range
   uint8_t skip_updates_counter;  // the running value
+  uint32_t update_interval;      // 0 if the range is polled on the update interval of the controller
+  uint32_t next_update;          // when the range is due if it has its own update_interval
 };
 
 class ModbusCommandItem {
@@ -302,8 +334,7 @@ class ModbusCommandItem {
   uint16_t register_count;
   ModbusFunctionCode function_code;
   ModbusRegisterType register_type;
-  std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
-      on_data_func;
+  std::function<void(ModbusRegisterType register_type, uint16_t start_address, BytesView data)> on_data_func;
   std::vector<uint8_t> payload = {};
   bool send();
   // wrong commands (esp. custom commands) can block the send queue
@@ -321,8 +352,7 @@ class ModbusCommandItem {
    */
   static ModbusCommandItem create_read_command(
       ModbusController *modbusdevice, ModbusRegisterType register_type, uint16_t start_address, uint16_t register_count,
-      std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
-          &&handler);
+      std::function<void(ModbusRegisterType register_type, uint16_t start_address, BytesView data)> &&handler);
   /** Create modbus read command
    *  Function code 02-04
    * @param modbusdevice pointer to the device to execute the command
@@ -381,7 +411,7 @@ class ModbusCommandItem {
    */
   static ModbusCommandItem create_custom_command(
       ModbusController *modbusdevice, const std::vector<uint8_t> &values,
-      std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
+      std::function<void(ModbusRegisterType register_type, uint16_t start_address, BytesView data)>
           &&handler = nullptr);
 
   /** Create custom modbus command
@@ -393,7 +423,7 @@ class ModbusCommandItem {
    */
   static ModbusCommandItem create_custom_command(
       ModbusController *modbusdevice, const std::vector<uint16_t> &values,
-      std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
+      std::function<void(ModbusRegisterType register_type, uint16_t start_address, BytesView data)>
           &&handler = nullptr);
 
   bool is_equal(const ModbusCommandItem &other);
@@ -420,17 +450,24 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   /// Registers a sensor with the controller. Called by esphomes code generator
   void add_sensor_item(SensorItem *item) { sensorset_.insert(item); }
   /// called when a modbus response was parsed without errors
-  void on_modbus_data(const std::vector<uint8_t> &data) override;
+  void on_modbus_raw_data(const uint8_t *data, size_t len) override;
   /// called when a modbus error response was received
   void on_modbus_error(uint8_t function_code, uint8_t exception_code) override;
-  /// default delegate called by process_modbus_data when a response has retrieved from the incoming queue
-  void on_register_data(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data);
-  /// default delegate called by process_modbus_data when a response for a write response has retrieved from the
-  /// incoming queue
-  void on_write_register_response(ModbusRegisterType register_type, uint16_t start_address,
-                                  const std::vector<uint8_t> &data);
+  /// default delegate called when the response to a read command was received
+  void on_register_data(ModbusRegisterType register_type, uint16_t start_address, BytesView data);
+  /// default delegate called when the response to a write command was received
+  void on_write_register_response(ModbusRegisterType register_type, uint16_t start_address, BytesView data);
   /// called by esphome generated code to set the command_throttle period
   void set_command_throttle(uint16_t command_throttle) { this->command_throttle_ = command_throttle; }
+  /// number of unused registers that may be read to combine two ranges into one command
+  void set_max_register_gap(uint8_t max_register_gap) { this->max_register_gap_ = max_register_gap; }
+  void set_request_rate_sensor(sensor::Sensor *request_rate_sensor) {
+    this->request_rate_sensor_ = request_rate_sensor;
+  }
+  void set_timeouts_sensor(sensor::Sensor *timeouts_sensor) { this->timeouts_sensor_ = timeouts_sensor; }
+  void set_response_time_sensor(sensor::Sensor *response_time_sensor) {
+    this->response_time_sensor_ = response_time_sensor;
+  }
 
  protected:
   /// parse sensormap_ and create range of sequential addresses
@@ -439,8 +476,16 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   SensorSet find_sensors_(ModbusRegisterType register_type, uint16_t start_address) const;
   /// submit the read command for the address range to the send queue
   void update_range_(RegisterRange &r);
-  /// parse incoming modbus data
-  void process_modbus_data_(const ModbusCommandItem *response);
+  /// create the read command for the address range, returns false if there is none
+  bool create_range_command_(const RegisterRange &r, ModbusCommandItem &command);
+  /// queue the ranges with their own update_interval that are due, the most overdue first
+  void schedule_ranges_();
+  bool is_queued_(const ModbusCommandItem &command) const;
+  /// move the first command of the list to the pool of reusable command items
+  void release_command_(std::list<std::unique_ptr<ModbusCommandItem>> &list);
+  /// a response or error for the last sent command was received
+  void on_response_();
+  void publish_statistics_();
   /// send the next modbus command from the send queue
   bool send_next_command_();
   /// get the number of queued modbus commands (should be mostly empty)
@@ -453,12 +498,29 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   std::vector<RegisterRange> register_ranges_;
   /// Hold the pending requests to be sent
   std::list<std::unique_ptr<ModbusCommandItem>> command_queue_;
-  /// modbus response data waiting to get processed
-  std::queue<std::unique_ptr<ModbusCommandItem>> incoming_queue_;
+  /// the command whose response is being dispatched
+  std::list<std::unique_ptr<ModbusCommandItem>> response_command_;
+  /// processed commands, reused for new commands to avoid allocations. Items are moved between the lists by splicing.
+  std::list<std::unique_ptr<ModbusCommandItem>> command_pool_;
+  /// ranges due in schedule_ranges_(), only kept to reuse the allocation
+  std::vector<RegisterRange *> due_ranges_;
+  /// when the next range with its own update_interval is due
+  uint32_t next_range_update_{0};
   /// when was the last send operation
   uint32_t last_command_timestamp_;
   /// min time in ms between sending modbus commands
   uint16_t command_throttle_;
+  uint8_t max_register_gap_{0};
+
+  sensor::Sensor *request_rate_sensor_{nullptr};
+  sensor::Sensor *timeouts_sensor_{nullptr};
+  sensor::Sensor *response_time_sensor_{nullptr};
+  /// statistics since the last publish_statistics_(), except for timeouts_
+  uint32_t statistics_start_{0};
+  uint32_t requests_{0};
+  uint32_t responses_{0};
+  uint32_t response_time_sum_{0};
+  uint32_t timeouts_{0};
 };
 
 /** Convert vector<uint8_t> response payload to float.
@@ -466,7 +528,7 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
  * @param item SensorItem object
  * @return float value of data
  */
-inline float payload_to_float(const std::vector<uint8_t> &data, const SensorItem &item) {
+inline float payload_to_float(BytesView data, const SensorItem &item) {
   int64_t number = payload_to_number(data, item.sensor_value_type, item.offset, item.bitmask);
 
   float float_value;
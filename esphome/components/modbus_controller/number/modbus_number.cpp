@@ -7,7 +7,7 @@ namespace modbus_controller {
 
 static const char *const TAG = "modbus.number";
 
-void ModbusNumber::parse_and_publish(const std::vector<uint8_t> &data) {
+void ModbusNumber::parse_and_publish(BytesView data) {
   float result = payload_to_float(data, *this) / multiply_by_;
 
   // Is there a lambda registered
@@ -50,7 +50,7 @@ void ModbusNumber::control(float value) {
     ESP_LOGV(TAG, "Modbus Number write raw: %s", format_hex_pretty(data).c_str());
     write_cmd = ModbusCommandItem::create_custom_command(
         this->parent_, data,
-        [this, write_cmd](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
+        [this, write_cmd](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
           this->parent_->on_write_register_response(write_cmd.register_type, this->start_address, data);
         });
   } else {
@@ -71,7 +71,7 @@ void ModbusNumber::control(float value) {
     }
     // publish new value
     write_cmd.on_data_func = [this, write_cmd, value](ModbusRegisterType register_type, uint16_t start_address,
-                                                      const std::vector<uint8_t> &data) {
+                                                      BytesView data) {
       // gets called when the write command is ack'd from the device
       parent_->on_write_register_response(write_cmd.register_type, start_address, data);
       this->publish_state(value);
@@ -81,7 +81,7 @@ void ModbusBinaryOutput::write_state(bool state) {
     ESP_LOGV(TAG, "Modbus binary output write raw: %s", format_hex_pretty(data).c_str());
     cmd = ModbusCommandItem::create_custom_command(
         this->parent_, data,
-        [this, cmd](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
+        [this, cmd](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
           this->parent_->on_write_register_response(cmd.register_type, this->start_address, data);
         });
   } else {
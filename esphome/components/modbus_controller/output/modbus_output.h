@@ -25,7 +25,7 @@ class ModbusFloatOutput : public output::FloatOutput, public Component, public S
   void set_parent(ModbusController *parent) { this->parent_ = parent; }
   void set_write_multiply(float factor) { multiply_by_ = factor; }
   // Do nothing
-  void parse_and_publish(const std::vector<uint8_t> &data) override{};
+  void parse_and_publish(BytesView data) override{};
 
   using write_transform_func_t = std::function<optional<float>(ModbusFloatOutput *, float, std::vector<uint16_t> &)>;
   void set_write_template(write_transform_func_t &&f) { this->write_transform_func_ = f; }
@@ -56,7 +56,7 @@ class ModbusBinaryOutput : public output::BinaryOutput, public Component, public
 
   void set_parent(ModbusController *parent) { this->parent_ = parent; }
   // Do nothing
-  void parse_and_publish(const std::vector<uint8_t> &data) override{};
+  void parse_and_publish(BytesView data) override{};
 
   using write_transform_func_t = std::function<optional<bool>(ModbusBinaryOutput *, bool, std::vector<uint8_t> &)>;
   void set_write_template(write_transform_func_t &&f) { this->write_transform_func_ = f; }
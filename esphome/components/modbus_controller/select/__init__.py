@@ -1,7 +1,13 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import select
-from esphome.const import CONF_ADDRESS, CONF_ID, CONF_LAMBDA, CONF_OPTIMISTIC
+from esphome.const import (
+    CONF_ADDRESS,
+    CONF_ID,
+    CONF_LAMBDA,
+    CONF_OPTIMISTIC,
+    CONF_UPDATE_INTERVAL,
+)
 
 from .. import (
     SENSOR_VALUE_TYPE,
@@ -9,6 +15,7 @@ from .. import (
     ModbusController,
     SensorItem,
     modbus_controller_ns,
+    validate_item_update_interval,
 )
 from ..const import (
     CONF_FORCE_NEW_RANGE,
@@ -74,6 +81,7 @@ CONFIG_SCHEMA = cv.All(
             ),
             cv.Optional(CONF_REGISTER_COUNT): cv.positive_int,
             cv.Optional(CONF_SKIP_UPDATES, default=0): cv.positive_int,
+            cv.Optional(CONF_UPDATE_INTERVAL): validate_item_update_interval,
             cv.Optional(CONF_FORCE_NEW_RANGE, default=False): cv.boolean,
             cv.Required(CONF_OPTIONSMAP): ensure_option_map(),
             cv.Optional(CONF_USE_WRITE_MULTIPLE, default=False): cv.boolean,
@@ -112,6 +120,8 @@ async def to_code(config):
     cg.add(var.set_parent(parent))
     cg.add(var.set_use_write_mutiple(config[CONF_USE_WRITE_MULTIPLE]))
     cg.add(var.set_optimistic(config[CONF_OPTIMISTIC]))
+    if CONF_UPDATE_INTERVAL in config:
+        cg.add(var.set_update_interval(config[CONF_UPDATE_INTERVAL]))
 
     if CONF_LAMBDA in config:
         template_ = await cg.process_lambda(
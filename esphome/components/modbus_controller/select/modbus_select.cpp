@@ -8,7 +8,7 @@ static const char *const TAG = "modbus_controller.select";
 
 void ModbusSelect::dump_config() { LOG_SELECT(TAG, "Modbus Controller Select", this); }
 
-void ModbusSelect::parse_and_publish(const std::vector<uint8_t> &data) {
+void ModbusSelect::parse_and_publish(BytesView data) {
   int64_t value = payload_to_number(data, this->sensor_value_type, this->offset, this->bitmask);
 
   ESP_LOGD(TAG, "New select value %lld from payload", value);
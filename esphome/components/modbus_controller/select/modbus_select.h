@@ -37,7 +37,7 @@ class ModbusSelect : public Component, public select::Select, public SensorItem
   void set_write_template(write_transform_func_t &&f) { this->write_transform_func_ = f; }
 
   void dump_config() override;
-  void parse_and_publish(const std::vector<uint8_t> &data) override;
+  void parse_and_publish(BytesView data) override;
   void control(const std::string &value) override;
 
  protected:
@@ -21,7 +21,7 @@ class ModbusSensor : public Component, public sensor::Sensor, public SensorItem
     this->force_new_range = force_new_range;
   }
 
-  void parse_and_publish(const std::vector<uint8_t> &data) override;
+  void parse_and_publish(BytesView data) override;
   void dump_config() override;
   using transform_func_t = std::function<optional<float>(ModbusSensor *, float, const std::vector<uint8_t> &)>;
 
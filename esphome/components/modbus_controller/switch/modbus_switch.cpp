@@ -13,7 +13,7 @@ void ModbusSwitch::setup() {
 }
 void ModbusSwitch::dump_config() { LOG_SWITCH(TAG, "Modbus Controller Switch", this); }
 
-void ModbusSwitch::parse_and_publish(const std::vector<uint8_t> &data) {
+void ModbusSwitch::parse_and_publish(BytesView data) {
   bool value = false;
   switch (this->register_type) {
     case ModbusRegisterType::DISCRETE_INPUT:
@@ -64,7 +64,7 @@ void ModbusSwitch::write_state(bool state) {
     ESP_LOGV(TAG, "Modbus Switch write raw: %s", format_hex_pretty(data).c_str());
     cmd = ModbusCommandItem::create_custom_command(
         this->parent_, data,
-        [this, cmd](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
+        [this, cmd](ModbusRegisterType register_type, uint16_t start_address, BytesView data) {
           this->parent_->on_write_register_response(cmd.register_type, this->start_address, data);
         });
   } else {
@@ -18,6 +18,10 @@ static const uint16_t MANUFACTURER_ID = 0x0059;
  *    If the sync button is pressed, report the MAC so a user can add this as a sensor.
  */
 
+MopekaListener::MopekaListener() {
+  this->add_match_manufacturer_uuid(esp32_ble_tracker::ESPBTUUID::from_uint16(MANUFACTURER_ID));
+}
+
 bool MopekaListener::parse_device(const esp32_ble_tracker::ESPBTDevice &device) {
   const auto &manu_datas = device.get_manufacturer_datas();
 
@@ -10,6 +10,7 @@ namespace mopeka_ble {
 
 class MopekaListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  MopekaListener();
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 
  protected:
@@ -53,6 +53,7 @@ AUTO_LOAD = ["json"]
 
 CONF_IDF_SEND_ASYNC = "idf_send_async"
 CONF_SKIP_CERT_CN_CHECK = "skip_cert_cn_check"
+CONF_WILDCARD_SUBSCRIPTION = "wildcard_subscription"
 
 
 def validate_message_just_topic(value):
@@ -202,6 +203,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_WILL_MESSAGE): MQTT_MESSAGE_SCHEMA,
             cv.Optional(CONF_SHUTDOWN_MESSAGE): MQTT_MESSAGE_SCHEMA,
             cv.Optional(CONF_TOPIC_PREFIX, default=lambda: CORE.name): cv.publish_topic,
+            cv.Optional(CONF_WILDCARD_SUBSCRIPTION, default=False): cv.boolean,
             cv.Optional(CONF_LOG_TOPIC): cv.Any(
                 None,
                 MQTT_MESSAGE_BASE.extend(
@@ -314,6 +316,7 @@ async def to_code(config):
         )
 
     cg.add(var.set_topic_prefix(config[CONF_TOPIC_PREFIX]))
+    cg.add(var.set_wildcard_subscription(config[CONF_WILDCARD_SUBSCRIPTION]))
 
     if config[CONF_USE_ABBREVIATIONS]:
         cg.add_define("USE_MQTT_ABBREVIATIONS")
@@ -27,6 +27,8 @@ MQTTClientComponent::MQTTClientComponent() {
 // Connection
 void MQTTClientComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up MQTT...");
+  if (this->wildcard_subscription_ && !this->topic_prefix_.empty())
+    this->wildcard_.topic = this->topic_prefix_ + "/#";
   this->mqtt_backend_.set_on_message(
       [this](const char *topic, const char *payload, size_t len, size_t index, size_t total) {
         if (index == 0)
@@ -72,6 +74,9 @@ void MQTTClientComponent::dump_config() {
     ESP_LOGCONFIG(TAG, "  Discovery retain: %s", YESNO(this->discovery_info_.retain));
   }
   ESP_LOGCONFIG(TAG, "  Topic Prefix: '%s'", this->topic_prefix_.c_str());
+  if (!this->wildcard_.topic.empty()) {
+    ESP_LOGCONFIG(TAG, "  Wildcard Subscription: '%s'", this->wildcard_.topic.c_str());
+  }
   if (!this->log_message_.topic.empty()) {
     ESP_LOGCONFIG(TAG, "  Log Topic: '%s'", this->log_message_.topic.c_str());
   }
@@ -86,6 +91,8 @@ void MQTTClientComponent::start_dnslookup_() {
     subscription.subscribed = false;
     subscription.resubscribe_timeout = 0;
   }
+  this->wildcard_.subscribed = false;
+  this->wildcard_.resubscribe_timeout = 0;
 
   this->status_set_warning();
   this->dns_resolve_error_ = false;
@@ -332,16 +339,43 @@ void MQTTClientComponent::resubscribe_subscription_(MQTTSubscription *sub) {
   }
 }
 void MQTTClientComponent::resubscribe_subscriptions_() {
+  if (!this->wildcard_.topic.empty())
+    this->resubscribe_subscription_(&this->wildcard_);
   for (auto &subscription : this->subscriptions_) {
     this->resubscribe_subscription_(&subscription);
   }
 }
+bool MQTTClientComponent::is_covered_by_wildcard_(const std::string &topic) const {
+  const std::string &prefix = this->topic_prefix_;
+  return this->wildcard_subscription_ && !prefix.empty() && topic.size() > prefix.size() &&
+         topic.compare(0, prefix.size(), prefix) == 0 && topic[prefix.size()] == '/';
+}
+void MQTTClientComponent::add_subscription_(const std::string &topic, uint8_t qos) {
+  MQTTSubscription *existing = nullptr;
+  if (this->is_covered_by_wildcard_(topic)) {
+    existing = &this->wildcard_;
+  } else {
+    for (auto &subscription : this->subscriptions_) {
+      if (subscription.topic == topic) {
+        existing = &subscription;
+        break;
+      }
+    }
+  }
+
+  if (existing != nullptr) {
+    // Subscribing again replaces the QoS of the existing subscription at the broker
+    if (qos > existing->qos) {
+      existing->qos = qos;
+      existing->subscribed = false;
+      existing->resubscribe_timeout = 0;
+    }
+    return;
+  }
 
-void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t callback, uint8_t qos) {
   MQTTSubscription subscription{
       .topic = topic,
       .qos = qos,
-      .callback = std::move(callback),
       .subscribed = false,
       .resubscribe_timeout = 0,
   };
@@ -349,22 +383,25 @@ void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t ca
   this->subscriptions_.push_back(subscription);
 }
 
+void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t callback, uint8_t qos) {
+  this->router_.add(topic, std::move(callback));
+  this->add_subscription_(topic, qos);
+}
+
 void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_json_callback_t &callback, uint8_t qos) {
   auto f = [callback](const std::string &topic, const std::string &payload) {
     json::parse_json(payload, [topic, callback](JsonObject root) { callback(topic, root); });
   };
-  MQTTSubscription subscription{
-      .topic = topic,
-      .qos = qos,
-      .callback = f,
-      .subscribed = false,
-      .resubscribe_timeout = 0,
-  };
-  this->resubscribe_subscription_(&subscription);
-  this->subscriptions_.push_back(subscription);
+  this->router_.add(topic, f);
+  this->add_subscription_(topic, qos);
 }
 
 void MQTTClientComponent::unsubscribe(const std::string &topic) {
+  this->router_.remove(topic);
+  // Messages for topics covered by the wildcard subscription are simply not routed anywhere anymore
+  if (this->is_covered_by_wildcard_(topic))
+    return;
+
   bool ret = this->mqtt_backend_.unsubscribe(topic.c_str());
   yield();
   if (ret) {
@@ -427,73 +464,13 @@ bool MQTTClientComponent::publish_json(const std::string &topic, const json::jso
   return this->publish(topic, message, qos, retain);
 }
 
-/** Check if the message topic matches the given subscription topic
- *
- * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
- *
- * @param message The message topic that was received from the MQTT server. Note: this must not contain
- *                wildcard characters as mandated by the MQTT spec.
- * @param subscription The subscription topic we are matching against.
- * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
- * @param past_separator Are we past the first '/' topic separator.
- * @return true if the subscription topic matches the message topic, false otherwise.
- */
-static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
-  // Reached end of both strings at the same time, this means we have a successful match
-  if (*message == '\0' && *subscription == '\0')
-    return true;
-
-  // Either the message or the subscribe are at the end. This means they don't match.
-  if (*message == '\0' || *subscription == '\0')
-    return false;
-
-  bool do_wildcards = is_normal || past_separator;
-
-  if (*subscription == '+' && do_wildcards) {
-    // single level wildcard
-    // consume + from subscription
-    subscription++;
-    // consume everything from message until '/' found or end of string
-    while (*message != '\0' && *message != '/') {
-      message++;
-    }
-    // after this, both pointers will point to a '/' or to the end of the string
-
-    return topic_match(message, subscription, is_normal, true);
-  }
-
-  if (*subscription == '#' && do_wildcards) {
-    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
-    return true;
-  }
-
-  // this handles '/' and normal characters at the same time.
-  if (*message != *subscription)
-    return false;
-
-  past_separator = past_separator || *subscription == '/';
-
-  // consume characters
-  subscription++;
-  message++;
-
-  return topic_match(message, subscription, is_normal, past_separator);
-}
-
-static bool topic_match(const char *message, const char *subscription) {
-  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
-}
-
 void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
 #ifdef USE_ESP8266
   // on ESP8266, this is called in LWiP thread; some components do not like running
   // in an ISR.
   this->defer([this, topic, payload]() {
 #endif
-    for (auto &subscription : this->subscriptions_) {
-      if (topic_match(topic.c_str(), subscription.topic.c_str()))
-        subscription.callback(topic, payload);
-    }
+    this->router_.route(topic, payload);
 #ifdef USE_ESP8266
   });
 #endif
@@ -14,6 +14,7 @@
 #elif defined(USE_ARDUINO)
 #include "mqtt_backend_arduino.h"
 #endif
+#include "mqtt_topic_router.h"
 #include "lwip/ip_addr.h"
 
 namespace esphome {
@@ -24,18 +25,12 @@ namespace mqtt {
 using mqtt_on_connect_callback_t = std::function<MQTTBackend::on_connect_callback_t>;
 using mqtt_on_disconnect_callback_t = std::function<MQTTBackend::on_disconnect_callback_t>;
 
-/** Callback for MQTT subscriptions.
- *
- * First parameter is the topic, the second one is the payload.
- */
-using mqtt_callback_t = std::function<void(const std::string &, const std::string &)>;
 using mqtt_json_callback_t = std::function<void(const std::string &, JsonObject)>;
 
-/// internal struct for MQTT subscriptions.
+/// internal struct for the MQTT subscriptions at the broker, the callbacks are kept in the MQTTTopicRouter.
 struct MQTTSubscription {
   std::string topic;
   uint8_t qos;
-  mqtt_callback_t callback;
   bool subscribed;
   uint32_t resubscribe_timeout;
 };
@@ -157,6 +152,12 @@ class MQTTClientComponent : public Component {
   void set_topic_prefix(const std::string &topic_prefix);
   /// Get the topic prefix of this device, using default if necessary
   const std::string &get_topic_prefix() const;
+  /** Subscribe to "<topic_prefix>/#" once instead of every topic below the topic prefix separately.
+   *
+   * Saves a SUBSCRIBE packet per command topic when connecting, at the cost of also receiving all messages published
+   * by this device (like its states) back from the broker, which are then dropped locally.
+   */
+  void set_wildcard_subscription(bool wildcard_subscription) { this->wildcard_subscription_ = wildcard_subscription; }
 
   /// Manually set the topic used for logging.
   void set_log_message_template(MQTTMessage &&message);
@@ -167,7 +168,7 @@ class MQTTClientComponent : public Component {
 
   /** Subscribe to an MQTT topic and call callback when a message is received.
    *
-   * @param topic The topic. Wildcards are currently not supported.
+   * @param topic The topic filter, may contain the '+' and '#' wildcards.
    * @param callback The callback function.
    * @param qos The QoS of this subscription.
    */
@@ -177,7 +178,7 @@ class MQTTClientComponent : public Component {
    *
    * If an invalid JSON payload is received, the callback will not be called.
    *
-   * @param topic The topic. Wildcards are currently not supported.
+   * @param topic The topic filter, may contain the '+' and '#' wildcards.
    * @param callback The callback with a parsed JsonObject that will be called when a message with matching topic is
    * received.
    * @param qos The QoS of this subscription.
@@ -263,6 +264,10 @@ class MQTTClientComponent : public Component {
   void recalculate_availability_();
 
   bool subscribe_(const char *topic, uint8_t qos);
+  /// Add a subscription at the broker for the topic filter, unless there already is one covering it.
+  void add_subscription_(const std::string &topic, uint8_t qos);
+  /// Whether the topic filter is covered by the "<topic_prefix>/#" subscription.
+  bool is_covered_by_wildcard_(const std::string &topic) const;
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
 
@@ -291,7 +296,12 @@ class MQTTClientComponent : public Component {
   std::string payload_buffer_;
   int log_level_{ESPHOME_LOG_LEVEL};
 
+  /// One entry per topic filter.
   std::vector<MQTTSubscription> subscriptions_;
+  MQTTTopicRouter router_;
+  bool wildcard_subscription_{false};
+  /// The "<topic_prefix>/#" subscription if wildcard_subscription_ is enabled.
+  MQTTSubscription wildcard_{};
 #if defined(USE_ESP_IDF)
   MQTTBackendIDF mqtt_backend_;
 #elif defined(USE_ARDUINO)
@@ -13,114 +13,117 @@ static const char *const TAG = "mqtt.climate";
 
 using namespace esphome::climate;
 
-void MQTTClimateComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
+void MQTTClimateComponent::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
   auto traits = this->device_->get_traits();
   // current_temperature_topic
   if (traits.get_supports_current_temperature()) {
     // current_temperature_topic
-    root[MQTT_CURRENT_TEMPERATURE_TOPIC] = this->get_current_temperature_state_topic();
+    root.add(MQTT_CURRENT_TEMPERATURE_TOPIC, this->get_current_temperature_state_topic());
   }
   // mode_command_topic
-  root[MQTT_MODE_COMMAND_TOPIC] = this->get_mode_command_topic();
+  root.add(MQTT_MODE_COMMAND_TOPIC, this->get_mode_command_topic());
   // mode_state_topic
-  root[MQTT_MODE_STATE_TOPIC] = this->get_mode_state_topic();
+  root.add(MQTT_MODE_STATE_TOPIC, this->get_mode_state_topic());
   // modes
-  JsonArray modes = root.createNestedArray(MQTT_MODES);
+  root.begin_array(MQTT_MODES);
   // sort array for nice UI in HA
   if (traits.supports_mode(CLIMATE_MODE_AUTO))
-    modes.add("auto");
-  modes.add("off");
+    root.add_value("auto");
+  root.add_value("off");
   if (traits.supports_mode(CLIMATE_MODE_COOL))
-    modes.add("cool");
+    root.add_value("cool");
   if (traits.supports_mode(CLIMATE_MODE_HEAT))
-    modes.add("heat");
+    root.add_value("heat");
   if (traits.supports_mode(CLIMATE_MODE_FAN_ONLY))
-    modes.add("fan_only");
+    root.add_value("fan_only");
   if (traits.supports_mode(CLIMATE_MODE_DRY))
-    modes.add("dry");
+    root.add_value("dry");
   if (traits.supports_mode(CLIMATE_MODE_HEAT_COOL))
-    modes.add("heat_cool");
+    root.add_value("heat_cool");
+  root.end_array();
 
   if (traits.get_supports_two_point_target_temperature()) {
     // temperature_low_command_topic
-    root[MQTT_TEMPERATURE_LOW_COMMAND_TOPIC] = this->get_target_temperature_low_command_topic();
+    root.add(MQTT_TEMPERATURE_LOW_COMMAND_TOPIC, this->get_target_temperature_low_command_topic());
     // temperature_low_state_topic
-    root[MQTT_TEMPERATURE_LOW_STATE_TOPIC] = this->get_target_temperature_low_state_topic();
+    root.add(MQTT_TEMPERATURE_LOW_STATE_TOPIC, this->get_target_temperature_low_state_topic());
     // temperature_high_command_topic
-    root[MQTT_TEMPERATURE_HIGH_COMMAND_TOPIC] = this->get_target_temperature_high_command_topic();
+    root.add(MQTT_TEMPERATURE_HIGH_COMMAND_TOPIC, this->get_target_temperature_high_command_topic());
     // temperature_high_state_topic
-    root[MQTT_TEMPERATURE_HIGH_STATE_TOPIC] = this->get_target_temperature_high_state_topic();
+    root.add(MQTT_TEMPERATURE_HIGH_STATE_TOPIC, this->get_target_temperature_high_state_topic());
   } else {
     // temperature_command_topic
-    root[MQTT_TEMPERATURE_COMMAND_TOPIC] = this->get_target_temperature_command_topic();
+    root.add(MQTT_TEMPERATURE_COMMAND_TOPIC, this->get_target_temperature_command_topic());
     // temperature_state_topic
-    root[MQTT_TEMPERATURE_STATE_TOPIC] = this->get_target_temperature_state_topic();
+    root.add(MQTT_TEMPERATURE_STATE_TOPIC, this->get_target_temperature_state_topic());
   }
 
   // min_temp
-  root[MQTT_MIN_TEMP] = traits.get_visual_min_temperature();
+  root.add(MQTT_MIN_TEMP, traits.get_visual_min_temperature());
   // max_temp
-  root[MQTT_MAX_TEMP] = traits.get_visual_max_temperature();
+  root.add(MQTT_MAX_TEMP, traits.get_visual_max_temperature());
   // temp_step
-  root["temp_step"] = traits.get_visual_temperature_step();
+  root.add("temp_step", traits.get_visual_temperature_step());
   // temperature units are always coerced to Celsius internally
-  root[MQTT_TEMPERATURE_UNIT] = "C";
+  root.add(MQTT_TEMPERATURE_UNIT, "C");
 
   if (traits.supports_preset(CLIMATE_PRESET_AWAY)) {
     // away_mode_command_topic
-    root[MQTT_AWAY_MODE_COMMAND_TOPIC] = this->get_away_command_topic();
+    root.add(MQTT_AWAY_MODE_COMMAND_TOPIC, this->get_away_command_topic());
     // away_mode_state_topic
-    root[MQTT_AWAY_MODE_STATE_TOPIC] = this->get_away_state_topic();
+    root.add(MQTT_AWAY_MODE_STATE_TOPIC, this->get_away_state_topic());
   }
   if (traits.get_supports_action()) {
     // action_topic
-    root[MQTT_ACTION_TOPIC] = this->get_action_state_topic();
+    root.add(MQTT_ACTION_TOPIC, this->get_action_state_topic());
   }
 
   if (traits.get_supports_fan_modes() || !traits.get_supported_custom_fan_modes().empty()) {
     // fan_mode_command_topic
-    root[MQTT_FAN_MODE_COMMAND_TOPIC] = this->get_fan_mode_command_topic();
+    root.add(MQTT_FAN_MODE_COMMAND_TOPIC, this->get_fan_mode_command_topic());
     // fan_mode_state_topic
-    root[MQTT_FAN_MODE_STATE_TOPIC] = this->get_fan_mode_state_topic();
+    root.add(MQTT_FAN_MODE_STATE_TOPIC, this->get_fan_mode_state_topic());
     // fan_modes
-    JsonArray fan_modes = root.createNestedArray("fan_modes");
+    root.begin_array("fan_modes");
     if (traits.supports_fan_mode(CLIMATE_FAN_ON))
-      fan_modes.add("on");
+      root.add_value("on");
     if (traits.supports_fan_mode(CLIMATE_FAN_OFF))
-      fan_modes.add("off");
+      root.add_value("off");
     if (traits.supports_fan_mode(CLIMATE_FAN_AUTO))
-      fan_modes.add("auto");
+      root.add_value("auto");
     if (traits.supports_fan_mode(CLIMATE_FAN_LOW))
-      fan_modes.add("low");
+      root.add_value("low");
     if (traits.supports_fan_mode(CLIMATE_FAN_MEDIUM))
-      fan_modes.add("medium");
+      root.add_value("medium");
     if (traits.supports_fan_mode(CLIMATE_FAN_HIGH))
-      fan_modes.add("high");
+      root.add_value("high");
     if (traits.supports_fan_mode(CLIMATE_FAN_MIDDLE))
-      fan_modes.add("middle");
+      root.add_value("middle");
     if (traits.supports_fan_mode(CLIMATE_FAN_FOCUS))
-      fan_modes.add("focus");
+      root.add_value("focus");
     if (traits.supports_fan_mode(CLIMATE_FAN_DIFFUSE))
-      fan_modes.add("diffuse");
+      root.add_value("diffuse");
     for (const auto &fan_mode : traits.get_supported_custom_fan_modes())
-      fan_modes.add(fan_mode);
+      root.add_value(fan_mode);
+    root.end_array();
   }
 
   if (traits.get_supports_swing_modes()) {
     // swing_mode_command_topic
-    root[MQTT_SWING_MODE_COMMAND_TOPIC] = this->get_swing_mode_command_topic();
+    root.add(MQTT_SWING_MODE_COMMAND_TOPIC, this->get_swing_mode_command_topic());
     // swing_mode_state_topic
-    root[MQTT_SWING_MODE_STATE_TOPIC] = this->get_swing_mode_state_topic();
+    root.add(MQTT_SWING_MODE_STATE_TOPIC, this->get_swing_mode_state_topic());
     // swing_modes
-    JsonArray swing_modes = root.createNestedArray("swing_modes");
+    root.begin_array("swing_modes");
     if (traits.supports_swing_mode(CLIMATE_SWING_OFF))
-      swing_modes.add("off");
+      root.add_value("off");
     if (traits.supports_swing_mode(CLIMATE_SWING_BOTH))
-      swing_modes.add("both");
+      root.add_value("both");
     if (traits.supports_swing_mode(CLIMATE_SWING_VERTICAL))
-      swing_modes.add("vertical");
+      root.add_value("vertical");
     if (traits.supports_swing_mode(CLIMATE_SWING_HORIZONTAL))
-      swing_modes.add("horizontal");
+      root.add_value("horizontal");
+    root.end_array();
   }
 
   config.state_topic = false;
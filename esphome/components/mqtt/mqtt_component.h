@@ -49,7 +49,7 @@ struct SendDiscoveryConfig {
  *
  * In order to implement automatic Home Assistant discovery, all sub-classes should:
  *
- *  1. Implement send_discovery that creates a Home Assistant discovery payload.
+ *  1. Implement send_discovery that writes the component specific fields of the Home Assistant discovery payload.
  *  2. Override component_type() to return the appropriate component type such as "light" or "sensor".
  *  3. Subscribe to command topics using subscribe() or subscribe_json() during setup().
  *
@@ -69,8 +69,14 @@ class MQTTComponent : public Component {
 
   void call_dump_config() override;
 
-  /// Send discovery info the Home Assistant, override this.
-  virtual void send_discovery(JsonObject root, SendDiscoveryConfig &config) = 0;
+  /** Send discovery info the Home Assistant, override this.
+   *
+   * The fields are written into the payload directly. The default implementation builds them as a document with the
+   * JsonObject overload below instead, for components that haven't been ported yet.
+   */
+  virtual void send_discovery(json::JsonWriter &root, SendDiscoveryConfig &config);
+  /// Send discovery info the Home Assistant through a document, only used by the default JsonWriter overload.
+  virtual void send_discovery(JsonObject root, SendDiscoveryConfig &config) {}
 
   virtual bool send_initial_state() = 0;
 
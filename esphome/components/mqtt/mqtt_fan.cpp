@@ -106,15 +106,15 @@ void MQTTFanComponent::dump_config() {
 
 bool MQTTFanComponent::send_initial_state() { return this->publish_state(); }
 
-void MQTTFanComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
+void MQTTFanComponent::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
   if (this->state_->get_traits().supports_oscillation()) {
-    root[MQTT_OSCILLATION_COMMAND_TOPIC] = this->get_oscillation_command_topic();
-    root[MQTT_OSCILLATION_STATE_TOPIC] = this->get_oscillation_state_topic();
+    root.add(MQTT_OSCILLATION_COMMAND_TOPIC, this->get_oscillation_command_topic());
+    root.add(MQTT_OSCILLATION_STATE_TOPIC, this->get_oscillation_state_topic());
   }
   if (this->state_->get_traits().supports_speed()) {
-    root[MQTT_PERCENTAGE_COMMAND_TOPIC] = this->get_speed_level_command_topic();
-    root[MQTT_PERCENTAGE_STATE_TOPIC] = this->get_speed_level_state_topic();
-    root[MQTT_SPEED_RANGE_MAX] = this->state_->get_traits().supported_speed_count();
+    root.add(MQTT_PERCENTAGE_COMMAND_TOPIC, this->get_speed_level_command_topic());
+    root.add(MQTT_PERCENTAGE_STATE_TOPIC, this->get_speed_level_state_topic());
+    root.add(MQTT_SPEED_RANGE_MAX, this->state_->get_traits().supported_speed_count());
   }
 }
 bool MQTTFanComponent::publish_state() {
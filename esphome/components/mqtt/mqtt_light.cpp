@@ -31,45 +31,48 @@ void MQTTJSONLightComponent::setup() {
 MQTTJSONLightComponent::MQTTJSONLightComponent(LightState *state) : state_(state) {}
 
 bool MQTTJSONLightComponent::publish_state_() {
-  return this->publish_json(this->get_state_topic_(),
-                            [this](JsonObject root) { LightJSONSchema::dump_json(*this->state_, root); });
+  std::string payload =
+      json::write_json([this](json::JsonWriter &root) { LightJSONSchema::dump_json(*this->state_, root); });
+  return this->publish(this->get_state_topic_(), payload);
 }
 LightState *MQTTJSONLightComponent::get_state() const { return this->state_; }
 
-void MQTTJSONLightComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
-  root["schema"] = "json";
+void MQTTJSONLightComponent::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
+  root.add("schema", "json");
   auto traits = this->state_->get_traits();
 
-  root[MQTT_COLOR_MODE] = true;
-  JsonArray color_modes = root.createNestedArray("supported_color_modes");
+  root.add(MQTT_COLOR_MODE, true);
+  root.begin_array("supported_color_modes");
   if (traits.supports_color_mode(ColorMode::ON_OFF))
-    color_modes.add("onoff");
+    root.add_value("onoff");
   if (traits.supports_color_mode(ColorMode::BRIGHTNESS))
-    color_modes.add("brightness");
+    root.add_value("brightness");
   if (traits.supports_color_mode(ColorMode::WHITE))
-    color_modes.add("white");
+    root.add_value("white");
   if (traits.supports_color_mode(ColorMode::COLOR_TEMPERATURE) ||
       traits.supports_color_mode(ColorMode::COLD_WARM_WHITE))
-    color_modes.add("color_temp");
+    root.add_value("color_temp");
   if (traits.supports_color_mode(ColorMode::RGB))
-    color_modes.add("rgb");
+    root.add_value("rgb");
   if (traits.supports_color_mode(ColorMode::RGB_WHITE) ||
       // HA doesn't support RGBCT, and there's no CWWW->CT emulation in ESPHome yet, so ignore CT control for now
       traits.supports_color_mode(ColorMode::RGB_COLOR_TEMPERATURE))
-    color_modes.add("rgbw");
+    root.add_value("rgbw");
   if (traits.supports_color_mode(ColorMode::RGB_COLD_WARM_WHITE))
-    color_modes.add("rgbww");
+    root.add_value("rgbww");
+  root.end_array();
 
   // legacy API
   if (traits.supports_color_capability(ColorCapability::BRIGHTNESS))
-    root["brightness"] = true;
+    root.add("brightness", true);
 
   if (this->state_->supports_effects()) {
-    root["effect"] = true;
-    JsonArray effect_list = root.createNestedArray(MQTT_EFFECT_LIST);
+    root.add("effect", true);
+    root.begin_array(MQTT_EFFECT_LIST);
     for (auto *effect : this->state_->get_effects())
-      effect_list.add(effect->get_name());
-    effect_list.add("None");
+      root.add_value(effect->get_name());
+    root.add_value("None");
+    root.end_array();
   }
 }
 bool MQTTJSONLightComponent::send_initial_state() { return this->publish_state_(); }
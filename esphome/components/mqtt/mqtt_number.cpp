@@ -37,22 +37,22 @@ void MQTTNumberComponent::dump_config() {
 std::string MQTTNumberComponent::component_type() const { return "number"; }
 const EntityBase *MQTTNumberComponent::get_entity() const { return this->number_; }
 
-void MQTTNumberComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
+void MQTTNumberComponent::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
   const auto &traits = number_->traits;
   // https://www.home-assistant.io/integrations/number.mqtt/
-  root[MQTT_MIN] = traits.get_min_value();
-  root[MQTT_MAX] = traits.get_max_value();
-  root[MQTT_STEP] = traits.get_step();
+  root.add(MQTT_MIN, traits.get_min_value());
+  root.add(MQTT_MAX, traits.get_max_value());
+  root.add(MQTT_STEP, traits.get_step());
   if (!this->number_->traits.get_unit_of_measurement().empty())
-    root[MQTT_UNIT_OF_MEASUREMENT] = this->number_->traits.get_unit_of_measurement();
+    root.add(MQTT_UNIT_OF_MEASUREMENT, this->number_->traits.get_unit_of_measurement());
   switch (this->number_->traits.get_mode()) {
     case NUMBER_MODE_AUTO:
       break;
     case NUMBER_MODE_BOX:
-      root[MQTT_MODE] = "box";
+      root.add(MQTT_MODE, "box");
       break;
     case NUMBER_MODE_SLIDER:
-      root[MQTT_MODE] = "slider";
+      root.add(MQTT_MODE, "slider");
       break;
   }
 
@@ -32,12 +32,13 @@ void MQTTSelectComponent::dump_config() {
 std::string MQTTSelectComponent::component_type() const { return "select"; }
 const EntityBase *MQTTSelectComponent::get_entity() const { return this->select_; }
 
-void MQTTSelectComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
+void MQTTSelectComponent::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
   const auto &traits = select_->traits;
   // https://www.home-assistant.io/integrations/select.mqtt/
-  JsonArray options = root.createNestedArray(MQTT_OPTIONS);
+  root.begin_array(MQTT_OPTIONS);
   for (const auto &option : traits.get_options())
-    options.add(option);
+    root.add_value(option);
+  root.end_array();
 
   config.command_topic = true;
 }
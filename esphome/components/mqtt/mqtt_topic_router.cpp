@@ -0,0 +1,156 @@
+#include "mqtt_topic_router.h"
+
+#ifdef USE_MQTT
+
+#include "esphome/core/helpers.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace mqtt {
+
+static size_t level_length(const char *level) {
+  const char *separator = strchr(level, '/');
+  return separator == nullptr ? strlen(level) : separator - level;
+}
+
+static bool is_wildcard(const char *level, size_t len, char wildcard) { return len == 1 && *level == wildcard; }
+
+MQTTTopicRouter::NodeList::const_iterator MQTTTopicRouter::lower_bound_(const Node *node, const char *level,
+                                                                        size_t len) {
+  return std::lower_bound(node->children.begin(), node->children.end(), level,
+                          [len](const std::unique_ptr<Node> &child, const char *level) {
+                            return child->level.compare(0, std::string::npos, level, len) < 0;
+                          });
+}
+
+bool MQTTTopicRouter::is_level_(const NodeList::const_iterator &it, const Node *node, const char *level, size_t len) {
+  return it != node->children.end() && (*it)->level.compare(0, std::string::npos, level, len) == 0;
+}
+
+void MQTTTopicRouter::add(const std::string &filter, mqtt_callback_t callback) {
+  Node *node = &this->root_;
+  const char *level = filter.c_str();
+  while (true) {
+    const size_t len = level_length(level);
+    if (is_wildcard(level, len, '#')) {
+      // '#' has to be the last level of a filter
+      node->multi_level.push_back(make_unique<mqtt_callback_t>(std::move(callback)));
+      return;
+    }
+
+    if (is_wildcard(level, len, '+')) {
+      if (node->single_level == nullptr)
+        node->single_level = make_unique<Node>();
+      node = node->single_level.get();
+    } else {
+      auto it = lower_bound_(node, level, len);
+      if (!is_level_(it, node, level, len)) {
+        it = node->children.insert(it, make_unique<Node>());
+        (*it)->level.assign(level, len);
+      }
+      node = it->get();
+    }
+
+    if (level[len] == '\0')
+      break;
+    level += len + 1;
+  }
+  node->callbacks.push_back(make_unique<mqtt_callback_t>(std::move(callback)));
+}
+
+void MQTTTopicRouter::remove(const std::string &filter) { this->remove_(&this->root_, filter.c_str()); }
+
+void MQTTTopicRouter::remove_(Node *node, const char *level) {
+  const size_t len = level_length(level);
+  if (is_wildcard(level, len, '#')) {
+    this->retire_(node->multi_level);
+    return;
+  }
+
+  const bool single_level = is_wildcard(level, len, '+');
+  auto it = node->children.cend();
+  Node *child = nullptr;
+  if (single_level) {
+    child = node->single_level.get();
+  } else {
+    it = lower_bound_(node, level, len);
+    if (is_level_(it, node, level, len))
+      child = it->get();
+  }
+  if (child == nullptr)
+    return;
+
+  if (level[len] == '\0') {
+    this->retire_(child->callbacks);
+  } else {
+    this->remove_(child, level + len + 1);
+  }
+
+  // Prune the branches that aren't used by any filter anymore
+  if (!child->empty())
+    return;
+  if (single_level) {
+    node->single_level.reset();
+  } else {
+    node->children.erase(it);
+  }
+}
+
+void MQTTTopicRouter::retire_(CallbackList &callbacks) {
+  if (this->routing_depth_ != 0) {
+    for (auto &callback : callbacks)
+      this->retired_.push_back(std::move(callback));
+  }
+  callbacks.clear();
+}
+
+void MQTTTopicRouter::route(const std::string &topic, const std::string &payload) {
+  // The callbacks may add or remove subscriptions, which moves the callbacks removed meanwhile to retired_. A nested
+  // route() from a callback finds matches_ empty and collects into a new vector.
+  std::vector<const mqtt_callback_t *> matches;
+  matches.swap(this->matches_);
+  collect_(&this->root_, topic.c_str(), true, matches);
+  this->routing_depth_++;
+  for (const auto *callback : matches)
+    (*callback)(topic, payload);
+  this->routing_depth_--;
+  if (this->routing_depth_ == 0)
+    this->retired_.clear();
+  matches.clear();
+  this->matches_.swap(matches);
+}
+
+void MQTTTopicRouter::append_(const CallbackList &callbacks, std::vector<const mqtt_callback_t *> &out) {
+  for (const auto &callback : callbacks)
+    out.push_back(callback.get());
+}
+
+void MQTTTopicRouter::collect_(const Node *node, const char *level, bool first_level,
+                               std::vector<const mqtt_callback_t *> &out) {
+  if (level == nullptr) {
+    append_(node->callbacks, out);
+    // '#' also matches the parent level, "a/#" matches "a"
+    append_(node->multi_level, out);
+    return;
+  }
+
+  // Topics starting with '$' are reserved for the server and not matched by wildcards on the first level
+  const bool do_wildcards = !first_level || *level != '$';
+  if (do_wildcards)
+    append_(node->multi_level, out);
+
+  const size_t len = level_length(level);
+  const char *next = level[len] == '\0' ? nullptr : level + len + 1;
+  auto it = lower_bound_(node, level, len);
+  if (is_level_(it, node, level, len))
+    collect_(it->get(), next, false, out);
+  if (do_wildcards && node->single_level != nullptr)
+    collect_(node->single_level.get(), next, false, out);
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+/** Callback for MQTT subscriptions.
+ *
+ * First parameter is the topic, the second one is the payload.
+ */
+using mqtt_callback_t = std::function<void(const std::string &, const std::string &)>;
+
+/** Dispatches received messages to the callbacks of all matching topic filters.
+ *
+ * The filters are stored in a trie with one node per topic level, so routing a message takes time proportional to
+ * the number of levels in its topic instead of the number of subscriptions. The single level ('+') and multi level
+ * ('#') wildcards are supported as specified by MQTT 3.1.1, including that wildcards on the first level don't match
+ * topics starting with '$'.
+ */
+class MQTTTopicRouter {
+ public:
+  void add(const std::string &filter, mqtt_callback_t callback);
+  /// Remove all callbacks that were added for exactly this filter.
+  void remove(const std::string &filter);
+  /** Call the callbacks of all filters matching the topic.
+   *
+   * Callbacks that are removed by one of the called callbacks are still called for this message, added ones aren't.
+   */
+  void route(const std::string &topic, const std::string &payload);
+
+ protected:
+  /// Callbacks are kept on the heap, so that the pointers collected by route() stay valid while the nodes change.
+  using CallbackList = std::vector<std::unique_ptr<mqtt_callback_t>>;
+
+  struct Node {
+    std::string level;
+    /// Children for literal levels, sorted by level.
+    std::vector<std::unique_ptr<Node>> children;
+    /// Child for a '+' level.
+    std::unique_ptr<Node> single_level;
+    /// Callbacks of filters continuing with '#' after this node.
+    CallbackList multi_level;
+    /// Callbacks of filters ending at this node.
+    CallbackList callbacks;
+
+    bool empty() const {
+      return this->children.empty() && this->single_level == nullptr && this->multi_level.empty() &&
+             this->callbacks.empty();
+    }
+  };
+
+  using NodeList = std::vector<std::unique_ptr<Node>>;
+
+  /// Position of the child for the literal level, or where it would have to be inserted.
+  static NodeList::const_iterator lower_bound_(const Node *node, const char *level, size_t len);
+  static bool is_level_(const NodeList::const_iterator &it, const Node *node, const char *level, size_t len);
+  void remove_(Node *node, const char *level);
+  /// Move the callbacks out of the trie, to be destroyed once no route() uses them anymore.
+  void retire_(CallbackList &callbacks);
+  /// Append the callbacks of all filters below node matching the topic levels starting at level (nullptr once all
+  /// levels are consumed) to out.
+  static void collect_(const Node *node, const char *level, bool first_level,
+                       std::vector<const mqtt_callback_t *> &out);
+  static void append_(const CallbackList &callbacks, std::vector<const mqtt_callback_t *> &out);
+
+  Node root_;
+  /// Matches of the last route(), only kept to reuse the allocation.
+  std::vector<const mqtt_callback_t *> matches_;
+  /// Callbacks removed while routing a message.
+  CallbackList retired_;
+  /// Number of route() calls in progress.
+  uint8_t routing_depth_{0};
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -101,6 +101,14 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
   }
 
  protected:
+  void fill_pixel_buffer_(light::ESPPixelBuffer *buffer) const {
+    buffer->data = this->controller_->Pixels();
+    for (uint8_t i = 0; i < 4; i++)
+      buffer->offsets[i] = this->rgb_offsets_[i];
+    buffer->effect_data = this->effect_data_;
+    buffer->correction = &this->correction_;
+  }
+
   NeoPixelBus<T_COLOR_FEATURE, T_METHOD> *controller_{nullptr};
   uint8_t *effect_data_{nullptr};
   uint8_t rgb_offsets_[4]{0, 1, 2, 3};
@@ -121,6 +129,11 @@ class NeoPixelRGBLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COL
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                nullptr, this->effect_data_ + index, &this->correction_);
   }
+  bool get_pixel_buffer_(light::ESPPixelBuffer *buffer) const override {
+    this->fill_pixel_buffer_(buffer);
+    buffer->stride = 3;
+    return true;
+  }
 };
 
 template<typename T_METHOD, typename T_COLOR_FEATURE = NeoRgbwFeature>
@@ -138,6 +151,11 @@ class NeoPixelRGBWLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_CO
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                base + this->rgb_offsets_[3], this->effect_data_ + index, &this->correction_);
   }
+  bool get_pixel_buffer_(light::ESPPixelBuffer *buffer) const override {
+    this->fill_pixel_buffer_(buffer);
+    buffer->stride = 4;
+    return true;
+  }
 };
 
 }  // namespace neopixelbus
@@ -2,7 +2,10 @@ from esphome.cpp_generator import RawExpression
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
+from esphome.components.esp32 import get_esp32_variant
+from esphome.components.esp32.const import VARIANT_ESP32
 from esphome.const import (
+    CONF_DELTA_UPDATES,
     CONF_ID,
     CONF_NUM_ATTEMPTS,
     CONF_PASSWORD,
@@ -22,6 +25,7 @@ CONF_ON_BEGIN = "on_begin"
 CONF_ON_PROGRESS = "on_progress"
 CONF_ON_END = "on_end"
 CONF_ON_ERROR = "on_error"
+CONF_WINDOW_SIZE = "window_size"
 
 ota_ns = cg.esphome_ns.namespace("ota")
 OTAState = ota_ns.enum("OTAState")
@@ -35,12 +39,23 @@ OTAEndTrigger = ota_ns.class_("OTAEndTrigger", automation.Trigger.template())
 OTAErrorTrigger = ota_ns.class_("OTAErrorTrigger", automation.Trigger.template())
 
 
+def validate_delta_updates(value):
+    value = cv.boolean(value)
+    if value and (not CORE.is_esp32 or get_esp32_variant() != VARIANT_ESP32):
+        raise cv.Invalid("Delta updates are only supported on the original ESP32")
+    return value
+
+
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(OTAComponent),
         cv.Optional(CONF_SAFE_MODE, default=True): cv.boolean,
         cv.SplitDefault(CONF_PORT, esp8266=8266, esp32=3232): cv.port,
+        cv.SplitDefault(CONF_WINDOW_SIZE, esp8266="4kB", esp32="16kB"): cv.All(
+            cv.validate_bytes, cv.int_range(min=2048, max=65536)
+        ),
         cv.Optional(CONF_PASSWORD): cv.string,
+        cv.Optional(CONF_DELTA_UPDATES, default=False): validate_delta_updates,
         cv.Optional(
             CONF_REBOOT_TIMEOUT, default="5min"
         ): cv.positive_time_period_milliseconds,
@@ -78,10 +93,14 @@ CONFIG_SCHEMA = cv.Schema(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_window_size(config[CONF_WINDOW_SIZE]))
     if CONF_PASSWORD in config:
         cg.add(var.set_auth_password(config[CONF_PASSWORD]))
         cg.add_define("USE_OTA_PASSWORD")
 
+    if config[CONF_DELTA_UPDATES]:
+        cg.add_define("USE_OTA_DELTA")
+
     await cg.register_component(var, config)
 
     if config[CONF_SAFE_MODE]:
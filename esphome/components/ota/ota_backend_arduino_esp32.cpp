@@ -6,13 +6,29 @@
 #include "ota_backend.h"
 
 #include <Update.h>
+#include <esp_ota_ops.h>
 
 namespace esphome {
 namespace ota {
 
+bool ArduinoESP32OTABackend::supports_compression() {
+#ifdef USE_ESP32_VARIANT_ESP32
+  return GzipInflater::has_enough_memory();
+#else
+  return false;
+#endif
+}
+
 OTAResponseTypes ArduinoESP32OTABackend::begin(size_t image_size) {
-  bool ret = Update.begin(image_size, U_FLASH);
+  // The size of a compressed image isn't known up front, Update erases the partition while writing
+  const esp_partition_t *partition = esp_ota_get_next_update_partition(nullptr);
+  if (partition != nullptr && image_size > partition->size)
+    return OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE;
+
+  bool ret = Update.begin(UPDATE_SIZE_UNKNOWN, U_FLASH);
   if (ret) {
+    this->md5_.init();
+    this->bytes_received_ = 0;
     return OTA_RESPONSE_OK;
   }
 
@@ -22,10 +38,35 @@ OTAResponseTypes ArduinoESP32OTABackend::begin(size_t image_size) {
   return OTA_RESPONSE_ERROR_UNKNOWN;
 }
 
-void ArduinoESP32OTABackend::set_update_md5(const char *md5) { Update.setMD5(md5); }
+void ArduinoESP32OTABackend::set_update_md5(const char *md5) { memcpy(this->expected_bin_md5_, md5, 32); }
 
 OTAResponseTypes ArduinoESP32OTABackend::write(uint8_t *data, size_t len) {
-  size_t written = Update.write(data, len);
+  // The checksum covers the data as it was sent, compressed or not
+  this->md5_.add(data, len);
+#ifdef USE_ESP32_VARIANT_ESP32
+  if (this->bytes_received_ == 0 && GzipInflater::is_gzip(data, len)) {
+    this->inflater_ = make_unique<GzipInflater>();
+    if (!this->inflater_->init())
+      return OTA_RESPONSE_ERROR_UNKNOWN;
+  }
+  this->bytes_received_ += len;
+  if (this->inflater_ != nullptr) {
+    bool ok = this->inflater_->feed(data, len, [this](const uint8_t *out, size_t out_len) {
+      this->inflate_error_ = this->write_flash_(out, out_len);
+      return this->inflate_error_ == OTA_RESPONSE_OK;
+    });
+    if (!ok)
+      return this->inflate_error_ != OTA_RESPONSE_OK ? this->inflate_error_ : OTA_RESPONSE_ERROR_MAGIC;
+    return OTA_RESPONSE_OK;
+  }
+#else
+  this->bytes_received_ += len;
+#endif
+  return this->write_flash_(data, len);
+}
+
+OTAResponseTypes ArduinoESP32OTABackend::write_flash_(const uint8_t *data, size_t len) {
+  size_t written = Update.write(const_cast<uint8_t *>(data), len);
   if (written != len) {
     return OTA_RESPONSE_ERROR_WRITING_FLASH;
   }
@@ -33,12 +74,28 @@ OTAResponseTypes ArduinoESP32OTABackend::write(uint8_t *data, size_t len) {
 }
 
 OTAResponseTypes ArduinoESP32OTABackend::end() {
-  if (!Update.end())
+  this->md5_.calculate();
+  bool valid = this->md5_.equals_hex(this->expected_bin_md5_);
+#ifdef USE_ESP32_VARIANT_ESP32
+  valid = valid && (this->inflater_ == nullptr || this->inflater_->is_done());
+  this->inflater_.reset();
+#endif
+  if (!valid) {
+    Update.abort();
+    return OTA_RESPONSE_ERROR_UPDATE_END;
+  }
+  // The image size is only known now, finish with what has been written
+  if (!Update.end(true))
     return OTA_RESPONSE_ERROR_UPDATE_END;
   return OTA_RESPONSE_OK;
 }
 
-void ArduinoESP32OTABackend::abort() { Update.abort(); }
+void ArduinoESP32OTABackend::abort() {
+  Update.abort();
+#ifdef USE_ESP32_VARIANT_ESP32
+  this->inflater_.reset();
+#endif
+}
 
 }  // namespace ota
 }  // namespace esphome
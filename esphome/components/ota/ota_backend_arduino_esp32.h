@@ -4,6 +4,10 @@
 
 #include "ota_component.h"
 #include "ota_backend.h"
+#include "ota_gzip.h"
+#include "esphome/components/md5/md5.h"
+
+#include <memory>
 
 namespace esphome {
 namespace ota {
@@ -15,7 +19,18 @@ class ArduinoESP32OTABackend : public OTABackend {
   OTAResponseTypes write(uint8_t *data, size_t len) override;
   OTAResponseTypes end() override;
   void abort() override;
-  bool supports_compression() override { return false; }
+  bool supports_compression() override;
+
+ protected:
+  OTAResponseTypes write_flash_(const uint8_t *data, size_t len);
+
+  md5::MD5Digest md5_{};
+  char expected_bin_md5_[32];
+  size_t bytes_received_{0};
+#ifdef USE_ESP32_VARIANT_ESP32
+  std::unique_ptr<GzipInflater> inflater_;
+  OTAResponseTypes inflate_error_{OTA_RESPONSE_OK};
+#endif
 };
 
 }  // namespace ota
@@ -0,0 +1,226 @@
+#include "ota_backend_delta.h"
+#ifdef USE_OTA_DELTA
+
+#include "esphome/components/md5/md5.h"
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+#include <esp_image_format.h>
+#include <esp_ota_ops.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.delta";
+
+static const uint8_t PATCH_MAGIC[4] = {'E', 'O', 'D', '1'};
+static const size_t PATCH_HEADER_SIZE = 44;
+static const uint8_t OP_COPY = 0x00;
+static const uint8_t OP_INSERT = 0x01;
+static const size_t OUTPUT_BUFFER_SIZE = 4096;
+
+static char s_running_md5[33];       // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t s_running_size = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static uint32_t decode_uint32(const uint8_t *data) { return encode_uint32(data[0], data[1], data[2], data[3]); }
+
+bool DeltaOTABackend::get_running_image_md5(char *output) {
+  if (s_running_size == 0) {
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    if (running == nullptr)
+      return false;
+    const esp_partition_pos_t pos = {running->address, running->size};
+    esp_image_metadata_t metadata;
+    if (esp_image_verify(ESP_IMAGE_VERIFY_SILENT, &pos, &metadata) != ESP_OK) {
+      ESP_LOGW(TAG, "Running firmware image is invalid");
+      return false;
+    }
+
+    md5::MD5Digest md5{};
+    md5.init();
+    uint8_t buf[1024];
+    for (uint32_t offset = 0; offset < metadata.image_len; offset += sizeof(buf)) {
+      const size_t len = std::min<size_t>(sizeof(buf), metadata.image_len - offset);
+      if (esp_partition_read(running, offset, buf, len) != ESP_OK)
+        return false;
+      md5.add(buf, len);
+      App.feed_wdt();
+    }
+    md5.calculate();
+    md5.get_hex(s_running_md5);
+    s_running_md5[32] = '\0';
+    s_running_size = metadata.image_len;
+    ESP_LOGD(TAG, "Running firmware: %u bytes, MD5 %s", s_running_size, s_running_md5);
+  }
+  memcpy(output, s_running_md5, sizeof(s_running_md5));
+  return true;
+}
+
+OTAResponseTypes DeltaOTABackend::begin(size_t image_size) {
+  char md5[33];
+  this->running_ = esp_ota_get_running_partition();
+  this->output_.reset(new (std::nothrow) uint8_t[OUTPUT_BUFFER_SIZE]);  // NOLINT(cppcoreguidelines-owning-memory)
+  if (this->running_ == nullptr || this->output_ == nullptr || !get_running_image_md5(md5))
+    return OTA_RESPONSE_ERROR_UNKNOWN;
+  // The size of the new image is only known once the patch header has been received
+  return this->backend_->begin(image_size);
+}
+
+OTAResponseTypes DeltaOTABackend::write(uint8_t *data, size_t len) {
+  if (this->first_write_) {
+    this->first_write_ = false;
+    if (GzipInflater::is_gzip(data, len)) {
+      this->inflater_ = make_unique<GzipInflater>();
+      if (!this->inflater_->init())
+        return OTA_RESPONSE_ERROR_UNKNOWN;
+    }
+  }
+  if (this->inflater_ == nullptr)
+    return this->apply_(data, len);
+
+  bool ok = this->inflater_->feed(data, len, [this](const uint8_t *out, size_t out_len) {
+    this->inflate_error_ = this->apply_(out, out_len);
+    return this->inflate_error_ == OTA_RESPONSE_OK;
+  });
+  if (!ok)
+    return this->inflate_error_ != OTA_RESPONSE_OK ? this->inflate_error_ : OTA_RESPONSE_ERROR_INVALID_DELTA;
+  return OTA_RESPONSE_OK;
+}
+
+size_t DeltaOTABackend::pending_header_size_() const {
+  if (this->state_ == STATE_HEADER)
+    return PATCH_HEADER_SIZE;
+  // Type, length and, for copies, the offset in the old image
+  return this->header_len_ > 0 && this->header_[0] == OP_COPY ? 9 : 5;
+}
+
+OTAResponseTypes DeltaOTABackend::apply_(const uint8_t *data, size_t len) {
+  while (len > 0) {
+    if (this->state_ == STATE_HEADER || this->state_ == STATE_OPERATION) {
+      const size_t n = std::min(this->pending_header_size_() - this->header_len_, len);
+      memcpy(this->header_ + this->header_len_, data, n);
+      this->header_len_ += n;
+      data += n;
+      len -= n;
+      // The size of an operation header is only known after its first byte
+      if (this->header_len_ < this->pending_header_size_())
+        continue;
+
+      OTAResponseTypes res = this->state_ == STATE_HEADER ? this->parse_header_() : this->parse_operation_();
+      this->header_len_ = 0;
+      if (res != OTA_RESPONSE_OK)
+        return res;
+      continue;
+    }
+    if (this->state_ == STATE_DONE) {
+      ESP_LOGW(TAG, "Unexpected data after the end of the patch");
+      return OTA_RESPONSE_ERROR_INVALID_DELTA;
+    }
+
+    const size_t n = std::min({len, static_cast<size_t>(this->op_remaining_), OUTPUT_BUFFER_SIZE - this->output_len_});
+    uint8_t *out = this->output_.get() + this->output_len_;
+    if (this->state_ == STATE_COPY) {
+      if (esp_partition_read(this->running_, this->copy_offset_, out, n) != ESP_OK)
+        return OTA_RESPONSE_ERROR_UNKNOWN;
+      for (size_t i = 0; i < n; i++)
+        out[i] += data[i];
+      this->copy_offset_ += n;
+    } else {
+      memcpy(out, data, n);
+    }
+    data += n;
+    len -= n;
+    this->output_len_ += n;
+    this->op_remaining_ -= n;
+    this->produced_ += n;
+
+    if (this->output_len_ == OUTPUT_BUFFER_SIZE) {
+      OTAResponseTypes res = this->flush_();
+      if (res != OTA_RESPONSE_OK)
+        return res;
+    }
+    if (this->op_remaining_ == 0)
+      this->state_ = this->produced_ == this->new_size_ ? STATE_DONE : STATE_OPERATION;
+  }
+  return OTA_RESPONSE_OK;
+}
+
+OTAResponseTypes DeltaOTABackend::parse_header_() {
+  if (memcmp(this->header_, PATCH_MAGIC, sizeof(PATCH_MAGIC)) != 0) {
+    ESP_LOGW(TAG, "Invalid patch header");
+    return OTA_RESPONSE_ERROR_INVALID_DELTA;
+  }
+  this->old_size_ = decode_uint32(this->header_ + 4);
+  this->new_size_ = decode_uint32(this->header_ + 8);
+  if (this->old_size_ != s_running_size || memcmp(this->header_ + 12, s_running_md5, 32) != 0) {
+    ESP_LOGW(TAG, "Patch doesn't apply to the running firmware");
+    return OTA_RESPONSE_ERROR_INVALID_DELTA;
+  }
+  if (this->new_size_ == 0)
+    return OTA_RESPONSE_ERROR_INVALID_DELTA;
+  ESP_LOGD(TAG, "Applying patch, new image is %u bytes", this->new_size_);
+  this->state_ = STATE_OPERATION;
+  return OTA_RESPONSE_OK;
+}
+
+OTAResponseTypes DeltaOTABackend::parse_operation_() {
+  const uint8_t type = this->header_[0];
+  this->op_remaining_ = decode_uint32(this->header_ + 1);
+  if (this->op_remaining_ == 0 || this->op_remaining_ > this->new_size_ - this->produced_) {
+    ESP_LOGW(TAG, "Invalid patch operation length %u", this->op_remaining_);
+    return OTA_RESPONSE_ERROR_INVALID_DELTA;
+  }
+  if (type == OP_INSERT) {
+    this->state_ = STATE_INSERT;
+    return OTA_RESPONSE_OK;
+  }
+  if (type != OP_COPY) {
+    ESP_LOGW(TAG, "Invalid patch operation 0x%02X", type);
+    return OTA_RESPONSE_ERROR_INVALID_DELTA;
+  }
+  this->copy_offset_ = decode_uint32(this->header_ + 5);
+  if (this->copy_offset_ > this->old_size_ || this->op_remaining_ > this->old_size_ - this->copy_offset_) {
+    ESP_LOGW(TAG, "Patch copies outside of the running firmware");
+    return OTA_RESPONSE_ERROR_INVALID_DELTA;
+  }
+  this->state_ = STATE_COPY;
+  return OTA_RESPONSE_OK;
+}
+
+OTAResponseTypes DeltaOTABackend::flush_() {
+  if (this->output_len_ == 0)
+    return OTA_RESPONSE_OK;
+  OTAResponseTypes res = this->backend_->write(this->output_.get(), this->output_len_);
+  this->output_len_ = 0;
+  return res;
+}
+
+OTAResponseTypes DeltaOTABackend::end() {
+  OTAResponseTypes res = this->flush_();
+  if (res == OTA_RESPONSE_OK && this->state_ != STATE_DONE) {
+    ESP_LOGW(TAG, "Patch ended after %u of %u bytes", this->produced_, this->new_size_);
+    res = OTA_RESPONSE_ERROR_INVALID_DELTA;
+  }
+  if (res != OTA_RESPONSE_OK) {
+    this->abort();
+    return res;
+  }
+  this->inflater_.reset();
+  this->output_.reset();
+  return this->backend_->end();
+}
+
+void DeltaOTABackend::abort() {
+  this->inflater_.reset();
+  this->output_.reset();
+  this->backend_->abort();
+}
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_OTA_DELTA
@@ -0,0 +1,73 @@
+#pragma once
+#include "esphome/core/defines.h"
+#ifdef USE_OTA_DELTA
+
+#include "ota_component.h"
+#include "ota_backend.h"
+#include "ota_gzip.h"
+
+#include <esp_partition.h>
+#include <memory>
+
+namespace esphome {
+namespace ota {
+
+/** Applies a delta update against the running firmware and passes the resulting image on to another backend.
+ *
+ * The patch (usually gzip compressed) starts with a header: magic "EOD1", the sizes of the old and the new image (4
+ * bytes MSB first each) and the MD5 of the old image as 32 hex characters. It's followed by operations that each
+ * start with a type byte and a length (4 bytes MSB first):
+ *  - COPY: offset in the old image (4 bytes MSB first), followed by length bytes that are added to the old data.
+ *  - INSERT: followed by length bytes of new data.
+ *
+ * The MD5 passed to set_update_md5() is the one of the new image, it's verified by the wrapped backend.
+ */
+class DeltaOTABackend : public OTABackend {
+ public:
+  explicit DeltaOTABackend(std::unique_ptr<OTABackend> backend) : backend_(std::move(backend)) {}
+
+  /// Get the MD5 of the running firmware image as 32 hex characters (plus null terminator). Only computed once, as
+  /// the whole image has to be read.
+  static bool get_running_image_md5(char *output);
+
+  OTAResponseTypes begin(size_t image_size) override;
+  void set_update_md5(const char *md5) override { this->backend_->set_update_md5(md5); }
+  OTAResponseTypes write(uint8_t *data, size_t len) override;
+  OTAResponseTypes end() override;
+  void abort() override;
+  bool supports_compression() override { return this->backend_->supports_compression(); }
+
+ protected:
+  enum State { STATE_HEADER, STATE_OPERATION, STATE_COPY, STATE_INSERT, STATE_DONE };
+
+  OTAResponseTypes apply_(const uint8_t *data, size_t len);
+  /// Number of bytes of the header or operation header currently being read.
+  size_t pending_header_size_() const;
+  OTAResponseTypes parse_header_();
+  OTAResponseTypes parse_operation_();
+  OTAResponseTypes flush_();
+
+  std::unique_ptr<OTABackend> backend_;
+  const esp_partition_t *running_{nullptr};
+  std::unique_ptr<GzipInflater> inflater_;
+  OTAResponseTypes inflate_error_{OTA_RESPONSE_OK};
+  bool first_write_{true};
+
+  State state_{STATE_HEADER};
+  uint8_t header_[44];
+  size_t header_len_{0};
+  uint32_t old_size_{0};
+  uint32_t new_size_{0};
+  /// Number of bytes of the new image produced so far.
+  uint32_t produced_{0};
+  uint32_t copy_offset_{0};
+  uint32_t op_remaining_{0};
+
+  std::unique_ptr<uint8_t[]> output_;
+  size_t output_len_{0};
+};
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_OTA_DELTA
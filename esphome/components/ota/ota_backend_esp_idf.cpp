@@ -4,17 +4,38 @@
 #include "ota_backend_esp_idf.h"
 #include "ota_component.h"
 #include <esp_ota_ops.h>
+#include <esp_idf_version.h>
 #include "esphome/components/md5/md5.h"
 
 namespace esphome {
 namespace ota {
 
+// The size of a compressed image isn't known up front, the partition is erased while writing instead
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 2, 0) && defined(USE_ESP32_VARIANT_ESP32)
+#define IDF_OTA_DECOMPRESS
+#endif
+
+bool IDFOTABackend::supports_compression() {
+#ifdef IDF_OTA_DECOMPRESS
+  return GzipInflater::has_enough_memory();
+#else
+  return false;
+#endif
+}
+
 OTAResponseTypes IDFOTABackend::begin(size_t image_size) {
   this->partition_ = esp_ota_get_next_update_partition(nullptr);
   if (this->partition_ == nullptr) {
     return OTA_RESPONSE_ERROR_NO_UPDATE_PARTITION;
   }
+  if (image_size > this->partition_->size) {
+    return OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE;
+  }
+#ifdef IDF_OTA_DECOMPRESS
+  esp_err_t err = esp_ota_begin(this->partition_, OTA_WITH_SEQUENTIAL_WRITES, &this->update_handle_);
+#else
   esp_err_t err = esp_ota_begin(this->partition_, image_size, &this->update_handle_);
+#endif
   if (err != ESP_OK) {
     esp_ota_abort(this->update_handle_);
     this->update_handle_ = 0;
@@ -26,14 +47,39 @@ OTAResponseTypes IDFOTABackend::begin(size_t image_size) {
     return OTA_RESPONSE_ERROR_UNKNOWN;
   }
   this->md5_.init();
+  this->bytes_received_ = 0;
   return OTA_RESPONSE_OK;
 }
 
 void IDFOTABackend::set_update_md5(const char *expected_md5) { memcpy(this->expected_bin_md5_, expected_md5, 32); }
 
 OTAResponseTypes IDFOTABackend::write(uint8_t *data, size_t len) {
-  esp_err_t err = esp_ota_write(this->update_handle_, data, len);
+  // The checksum covers the data as it was sent, compressed or not
   this->md5_.add(data, len);
+#ifdef IDF_OTA_DECOMPRESS
+  if (this->bytes_received_ == 0 && GzipInflater::is_gzip(data, len)) {
+    this->inflater_ = make_unique<GzipInflater>();
+    if (!this->inflater_->init())
+      return OTA_RESPONSE_ERROR_UNKNOWN;
+  }
+  this->bytes_received_ += len;
+  if (this->inflater_ != nullptr) {
+    bool ok = this->inflater_->feed(data, len, [this](const uint8_t *out, size_t out_len) {
+      this->inflate_error_ = this->write_flash_(out, out_len);
+      return this->inflate_error_ == OTA_RESPONSE_OK;
+    });
+    if (!ok)
+      return this->inflate_error_ != OTA_RESPONSE_OK ? this->inflate_error_ : OTA_RESPONSE_ERROR_MAGIC;
+    return OTA_RESPONSE_OK;
+  }
+#else
+  this->bytes_received_ += len;
+#endif
+  return this->write_flash_(data, len);
+}
+
+OTAResponseTypes IDFOTABackend::write_flash_(const uint8_t *data, size_t len) {
+  esp_err_t err = esp_ota_write(this->update_handle_, data, len);
   if (err != ESP_OK) {
     if (err == ESP_ERR_OTA_VALIDATE_FAILED) {
       return OTA_RESPONSE_ERROR_MAGIC;
@@ -51,6 +97,14 @@ OTAResponseTypes IDFOTABackend::end() {
     this->abort();
     return OTA_RESPONSE_ERROR_UPDATE_END;
   }
+#ifdef IDF_OTA_DECOMPRESS
+  bool truncated = this->inflater_ != nullptr && !this->inflater_->is_done();
+  this->inflater_.reset();
+  if (truncated) {
+    this->abort();
+    return OTA_RESPONSE_ERROR_UPDATE_END;
+  }
+#endif
   esp_err_t err = esp_ota_end(this->update_handle_);
   this->update_handle_ = 0;
   if (err == ESP_OK) {
@@ -71,6 +125,9 @@ OTAResponseTypes IDFOTABackend::end() {
 void IDFOTABackend::abort() {
   esp_ota_abort(this->update_handle_);
   this->update_handle_ = 0;
+#ifdef IDF_OTA_DECOMPRESS
+  this->inflater_.reset();
+#endif
 }
 
 }  // namespace ota
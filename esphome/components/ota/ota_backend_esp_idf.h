@@ -4,9 +4,12 @@
 
 #include "ota_component.h"
 #include "ota_backend.h"
+#include "ota_gzip.h"
 #include <esp_ota_ops.h>
 #include "esphome/components/md5/md5.h"
 
+#include <memory>
+
 namespace esphome {
 namespace ota {
 
@@ -17,13 +20,20 @@ class IDFOTABackend : public OTABackend {
   OTAResponseTypes write(uint8_t *data, size_t len) override;
   OTAResponseTypes end() override;
   void abort() override;
-  bool supports_compression() override { return false; }
+  bool supports_compression() override;
 
  private:
+  OTAResponseTypes write_flash_(const uint8_t *data, size_t len);
+
   esp_ota_handle_t update_handle_{0};
   const esp_partition_t *partition_;
   md5::MD5Digest md5_{};
   char expected_bin_md5_[32];
+  size_t bytes_received_{0};
+#ifdef USE_ESP32_VARIANT_ESP32
+  std::unique_ptr<GzipInflater> inflater_;
+  OTAResponseTypes inflate_error_{OTA_RESPONSE_OK};
+#endif
 };
 
 }  // namespace ota
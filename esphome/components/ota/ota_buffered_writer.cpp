@@ -0,0 +1,130 @@
+#include "ota_buffered_writer.h"
+
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+#include <new>
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.writer";
+
+#ifdef USE_ESP32
+
+bool OTABufferedWriter::init() {
+  this->free_queue_ = xQueueCreate(BLOCK_COUNT, sizeof(uint8_t *));
+  this->filled_queue_ = xQueueCreate(BLOCK_COUNT + 1, sizeof(Block));
+  this->task_done_ = xSemaphoreCreateBinary();
+  if (this->free_queue_ == nullptr || this->filled_queue_ == nullptr || this->task_done_ == nullptr)
+    return false;
+
+  for (auto &block : this->blocks_) {
+    block = new (std::nothrow) uint8_t[this->block_size_];  // NOLINT(cppcoreguidelines-owning-memory)
+    if (block == nullptr) {
+      ESP_LOGW(TAG, "Not enough memory for a %u byte block", this->block_size_);
+      return false;
+    }
+    xQueueSend(this->free_queue_, &block, 0);
+  }
+
+  // Same priority as the loop task so that neither starves the other, but the writer may run on the other core
+  BaseType_t res = xTaskCreate(&OTABufferedWriter::writer_task, "ota_writer", 8192, this,
+                               uxTaskPriorityGet(nullptr), &this->task_);
+  if (res != pdPASS) {
+    this->task_ = nullptr;
+    ESP_LOGW(TAG, "Could not start writer task");
+    return false;
+  }
+  return true;
+}
+
+OTABufferedWriter::~OTABufferedWriter() {
+  if (this->task_ != nullptr) {
+    // Lets the task finish the pending writes before it stops
+    Block stop{nullptr, 0};
+    xQueueSend(this->filled_queue_, &stop, portMAX_DELAY);
+    xSemaphoreTake(this->task_done_, portMAX_DELAY);
+  }
+  if (this->free_queue_ != nullptr)
+    vQueueDelete(this->free_queue_);
+  if (this->filled_queue_ != nullptr)
+    vQueueDelete(this->filled_queue_);
+  if (this->task_done_ != nullptr)
+    vSemaphoreDelete(this->task_done_);
+  for (auto *block : this->blocks_)
+    delete[] block;  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+void OTABufferedWriter::writer_task(void *arg) {
+  auto *writer = reinterpret_cast<OTABufferedWriter *>(arg);
+  Block block;
+  while (xQueueReceive(writer->filled_queue_, &block, portMAX_DELAY) == pdTRUE && block.data != nullptr) {
+    // Once a write failed the update is aborted, just hand the remaining blocks back
+    if (writer->error_ == OTA_RESPONSE_OK) {
+      OTAResponseTypes res = writer->backend_->write(block.data, block.len);
+      if (res != OTA_RESPONSE_OK)
+        writer->error_ = res;
+    }
+    xQueueSend(writer->free_queue_, &block.data, portMAX_DELAY);
+  }
+  xSemaphoreGive(writer->task_done_);
+  vTaskDelete(nullptr);
+}
+
+uint8_t *OTABufferedWriter::acquire() {
+  uint8_t *block = nullptr;
+  while (xQueueReceive(this->free_queue_, &block, pdMS_TO_TICKS(100)) != pdTRUE)
+    App.feed_wdt();
+  if (this->error_ != OTA_RESPONSE_OK) {
+    xQueueSend(this->free_queue_, &block, 0);
+    return nullptr;
+  }
+  return block;
+}
+
+void OTABufferedWriter::submit(uint8_t *block, size_t len) {
+  Block filled{block, len};
+  xQueueSend(this->filled_queue_, &filled, portMAX_DELAY);
+}
+
+OTAResponseTypes OTABufferedWriter::flush() {
+  // Every block acquired so far has been submitted, wait until the writer task handed all of them back
+  while (uxQueueMessagesWaiting(this->free_queue_) < BLOCK_COUNT) {
+    App.feed_wdt();
+    vTaskDelay(1);
+  }
+  return this->error_;
+}
+
+#else  // !USE_ESP32
+
+bool OTABufferedWriter::init() {
+  this->block_.reset(new (std::nothrow) uint8_t[this->block_size_]);  // NOLINT(cppcoreguidelines-owning-memory)
+  if (this->block_ == nullptr) {
+    ESP_LOGW(TAG, "Not enough memory for a %u byte block", this->block_size_);
+    return false;
+  }
+  return true;
+}
+
+OTABufferedWriter::~OTABufferedWriter() = default;
+
+uint8_t *OTABufferedWriter::acquire() {
+  if (this->error_ != OTA_RESPONSE_OK)
+    return nullptr;
+  return this->block_.get();
+}
+
+void OTABufferedWriter::submit(uint8_t *block, size_t len) {
+  OTAResponseTypes res = this->backend_->write(block, len);
+  if (res != OTA_RESPONSE_OK)
+    this->error_ = res;
+}
+
+OTAResponseTypes OTABufferedWriter::flush() { return this->error_; }
+
+#endif  // USE_ESP32
+
+}  // namespace ota
+}  // namespace esphome
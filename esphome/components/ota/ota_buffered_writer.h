@@ -0,0 +1,72 @@
+#pragma once
+
+#include "ota_component.h"
+#include "ota_backend.h"
+#include "esphome/core/defines.h"
+
+#include <memory>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+namespace ota {
+
+/** Hands the received update data to the backend in blocks.
+ *
+ * On ESP32 the blocks are written by a separate task, so that the next block can be received from the network while
+ * the previous one is being written to flash (and decompressed). On other platforms a single block is written
+ * synchronously.
+ */
+class OTABufferedWriter {
+ public:
+  OTABufferedWriter(OTABackend *backend, size_t block_size) : backend_(backend), block_size_(block_size) {}
+  ~OTABufferedWriter();
+
+  /// Allocate the blocks (and start the writer task), returns false if there's not enough memory.
+  bool init();
+
+  /// Get an empty block to receive into, waits for a pending write if required.
+  /// Returns nullptr if a write has failed, see get_error().
+  uint8_t *acquire();
+  /// Queue the first len bytes of a block returned by acquire() for writing.
+  void submit(uint8_t *block, size_t len);
+  /// Wait until all submitted blocks are written, returns the first error.
+  OTAResponseTypes flush();
+
+  OTAResponseTypes get_error() const { return this->error_; }
+  size_t get_block_size() const { return this->block_size_; }
+
+ protected:
+  OTABackend *backend_;
+  size_t block_size_;
+  volatile OTAResponseTypes error_{OTA_RESPONSE_OK};
+
+#ifdef USE_ESP32
+  static const uint8_t BLOCK_COUNT = 2;
+
+  struct Block {
+    uint8_t *data;
+    size_t len;
+  };
+
+  static void writer_task(void *arg);
+
+  uint8_t *blocks_[BLOCK_COUNT]{};
+  /// Blocks available to the receiving side.
+  QueueHandle_t free_queue_{nullptr};
+  /// Blocks waiting to be written, a block without data stops the task.
+  QueueHandle_t filled_queue_{nullptr};
+  SemaphoreHandle_t task_done_{nullptr};
+  TaskHandle_t task_{nullptr};
+#else
+  std::unique_ptr<uint8_t[]> block_;
+#endif
+};
+
+}  // namespace ota
+}  // namespace esphome
@@ -1,7 +1,9 @@
 #include "ota_component.h"
 #include "ota_backend.h"
+#include "ota_buffered_writer.h"
 #include "ota_backend_arduino_esp32.h"
 #include "ota_backend_arduino_esp8266.h"
+#include "ota_backend_delta.h"
 #include "ota_backend_esp_idf.h"
 
 #include "esphome/core/log.h"
@@ -19,7 +21,8 @@ namespace ota {
 
 static const char *const TAG = "ota";
 
-static const uint8_t OTA_VERSION_1_0 = 1;
+/// Version 2 announces a window size after the binary MD5 and acknowledges the received data in chunks.
+static const uint8_t OTA_VERSION_2_0 = 2;
 
 std::unique_ptr<OTABackend> make_ota_backend() {
 #ifdef USE_ARDUINO
@@ -36,7 +39,7 @@ std::unique_ptr<OTABackend> make_ota_backend() {
 }
 
 void OTAComponent::setup() {
-  server_ = socket::socket_ip(SOCK_STREAM, 0);
+  server_ = socket::socket_ip_loop_monitored(SOCK_STREAM, 0);
   if (server_ == nullptr) {
     ESP_LOGW(TAG, "Could not create socket.");
     this->mark_failed();
@@ -84,6 +87,7 @@ void OTAComponent::setup() {
 void OTAComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Over-The-Air Updates:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->port_);
+  ESP_LOGCONFIG(TAG, "  Window Size: %u bytes", this->window_size_);
 #ifdef USE_OTA_PASSWORD
   if (!this->password_.empty()) {
     ESP_LOGCONFIG(TAG, "  Using Password.");
@@ -108,17 +112,25 @@ void OTAComponent::loop() {
 }
 
 static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
+static const uint8_t FEATURE_SUPPORTS_DELTA = 0x02;
+
+static const uint8_t OTA_UPDATE_DELTA = 0x01;
 
 void OTAComponent::handle_() {
   OTAResponseTypes error_code = OTA_RESPONSE_ERROR_UNKNOWN;
   bool update_started = false;
   size_t total = 0;
-  uint32_t last_progress = 0;
-  uint8_t buf[1024];
+  uint32_t start_time;
+  uint32_t last_progress;
+  uint32_t elapsed;
+  uint8_t buf[128];
   char *sbuf = reinterpret_cast<char *>(buf);
   size_t ota_size;
   uint8_t ota_features;
   std::unique_ptr<OTABackend> backend;
+  std::unique_ptr<OTABufferedWriter> writer;
+  uint8_t *block = nullptr;
+  size_t block_len = 0;
   (void) ota_features;
 
   if (client_ == nullptr) {
@@ -156,7 +168,7 @@ void OTAComponent::handle_() {
 
   // Send OK and version - 2 bytes
   buf[0] = OTA_RESPONSE_OK;
-  buf[1] = OTA_VERSION_1_0;
+  buf[1] = OTA_VERSION_2_0;
   this->writeall_(buf, 2);
 
   backend = make_ota_backend();
@@ -177,6 +189,31 @@ void OTAComponent::handle_() {
 
   this->writeall_(buf, 1);
 
+  if ((ota_features & FEATURE_SUPPORTS_DELTA) != 0) {
+    // Offer a delta update - 1 byte, followed by the MD5 of the running firmware (32 bytes hex) if supported.
+    // A delta is always sent compressed.
+    buf[0] = OTA_RESPONSE_HEADER_OK;
+#ifdef USE_OTA_DELTA
+    if (backend->supports_compression() && DeltaOTABackend::get_running_image_md5(sbuf + 1))
+      buf[0] = OTA_RESPONSE_SUPPORTS_DELTA;
+#endif
+    this->writeall_(buf, buf[0] == OTA_RESPONSE_SUPPORTS_DELTA ? 33 : 1);
+
+    if (buf[0] == OTA_RESPONSE_SUPPORTS_DELTA) {
+      // Read update type - 1 byte, full image (0) or delta (1). The client computes the patch before sending it.
+      if (!this->readall_(buf, 1, 30000)) {
+        ESP_LOGW(TAG, "Reading update type failed!");
+        goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+      }
+#ifdef USE_OTA_DELTA
+      if (buf[0] == OTA_UPDATE_DELTA) {
+        ESP_LOGD(TAG, "Receiving delta update");
+        backend = make_unique<DeltaOTABackend>(std::move(backend));
+      }
+#endif
+    }
+  }
+
 #ifdef USE_OTA_PASSWORD
   if (!this->password_.empty()) {
     buf[0] = OTA_RESPONSE_REQUEST_AUTH;
@@ -270,14 +307,38 @@ void OTAComponent::handle_() {
   ESP_LOGV(TAG, "Update: Binary MD5 is %s", sbuf);
   backend->set_update_md5(sbuf);
 
+  // Received data is written in blocks of half the window, so one block can be received while the other one is
+  // being written
+  writer = make_unique<OTABufferedWriter>(backend.get(), this->window_size_ / 2);
+  if (!writer->init()) {
+    ESP_LOGW(TAG, "Allocating receive buffers failed!");
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+  }
+
   // Acknowledge MD5 OK - 1 byte
   buf[0] = OTA_RESPONSE_BIN_MD5_OK;
   this->writeall_(buf, 1);
 
+  // Send window size, 4 bytes MSB first
+  for (uint8_t i = 0; i < 4; i++)
+    buf[i] = this->window_size_ >> (24 - i * 8);
+  this->writeall_(buf, 4);
+
+  start_time = last_progress = millis();
   while (total < ota_size) {
     // TODO: timeout check
-    size_t requested = std::min(sizeof(buf), ota_size - total);
-    ssize_t read = this->client_->read(buf, requested);
+    if (block == nullptr) {
+      block = writer->acquire();
+      block_len = 0;
+      if (block == nullptr) {
+        ESP_LOGW(TAG, "Error writing binary data to flash!");
+        error_code = writer->get_error();
+        goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+      }
+    }
+
+    size_t requested = std::min(writer->get_block_size() - block_len, ota_size - total);
+    ssize_t read = this->client_->read(block + block_len, requested);
     if (read == -1) {
       if (errno == EAGAIN || errno == EWOULDBLOCK) {
         App.feed_wdt();
@@ -293,19 +354,26 @@ void OTAComponent::handle_() {
       ESP_LOGW(TAG, "Remote end closed connection");
       goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
     }
+    block_len += read;
+    total += read;
 
-    error_code = backend->write(buf, read);
-    if (error_code != OTA_RESPONSE_OK) {
-      ESP_LOGW(TAG, "Error writing binary data to flash!");
-      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    if (block_len == writer->get_block_size() || total == ota_size) {
+      writer->submit(block, block_len);
+      block = nullptr;
+
+      // Acknowledge chunk - 1 byte, followed by the number of bytes received so far, 4 bytes MSB first
+      buf[0] = OTA_RESPONSE_CHUNK_OK;
+      for (uint8_t i = 0; i < 4; i++)
+        buf[i + 1] = total >> (24 - i * 8);
+      this->writeall_(buf, 5);
     }
-    total += read;
 
     uint32_t now = millis();
     if (now - last_progress > 1000) {
       last_progress = now;
       float percentage = (total * 100.0f) / ota_size;
-      ESP_LOGD(TAG, "OTA in progress: %0.1f%%", percentage);
+      // bytes per millisecond are kB/s
+      ESP_LOGD(TAG, "OTA in progress: %0.1f%% (%.1f kB/s)", percentage, total / float(now - start_time));
 #ifdef USE_OTA_STATE_CALLBACK
       this->state_callback_.call(OTA_IN_PROGRESS, percentage, 0);
 #endif
@@ -315,6 +383,15 @@ void OTAComponent::handle_() {
     }
   }
 
+  error_code = writer->flush();
+  if (error_code != OTA_RESPONSE_OK) {
+    ESP_LOGW(TAG, "Error writing binary data to flash!");
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+  }
+  writer.reset();
+  elapsed = std::max<uint32_t>(millis() - start_time, 1);
+  ESP_LOGI(TAG, "Received %u bytes in %.1fs (%.1f kB/s)", total, elapsed / 1000.0f, total / float(elapsed));
+
   // Acknowledge receive OK - 1 byte
   buf[0] = OTA_RESPONSE_RECEIVE_OK;
   this->writeall_(buf, 1);
@@ -352,6 +429,8 @@ error:
   this->client_->close();
   this->client_ = nullptr;
 
+  // Stop writing before the update is aborted
+  writer.reset();
   if (backend != nullptr && update_started) {
     backend->abort();
   }
@@ -362,12 +441,12 @@ error:
 #endif
 }
 
-bool OTAComponent::readall_(uint8_t *buf, size_t len) {
+bool OTAComponent::readall_(uint8_t *buf, size_t len, uint32_t timeout) {
   uint32_t start = millis();
   uint32_t at = 0;
   while (len - at > 0) {
     uint32_t now = millis();
-    if (now - start > 1000) {
+    if (now - start > timeout) {
       ESP_LOGW(TAG, "Timed out reading %d bytes of data", len);
       return false;
     }
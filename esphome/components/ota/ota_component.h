@@ -20,6 +20,8 @@ enum OTAResponseTypes {
   OTA_RESPONSE_RECEIVE_OK = 68,
   OTA_RESPONSE_UPDATE_END_OK = 69,
   OTA_RESPONSE_SUPPORTS_COMPRESSION = 70,
+  OTA_RESPONSE_CHUNK_OK = 71,
+  OTA_RESPONSE_SUPPORTS_DELTA = 72,
 
   OTA_RESPONSE_ERROR_MAGIC = 128,
   OTA_RESPONSE_ERROR_UPDATE_PREPARE = 129,
@@ -32,6 +34,7 @@ enum OTAResponseTypes {
   OTA_RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136,
   OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137,
   OTA_RESPONSE_ERROR_NO_UPDATE_PARTITION = 138,
+  OTA_RESPONSE_ERROR_INVALID_DELTA = 139,
   OTA_RESPONSE_ERROR_UNKNOWN = 255,
 };
 
@@ -46,6 +49,8 @@ class OTAComponent : public Component {
 
   /// Manually set the port OTA should listen on.
   void set_port(uint16_t port);
+  /// Set how many bytes the client may send ahead of the acknowledgements.
+  void set_window_size(uint32_t window_size) { this->window_size_ = window_size; }
 
   bool should_enter_safe_mode(uint8_t num_attempts, uint32_t enable_time);
 
@@ -75,7 +80,7 @@ class OTAComponent : public Component {
   uint32_t read_rtc_();
 
   void handle_();
-  bool readall_(uint8_t *buf, size_t len);
+  bool readall_(uint8_t *buf, size_t len, uint32_t timeout = 1000);
   bool writeall_(const uint8_t *buf, size_t len);
 
 #ifdef USE_OTA_PASSWORD
@@ -83,6 +88,7 @@ class OTAComponent : public Component {
 #endif  // USE_OTA_PASSWORD
 
   uint16_t port_;
+  uint32_t window_size_{4096};
 
   std::unique_ptr<socket::Socket> server_;
   std::unique_ptr<socket::Socket> client_;
@@ -0,0 +1,129 @@
+#include "ota_gzip.h"
+
+#if defined(USE_ESP32) && defined(USE_ESP32_VARIANT_ESP32)
+
+#include "esphome/core/log.h"
+
+#include <esp_heap_caps.h>
+#include <new>
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.gzip";
+
+static const uint8_t GZIP_METHOD_DEFLATE = 8;
+static const uint8_t GZIP_FLAG_HCRC = 0x02;
+static const uint8_t GZIP_FLAG_EXTRA = 0x04;
+static const uint8_t GZIP_FLAG_NAME = 0x08;
+static const uint8_t GZIP_FLAG_COMMENT = 0x10;
+static const size_t GZIP_MAX_HEADER_SIZE = 16384;
+
+GzipInflater::~GzipInflater() {
+  delete this->decompressor_;  // NOLINT(cppcoreguidelines-owning-memory)
+  delete[] this->dictionary_;  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+bool GzipInflater::has_enough_memory() {
+  // Some headroom for the receive buffers and the network stack
+  return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) >= TINFL_LZ_DICT_SIZE &&
+         heap_caps_get_free_size(MALLOC_CAP_8BIT) >= TINFL_LZ_DICT_SIZE + sizeof(tinfl_decompressor) + 16384;
+}
+
+bool GzipInflater::init() {
+  this->decompressor_ = new (std::nothrow) tinfl_decompressor;  // NOLINT(cppcoreguidelines-owning-memory)
+  this->dictionary_ = new (std::nothrow) uint8_t[TINFL_LZ_DICT_SIZE];  // NOLINT(cppcoreguidelines-owning-memory)
+  if (this->decompressor_ == nullptr || this->dictionary_ == nullptr) {
+    ESP_LOGW(TAG, "Not enough memory to decompress the update");
+    return false;
+  }
+  tinfl_init(this->decompressor_);
+  return true;
+}
+
+bool GzipInflater::feed(const uint8_t *data, size_t len, const OutputCallback &output) {
+  if (this->state_ == STATE_DEFLATE)
+    return this->inflate_(data, len, output);
+  if (this->state_ == STATE_DONE)
+    return true;  // gzip trailer
+
+  this->header_.insert(this->header_.end(), data, data + len);
+  int header_len = this->parse_header_();
+  if (header_len < 0 || (header_len == 0 && this->header_.size() > GZIP_MAX_HEADER_SIZE)) {
+    ESP_LOGW(TAG, "Invalid gzip header");
+    return false;
+  }
+  if (header_len == 0)
+    return true;
+
+  ESP_LOGD(TAG, "Decompressing gzip stream");
+  std::vector<uint8_t> header;
+  header.swap(this->header_);
+  this->state_ = STATE_DEFLATE;
+  return this->inflate_(header.data() + header_len, header.size() - header_len, output);
+}
+
+int GzipInflater::parse_header_() const {
+  const auto &header = this->header_;
+  if (header.size() < 10)
+    return 0;
+  if (header[0] != 0x1F || header[1] != 0x8B || header[2] != GZIP_METHOD_DEFLATE)
+    return -1;
+
+  const uint8_t flags = header[3];
+  size_t pos = 10;
+  if (flags & GZIP_FLAG_EXTRA) {
+    if (header.size() < pos + 2)
+      return 0;
+    pos += 2 + (header[pos] | (header[pos + 1] << 8));
+  }
+  for (uint8_t flag : {GZIP_FLAG_NAME, GZIP_FLAG_COMMENT}) {
+    if ((flags & flag) == 0)
+      continue;
+    // Zero-terminated string
+    while (pos < header.size() && header[pos] != 0)
+      pos++;
+    if (pos >= header.size())
+      return 0;
+    pos++;
+  }
+  if (flags & GZIP_FLAG_HCRC)
+    pos += 2;
+  if (header.size() < pos)
+    return 0;
+  return pos;
+}
+
+bool GzipInflater::inflate_(const uint8_t *data, size_t len, const OutputCallback &output) {
+  while (this->state_ == STATE_DEFLATE) {
+    size_t in_bytes = len;
+    size_t out_bytes = TINFL_LZ_DICT_SIZE - this->dictionary_offset_;
+    // The dictionary is used as a ring buffer, so the output has to be consumed before the next call
+    tinfl_status status =
+        tinfl_decompress(this->decompressor_, data, &in_bytes, this->dictionary_,
+                         this->dictionary_ + this->dictionary_offset_, &out_bytes, TINFL_FLAG_HAS_MORE_INPUT);
+    data += in_bytes;
+    len -= in_bytes;
+
+    if (out_bytes > 0) {
+      if (!output(this->dictionary_ + this->dictionary_offset_, out_bytes))
+        return false;
+      this->dictionary_offset_ = (this->dictionary_offset_ + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+    }
+
+    if (status == TINFL_STATUS_DONE) {
+      this->state_ = STATE_DONE;
+    } else if (status < TINFL_STATUS_DONE) {
+      ESP_LOGW(TAG, "Decompression failed: %d", status);
+      return false;
+    } else if (status == TINFL_STATUS_NEEDS_MORE_INPUT && len == 0) {
+      return true;
+    }
+  }
+  return true;
+}
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_ESP32 && USE_ESP32_VARIANT_ESP32
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#if defined(USE_ESP32) && defined(USE_ESP32_VARIANT_ESP32)
+
+#include <esp_system.h>
+#if ESP_IDF_VERSION_MAJOR >= 4
+#include <esp32/rom/miniz.h>
+#else
+#include <rom/miniz.h>
+#endif
+
+#include <functional>
+#include <vector>
+
+namespace esphome {
+namespace ota {
+
+/** Streaming decompression of a gzip compressed update, using the inflate implementation in the ESP32 ROM.
+ *
+ * Needs a 32kB dictionary (which doubles as output buffer) and about 11kB of decompressor state on the heap. The
+ * CRC-32 in the gzip trailer isn't checked, the MD5 of the compressed stream is verified by the backend instead.
+ */
+class GzipInflater {
+ public:
+  using OutputCallback = std::function<bool(const uint8_t *data, size_t len)>;
+
+  ~GzipInflater();
+
+  static bool is_gzip(const uint8_t *data, size_t len) { return len >= 2 && data[0] == 0x1F && data[1] == 0x8B; }
+  /// Whether there's enough heap left to decompress an update.
+  static bool has_enough_memory();
+
+  bool init();
+  /// Decompress the next part of the stream, the output is passed to the callback in one or more chunks.
+  /// Returns false if the data is invalid or the callback failed.
+  bool feed(const uint8_t *data, size_t len, const OutputCallback &output);
+  bool is_done() const { return this->state_ == STATE_DONE; }
+
+ protected:
+  enum State { STATE_HEADER, STATE_DEFLATE, STATE_DONE };
+
+  /// Returns the length of the gzip header in header_, 0 if it isn't complete yet and -1 if it's invalid.
+  int parse_header_() const;
+  bool inflate_(const uint8_t *data, size_t len, const OutputCallback &output);
+
+  State state_{STATE_HEADER};
+  std::vector<uint8_t> header_;
+  tinfl_decompressor *decompressor_{nullptr};
+  uint8_t *dictionary_{nullptr};
+  size_t dictionary_offset_{0};
+};
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_ESP32 && USE_ESP32_VARIANT_ESP32
@@ -0,0 +1,204 @@
+#include "log_store.h"
+#include "esphome/core/log.h"
+
+#include <cstring>
+
+namespace esphome {
+namespace preferences {
+
+static const char *const TAG = "preferences.log_store";
+
+static const uint32_t SECTOR_MAGIC = 0x314C5345;      // "ESL1"
+static const uint32_t SECTOR_COMMITTED = 0x54494D43;  // "CMIT"
+static const uint32_t SECTOR_HEADER_SIZE = 12;
+static const uint32_t RECORD_MAGIC = 0x5AA5;
+static const uint32_t ERASED_WORD = 0xFFFFFFFF;
+
+static uint32_t crc32_words(const uint32_t *data, size_t words) {
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < words * 4; i++) {
+    crc ^= bytes[i];
+    for (uint8_t j = 0; j < 8; j++)
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  return ~crc;
+}
+
+bool LogStore::load() {
+  this->entries_.clear();
+
+  int32_t newest = -1;
+  for (uint32_t sector = 0; sector < this->sector_count_; sector++) {
+    uint32_t header[3];
+    if (!this->flash_->read(sector * this->sector_size_, header, 3))
+      continue;
+    if (header[0] != SECTOR_MAGIC || header[2] != SECTOR_COMMITTED)
+      continue;
+    if (newest == -1 || static_cast<int32_t>(header[1] - this->sequence_) > 0) {
+      newest = sector;
+      this->sequence_ = header[1];
+    }
+  }
+
+  if (newest == -1) {
+    ESP_LOGD(TAG, "No preferences stored yet");
+    // The first sync() starts the ring at sector 0
+    this->sequence_ = 0;
+    this->active_sector_ = this->sector_count_ - 1;
+    this->active_offset_ = this->sector_size_;
+    return false;
+  }
+
+  this->active_sector_ = newest;
+  this->active_offset_ = this->replay_sector_(newest);
+  ESP_LOGD(TAG, "Loaded %u preferences from sector %u (sequence %u, %u bytes used)", this->entries_.size(),
+           this->active_sector_, this->sequence_, this->active_offset_);
+  return true;
+}
+
+uint32_t LogStore::replay_sector_(uint32_t sector) {
+  const size_t words = this->sector_size_ / 4;
+  std::vector<uint32_t> buffer(words);
+  if (!this->flash_->read(sector * this->sector_size_, buffer.data(), words))
+    return this->sector_size_;
+
+  size_t pos = SECTOR_HEADER_SIZE / 4;
+  while (pos + 3 <= words) {
+    const uint32_t head = buffer[pos];
+    if (head == ERASED_WORD)
+      return pos * 4;
+    if ((head & 0xFFFF) != RECORD_MAGIC)
+      break;
+    const size_t len = head >> 16;
+    const size_t data_words = (len + 3) / 4;
+    if (pos + 3 + data_words > words)
+      break;
+    if (crc32_words(&buffer[pos], 2 + data_words) != buffer[pos + 2 + data_words])
+      break;
+
+    const auto *data = reinterpret_cast<const uint8_t *>(&buffer[pos + 2]);
+    Entry *entry = this->find_(buffer[pos + 1]);
+    if (entry == nullptr) {
+      this->entries_.push_back(Entry{buffer[pos + 1], false, {}});
+      entry = &this->entries_.back();
+    }
+    entry->data.assign(data, data + len);
+    pos += 3 + data_words;
+  }
+
+  // Full sector, or a record that was torn by a reset: never append after it
+  if (pos + 3 <= words)
+    ESP_LOGW(TAG, "Invalid record at offset %u of sector %u", pos * 4, sector);
+  return this->sector_size_;
+}
+
+LogStore::Entry *LogStore::find_(uint32_t key) {
+  for (auto &entry : this->entries_) {
+    if (entry.key == key)
+      return &entry;
+  }
+  return nullptr;
+}
+
+bool LogStore::get(uint32_t key, uint8_t *data, size_t len) const {
+  for (const auto &entry : this->entries_) {
+    if (entry.key != key)
+      continue;
+    if (entry.data.size() != len)
+      return false;
+    memcpy(data, entry.data.data(), len);
+    return true;
+  }
+  return false;
+}
+
+void LogStore::set(uint32_t key, const uint8_t *data, size_t len) {
+  Entry *entry = this->find_(key);
+  if (entry == nullptr) {
+    this->entries_.push_back(Entry{key, true, std::vector<uint8_t>(data, data + len)});
+    return;
+  }
+  if (entry->data.size() == len && memcmp(entry->data.data(), data, len) == 0)
+    return;
+  entry->data.assign(data, data + len);
+  entry->pending = true;
+}
+
+bool LogStore::has_pending() const {
+  for (const auto &entry : this->entries_) {
+    if (entry.pending)
+      return true;
+  }
+  return false;
+}
+
+bool LogStore::sync() {
+  for (auto &entry : this->entries_) {
+    if (!entry.pending)
+      continue;
+    const uint32_t size = record_size(entry.data.size());
+    if (this->active_offset_ + size > this->sector_size_)
+      return this->rollover_();
+    if (!this->write_record_(this->active_sector_ * this->sector_size_ + this->active_offset_, entry)) {
+      // The record might be torn, continue in the next sector
+      this->active_offset_ = this->sector_size_;
+      return false;
+    }
+    this->active_offset_ += size;
+    entry.pending = false;
+  }
+  return true;
+}
+
+bool LogStore::write_record_(uint32_t address, const Entry &entry) {
+  const size_t len = entry.data.size();
+  std::vector<uint32_t> record(3 + (len + 3) / 4, 0);
+  record[0] = (len << 16) | RECORD_MAGIC;
+  record[1] = entry.key;
+  memcpy(&record[2], entry.data.data(), len);
+  record.back() = crc32_words(record.data(), record.size() - 1);
+  this->bytes_written_ += record.size() * 4;
+  return this->flash_->write(address, record.data(), record.size());
+}
+
+bool LogStore::rollover_() {
+  const uint32_t sector = (this->active_sector_ + 1) % this->sector_count_;
+  const uint32_t base = sector * this->sector_size_;
+  ESP_LOGV(TAG, "Compacting preferences into sector %u", sector);
+  if (!this->flash_->erase_sector(sector)) {
+    ESP_LOGW(TAG, "Erasing sector %u failed", sector);
+    return false;
+  }
+  this->erase_count_++;
+
+  const uint32_t header[2] = {SECTOR_MAGIC, this->sequence_ + 1};
+  if (!this->flash_->write(base, header, 2))
+    return false;
+  uint32_t offset = SECTOR_HEADER_SIZE;
+  for (const auto &entry : this->entries_) {
+    const uint32_t size = record_size(entry.data.size());
+    if (offset + size > this->sector_size_) {
+      ESP_LOGE(TAG, "Preferences don't fit in a single sector!");
+      return false;
+    }
+    if (!this->write_record_(base + offset, entry))
+      return false;
+    offset += size;
+  }
+  // Only now the new sector takes precedence over the previous one
+  const uint32_t commit = SECTOR_COMMITTED;
+  if (!this->flash_->write(base + 8, &commit, 1))
+    return false;
+  this->bytes_written_ += SECTOR_HEADER_SIZE;
+
+  this->active_sector_ = sector;
+  this->active_offset_ = offset;
+  this->sequence_++;
+  for (auto &entry : this->entries_)
+    entry.pending = false;
+  return true;
+}
+
+}  // namespace preferences
+}  // namespace esphome
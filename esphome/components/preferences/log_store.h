@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace preferences {
+
+/// Flash access used by LogStore. Addresses are byte offsets relative to the first sector of the store and are always
+/// word aligned.
+class LogStoreFlash {
+ public:
+  virtual bool erase_sector(uint32_t sector) = 0;
+  virtual bool write(uint32_t address, const uint32_t *data, size_t words) = 0;
+  virtual bool read(uint32_t address, uint32_t *data, size_t words) = 0;
+};
+
+/** Append-only preference store spread over a ring of flash sectors.
+ *
+ * Every changed value is appended to the active sector as a record with its own CRC, so a sync only writes the
+ * values that changed. When the active sector is full, the next sector of the ring is erased and a snapshot of all
+ * values is written to it before it becomes active; erases are therefore spread evenly over all sectors and the
+ * previous sector stays valid until the snapshot is complete.
+ *
+ * Sector layout: magic, sequence number, commit marker (written once the snapshot is complete), records.
+ * Record layout: length (upper 16 bits) and record magic, key, data padded to whole words, CRC-32 of all of these.
+ */
+class LogStore {
+ public:
+  LogStore(LogStoreFlash *flash, uint32_t sector_size, uint32_t sector_count)
+      : flash_(flash), sector_size_(sector_size), sector_count_(sector_count) {}
+
+  /// Scan the sectors once and build the in-RAM index with the latest value of every key.
+  /// Returns false if the store doesn't contain any data yet.
+  bool load();
+
+  /// Copy the value of the given key to data, fails if the key isn't stored or has a different length.
+  bool get(uint32_t key, uint8_t *data, size_t len) const;
+  /// Stage a new value for the given key, it's written with the next sync() if it differs from the stored one.
+  void set(uint32_t key, const uint8_t *data, size_t len);
+  bool has_pending() const;
+
+  /// Append records for all changed values to flash.
+  bool sync();
+
+  uint32_t get_erase_count() const { return this->erase_count_; }
+  uint32_t get_bytes_written() const { return this->bytes_written_; }
+
+ protected:
+  struct Entry {
+    uint32_t key;
+    bool pending;
+    std::vector<uint8_t> data;
+  };
+
+  Entry *find_(uint32_t key);
+  /// Replay the records of the given sector into the index, returns the offset after the last valid record.
+  uint32_t replay_sector_(uint32_t sector);
+  bool write_record_(uint32_t address, const Entry &entry);
+  /// Start the next sector of the ring with a snapshot of all values.
+  bool rollover_();
+
+  static uint32_t record_size(size_t len) { return 12 + ((len + 3) & ~3u); }
+
+  LogStoreFlash *flash_;
+  uint32_t sector_size_;
+  uint32_t sector_count_;
+  std::vector<Entry> entries_;
+  uint32_t active_sector_{0};
+  /// Byte offset of the next record in the active sector, sector_size_ if a rollover is required.
+  uint32_t active_offset_{0};
+  uint32_t sequence_{0};
+  uint32_t erase_count_{0};
+  uint32_t bytes_written_{0};
+};
+
+}  // namespace preferences
+}  // namespace esphome
@@ -70,7 +70,7 @@ class MideaProtocol : public RemoteProtocol<MideaData> {
 class MideaBinarySensor : public RemoteReceiverBinarySensorBase {
  public:
   bool matches(RemoteReceiveData src) override {
-    auto data = MideaProtocol().decode(src);
+    auto data = RemoteDecodeCache<MideaProtocol, MideaData>::decode(src);
     return data.has_value() && data.value() == this->data_;
   }
   void set_code(const std::vector<uint8_t> &code) { this->data_ = code; }
@@ -6,6 +6,8 @@ namespace remote_base {
 
 static const char *const TAG = "remote.rc_switch";
 
+static const uint8_t DECODE_CACHE_SIZE = 4;
+
 const RCSwitchBase RC_SWITCH_PROTOCOLS[9] = {RCSwitchBase(0, 0, 0, 0, 0, 0, false),
                                              RCSwitchBase(350, 10850, 350, 1050, 1050, 350, false),
                                              RCSwitchBase(650, 6500, 650, 1300, 1300, 650, false),
@@ -238,10 +240,46 @@ uint64_t decode_binary_string_mask(const std::string &data) {
   return ret;
 }
 
+bool RCSwitchRawReceiver::decode_cached_(const RCSwitchBase &protocol, RemoteReceiveData &src, uint64_t *out_data,
+                                         uint8_t *out_nbits) {
+  struct DecodeResult {
+    uint32_t signal_id;
+    RCSwitchBase protocol;
+    bool valid;
+    uint64_t data;
+    uint8_t nbits;
+  };
+  // Receivers usually share few protocols, keep the results of the last ones used
+  static DecodeResult results[DECODE_CACHE_SIZE] = {};
+  static uint8_t next_result = 0;
+
+  const uint32_t signal_id = src.get_signal_id();
+  if (signal_id == 0)
+    return protocol.decode(src, out_data, out_nbits);
+
+  DecodeResult *result = nullptr;
+  for (auto &r : results) {
+    if (r.signal_id == signal_id && r.protocol == protocol) {
+      result = &r;
+      break;
+    }
+  }
+  if (result == nullptr) {
+    result = &results[next_result];
+    next_result = (next_result + 1) % DECODE_CACHE_SIZE;
+    result->signal_id = signal_id;
+    result->protocol = protocol;
+    result->valid = protocol.decode(src, &result->data, &result->nbits);
+  }
+  *out_data = result->data;
+  *out_nbits = result->nbits;
+  return result->valid;
+}
+
 bool RCSwitchRawReceiver::matches(RemoteReceiveData src) {
   uint64_t decoded_code;
   uint8_t decoded_nbits;
-  if (!this->protocol_.decode(src, &decoded_code, &decoded_nbits))
+  if (!decode_cached_(this->protocol_, src, &decoded_code, &decoded_nbits))
     return false;
 
   return decoded_nbits == this->nbits_ && (decoded_code & this->mask_) == (this->code_ & this->mask_);
@@ -50,6 +50,12 @@ class RCSwitchBase {
 
   static void type_d_code(uint8_t group, uint8_t device, bool state, uint64_t *out_code, uint8_t *out_nbits);
 
+  bool operator==(const RCSwitchBase &rhs) const {
+    return sync_high_ == rhs.sync_high_ && sync_low_ == rhs.sync_low_ && zero_high_ == rhs.zero_high_ &&
+           zero_low_ == rhs.zero_low_ && one_high_ == rhs.one_high_ && one_low_ == rhs.one_low_ &&
+           inverted_ == rhs.inverted_;
+  }
+
  protected:
   uint32_t sync_high_{};
   uint32_t sync_low_{};
@@ -201,6 +207,9 @@ class RCSwitchRawReceiver : public RemoteReceiverBinarySensorBase {
 
  protected:
   bool matches(RemoteReceiveData src) override;
+  /// Decode the signal with the protocol, sharing the result with all receivers using the same protocol.
+  static bool decode_cached_(const RCSwitchBase &protocol, RemoteReceiveData &src, uint64_t *out_data,
+                             uint8_t *out_nbits);
 
   RCSwitchBase protocol_;
   uint64_t code_;
@@ -24,6 +24,14 @@ void RemoteRMTChannel::config_rmt(rmt_config_t &rmt) {
 }
 #endif
 
+uint32_t RemoteReceiverBase::next_signal_id_() {
+  static uint32_t last_signal_id = 0;
+  // 0 is used for unknown signals, skip it on overflow
+  if (++last_signal_id == 0)
+    last_signal_id = 1;
+  return last_signal_id;
+}
+
 void RemoteReceiverBinarySensorBase::dump_config() { LOG_BINARY_SENSOR("", "Remote Receiver Binary Sensor", this); }
 
 void RemoteTransmitterBase::send_(uint32_t send_times, uint32_t send_wait) {
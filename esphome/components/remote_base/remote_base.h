@@ -56,7 +56,8 @@ class RemoteTransmitData {
 
 class RemoteReceiveData {
  public:
-  RemoteReceiveData(std::vector<int32_t> *data, uint8_t tolerance) : data_(data), tolerance_(tolerance) {}
+  RemoteReceiveData(std::vector<int32_t> *data, uint8_t tolerance, uint32_t signal_id = 0)
+      : data_(data), tolerance_(tolerance), signal_id_(signal_id) {}
 
   bool peek_mark(uint32_t length, uint32_t offset = 0) {
     if (int32_t(this->index_ + offset) >= this->size())
@@ -136,6 +137,9 @@ class RemoteReceiveData {
 
   std::vector<int32_t> *get_raw_data() { return this->data_; }
 
+  /// Identifies the received signal, it's the same for all listeners and dumpers it's passed to. 0 if unknown.
+  uint32_t get_signal_id() const { return this->signal_id_; }
+
  protected:
   int32_t lower_bound_(uint32_t length) { return int32_t(100 - this->tolerance_) * length / 100U; }
   int32_t upper_bound_(uint32_t length) { return int32_t(100 + this->tolerance_) * length / 100U; }
@@ -143,6 +147,7 @@ class RemoteReceiveData {
   uint32_t index_{0};
   std::vector<int32_t> *data_;
   uint8_t tolerance_;
+  uint32_t signal_id_;
 };
 
 template<typename T> class RemoteProtocol {
@@ -154,6 +159,32 @@ template<typename T> class RemoteProtocol {
   virtual void dump(const T &data) = 0;
 };
 
+/** Decodes every received signal only once per protocol, no matter how many listeners and dumpers of the protocol
+ * it's passed to.
+ *
+ * The result for the last signal is kept per protocol. Signals are told apart by their id, which is unique across
+ * all receivers.
+ */
+template<typename T, typename D> class RemoteDecodeCache {
+ public:
+  static optional<D> decode(RemoteReceiveData src) {
+    const uint32_t signal_id = src.get_signal_id();
+    if (signal_id == 0)
+      return T().decode(src);
+    if (signal_id != last_signal_id_) {
+      last_signal_id_ = signal_id;
+      last_value_ = T().decode(src);
+    }
+    return last_value_;
+  }
+
+ protected:
+  static uint32_t last_signal_id_;
+  static optional<D> last_value_;
+};
+template<typename T, typename D> uint32_t RemoteDecodeCache<T, D>::last_signal_id_ = 0;
+template<typename T, typename D> optional<D> RemoteDecodeCache<T, D>::last_value_ = {};
+
 class RemoteComponentBase {
  public:
   explicit RemoteComponentBase(InternalGPIOPin *pin) : pin_(pin){};
@@ -246,7 +277,7 @@ class RemoteReceiverBase : public RemoteComponentBase {
   bool call_listeners_() {
     bool success = false;
     for (auto *listener : this->listeners_) {
-      auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+      auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->signal_id_);
       if (listener->on_receive(data))
         success = true;
     }
@@ -255,18 +286,20 @@ class RemoteReceiverBase : public RemoteComponentBase {
   void call_dumpers_() {
     bool success = false;
     for (auto *dumper : this->dumpers_) {
-      auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+      auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->signal_id_);
       if (dumper->dump(data))
         success = true;
     }
     if (!success) {
       for (auto *dumper : this->secondary_dumpers_) {
-        auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+        auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->signal_id_);
         dumper->dump(data);
       }
     }
   }
   void call_listeners_dumpers_() {
+    // temp_ holds a new signal, so results cached for the previous one don't apply anymore
+    this->signal_id_ = next_signal_id_();
     if (this->call_listeners_())
       return;
     // If a listener handled, then do not dump
@@ -276,8 +309,11 @@ class RemoteReceiverBase : public RemoteComponentBase {
   std::vector<RemoteReceiverListener *> listeners_;
   std::vector<RemoteReceiverDumperBase *> dumpers_;
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
+  static uint32_t next_signal_id_();
+
   std::vector<int32_t> temp_;
   uint8_t tolerance_{25};
+  uint32_t signal_id_{0};
 };
 
 class RemoteReceiverBinarySensorBase : public binary_sensor::BinarySensorInitiallyOff,
@@ -304,8 +340,7 @@ template<typename T, typename D> class RemoteReceiverBinarySensor : public Remot
 
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = RemoteDecodeCache<T, D>::decode(src);
     return res.has_value() && *res == this->data_;
   }
 
@@ -319,8 +354,7 @@ template<typename T, typename D> class RemoteReceiverBinarySensor : public Remot
 template<typename T, typename D> class RemoteReceiverTrigger : public Trigger<D>, public RemoteReceiverListener {
  protected:
   bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = RemoteDecodeCache<T, D>::decode(src);
     if (res.has_value()) {
       this->trigger(*res);
       return true;
@@ -353,11 +387,10 @@ template<typename... Ts> class RemoteTransmitterActionBase : public Action<Ts...
 template<typename T, typename D> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
+    auto decoded = RemoteDecodeCache<T, D>::decode(src);
     if (!decoded.has_value())
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
 };
@@ -1,4 +1,5 @@
 #include "rotary_encoder.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
@@ -122,6 +123,8 @@ void IRAM_ATTR HOT RotaryEncoderSensorStore::gpio_intr(RotaryEncoderSensorStore
   arg->first_read = false;
 
   arg->state = new_state;
+  if (rotation_dir != 0)
+    App.wake_loop();
 }
 
 void RotaryEncoderSensor::setup() {
@@ -28,6 +28,7 @@ optional<RuuviParseResult> parse_ruuvi(const esp32_ble_tracker::ESPBTDevice &dev
 
 class RuuviListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  RuuviListener() { this->add_match_manufacturer_uuid(esp32_ble_tracker::ESPBTUUID::from_uint16(0x0499)); }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
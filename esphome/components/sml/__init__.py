@@ -30,9 +30,18 @@ async def to_code(config):
     await uart.register_uart_device(var, config)
 
 
+OBIS_CODE_PATTERN = re.compile(r"^(\d{1,3})-(\d{1,3}):(\d{1,3})\.(\d{1,3})\.(\d{1,3})$")
+
+
 def obis_code(value):
     value = cv.string(value)
-    match = re.match(r"^\d{1,3}-\d{1,3}:\d{1,3}\.\d{1,3}\.\d{1,3}$", value)
-    if match is None:
+    match = OBIS_CODE_PATTERN.match(value)
+    if match is None or any(int(group) > 255 for group in match.groups()):
         raise cv.Invalid(f"{value} is not a valid OBIS code")
     return value
+
+
+def obis_key(value):
+    """Return the expression for the key of a validated OBIS code."""
+    groups = OBIS_CODE_PATTERN.match(value).groups()
+    return sml_ns.obis_key(*(int(group) for group in groups))
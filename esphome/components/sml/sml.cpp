@@ -1,7 +1,10 @@
 #include "sml.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "sml_parser.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace sml {
 
@@ -24,87 +27,71 @@ char Sml::check_start_end_bytes_(uint8_t byte) {
 }
 
 void Sml::loop() {
-  while (available()) {
-    const char c = read();
-
-    if (this->record_)
-      this->sml_data_.emplace_back(c);
-
-    switch (this->check_start_end_bytes_(c)) {
-      case START_BYTES_DETECTED: {
-        this->record_ = true;
-        this->sml_data_.clear();
-        break;
-      };
-      case END_BYTES_DETECTED: {
-        if (this->record_) {
-          this->record_ = false;
-
-          if (!check_sml_data(this->sml_data_))
-            break;
-
-          // remove footer bytes
-          this->sml_data_.resize(this->sml_data_.size() - 8);
-          this->process_sml_file_(this->sml_data_);
-        }
-        break;
+  int available = this->available();
+  uint8_t buf[64];
+  while (available > 0) {
+    const size_t len = std::min<size_t>(available, sizeof(buf));
+    if (!this->read_array(buf, len))
+      break;
+    available -= len;
+
+    for (size_t i = 0; i < len; i++) {
+      const uint8_t c = buf[i];
+      if (this->record_)
+        this->record_byte_(c);
+
+      switch (this->check_start_end_bytes_(c)) {
+        case START_BYTES_DETECTED: {
+          this->record_ = true;
+          // Keeps the capacity, so the buffer is only allocated for the first files
+          this->sml_data_.clear();
+          // The checksum includes the start sequence
+          this->crc_x25_ = 0x6e23 ^ 0xffff;
+          this->crc_kermit_ = 0xed50;
+          break;
+        };
+        case END_BYTES_DETECTED: {
+          if (this->record_) {
+            this->record_ = false;
+
+            if (!this->check_crc_())
+              break;
+
+            // remove footer bytes
+            this->process_sml_file_(BytesView(this->sml_data_.data(), this->sml_data_.size() - 8));
+          }
+          break;
+        };
       };
-    };
+    }
   }
 }
 
-void Sml::process_sml_file_(const bytes &sml_data) {
-  SmlFile sml_file = SmlFile(sml_data);
-  std::vector<ObisInfo> obis_info = sml_file.get_obis_info();
-  this->publish_obis_info_(obis_info);
-
-  this->log_obis_info_(obis_info);
-}
-
-void Sml::log_obis_info_(const std::vector<ObisInfo> &obis_info_vec) {
-  ESP_LOGD(TAG, "OBIS info:");
-  for (auto const &obis_info : obis_info_vec) {
-    std::string info;
-    info += "  (" + bytes_repr(obis_info.server_id) + ") ";
-    info += obis_info.code_repr();
-    info += " [0x" + bytes_repr(obis_info.value) + "]";
-    ESP_LOGD(TAG, "%s", info.c_str());
-  }
-}
-
-void Sml::publish_obis_info_(const std::vector<ObisInfo> &obis_info_vec) {
-  for (auto const &obis_info : obis_info_vec) {
-    this->publish_value_(obis_info);
-  }
-}
-
-void Sml::publish_value_(const ObisInfo &obis_info) {
-  for (auto const &sml_listener : sml_listeners_) {
-    if ((!sml_listener->server_id.empty()) && (bytes_repr(obis_info.server_id) != sml_listener->server_id))
-      continue;
-    if (obis_info.code_repr() != sml_listener->obis_code)
-      continue;
-    sml_listener->publish_val(obis_info);
-  }
+void Sml::record_byte_(uint8_t byte) {
+  this->sml_data_.push_back(byte);
+  const size_t size = this->sml_data_.size();
+  if (size < 3)
+    return;
+  const uint8_t crc_byte = this->sml_data_[size - 3];
+  this->crc_x25_ = (this->crc_x25_ >> 8) ^ CRC16_X25_TABLE[(this->crc_x25_ & 0xff) ^ crc_byte];
+  this->crc_kermit_ = (this->crc_kermit_ >> 8) ^ CRC16_X25_TABLE[(this->crc_kermit_ & 0xff) ^ crc_byte];
 }
 
-void Sml::dump_config() { ESP_LOGCONFIG(TAG, "SML:"); }
-
-void Sml::register_sml_listener(SmlListener *listener) { sml_listeners_.emplace_back(listener); }
-
-bool check_sml_data(const bytes &buffer) {
-  if (buffer.size() < 2) {
+bool Sml::check_crc_() {
+  const size_t size = this->sml_data_.size();
+  if (size < 8) {
     ESP_LOGW(TAG, "Checksum error in received SML data.");
     return false;
   }
 
-  uint16_t crc_received = (buffer.at(buffer.size() - 2) << 8) | buffer.at(buffer.size() - 1);
-  if (crc_received == calc_crc16_x25(buffer.begin(), buffer.end() - 2, 0x6e23)) {
+  uint16_t crc_received = (this->sml_data_[size - 2] << 8) | this->sml_data_[size - 1];
+  uint16_t crc_x25 = this->crc_x25_ ^ 0xffff;
+  if (crc_received == ((crc_x25 >> 8) | ((crc_x25 & 0xff) << 8))) {
     ESP_LOGV(TAG, "Checksum verification successful with CRC16/X25.");
     return true;
   }
 
-  if (crc_received == calc_crc16_kermit(buffer.begin(), buffer.end() - 2, 0xed50)) {
+  if (crc_received == this->crc_kermit_) {
     ESP_LOGV(TAG, "Checksum verification successful with CRC16/KERMIT.");
     return true;
   }
@@ -113,20 +100,69 @@ bool check_sml_data(const bytes &buffer) {
   return false;
 }
 
-uint16_t calc_crc16_p1021(bytes::const_iterator begin, bytes::const_iterator end, uint16_t crcsum) {
-  for (auto it = begin; it != end; it++) {
-    crcsum = (crcsum >> 8) ^ CRC16_X25_TABLE[(crcsum & 0xff) ^ *it];
-  }
-  return crcsum;
+void Sml::process_sml_file_(const BytesView &sml_data) {
+  bool log = false;
+#ifdef ESPHOME_LOG_HAS_VERBOSE
+  // All entries are decoded and logged, so that the OBIS codes of a meter can be found out
+  log = ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_VERBOSE, TAG);
+  if (log)
+    ESP_LOGV(TAG, "OBIS info:");
+#endif
+
+  SmlFile sml_file(sml_data);
+  bool valid = sml_file.get_obis_info(
+      [this, log](const BytesView &code) {
+        if (log)
+          return true;
+        return code.size() >= 5 &&
+               this->listeners_by_code_.count(obis_key(code[0], code[1], code[2], code[3], code[4])) > 0;
+      },
+      [this, log](const ObisInfo &obis_info) {
+        if (log)
+          this->log_obis_info_(obis_info);
+        this->publish_value_(obis_info);
+      });
+  if (!valid)
+    ESP_LOGW(TAG, "Invalid SML data received.");
 }
 
-uint16_t calc_crc16_x25(bytes::const_iterator begin, bytes::const_iterator end, uint16_t crcsum = 0) {
-  crcsum = calc_crc16_p1021(begin, end, crcsum ^ 0xffff) ^ 0xffff;
-  return (crcsum >> 8) | ((crcsum & 0xff) << 8);
+void Sml::log_obis_info_(const ObisInfo &obis_info) {
+  std::string info;
+  info += "  (" + bytes_repr(obis_info.server_id) + ") ";
+  info += obis_info.code_repr();
+  info += " [0x" + bytes_repr(obis_info.value) + "]";
+  ESP_LOGV(TAG, "%s", info.c_str());
 }
 
-uint16_t calc_crc16_kermit(bytes::const_iterator begin, bytes::const_iterator end, uint16_t crcsum = 0) {
-  return calc_crc16_p1021(begin, end, crcsum);
+void Sml::publish_value_(const ObisInfo &obis_info) {
+  const BytesView &code = obis_info.code;
+  if (code.size() < 5)
+    return;
+  auto it = this->listeners_by_code_.find(obis_key(code[0], code[1], code[2], code[3], code[4]));
+  if (it == this->listeners_by_code_.end())
+    return;
+  for (auto const &indexed : it->second) {
+    if (!indexed.server_id.empty() &&
+        (indexed.server_id.size() != obis_info.server_id.size() ||
+         !std::equal(indexed.server_id.begin(), indexed.server_id.end(), obis_info.server_id.begin())))
+      continue;
+    indexed.listener->publish_val(obis_info);
+  }
+}
+
+void Sml::dump_config() { ESP_LOGCONFIG(TAG, "SML:"); }
+
+void Sml::register_sml_listener(SmlListener *listener, uint64_t code_key) {
+  sml_listeners_.emplace_back(listener);
+
+  IndexedListener indexed{listener, {}};
+  const std::string &server_id = listener->server_id;
+  if (!server_id.empty() &&
+      (server_id.size() % 2 != 0 || !parse_hex(server_id, indexed.server_id, server_id.size() / 2))) {
+    ESP_LOGW(TAG, "Server ID %s is invalid", server_id.c_str());
+    return;
+  }
+  this->listeners_by_code_[code_key].push_back(std::move(indexed));
 }
 
 uint8_t get_code(uint8_t byte) {
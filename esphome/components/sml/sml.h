@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "esphome/core/component.h"
 #include "esphome/components/uart/uart.h"
@@ -19,29 +20,38 @@ class SmlListener {
 
 class Sml : public Component, public uart::UARTDevice {
  public:
-  void register_sml_listener(SmlListener *listener);
+  /// Register a listener for the OBIS code with the given key, see obis_key().
+  void register_sml_listener(SmlListener *listener, uint64_t code_key);
   void loop() override;
   void dump_config() override;
   std::vector<SmlListener *> sml_listeners_{};
 
  protected:
-  void process_sml_file_(const bytes &sml_data);
-  void log_obis_info_(const std::vector<ObisInfo> &obis_info_vec);
-  void publish_obis_info_(const std::vector<ObisInfo> &obis_info_vec);
+  struct IndexedListener {
+    SmlListener *listener;
+    /// The server ID of the listener as bytes, empty to match all servers.
+    bytes server_id;
+  };
+
+  void process_sml_file_(const BytesView &sml_data);
+  void log_obis_info_(const ObisInfo &obis_info);
   char check_start_end_bytes_(uint8_t byte);
   void publish_value_(const ObisInfo &obis_info);
+  /// Add a received byte to the file and to the checksums, which lag behind by the two checksum bytes.
+  void record_byte_(uint8_t byte);
+  /// Check the checksum of the file that was just received.
+  bool check_crc_();
 
   // Serial parser
   bool record_ = false;
   uint16_t incoming_mask_ = 0;
   bytes sml_data_;
+  uint16_t crc_x25_{0};
+  uint16_t crc_kermit_{0};
+  /// The listeners by the key of their OBIS code.
+  std::unordered_map<uint64_t, std::vector<IndexedListener>> listeners_by_code_;
 };
 
-bool check_sml_data(const bytes &buffer);
-uint16_t calc_crc16_p1021(bytes::const_iterator begin, bytes::const_iterator end, uint16_t crcsum);
-uint16_t calc_crc16_x25(bytes::const_iterator begin, bytes::const_iterator end, uint16_t crcsum);
-uint16_t calc_crc16_kermit(bytes::const_iterator begin, bytes::const_iterator end, uint16_t crcsum);
-
 uint8_t get_code(uint8_t byte);
 }  // namespace sml
 }  // namespace esphome
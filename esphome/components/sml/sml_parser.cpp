@@ -5,77 +5,165 @@
 namespace esphome {
 namespace sml {
 
-SmlFile::SmlFile(bytes buffer) : buffer_(std::move(buffer)) {
-  // extract messages
+// Number of nodes in front of the interesting ones, see the SML specification (BSI TR-03109-1)
+static const size_t MESSAGE_BODY_INDEX = 3;
+static const size_t LIST_RESPONSE_SERVER_ID_INDEX = 1;
+static const size_t LIST_RESPONSE_VAL_LIST_INDEX = 4;
+static const size_t LIST_ENTRY_LENGTH = 7;
+
+bool SmlFile::get_obis_info(const obis_filter_t &filter, const obis_callback_t &callback) {
   this->pos_ = 0;
   while (this->pos_ < this->buffer_.size()) {
     if (this->buffer_[this->pos_] == 0x00)
       break;  // fill byte detected -> no more messages
 
-    SmlNode message = SmlNode();
-    if (!this->setup_node(&message))
-      break;
-    this->messages.emplace_back(message);
+    size_t message_length;
+    if (!this->read_list_(&message_length) || message_length <= MESSAGE_BODY_INDEX)
+      return false;
+    if (!this->skip_nodes_(MESSAGE_BODY_INDEX))
+      return false;
+
+    size_t body_length;
+    BytesView message_type;
+    if (!this->read_list_(&body_length) || body_length < 2 || !this->read_value_(&message_type))
+      return false;
+    if (bytes_to_uint(message_type) == SML_GET_LIST_RES) {
+      if (!this->read_list_response_(filter, callback))
+        return false;
+    } else if (!this->skip_nodes_(1)) {
+      return false;
+    }
+
+    // Remaining nodes of the body, the CRC and the end of the message
+    if (!this->skip_nodes_(body_length - 2) || !this->skip_nodes_(message_length - MESSAGE_BODY_INDEX - 1))
+      return false;
   }
+  return true;
 }
 
-bool SmlFile::setup_node(SmlNode *node) {
-  uint8_t type = this->buffer_[this->pos_] >> 4;      // type including overlength info
-  uint8_t length = this->buffer_[this->pos_] & 0x0f;  // length including TL bytes
-  bool is_list = (type & 0x07) == SML_LIST;
-  bool has_extended_length = type & 0x08;  // we have a long list/value (>15 entries)
-  uint8_t parse_length = length;
-  if (has_extended_length) {
-    length = (length << 4) + (this->buffer_[this->pos_ + 1] & 0x0f);
-    parse_length = length - 1;
-    this->pos_ += 1;
+bool SmlFile::read_list_response_(const obis_filter_t &filter, const obis_callback_t &callback) {
+  size_t length;
+  if (!this->read_list_(&length) || length <= LIST_RESPONSE_VAL_LIST_INDEX)
+    return false;
+
+  BytesView server_id;
+  if (!this->skip_nodes_(LIST_RESPONSE_SERVER_ID_INDEX) || !this->read_value_(&server_id))
+    return false;
+  if (!this->skip_nodes_(LIST_RESPONSE_VAL_LIST_INDEX - LIST_RESPONSE_SERVER_ID_INDEX - 1))
+    return false;
+
+  size_t entries;
+  if (!this->read_list_(&entries))
+    return false;
+  for (size_t i = 0; i < entries; i++) {
+    if (!this->read_list_entry_(server_id, filter, callback))
+      return false;
   }
+  return this->skip_nodes_(length - LIST_RESPONSE_VAL_LIST_INDEX - 1);
+}
 
-  if (this->pos_ + parse_length >= this->buffer_.size())
+bool SmlFile::read_list_entry_(BytesView server_id, const obis_filter_t &filter, const obis_callback_t &callback) {
+  size_t length;
+  ObisInfo obis_info;
+  obis_info.server_id = server_id;
+  if (!this->read_list_(&length) || length < 6 || !this->read_value_(&obis_info.code))
+    return false;
+  if (!filter(obis_info.code))
+    return this->skip_nodes_(length - 1);
+
+  BytesView unit, scaler;
+  uint8_t value_type;
+  // The value time is skipped, it's a list for most meters
+  if (!this->read_value_(&obis_info.status) || !this->skip_nodes_(1) || !this->read_value_(&unit) ||
+      !this->read_value_(&scaler) || !this->read_value_(&obis_info.value, &value_type))
+    return false;
+  obis_info.unit = bytes_to_uint(unit);
+  obis_info.scaler = bytes_to_int(scaler);
+  obis_info.value_type = value_type;
+  if (!this->skip_nodes_(length - 6))
     return false;
 
-  node->type = type & 0x07;
-  node->nodes.clear();
-  node->value_bytes.clear();
-  if (this->buffer_[this->pos_] == 0x00) {  // end of message
-    this->pos_ += 1;
-  } else if (is_list) {  // list
+  callback(obis_info);
+  return true;
+}
+
+bool SmlFile::read_node_(SmlNode *node) {
+  if (this->pos_ >= this->buffer_.size())
+    return false;
+  uint8_t tl = this->buffer_[this->pos_];
+  if (tl == 0x00) {  // end of message
+    node->type = SML_OCTET;
+    node->length = 0;
+    node->value_bytes = BytesView();
     this->pos_ += 1;
-    node->nodes.reserve(parse_length);
-    for (size_t i = 0; i != parse_length; i++) {
-      SmlNode child_node = SmlNode();
-      if (!this->setup_node(&child_node))
+    return true;
+  }
+
+  node->type = (tl >> 4) & 0x07;
+  size_t length = tl & 0x0f;
+  size_t tl_length = 1;
+  // Long lists and values continue the length in the following bytes
+  while (tl & 0x80) {
+    if (this->pos_ + tl_length >= this->buffer_.size() || tl_length >= sizeof(size_t))
+      return false;
+    tl = this->buffer_[this->pos_ + tl_length];
+    length = (length << 4) | (tl & 0x0f);
+    tl_length++;
+  }
+
+  if (node->type == SML_LIST) {
+    // The length of a list is the number of its children
+    node->length = length;
+    node->value_bytes = BytesView();
+    this->pos_ += tl_length;
+    return true;
+  }
+  // The length of a value includes the type-length field
+  if (length < tl_length || length > this->buffer_.size() - this->pos_)
+    return false;
+  node->length = 0;
+  node->value_bytes = this->buffer_.subview(this->pos_ + tl_length, length - tl_length);
+  this->pos_ += length;
+  return true;
+}
+
+bool SmlFile::skip_nodes_(size_t count) {
+  while (count > 0) {
+    SmlNode node;
+    if (!this->read_node_(&node))
+      return false;
+    count--;
+    if (node.type == SML_LIST) {
+      // Every node takes at least one byte, more children than that can't be in the file
+      if (node.length > this->buffer_.size() - this->pos_)
         return false;
-      node->nodes.emplace_back(child_node);
+      count += node.length;
     }
-  } else {  // value
-    node->value_bytes =
-        bytes(this->buffer_.begin() + this->pos_ + 1, this->buffer_.begin() + this->pos_ + parse_length);
-    this->pos_ += parse_length;
   }
   return true;
 }
 
-std::vector<ObisInfo> SmlFile::get_obis_info() {
-  std::vector<ObisInfo> obis_info;
-  for (auto const &message : messages) {
-    SmlNode message_body = message.nodes[3];
-    uint16_t message_type = bytes_to_uint(message_body.nodes[0].value_bytes);
-    if (message_type != SML_GET_LIST_RES)
-      continue;
-
-    SmlNode get_list_response = message_body.nodes[1];
-    bytes server_id = get_list_response.nodes[1].value_bytes;
-    SmlNode val_list = get_list_response.nodes[4];
+bool SmlFile::read_list_(size_t *length) {
+  SmlNode node;
+  if (!this->read_node_(&node) || node.type != SML_LIST)
+    return false;
+  *length = node.length;
+  return true;
+}
 
-    for (auto const &val_list_entry : val_list.nodes) {
-      obis_info.emplace_back(server_id, val_list_entry);
-    }
-  }
-  return obis_info;
+bool SmlFile::read_value_(BytesView *value, uint8_t *type) {
+  SmlNode node;
+  if (!this->read_node_(&node))
+    return false;
+  if (type != nullptr)
+    *type = node.type;
+  *value = node.value_bytes;
+  if (node.type == SML_LIST)
+    return this->skip_nodes_(node.length);
+  return true;
 }
 
-std::string bytes_repr(const bytes &buffer) {
+std::string bytes_repr(const BytesView &buffer) {
   std::string repr;
   for (auto const value : buffer) {
     repr += str_sprintf("%02x", value & 0xff);
@@ -83,7 +171,7 @@ std::string bytes_repr(const bytes &buffer) {
   return repr;
 }
 
-uint64_t bytes_to_uint(const bytes &buffer) {
+uint64_t bytes_to_uint(const BytesView &buffer) {
   uint64_t val = 0;
   for (auto const value : buffer) {
     val = (val << 8) + value;
@@ -91,7 +179,7 @@ uint64_t bytes_to_uint(const bytes &buffer) {
   return val;
 }
 
-int64_t bytes_to_int(const bytes &buffer) {
+int64_t bytes_to_int(const BytesView &buffer) {
   uint64_t tmp = bytes_to_uint(buffer);
   int64_t val;
 
@@ -111,19 +199,11 @@ int64_t bytes_to_int(const bytes &buffer) {
   return val;
 }
 
-std::string bytes_to_string(const bytes &buffer) { return std::string(buffer.begin(), buffer.end()); }
-
-ObisInfo::ObisInfo(bytes server_id, SmlNode val_list_entry) : server_id(std::move(server_id)) {
-  this->code = val_list_entry.nodes[0].value_bytes;
-  this->status = val_list_entry.nodes[1].value_bytes;
-  this->unit = bytes_to_uint(val_list_entry.nodes[3].value_bytes);
-  this->scaler = bytes_to_int(val_list_entry.nodes[4].value_bytes);
-  SmlNode value_node = val_list_entry.nodes[5];
-  this->value = value_node.value_bytes;
-  this->value_type = value_node.type;
-}
+std::string bytes_to_string(const BytesView &buffer) { return std::string(buffer.begin(), buffer.end()); }
 
 std::string ObisInfo::code_repr() const {
+  if (this->code.size() < 5)
+    return bytes_repr(this->code);
   return str_sprintf("%d-%d:%d.%d.%d", this->code[0], this->code[1], this->code[2], this->code[3], this->code[4]);
 }
 
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <functional>
 #include <string>
 #include <vector>
 #include "constants.h"
@@ -11,44 +12,95 @@ namespace sml {
 
 using bytes = std::vector<uint8_t>;
 
-class SmlNode {
+/// A view of a range of bytes that doesn't own them, usually part of a received SML file.
+class BytesView {
  public:
+  BytesView() = default;
+  BytesView(const uint8_t *first, size_t count) : first_(first), count_(count) {}
+  BytesView(const bytes &buffer) : first_(buffer.data()), count_(buffer.size()) {}  // NOLINT
+
+  size_t size() const { return this->count_; }
+  bool empty() const { return this->count_ == 0; }
+  uint8_t operator[](size_t index) const { return this->first_[index]; }
+  const uint8_t *begin() const { return this->first_; }
+  const uint8_t *end() const { return this->first_ + this->count_; }
+  BytesView subview(size_t offset, size_t count) const { return {this->first_ + offset, count}; }
+
+ protected:
+  const uint8_t *first_{nullptr};
+  size_t count_{0};
+};
+
+/// A decoded type-length field. Lists only hold the number of their children, which follow the field.
+struct SmlNode {
   uint8_t type;
-  bytes value_bytes;
-  std::vector<SmlNode> nodes;
+  /// Number of children of a list.
+  size_t length;
+  /// Content of a value.
+  BytesView value_bytes;
 };
 
+/** An entry of the value list in a GetList response.
+ *
+ * The views point into the received SML file, they are only valid while the entry is being published.
+ */
 class ObisInfo {
  public:
-  ObisInfo(bytes server_id, SmlNode val_list_entry);
-  bytes server_id;
-  bytes code;
-  bytes status;
+  BytesView server_id;
+  BytesView code;
+  BytesView status;
   char unit;
   char scaler;
-  bytes value;
+  BytesView value;
   uint16_t value_type;
   std::string code_repr() const;
 };
 
+/** Parser for an SML file (without the escape sequences and the footer).
+ *
+ * The file is walked once and nothing is copied, the nodes of the entries are only decoded if they're wanted.
+ */
 class SmlFile {
  public:
-  SmlFile(bytes buffer);
-  bool setup_node(SmlNode *node);
-  std::vector<SmlNode> messages;
-  std::vector<ObisInfo> get_obis_info();
+  /// Decides from its OBIS code whether an entry is decoded.
+  using obis_filter_t = std::function<bool(const BytesView &code)>;
+  using obis_callback_t = std::function<void(const ObisInfo &obis_info)>;
+
+  SmlFile(BytesView buffer) : buffer_(buffer) {}
+
+  /** Pass the wanted entries of all GetList responses in the file to `callback`.
+   *
+   * Returns false if the file is malformed, the entries in front of the error have been passed on already.
+   */
+  bool get_obis_info(const obis_filter_t &filter, const obis_callback_t &callback);
 
  protected:
-  const bytes buffer_;
-  size_t pos_;
+  /// Decode the next type-length field and skip over the content of values.
+  bool read_node_(SmlNode *node);
+  /// Skip over the next `count` nodes, including all their children.
+  bool skip_nodes_(size_t count);
+  /// Read the next node if it's a list, returning its number of children.
+  bool read_list_(size_t *length);
+  /// Read the next node if it's a value. Lists are skipped and result in an empty value.
+  bool read_value_(BytesView *value, uint8_t *type = nullptr);
+  bool read_list_response_(const obis_filter_t &filter, const obis_callback_t &callback);
+  bool read_list_entry_(BytesView server_id, const obis_filter_t &filter, const obis_callback_t &callback);
+
+  BytesView buffer_;
+  size_t pos_{0};
 };
 
-std::string bytes_repr(const bytes &buffer);
+/// Key of the first five bytes of an OBIS code (A-B:C.D.E), which identify a value.
+inline uint64_t obis_key(uint8_t a, uint8_t b, uint8_t c, uint8_t d, uint8_t e) {
+  return (uint64_t(a) << 32) | (uint32_t(b) << 24) | (uint32_t(c) << 16) | (uint32_t(d) << 8) | e;
+}
+
+std::string bytes_repr(const BytesView &buffer);
 
-uint64_t bytes_to_uint(const bytes &buffer);
+uint64_t bytes_to_uint(const BytesView &buffer);
 
-int64_t bytes_to_int(const bytes &buffer);
+int64_t bytes_to_int(const BytesView &buffer);
 
-std::string bytes_to_string(const bytes &buffer);
+std::string bytes_to_string(const BytesView &buffer);
 }  // namespace sml
 }  // namespace esphome
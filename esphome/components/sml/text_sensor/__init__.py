@@ -3,7 +3,15 @@ import esphome.config_validation as cv
 from esphome.components import text_sensor
 from esphome.const import CONF_FORMAT, CONF_ID
 
-from .. import CONF_OBIS_CODE, CONF_SERVER_ID, CONF_SML_ID, Sml, obis_code, sml_ns
+from .. import (
+    CONF_OBIS_CODE,
+    CONF_SERVER_ID,
+    CONF_SML_ID,
+    Sml,
+    obis_code,
+    obis_key,
+    sml_ns,
+)
 
 AUTO_LOAD = ["sml"]
 
@@ -40,4 +48,4 @@ async def to_code(config):
     await cg.register_component(var, config)
     await text_sensor.register_text_sensor(var, config)
     sml = await cg.get_variable(config[CONF_SML_ID])
-    cg.add(sml.register_sml_listener(var))
+    cg.add(sml.register_sml_listener(var, obis_key(config[CONF_OBIS_CODE])))
@@ -1,6 +1,7 @@
 #include "socket.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/application.h"
 
 #ifdef USE_SOCKET_IMPL_BSD_SOCKETS
 
@@ -35,7 +36,12 @@ std::string format_sockaddr(const struct sockaddr_storage &storage) {
 
 class BSDSocketImpl : public Socket {
  public:
-  BSDSocketImpl(int fd) : fd_(fd) {}
+  BSDSocketImpl(int fd, bool loop_monitored = false) : fd_(fd), loop_monitored_(loop_monitored) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    if (this->loop_monitored_)
+      App.register_socket_fd(this->fd_);
+#endif
+  }
   ~BSDSocketImpl() override {
     if (!closed_) {
       close();  // NOLINT(clang-analyzer-optin.cplusplus.VirtualCall)
@@ -45,10 +51,15 @@ class BSDSocketImpl : public Socket {
     int fd = ::accept(fd_, addr, addrlen);
     if (fd == -1)
       return {};
-    return make_unique<BSDSocketImpl>(fd);
+    // Accepted connections wake the loop if the listening socket does
+    return make_unique<BSDSocketImpl>(fd, this->loop_monitored_);
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return ::bind(fd_, addr, addrlen); }
   int close() override {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    if (this->loop_monitored_)
+      App.unregister_socket_fd(this->fd_);
+#endif
     int ret = ::close(fd_);
     closed_ = true;
     return ret;
@@ -148,6 +159,7 @@ class BSDSocketImpl : public Socket {
  protected:
   int fd_;
   bool closed_ = false;
+  bool loop_monitored_;
 };
 
 std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
@@ -157,6 +169,13 @@ std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
   return std::unique_ptr<Socket>{new BSDSocketImpl(ret)};
 }
 
+std::unique_ptr<Socket> socket_loop_monitored(int domain, int type, int protocol) {
+  int ret = ::socket(domain, type, protocol);
+  if (ret == -1)
+    return nullptr;
+  return std::unique_ptr<Socket>{new BSDSocketImpl(ret, true)};
+}
+
 }  // namespace socket
 }  // namespace esphome
 
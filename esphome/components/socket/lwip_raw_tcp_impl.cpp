@@ -11,6 +11,7 @@
 #include <cstring>
 #include <queue>
 
+#include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
@@ -492,6 +493,7 @@ class LWIPRawImpl : public Socket {
     auto sock = make_unique<LWIPRawImpl>(family_, newpcb);
     sock->init();
     accepted_sockets_.push(std::move(sock));
+    App.wake_loop();
     return ERR_OK;
   }
   void err_fn(err_t err) {
@@ -509,10 +511,12 @@ class LWIPRawImpl : public Socket {
       // "An error code if there has been an error receiving Only return ERR_ABRT if you have
       // called tcp_abort from within the callback function!"
       rx_closed_ = true;
+      App.wake_loop();
       return ERR_OK;
     }
     if (pb == nullptr) {
       rx_closed_ = true;
+      App.wake_loop();
       return ERR_OK;
     }
     if (rx_buf_ == nullptr) {
@@ -522,6 +526,7 @@ class LWIPRawImpl : public Socket {
     } else {
       pbuf_cat(rx_buf_, pb);
     }
+    App.wake_loop();
     return ERR_OK;
   }
 
@@ -601,6 +606,11 @@ std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
   return std::unique_ptr<Socket>{sock};
 }
 
+std::unique_ptr<Socket> socket_loop_monitored(int domain, int type, int protocol) {
+  // The raw TCP callbacks already wake the loop whenever data or a connection arrives
+  return socket(domain, type, protocol);
+}
+
 }  // namespace socket
 }  // namespace esphome
 
@@ -44,6 +44,12 @@ std::unique_ptr<Socket> socket(int domain, int type, int protocol);
 /// Create a socket in the newest available IP domain (IPv6 or IPv4) of the given type and protocol.
 std::unique_ptr<Socket> socket_ip(int type, int protocol);
 
+/// Create a socket of the given domain, type and protocol that wakes the main loop when it becomes readable.
+std::unique_ptr<Socket> socket_loop_monitored(int domain, int type, int protocol);
+
+/// Create a socket like socket_ip() that wakes the main loop when it becomes readable.
+std::unique_ptr<Socket> socket_ip_loop_monitored(int type, int protocol);
+
 /// Set a sockaddr to the any address for the IP version used by socket_ip().
 socklen_t set_sockaddr_any(struct sockaddr *addr, socklen_t addrlen, uint16_t port);
 
@@ -3,17 +3,32 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
 
+#ifdef USE_SPI_ESP_IDF_BACKEND
+#include <esp_idf_version.h>
+#include <cstring>
+#endif  // USE_SPI_ESP_IDF_BACKEND
+
 namespace esphome {
 namespace spi {
 
 static const char *const TAG = "spi";
 
+#ifdef USE_SPI_ESP_IDF_BACKEND
+/// Largest single DMA transaction, longer writes are split and queued back to back.
+static const size_t IDF_MAX_TRANSFER_SIZE = 8192;
+#endif  // USE_SPI_ESP_IDF_BACKEND
+
 void IRAM_ATTR HOT SPIComponent::disable() {
 #ifdef USE_SPI_ARDUINO_BACKEND
   if (this->hw_spi_ != nullptr) {
     this->hw_spi_->endTransaction();
   }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  // Queued transfers have to finish before the device is deselected
+  this->wait_async();
+  this->idf_device_ = nullptr;
+#endif  // USE_SPI_ESP_IDF_BACKEND
   if (this->active_cs_) {
     this->active_cs_->digital_write(true);
     this->active_cs_ = nullptr;
@@ -24,7 +39,7 @@ void SPIComponent::setup() {
   this->clk_->setup();
   this->clk_->digital_write(true);
 
-#ifdef USE_SPI_ARDUINO_BACKEND
+#if defined(USE_SPI_ARDUINO_BACKEND) || defined(USE_SPI_ESP_IDF_BACKEND)
   bool use_hw_spi = true;
   const bool has_miso = this->miso_ != nullptr;
   const bool has_mosi = this->mosi_ != nullptr;
@@ -54,6 +69,7 @@ void SPIComponent::setup() {
       mosi_pin = has_mosi ? mosi_internal->get_pin() : -1;
     }
   }
+#ifdef USE_SPI_ARDUINO_BACKEND
 #ifdef USE_ESP8266
   if (!(clk_pin == 6 && miso_pin == 7 && mosi_pin == 8) &&
       !(clk_pin == 14 && (!has_miso || miso_pin == 12) && (!has_mosi || mosi_pin == 13)))
@@ -84,6 +100,43 @@ void SPIComponent::setup() {
   }
 #endif  // USE_ESP32
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  static const spi_host_device_t HOSTS[] = {
+    SPI2_HOST,
+#if SOC_SPI_PERIPH_NUM > 2
+    SPI3_HOST,
+#endif  // SOC_SPI_PERIPH_NUM > 2
+  };
+  static uint8_t spi_bus_num = 0;
+  if (spi_bus_num >= sizeof(HOSTS) / sizeof(HOSTS[0])) {
+    use_hw_spi = false;
+  }
+
+  if (use_hw_spi) {
+    const spi_host_device_t host = HOSTS[spi_bus_num++];
+    spi_bus_config_t bus_config{};
+    bus_config.mosi_io_num = mosi_pin;
+    bus_config.miso_io_num = miso_pin;
+    bus_config.sclk_io_num = clk_pin;
+    bus_config.quadwp_io_num = -1;
+    bus_config.quadhd_io_num = -1;
+    bus_config.max_transfer_sz = IDF_MAX_TRANSFER_SIZE;
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 3, 0)
+    const int dma_channel = SPI_DMA_CH_AUTO;
+#else
+    const int dma_channel = host == SPI2_HOST ? 1 : 2;
+#endif  // ESP_IDF_VERSION
+    esp_err_t err = spi_bus_initialize(host, &bus_config, dma_channel);
+    if (err != ESP_OK) {
+      ESP_LOGE(TAG, "spi_bus_initialize failed: %s", esp_err_to_name(err));
+      this->mark_failed();
+      return;
+    }
+    this->idf_host_ = host;
+    return;
+  }
+#endif  // USE_SPI_ESP_IDF_BACKEND
+#endif  // USE_SPI_ARDUINO_BACKEND || USE_SPI_ESP_IDF_BACKEND
 
   if (this->miso_ != nullptr) {
     this->miso_->setup();
@@ -101,9 +154,132 @@ void SPIComponent::dump_config() {
 #ifdef USE_SPI_ARDUINO_BACKEND
   ESP_LOGCONFIG(TAG, "  Using HW SPI: %s", YESNO(this->hw_spi_ != nullptr));
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  ESP_LOGCONFIG(TAG, "  Using HW SPI: %s", YESNO(this->idf_host_ >= 0));
+#endif  // USE_SPI_ESP_IDF_BACKEND
 }
 float SPIComponent::get_setup_priority() const { return setup_priority::BUS; }
 
+void SPIComponent::wait_async() {
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  while (this->idf_pending_ > 0) {
+    spi_transaction_t *transaction;
+    spi_device_get_trans_result(this->idf_device_, &transaction, portMAX_DELAY);
+    this->idf_pending_--;
+  }
+#endif  // USE_SPI_ESP_IDF_BACKEND
+}
+
+#ifdef USE_SPI_ESP_IDF_BACKEND
+spi_device_handle_t SPIComponent::get_idf_device_(uint8_t mode, uint32_t clock_speed, bool lsb_first) {
+  // Don't try again on every transaction, and don't send anything on a bus that failed
+  if (this->is_failed())
+    return nullptr;
+  for (auto &device : this->idf_devices_) {
+    if (device.mode == mode && device.clock_speed == clock_speed && device.lsb_first == lsb_first)
+      return device.handle;
+  }
+
+  spi_device_interface_config_t config{};
+  config.mode = mode;
+  config.clock_speed_hz = clock_speed;
+  // Chip select is driven by the devices, which may use any pin including ones on IO expanders
+  config.spics_io_num = -1;
+  config.queue_size = IDF_QUEUE_SIZE;
+  if (lsb_first)
+    config.flags = SPI_DEVICE_BIT_LSBFIRST;
+
+  IDFDevice device{mode, clock_speed, lsb_first, nullptr};
+  auto host = static_cast<spi_host_device_t>(this->idf_host_);
+  esp_err_t err = spi_bus_add_device(host, &config, &device.handle);
+  if (err == ESP_ERR_NOT_FOUND && !this->idf_devices_.empty()) {
+    // The number of devices per bus is limited, free the slot of the settings used first
+    spi_bus_remove_device(this->idf_devices_.front().handle);
+    this->idf_devices_.erase(this->idf_devices_.begin());
+    err = spi_bus_add_device(host, &config, &device.handle);
+  }
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "spi_bus_add_device failed: %s", esp_err_to_name(err));
+    this->mark_failed();
+    return nullptr;
+  }
+  this->idf_devices_.push_back(device);
+  return device.handle;
+}
+
+void SPIComponent::idf_fail_(const char *function, esp_err_t err) {
+  ESP_LOGE(TAG, "%s failed: %s", function, esp_err_to_name(err));
+  // Let the queued part complete, the rest of the transaction and all later ones are dropped
+  this->wait_async();
+  this->idf_device_ = nullptr;
+  this->mark_failed();
+}
+
+void SPIComponent::idf_write_(const uint8_t *data, size_t length, bool async) {
+  if (!async) {
+    this->wait_async();
+    if (length <= 4) {
+      // Short writes are sent from the transaction itself without setting up DMA
+      spi_transaction_t transaction{};
+      transaction.flags = SPI_TRANS_USE_TXDATA;
+      transaction.length = length * 8;
+      memcpy(transaction.tx_data, data, length);
+      esp_err_t err = spi_device_polling_transmit(this->idf_device_, &transaction);
+      if (err != ESP_OK)
+        this->idf_fail_("spi_device_polling_transmit", err);
+      return;
+    }
+  }
+
+  while (length > 0) {
+    const size_t chunk = std::min(length, IDF_MAX_TRANSFER_SIZE);
+    if (this->idf_pending_ == IDF_QUEUE_SIZE) {
+      // The oldest transaction completes first and frees its slot, which is the next one in the ring
+      spi_transaction_t *done;
+      spi_device_get_trans_result(this->idf_device_, &done, portMAX_DELAY);
+      this->idf_pending_--;
+    }
+    spi_transaction_t *transaction = &this->idf_transactions_[this->idf_next_transaction_];
+    memset(transaction, 0, sizeof(spi_transaction_t));
+    transaction->length = chunk * 8;
+    transaction->tx_buffer = data;
+    esp_err_t err = spi_device_queue_trans(this->idf_device_, transaction, portMAX_DELAY);
+    if (err != ESP_OK) {
+      this->idf_fail_("spi_device_queue_trans", err);
+      return;
+    }
+    this->idf_next_transaction_ = (this->idf_next_transaction_ + 1) % IDF_QUEUE_SIZE;
+    this->idf_pending_++;
+    data += chunk;
+    length -= chunk;
+  }
+
+  if (!async)
+    this->wait_async();
+}
+
+void SPIComponent::idf_transfer_(uint8_t *data, size_t length) {
+  this->wait_async();
+  // Word aligned, so DMA can receive into it directly
+  uint32_t rx_buffer[16];
+  while (length > 0) {
+    const size_t chunk = std::min(length, sizeof(rx_buffer));
+    spi_transaction_t transaction{};
+    transaction.length = chunk * 8;
+    transaction.tx_buffer = data;
+    transaction.rx_buffer = rx_buffer;
+    esp_err_t err = spi_device_polling_transmit(this->idf_device_, &transaction);
+    if (err != ESP_OK) {
+      this->idf_fail_("spi_device_polling_transmit", err);
+      return;
+    }
+    memcpy(data, rx_buffer, chunk);
+    data += chunk;
+    length -= chunk;
+  }
+}
+#endif  // USE_SPI_ESP_IDF_BACKEND
+
 void SPIComponent::cycle_clock_(bool value) {
   uint32_t start = arch_get_cpu_cycle_count();
   while (start - arch_get_cpu_cycle_count() < this->wait_cycle_)
@@ -123,6 +299,11 @@ void SPIComponent::cycle_clock_(bool value) {
 
 template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, bool READ, bool WRITE>
 uint8_t HOT SPIComponent::transfer_(uint8_t data) {
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  // The pins were set up for the SPI host, not as GPIOs. Without a device for the settings, nothing is transferred.
+  if (this->idf_host_ >= 0)
+    return 0;
+#endif  // USE_SPI_ESP_IDF_BACKEND
   // Clock starts out at idle level
   this->clk_->digital_write(CLOCK_POLARITY);
   uint8_t out_data = 0;
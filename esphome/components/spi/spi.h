@@ -2,16 +2,25 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include <algorithm>
 #include <vector>
 
 #ifdef USE_ARDUINO
 #define USE_SPI_ARDUINO_BACKEND
 #endif
 
+#if defined(USE_ESP32) && defined(USE_ESP_IDF)
+#define USE_SPI_ESP_IDF_BACKEND
+#endif
+
 #ifdef USE_SPI_ARDUINO_BACKEND
 #include <SPI.h>
 #endif
 
+#ifdef USE_SPI_ESP_IDF_BACKEND
+#include <driver/spi_master.h>
+#endif
+
 namespace esphome {
 namespace spi {
 
@@ -69,6 +78,12 @@ enum SPIDataRate : uint32_t {
   DATA_RATE_40MHZ = 40000000,
 };
 
+/// One buffer of a scatter list passed to SPIComponent::writev().
+struct WriteBuffer {
+  const uint8_t *data;
+  size_t len;
+};
+
 class SPIComponent : public Component {
  public:
   void set_clk(GPIOPin *clk) { clk_ = clk; }
@@ -85,6 +100,13 @@ class SPIComponent : public Component {
       return this->hw_spi_->transfer(0x00);
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_device_ != nullptr) {
+      uint8_t data = 0x00;
+      this->idf_transfer_(&data, 1);
+      return data;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     return this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, true, false>(0x00);
   }
 
@@ -96,6 +118,12 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_device_ != nullptr) {
+      this->idf_transfer_(data, length);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     for (size_t i = 0; i < length; i++) {
       data[i] = this->read_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>();
     }
@@ -109,6 +137,12 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_device_ != nullptr) {
+      this->idf_write_(&data, 1, false);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, false, true>(data);
   }
 
@@ -120,23 +154,23 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
-
-    this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data >> 8);
-    this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data);
+    const uint8_t bytes[2] = {uint8_t(data >> 8), uint8_t(data)};
+    this->write_array<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(bytes, 2);
   }
 
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE>
   void write_array16(const uint16_t *data, size_t length) {
-#ifdef USE_SPI_ARDUINO_BACKEND
-    if (this->hw_spi_ != nullptr) {
-      for (size_t i = 0; i < length; i++) {
-        this->hw_spi_->write16(data[i]);
+    // Swap the values to MSB first in chunks, so they can be sent as bulk transfers instead of word by word
+    uint8_t buffer[128];
+    while (length > 0) {
+      const size_t chunk = std::min(length, sizeof(buffer) / 2);
+      for (size_t i = 0; i < chunk; i++) {
+        buffer[i * 2] = data[i] >> 8;
+        buffer[i * 2 + 1] = data[i];
       }
-      return;
-    }
-#endif  // USE_SPI_ARDUINO_BACKEND
-    for (size_t i = 0; i < length; i++) {
-      this->write_byte16<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data[i]);
+      this->write_array<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(buffer, chunk * 2);
+      data += chunk;
+      length -= chunk;
     }
   }
 
@@ -149,11 +183,44 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_device_ != nullptr) {
+      this->idf_write_(data, length, false);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     for (size_t i = 0; i < length; i++) {
       this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data[i]);
     }
   }
 
+  /** Start writing data without waiting for the transfer to complete.
+   *
+   * With the ESP-IDF backend the data is sent by DMA in the background, on all other backends this is the same as
+   * write_array(). The data has to stay valid and unchanged until wait_async() or disable() is called.
+   */
+  template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE>
+  void write_array_async(const uint8_t *data, size_t length) {
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_device_ != nullptr) {
+      this->idf_write_(data, length, true);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
+    this->write_array<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data, length);
+  }
+
+  /// Wait until all transfers started by write_array_async() have completed.
+  void wait_async();
+
+  /// Write the buffers one after another, the bus isn't released in between.
+  template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE>
+  void writev(const WriteBuffer *buffers, size_t cnt) {
+    for (size_t i = 0; i < cnt; i++)
+      this->write_array_async<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(buffers[i].data, buffers[i].len);
+    this->wait_async();
+  }
+
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE>
   uint8_t transfer_byte(uint8_t data) {
     if (this->miso_ != nullptr) {
@@ -162,6 +229,12 @@ class SPIComponent : public Component {
         return this->hw_spi_->transfer(data);
       } else {
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+        if (this->idf_device_ != nullptr) {
+          this->idf_transfer_(&data, 1);
+          return data;
+        }
+#endif  // USE_SPI_ESP_IDF_BACKEND
         return this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, true, true>(data);
 #ifdef USE_SPI_ARDUINO_BACKEND
       }
@@ -183,6 +256,16 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_device_ != nullptr) {
+      if (this->miso_ != nullptr) {
+        this->idf_transfer_(data, length);
+      } else {
+        this->idf_write_(data, length, false);
+      }
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
 
     if (this->miso_ != nullptr) {
       for (size_t i = 0; i < length; i++) {
@@ -209,9 +292,18 @@ class SPIComponent : public Component {
       this->hw_spi_->beginTransaction(settings);
     } else {
 #endif  // USE_SPI_ARDUINO_BACKEND
-      this->clk_->digital_write(CLOCK_POLARITY);
-      uint32_t cpu_freq_hz = arch_get_cpu_freq_hz();
-      this->wait_cycle_ = uint32_t(cpu_freq_hz) / DATA_RATE / 2ULL;
+#ifdef USE_SPI_ESP_IDF_BACKEND
+      if (this->idf_host_ >= 0) {
+        const uint8_t mode = (CLOCK_POLARITY ? 2 : 0) | (CLOCK_PHASE ? 1 : 0);
+        this->idf_device_ = this->get_idf_device_(mode, DATA_RATE, BIT_ORDER == BIT_ORDER_LSB_FIRST);
+      } else {
+#endif  // USE_SPI_ESP_IDF_BACKEND
+        this->clk_->digital_write(CLOCK_POLARITY);
+        uint32_t cpu_freq_hz = arch_get_cpu_freq_hz();
+        this->wait_cycle_ = uint32_t(cpu_freq_hz) / DATA_RATE / 2ULL;
+#ifdef USE_SPI_ESP_IDF_BACKEND
+      }
+#endif  // USE_SPI_ESP_IDF_BACKEND
 #ifdef USE_SPI_ARDUINO_BACKEND
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
@@ -232,6 +324,23 @@ class SPIComponent : public Component {
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, bool READ, bool WRITE>
   uint8_t transfer_(uint8_t data);
 
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  /// Device handle for the settings, devices are added to the bus on first use. Marks the bus failed if that fails.
+  spi_device_handle_t get_idf_device_(uint8_t mode, uint32_t clock_speed, bool lsb_first);
+  /// Mark the bus failed after a driver error, so that nothing more is sent instead of silently truncated data.
+  void idf_fail_(const char *function, esp_err_t err);
+  void idf_write_(const uint8_t *data, size_t length, bool async);
+  /// Full duplex transfer, the received data replaces the sent data.
+  void idf_transfer_(uint8_t *data, size_t length);
+
+  struct IDFDevice {
+    uint8_t mode;
+    uint32_t clock_speed;
+    bool lsb_first;
+    spi_device_handle_t handle;
+  };
+#endif  // USE_SPI_ESP_IDF_BACKEND
+
   GPIOPin *clk_;
   GPIOPin *miso_{nullptr};
   GPIOPin *mosi_{nullptr};
@@ -239,6 +348,18 @@ class SPIComponent : public Component {
 #ifdef USE_SPI_ARDUINO_BACKEND
   SPIClass *hw_spi_{nullptr};
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  static const size_t IDF_QUEUE_SIZE = 4;
+
+  int idf_host_{-1};
+  std::vector<IDFDevice> idf_devices_;
+  /// Device of the active transaction.
+  spi_device_handle_t idf_device_{nullptr};
+  /// Ring of the queued transactions, completed in order.
+  spi_transaction_t idf_transactions_[IDF_QUEUE_SIZE];
+  size_t idf_next_transaction_{0};
+  size_t idf_pending_{0};
+#endif  // USE_SPI_ESP_IDF_BACKEND
   uint32_t wait_cycle_;
 };
 
@@ -248,6 +369,26 @@ class SPIDevice {
   SPIDevice() = default;
   SPIDevice(SPIComponent *parent, GPIOPin *cs) : parent_(parent), cs_(cs) {}
 
+  /** Enables the device for the lifetime of the object, so it's disabled again on every path out of a scope.
+   *
+   * @code
+   * {
+   *   Transaction transaction(this);
+   *   this->write_array(data, length);
+   * }
+   * @endcode
+   */
+  class Transaction {
+   public:
+    explicit Transaction(SPIDevice *device) : device_(device) { device_->enable(); }
+    Transaction(const Transaction &) = delete;
+    Transaction &operator=(const Transaction &) = delete;
+    ~Transaction() { device_->disable(); }
+
+   protected:
+    SPIDevice *device_;
+  };
+
   void set_spi_parent(SPIComponent *parent) { parent_ = parent; }
   void set_cs_pin(GPIOPin *cs) { cs_ = cs; }
 
@@ -294,6 +435,16 @@ class SPIDevice {
 
   void write_array(const std::vector<uint8_t> &data) { this->write_array(data.data(), data.size()); }
 
+  void write_array_async(const uint8_t *data, size_t length) {
+    this->parent_->template write_array_async<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data, length);
+  }
+
+  void wait_async() { this->parent_->wait_async(); }
+
+  void writev(const WriteBuffer *buffers, size_t cnt) {
+    this->parent_->template writev<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(buffers, cnt);
+  }
+
   uint8_t transfer_byte(uint8_t data) {
     return this->parent_->template transfer_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data);
   }
@@ -426,7 +426,7 @@ void HOT ST7735::write_display_data_() {
   uint16_t y1 = offsety;
   uint16_t y2 = y1 + get_height_internal() - 1;
 
-  this->enable();
+  Transaction transaction(this);
 
   // set column(x) address
   this->dc_pin_->digital_write(false);
@@ -446,21 +446,33 @@ void HOT ST7735::write_display_data_() {
   this->dc_pin_->digital_write(true);
 
   if (this->eightbitcolor_) {
-    for (size_t line = 0; line < this->get_buffer_length(); line = line + this->get_width_internal()) {
-      for (int index = 0; index < this->get_width_internal(); ++index) {
-        auto color332 = display::ColorUtil::to_color(this->buffer_[index + line], display::ColorOrder::COLOR_ORDER_RGB,
+    // convert into one buffer while the other one is being sent
+    uint8_t transfer_buffer[2][128];
+    uint8_t current = 0;
+    size_t pos = 0;
+    const size_t length = this->get_buffer_length();
+    while (pos < length) {
+      uint8_t *dst = transfer_buffer[current];
+      const size_t chunk = std::min(length - pos, sizeof(transfer_buffer[0]) / 2);
+      for (size_t i = 0; i < chunk; i++) {
+        auto color332 = display::ColorUtil::to_color(this->buffer_[pos + i], display::ColorOrder::COLOR_ORDER_RGB,
                                                      display::ColorBitness::COLOR_BITNESS_332, true);
 
         auto color = display::ColorUtil::color_to_565(color332);
 
-        this->write_byte((color >> 8) & 0xff);
-        this->write_byte(color & 0xff);
+        *dst++ = (color >> 8) & 0xff;
+        *dst++ = color & 0xff;
       }
+      this->wait_async();
+      this->write_array_async(transfer_buffer[current], chunk * 2);
+      current ^= 1;
+      pos += chunk;
     }
+    // the buffers are on the stack, so wait before returning
+    this->wait_async();
   } else {
     this->write_array(this->buffer_, this->get_buffer_length());
   }
-  this->disable();
 }
 
 void ST7735::spi_master_write_addr_(uint16_t addr1, uint16_t addr2) {
@@ -1,5 +1,6 @@
 #include "st7789v.h"
 #include "esphome/core/log.h"
+#include "esphome/core/hal.h"
 
 namespace esphome {
 namespace st7789v {
@@ -134,12 +135,17 @@ void ST7789V::update() {
 void ST7789V::loop() {}
 
 void ST7789V::write_display_data() {
-  uint16_t x1 = 52;   // _offsetx
-  uint16_t x2 = 186;  // _offsetx
-  uint16_t y1 = 40;   // _offsety
-  uint16_t y2 = 279;  // _offsety
+  // only transfer the windows that changed since the last update
+  this->for_each_changed_window_(2, [this](int x, int y, int w, int h) { this->write_window_(x, y, w, h); });
+}
 
-  this->enable();
+void ST7789V::write_window_(int x, int y, int w, int h) {
+  uint16_t x1 = 52 + x;         // _offsetx
+  uint16_t x2 = 52 + x + w - 1;  // _offsetx
+  uint16_t y1 = 40 + y;         // _offsety
+  uint16_t y2 = 40 + y + h - 1;  // _offsety
+
+  Transaction transaction(this);
 
   // set column(x) address
   this->dc_pin_->digital_write(false);
@@ -156,9 +162,15 @@ void ST7789V::write_display_data() {
   this->write_byte(ST7789_RAMWR);
   this->dc_pin_->digital_write(true);
 
-  this->write_array(this->buffer_, this->get_buffer_length_());
-
-  this->disable();
+  const size_t stride = size_t(this->get_width_internal()) * 2;
+  if (w == this->get_width_internal()) {
+    // full width rows are contiguous in the buffer
+    this->write_array(this->buffer_ + y * stride, h * stride);
+    return;
+  }
+  // queue the rows back to back, the buffer isn't touched before the transaction ends
+  for (int row = y; row < y + h; row++)
+    this->write_array_async(this->buffer_ + row * stride + x * 2, w * 2);
 }
 
 void ST7789V::init_reset_() {
@@ -270,5 +282,47 @@ void HOT ST7789V::draw_absolute_pixel_internal(int x, int y, Color color) {
   this->buffer_[pos] = color565 & 0xff;
 }
 
+void HOT ST7789V::fill_span_internal(int x, int y, int width, Color color) {
+  auto color565 = display::ColorUtil::color_to_565(color);
+  uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * 2;
+  for (int i = 0; i < width; i++) {
+    *dst++ = (color565 >> 8) & 0xff;
+    *dst++ = color565 & 0xff;
+  }
+}
+
+void HOT ST7789V::blit_bitmap_1bpp_internal(int x, int y, int width, int height, const uint8_t *data, Color color_on,
+                                            Color color_off, bool transparent) {
+  // convert both colors once instead of for every pixel
+  const uint16_t on = display::ColorUtil::color_to_565(color_on);
+  const uint16_t off = display::ColorUtil::color_to_565(color_off);
+  const uint32_t stride = (width + 7u) / 8u;
+  for (int row = 0; row < height; row++) {
+    const uint8_t *src = data + row * stride;
+    uint8_t *dst = this->buffer_ + (x + (y + row) * this->get_width_internal()) * 2;
+    for (int col = 0; col < width; col++, dst += 2) {
+      uint16_t color;
+      if (progmem_read_byte(src + col / 8u) & (0x80 >> (col % 8u))) {
+        color = on;
+      } else if (!transparent) {
+        color = off;
+      } else {
+        continue;
+      }
+      dst[0] = (color >> 8) & 0xff;
+      dst[1] = color & 0xff;
+    }
+  }
+}
+
+void HOT ST7789V::blit_rgb565_internal(int x, int y, int width, int height, const uint8_t *data) {
+  // the image data already has the layout of the buffer
+  for (int row = 0; row < height; row++) {
+    uint8_t *dst = this->buffer_ + (x + (y + row) * this->get_width_internal()) * 2;
+    for (int i = 0; i < width * 2; i++)
+      *dst++ = progmem_read_byte(data++);
+  }
+}
+
 }  // namespace st7789v
 }  // namespace esphome
@@ -147,6 +147,11 @@ class ST7789V : public PollingComponent,
   void draw_filled_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_bitmap_1bpp_internal(int x, int y, int width, int height, const uint8_t *data, Color color_on,
+                                 Color color_off, bool transparent) override;
+  void blit_rgb565_internal(int x, int y, int width, int height, const uint8_t *data) override;
+  void write_window_(int x, int y, int w, int h);
 };
 
 }  // namespace st7789v
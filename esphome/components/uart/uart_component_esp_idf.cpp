@@ -13,6 +13,8 @@
 namespace esphome {
 namespace uart {
 static const char *const TAG = "uart.idf";
+/// Events the driver can queue before the RX wake task fetches them, further events are dropped.
+static const int UART_EVENT_QUEUE_SIZE = 8;
 
 uart_config_t IDFUARTComponent::get_config_() {
   uart_parity_t parity = UART_PARITY_DISABLE;
@@ -79,7 +81,7 @@ void IDFUARTComponent::setup() {
     return;
   }
 
-  err = uart_driver_install(this->uart_num_, this->rx_buffer_size_, 0, 0, nullptr, 0);
+  err = uart_driver_install(this->uart_num_, this->rx_buffer_size_, 0, UART_EVENT_QUEUE_SIZE, &this->event_queue_, 0);
   if (err != ESP_OK) {
     ESP_LOGW(TAG, "uart_driver_install failed: %s", esp_err_to_name(err));
     this->mark_failed();
@@ -109,9 +111,28 @@ void IDFUARTComponent::setup() {
     return;
   }
 
+  if (this->rx_pin_ != nullptr) {
+    // The driver reports received data through the event queue, wake the loop on it so that the bytes are read
+    // right away instead of after the rest of the loop interval
+    if (xTaskCreate(IDFUARTComponent::rx_event_task_, "uart_rx_wake", 2048, this->event_queue_,
+                    uxTaskPriorityGet(nullptr), nullptr) != pdPASS) {
+      ESP_LOGW(TAG, "Could not create the RX wake task, received data is read in the next loop iteration");
+    }
+  }
+
   xSemaphoreGive(this->lock_);
 }
 
+void IDFUARTComponent::rx_event_task_(void *arg) {
+  auto *event_queue = static_cast<QueueHandle_t>(arg);
+  uart_event_t event;
+  while (true) {
+    // Data, a full buffer and an overflow all leave bytes for loop() to read
+    if (xQueueReceive(event_queue, &event, portMAX_DELAY) == pdTRUE)
+      App.wake_loop();
+  }
+}
+
 void IDFUARTComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "UART Bus:");
   ESP_LOGCONFIG(TAG, "  Number: %u", this->uart_num_);
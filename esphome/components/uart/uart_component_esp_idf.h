@@ -28,6 +28,9 @@ class IDFUARTComponent : public UARTComponent, public Component {
   uart_port_t uart_num_;
   uart_config_t get_config_();
   SemaphoreHandle_t lock_;
+  /// Driver events, rx_event_task_() wakes the main loop on them.
+  QueueHandle_t event_queue_{nullptr};
+  static void rx_event_task_(void *arg);
 
   bool has_peek_{false};
   uint8_t peek_byte_;
@@ -157,6 +157,16 @@ void WaveshareEPaper::start_data_() {
   this->enable();
 }
 void WaveshareEPaper::end_data_() { this->disable(); }
+void WaveshareEPaper::write_fill_(uint8_t value, size_t length) {
+  uint8_t buffer[64];
+  memset(buffer, value, sizeof(buffer));
+  while (length > 0) {
+    const size_t chunk = std::min(length, sizeof(buffer));
+    this->write_array_async(buffer, chunk);
+    length -= chunk;
+  }
+  this->wait_async();
+}
 void WaveshareEPaper::on_safe_shutdown() { this->deep_sleep(); }
 
 // ========================================================
@@ -346,11 +356,10 @@ void HOT WaveshareEPaperTypeA::display() {
   switch (this->model_) {
     case TTGO_EPAPER_2_13_IN_B1: {  // block needed because of variable initializations
       int16_t wb = ((this->get_width_internal()) >> 3);
+      // rows are sent in reverse order, each one is contiguous in the buffer
       for (int i = 0; i < this->get_height_internal(); i++) {
-        for (int j = 0; j < wb; j++) {
-          int idx = j + (this->get_height_internal() - 1 - i) * wb;
-          this->write_byte(this->buffer_[idx]);
-        }
+        int idx = (this->get_height_internal() - 1 - i) * wb;
+        this->write_array_async(this->buffer_ + idx, wb);
       }
       break;
     }
@@ -638,8 +647,7 @@ void HOT WaveshareEPaper2P9InB::display() {
   this->command(0x13);
   delay(2);
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++)
-    this->write_byte(0x00);
+  this->write_fill_(0x00, this->get_buffer_length_());
   this->end_data_();
   delay(2);
 
@@ -817,8 +825,7 @@ void HOT WaveshareEPaper4P2InBV2::display() {
   // COMMAND DATA START TRANSMISSION 2 (RED data)
   this->command(0x13);
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++)
-    this->write_byte(0xFF);
+  this->write_fill_(0xFF, this->get_buffer_length_());
   this->end_data_();
   delay(2);
 
@@ -985,8 +992,7 @@ void HOT WaveshareEPaper7P5InBV2::display() {
   this->command(0x13);
   delay(2);
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++)
-    this->write_byte(0x00);
+  this->write_fill_(0x00, this->get_buffer_length_());
   this->end_data_();
   delay(2);
 
@@ -1456,8 +1462,7 @@ void HOT WaveshareEPaper7P5InHDB::display() {
   // RED
   this->command(0x26);
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++)
-    this->write_byte(0x00);
+  this->write_fill_(0x00, this->get_buffer_length_());
   this->end_data_();
 
   this->command(0x22);
@@ -61,6 +61,8 @@ class WaveshareEPaper : public PollingComponent,
   void end_command_();
   void start_data_();
   void end_data_();
+  /// Send the same byte length times, the data has to be started already.
+  void write_fill_(uint8_t value, size_t length);
 
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *dc_pin_;
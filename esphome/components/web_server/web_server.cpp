@@ -6,6 +6,7 @@
 #include "esphome/core/application.h"
 #include "esphome/core/entity_base.h"
 #include "esphome/core/util.h"
+#include "esphome/core/profiler.h"
 #include "esphome/components/json/json_util.h"
 #include "esphome/components/network/util.h"
 
@@ -96,10 +97,10 @@ void WebServer::setup() {
   this->events_.onConnect([this](AsyncEventSourceClient *client) {
     // Configure reconnect timeout and send config
 
-    client->send(json::build_json([this](JsonObject root) {
-                   root["title"] = App.get_name();
-                   root["ota"] = this->allow_ota_;
-                   root["lang"] = "en";
+    client->send(json::write_json([this](json::JsonWriter &root) {
+                   root.add("title", App.get_name());
+                   root.add("ota", this->allow_ota_);
+                   root.add("lang", "en");
                  }).c_str(),
                  "ping", millis(), 30000);
 
@@ -118,12 +119,55 @@ void WebServer::setup() {
   if (this->allow_ota_)
     this->base_->add_ota_handler();
 
-  this->set_interval(10000, [this]() { this->events_.send("", "ping", millis(), 30000); });
+  this->set_interval(10000, [this]() {
+    this->events_.send("", "ping", millis(), 30000);
+    if (this->state_events_sent_ != this->logged_state_events_sent_) {
+      ESP_LOGD(TAG, "State events: %u sent, %u coalesced", this->state_events_sent_, this->state_events_suppressed_);
+      this->logged_state_events_sent_ = this->state_events_sent_;
+    }
+  });
+}
+void WebServer::loop() {
+  this->entities_iterator_.advance();
+
+  if (this->pending_count_ == 0)
+    return;
+  const uint32_t now = millis();
+  if (now - this->last_state_events_ < this->throttle_)
+    return;
+  this->last_state_events_ = now;
+  this->send_state_events_();
 }
-void WebServer::loop() { this->entities_iterator_.advance(); }
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->base_->get_port());
+  ESP_LOGCONFIG(TAG, "  Throttle: %ums", this->throttle_);
+  ESP_LOGCONFIG(TAG, "  State events: %u sent, %u coalesced", this->state_events_sent_,
+                this->state_events_suppressed_);
+}
+
+void WebServer::schedule_state_event_(EntityBase *obj, state_json_t json) {
+  // Without clients there's nobody to send the state to, new clients receive all states when they connect
+  if (this->events_.count() == 0)
+    return;
+  state_json_t &pending = this->pending_states_[obj];
+  if (pending != nullptr) {
+    this->state_events_suppressed_++;
+    return;
+  }
+  pending = json;
+  this->pending_count_++;
+}
+void WebServer::send_state_events_() {
+  // The JSON is built from the current state of each entity, so it's always the latest one
+  for (auto &it : this->pending_states_) {
+    if (it.second == nullptr)
+      continue;
+    this->events_.send(it.second(this, it.first).c_str(), "state");
+    it.second = nullptr;
+  }
+  this->state_events_sent_ += this->pending_count_;
+  this->pending_count_ = 0;
 }
 float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
 
@@ -328,25 +372,40 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 }
 #endif
 
-#define set_json_id(root, obj, sensor, start_config) \
-  (root)["id"] = sensor; \
-  if (((start_config) == DETAIL_ALL)) \
-    (root)["name"] = (obj)->get_name();
+static void set_json_id(json::JsonWriter &root, EntityBase *obj, const std::string &id, JsonDetail start_config) {
+  root.add("id", id);
+  if (start_config == DETAIL_ALL)
+    root.add("name", obj->get_name());
+}
 
-#define set_json_value(root, obj, sensor, value, start_config) \
-  set_json_id((root), (obj), sensor, start_config)(root)["value"] = value;
+template<typename V>
+static void set_json_value(json::JsonWriter &root, EntityBase *obj, const std::string &id, const V &value,
+                           JsonDetail start_config) {
+  set_json_id(root, obj, id, start_config);
+  root.add("value", value);
+}
 
-#define set_json_state_value(root, obj, sensor, state, value, start_config) \
-  set_json_value(root, obj, sensor, value, start_config)(root)["state"] = state;
+template<typename S, typename V>
+static void set_json_state_value(json::JsonWriter &root, EntityBase *obj, const std::string &id, const S &state,
+                                 const V &value, JsonDetail start_config) {
+  set_json_value(root, obj, id, value, start_config);
+  root.add("state", state);
+}
 
-#define set_json_icon_state_value(root, obj, sensor, state, value, start_config) \
-  set_json_value(root, obj, sensor, value, start_config)(root)["state"] = state; \
-  if (((start_config) == DETAIL_ALL)) \
-    (root)["icon"] = (obj)->get_icon();
+template<typename S, typename V>
+static void set_json_icon_state_value(json::JsonWriter &root, EntityBase *obj, const std::string &id, const S &state,
+                                      const V &value, JsonDetail start_config) {
+  set_json_state_value(root, obj, id, state, value, start_config);
+  if (start_config == DETAIL_ALL)
+    root.add("icon", obj->get_icon());
+}
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  this->events_.send(this->sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    auto *sensor = static_cast<sensor::Sensor *>(entity);
+    return web_server->sensor_json(sensor, sensor->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (sensor::Sensor *obj : App.get_sensors()) {
@@ -359,7 +418,7 @@ void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
     if (!obj->get_unit_of_measurement().empty())
       state += " " + obj->get_unit_of_measurement();
@@ -370,7 +429,10 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  this->events_.send(this->text_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    auto *text_sensor = static_cast<text_sensor::TextSensor *>(entity);
+    return web_server->text_sensor_json(text_sensor, text_sensor->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
@@ -384,7 +446,7 @@ void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
                                         JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
   });
 }
@@ -392,10 +454,13 @@ std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std:
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  this->events_.send(this->switch_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    auto *a_switch = static_cast<switch_::Switch *>(entity);
+    return web_server->switch_json(a_switch, a_switch->state, DETAIL_STATE);
+  });
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
   });
 }
@@ -427,8 +492,9 @@ void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlM
 
 #ifdef USE_BUTTON
 std::string WebServer::button_json(button::Button *obj, JsonDetail start_config) {
-  return json::build_json(
-      [obj, start_config](JsonObject root) { set_json_id(root, obj, "button-" + obj->get_object_id(), start_config); });
+  return json::write_json([obj, start_config](json::JsonWriter &root) {
+    set_json_id(root, obj, "button-" + obj->get_object_id(), start_config);
+  });
 }
 
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -450,10 +516,13 @@ void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlM
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  this->events_.send(this->binary_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    auto *binary_sensor = static_cast<binary_sensor::BinarySensor *>(entity);
+    return web_server->binary_sensor_json(binary_sensor, binary_sensor->state, DETAIL_STATE);
+  });
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
   });
 }
@@ -470,17 +539,21 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
 #endif
 
 #ifdef USE_FAN
-void WebServer::on_fan_update(fan::Fan *obj) { this->events_.send(this->fan_json(obj, DETAIL_STATE).c_str(), "state"); }
+void WebServer::on_fan_update(fan::Fan *obj) {
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    return web_server->fan_json(static_cast<fan::Fan *>(entity), DETAIL_STATE);
+  });
+}
 std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonWriter &root) {
     set_json_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state, start_config);
     const auto traits = obj->get_traits();
     if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
-      root["speed_count"] = traits.supported_speed_count();
+      root.add("speed_level", obj->speed);
+      root.add("speed_count", traits.supported_speed_count());
     }
     if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
+      root.add("oscillation", obj->oscillating);
   });
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -542,7 +615,9 @@ void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatc
 
 #ifdef USE_LIGHT
 void WebServer::on_light_update(light::LightState *obj) {
-  this->events_.send(this->light_json(obj, DETAIL_STATE).c_str(), "state");
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    return web_server->light_json(static_cast<light::LightState *>(entity), DETAIL_STATE);
+  });
 }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (light::LightState *obj : App.get_lights()) {
@@ -603,17 +678,20 @@ void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::light_json(light::LightState *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "light-" + obj->get_object_id(), start_config);
-    root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
+    // dump_json() adds the state for all known color modes, keys are written as they come and mustn't repeat
+    if (!(obj->remote_values.get_color_mode() & light::ColorCapability::ON_OFF))
+      root.add("state", obj->remote_values.is_on() ? "ON" : "OFF");
 
     light::LightJSONSchema::dump_json(*obj, root);
     if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("effects");
-      opt.add("None");
+      root.begin_array("effects");
+      root.add_value("None");
       for (auto const &option : obj->get_effects()) {
-        opt.add(option->get_name());
+        root.add_value(option->get_name());
       }
+      root.end_array();
     }
   });
 }
@@ -621,7 +699,9 @@ std::string WebServer::light_json(light::LightState *obj, JsonDetail start_confi
 
 #ifdef USE_COVER
 void WebServer::on_cover_update(cover::Cover *obj) {
-  this->events_.send(this->cover_json(obj, DETAIL_STATE).c_str(), "state");
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    return web_server->cover_json(static_cast<cover::Cover *>(entity), DETAIL_STATE);
+  });
 }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (cover::Cover *obj : App.get_covers()) {
@@ -665,20 +745,23 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonWriter &root) {
     set_json_state_value(root, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
                          obj->position, start_config);
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
+    root.add("current_operation", cover::cover_operation_to_str(obj->current_operation));
 
     if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
+      root.add("tilt", obj->tilt);
   });
 }
 #endif
 
 #ifdef USE_NUMBER
 void WebServer::on_number_update(number::Number *obj, float state) {
-  this->events_.send(this->number_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    auto *number = static_cast<number::Number *>(entity);
+    return web_server->number_json(number, number->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_numbers()) {
@@ -711,20 +794,20 @@ void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlM
 }
 
 std::string WebServer::number_json(number::Number *obj, float value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "number-" + obj->get_object_id(), start_config);
     if (start_config == DETAIL_ALL) {
-      root["min_value"] = obj->traits.get_min_value();
-      root["max_value"] = obj->traits.get_max_value();
-      root["step"] = obj->traits.get_step();
-      root["mode"] = (int) obj->traits.get_mode();
+      root.add("min_value", obj->traits.get_min_value());
+      root.add("max_value", obj->traits.get_max_value());
+      root.add("step", obj->traits.get_step());
+      root.add("mode", (int) obj->traits.get_mode());
     }
     std::string state = str_sprintf("%f", value);
-    root["state"] = state;
+    root.add("state", state);
     if (isnan(value)) {
-      root["value"] = "\"NaN\"";
+      root.add("value", "\"NaN\"");
     } else {
-      root["value"] = value;
+      root.add("value", value);
     }
   });
 }
@@ -732,7 +815,10 @@ std::string WebServer::number_json(number::Number *obj, float value, JsonDetail
 
 #ifdef USE_SELECT
 void WebServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
-  this->events_.send(this->select_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    auto *select = static_cast<select::Select *>(entity);
+    return web_server->select_json(select, select->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_selects()) {
@@ -764,13 +850,14 @@ void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_state_value(root, obj, "select-" + obj->get_object_id(), value, value, start_config);
     if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("option");
+      root.begin_array("option");
       for (auto &option : obj->traits.get_options()) {
-        opt.add(option);
+        root.add_value(option);
       }
+      root.end_array();
     }
   });
 }
@@ -778,7 +865,9 @@ std::string WebServer::select_json(select::Select *obj, const std::string &value
 
 #ifdef USE_CLIMATE
 void WebServer::on_climate_update(climate::Climate *obj) {
-  this->events_.send(this->climate_json(obj, DETAIL_STATE).c_str(), "state");
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    return web_server->climate_json(static_cast<climate::Climate *>(entity), DETAIL_STATE);
+  });
 }
 
 void WebServer::handle_climate_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -836,74 +925,80 @@ void WebServer::handle_climate_request(AsyncWebServerRequest *request, const Url
 #define PSTR_LOCAL(mode_s) strncpy_P(__buf, (PGM_P)((mode_s)), 15)
 
 std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "climate-" + obj->get_object_id(), start_config);
     const auto traits = obj->get_traits();
     char __buf[16];
 
     if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("modes");
+      root.begin_array("modes");
       for (climate::ClimateMode m : traits.get_supported_modes())
-        opt.add(PSTR_LOCAL(climate::climate_mode_to_string(m)));
+        root.add_value(PSTR_LOCAL(climate::climate_mode_to_string(m)));
+      root.end_array();
       if (!traits.get_supported_custom_fan_modes().empty()) {
-        JsonArray opt = root.createNestedArray("fan_modes");
+        root.begin_array("fan_modes");
         for (climate::ClimateFanMode m : traits.get_supported_fan_modes())
-          opt.add(PSTR_LOCAL(climate::climate_fan_mode_to_string(m)));
+          root.add_value(PSTR_LOCAL(climate::climate_fan_mode_to_string(m)));
+        root.end_array();
       }
 
       if (!traits.get_supported_custom_fan_modes().empty()) {
-        JsonArray opt = root.createNestedArray("custom_fan_modes");
+        root.begin_array("custom_fan_modes");
         for (auto const &custom_fan_mode : traits.get_supported_custom_fan_modes())
-          opt.add(custom_fan_mode);
+          root.add_value(custom_fan_mode);
+        root.end_array();
       }
       if (traits.get_supports_swing_modes()) {
-        JsonArray opt = root.createNestedArray("swing_modes");
+        root.begin_array("swing_modes");
         for (auto swing_mode : traits.get_supported_swing_modes())
-          opt.add(PSTR_LOCAL(climate::climate_swing_mode_to_string(swing_mode)));
+          root.add_value(PSTR_LOCAL(climate::climate_swing_mode_to_string(swing_mode)));
+        root.end_array();
       }
       if (traits.get_supports_presets() && obj->preset.has_value()) {
-        JsonArray opt = root.createNestedArray("presets");
+        root.begin_array("presets");
         for (climate::ClimatePreset m : traits.get_supported_presets())
-          opt.add(PSTR_LOCAL(climate::climate_preset_to_string(m)));
+          root.add_value(PSTR_LOCAL(climate::climate_preset_to_string(m)));
+        root.end_array();
       }
       if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
-        JsonArray opt = root.createNestedArray("custom_presets");
+        root.begin_array("custom_presets");
         for (auto const &custom_preset : traits.get_supported_custom_presets())
-          opt.add(custom_preset);
+          root.add_value(custom_preset);
+        root.end_array();
       }
     }
 
-    root["mode"] = PSTR_LOCAL(climate_mode_to_string(obj->mode));
-    root["max_temp"] = traits.get_visual_max_temperature();
-    root["min_temp"] = traits.get_visual_min_temperature();
-    root["step"] = traits.get_visual_temperature_step();
+    root.add("mode", PSTR_LOCAL(climate_mode_to_string(obj->mode)));
+    root.add("max_temp", traits.get_visual_max_temperature());
+    root.add("min_temp", traits.get_visual_min_temperature());
+    root.add("step", traits.get_visual_temperature_step());
     if (traits.get_supports_action()) {
-      root["action"] = PSTR_LOCAL(climate_action_to_string(obj->action));
+      root.add("action", PSTR_LOCAL(climate_action_to_string(obj->action)));
     }
     if (traits.get_supports_fan_modes() && obj->fan_mode.has_value()) {
-      root["fan_mode"] = PSTR_LOCAL(climate_fan_mode_to_string(obj->fan_mode.value()));
+      root.add("fan_mode", PSTR_LOCAL(climate_fan_mode_to_string(obj->fan_mode.value())));
     }
     if (!traits.get_supported_custom_fan_modes().empty() && obj->custom_fan_mode.has_value()) {
-      root["custom_fan_mode"] = obj->custom_fan_mode.value().c_str();
+      root.add("custom_fan_mode", obj->custom_fan_mode.value().c_str());
     }
     if (traits.get_supports_presets() && obj->preset.has_value()) {
-      root["preset"] = PSTR_LOCAL(climate_preset_to_string(obj->preset.value()));
+      root.add("preset", PSTR_LOCAL(climate_preset_to_string(obj->preset.value())));
     }
     if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
-      root["custom_preset"] = obj->custom_preset.value().c_str();
+      root.add("custom_preset", obj->custom_preset.value().c_str());
     }
     if (traits.get_supports_swing_modes()) {
-      root["swing_mode"] = PSTR_LOCAL(climate_swing_mode_to_string(obj->swing_mode));
+      root.add("swing_mode", PSTR_LOCAL(climate_swing_mode_to_string(obj->swing_mode)));
     }
     if (traits.get_supports_current_temperature()) {
-      root["current_temperature"] = obj->current_temperature;
+      root.add("current_temperature", obj->current_temperature);
     }
     if (traits.get_supports_two_point_target_temperature()) {
-      root["current_temperature_low"] = obj->target_temperature_low;
-      root["current_temperature_high"] = obj->target_temperature_low;
+      root.add("current_temperature_low", obj->target_temperature_low);
+      root.add("current_temperature_high", obj->target_temperature_low);
     } else {
-      root["target_temperature"] = obj->target_temperature;
-      root["state"] = obj->target_temperature;
+      root.add("target_temperature", obj->target_temperature);
+      root.add("state", obj->target_temperature);
     }
   });
 }
@@ -911,12 +1006,15 @@ std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_conf
 
 #ifdef USE_LOCK
 void WebServer::on_lock_update(lock::Lock *obj) {
-  this->events_.send(this->lock_json(obj, obj->state, DETAIL_STATE).c_str(), "state");
+  this->schedule_state_event_(obj, [](WebServer *web_server, EntityBase *entity) {
+    auto *a_lock = static_cast<lock::Lock *>(entity);
+    return web_server->lock_json(a_lock, a_lock->state, DETAIL_STATE);
+  });
 }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
-                              start_config);
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
+    set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value),
+                              static_cast<int>(value), start_config);
   });
 }
 void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -945,6 +1043,36 @@ void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMat
 }
 #endif
 
+#ifdef USE_PROFILER
+void WebServer::handle_profile_request(AsyncWebServerRequest *request) {
+  static const char *const SOURCES[] = {"loop", "timeout", "interval"};
+  // This runs in the web server's task, so work on a copy instead of the statistics the main loop records into
+  const ProfileSnapshot snapshot = global_profiler.snapshot(request->hasParam("reset"));
+  std::string data = json::write_json([&snapshot](json::JsonWriter &root) {
+    root.add("duration_ms", snapshot.duration_ms);
+    root.begin_array("entries");
+    for (const auto &entry : snapshot.entries) {
+      root.begin_object();
+      root.add("component", entry.component != nullptr ? entry.component->get_component_source() : "<null>");
+      root.add("source", SOURCES[static_cast<uint8_t>(entry.source)]);
+      root.add("name_hash", entry.name_hash);
+      root.add("count", entry.stats.count);
+      root.add("total_us", entry.stats.total_us);
+      root.add("max_us", entry.stats.max_us);
+      root.add("p50_us", entry.stats.percentile_us(50));
+      root.add("p99_us", entry.stats.percentile_us(99));
+      root.begin_array("buckets");
+      for (uint32_t bucket : entry.stats.buckets)
+        root.add_value(bucket);
+      root.end_array();
+      root.end_object();
+    }
+    root.end_array();
+  });
+  request->send(200, "application/json", data.c_str());
+}
+#endif
+
 bool WebServer::canHandle(AsyncWebServerRequest *request) {
   if (request->url() == "/")
     return true;
@@ -959,6 +1087,11 @@ bool WebServer::canHandle(AsyncWebServerRequest *request) {
     return true;
 #endif
 
+#ifdef USE_PROFILER
+  if (request->method() == HTTP_GET && request->url() == "/debug/profile")
+    return true;
+#endif
+
   UrlMatch match = match_url(request->url().c_str(), true);
   if (!match.valid)
     return false;
@@ -1044,6 +1177,13 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
   }
 #endif
 
+#ifdef USE_PROFILER
+  if (request->url() == "/debug/profile") {
+    this->handle_profile_request(request);
+    return;
+  }
+#endif
+
   UrlMatch match = match_url(request->url().c_str());
 #ifdef USE_SENSOR
   if (match.domain == "sensor") {
@@ -7,7 +7,9 @@
 #include "esphome/components/web_server_base/web_server_base.h"
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
+#include "esphome/core/entity_base.h"
 
+#include <unordered_map>
 #include <vector>
 
 namespace esphome {
@@ -73,6 +75,17 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    * @param allow_ota.
    */
   void set_allow_ota(bool allow_ota) { this->allow_ota_ = allow_ota; }
+  /** Set the minimum time between two batches of state events. State changes in between are coalesced, so only
+   * the latest state of each entity is sent. Defaults to 0, which still coalesces the changes within one loop.
+   *
+   * @param throttle The minimum interval in milliseconds, 0 sends the state changes in the next loop.
+   */
+  void set_throttle(uint32_t throttle) { this->throttle_ = throttle; }
+
+  /// The number of state events sent to the connected clients.
+  uint32_t get_state_events_sent() const { return this->state_events_sent_; }
+  /// The number of state changes that weren't sent, because a newer state of the same entity replaced them.
+  uint32_t get_state_events_suppressed() const { return this->state_events_suppressed_; }
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -98,6 +111,11 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   void handle_js_request(AsyncWebServerRequest *request);
 #endif
 
+#ifdef USE_PROFILER
+  /// Handle a profiler statistics request under '/debug/profile'.
+  void handle_profile_request(AsyncWebServerRequest *request);
+#endif
+
 #ifdef USE_SENSOR
   void on_sensor_update(sensor::Sensor *obj, float state) override;
   /// Handle a sensor request under '/sensor/<id>'.
@@ -221,6 +239,14 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 
  protected:
   friend ListEntitiesIterator;
+
+  /// Builds the JSON state event of an entity from its current state.
+  using state_json_t = std::string (*)(WebServer *web_server, EntityBase *obj);
+
+  /// Mark the state of an entity as changed, it's sent with the next batch of state events.
+  void schedule_state_event_(EntityBase *obj, state_json_t json);
+  void send_state_events_();
+
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
   ListEntitiesIterator entities_iterator_;
@@ -230,6 +256,15 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   const char *js_include_{nullptr};
   bool include_internal_{false};
   bool allow_ota_{true};
+  uint32_t throttle_{0};
+  /// Every entity that had a state change while a client was connected, the value is the JSON builder if the
+  /// change hasn't been sent yet and nullptr otherwise. Entries are kept so that the map doesn't allocate again.
+  std::unordered_map<EntityBase *, state_json_t> pending_states_;
+  size_t pending_count_{0};
+  uint32_t last_state_events_{0};
+  uint32_t state_events_sent_{0};
+  uint32_t state_events_suppressed_{0};
+  uint32_t logged_state_events_sent_{0};
 };
 
 }  // namespace web_server
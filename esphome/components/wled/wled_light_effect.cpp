@@ -4,6 +4,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+
 #ifdef USE_ESP32
 #include <WiFi.h>
 #endif
@@ -176,17 +178,11 @@ bool WLEDLightEffect::parse_drgb_frame_(light::AddressableLight &it, const uint8
     return false;
   }
 
-  auto count = size / 3;
-  auto max_leds = it.size();
-
-  for (uint16_t led = 0; led < count; ++led, payload += 3) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
+  auto count = std::min<int32_t>(size / 3, it.size());
 
-    if (led < max_leds) {
-      it[led].set(Color(r, g, b));
-    }
+  for (auto led : it.range(0, count)) {
+    led.set(Color(payload[0], payload[1], payload[2]));
+    payload += 3;
   }
 
   return true;
@@ -198,18 +194,11 @@ bool WLEDLightEffect::parse_drgbw_frame_(light::AddressableLight &it, const uint
     return false;
   }
 
-  auto count = size / 4;
-  auto max_leds = it.size();
-
-  for (uint16_t led = 0; led < count; ++led, payload += 4) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
-    uint8_t w = payload[3];
+  auto count = std::min<int32_t>(size / 4, it.size());
 
-    if (led < max_leds) {
-      it[led].set(Color(r, g, b, w));
-    }
+  for (auto led : it.range(0, count)) {
+    led.set(Color(payload[0], payload[1], payload[2], payload[3]));
+    payload += 4;
   }
 
   return true;
@@ -230,17 +219,13 @@ bool WLEDLightEffect::parse_dnrgb_frame_(light::AddressableLight &it, const uint
     return false;
   }
 
-  auto count = size / 3;
-  auto max_leds = it.size();
-
-  for (; count > 0; count--, payload += 3, led++) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
+  if (led >= it.size())
+    return true;
+  auto count = std::min<int32_t>(size / 3, it.size() - led);
 
-    if (led < max_leds) {
-      it[led].set(Color(r, g, b));
-    }
+  for (auto output : it.range(led, led + count)) {
+    output.set(Color(payload[0], payload[1], payload[2]));
+    payload += 3;
   }
 
   return true;
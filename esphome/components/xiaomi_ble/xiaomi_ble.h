@@ -71,6 +71,7 @@ bool report_xiaomi_results(const optional<XiaomiParseResult> &result, const std:
 
 class XiaomiListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  XiaomiListener() { this->add_match_service_data_uuid(esp32_ble_tracker::ESPBTUUID::from_uint16(0xFE95)); }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
@@ -162,6 +162,7 @@ CONF_DEFAULT_TRANSITION_LENGTH = "default_transition_length"
 CONF_DELAY = "delay"
 CONF_DELIMITER = "delimiter"
 CONF_DELTA = "delta"
+CONF_DELTA_UPDATES = "delta_updates"
 CONF_DEVICE = "device"
 CONF_DEVICE_CLASS = "device_class"
 CONF_DEVICE_FACTOR = "device_factor"
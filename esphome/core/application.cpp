@@ -2,11 +2,21 @@
 #include "esphome/core/log.h"
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/profiler.h"
 
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+#include "esphome/components/socket/headers.h"
+#include <cerrno>
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/timers.h>
+#endif
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
@@ -71,6 +81,9 @@ void Application::loop() {
   for (Component *component : this->looping_components_) {
     {
       WarnIfComponentBlockingGuard guard{component};
+#ifdef USE_PROFILER
+      ProfileGuard profile{component, ProfileSource::LOOP};
+#endif
       component->call();
     }
     new_app_state |= component->get_component_state();
@@ -93,7 +106,7 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    this->wait_for_wake_(delay_time);
   }
   this->last_loop_ = now;
 
@@ -110,6 +123,102 @@ void Application::loop() {
   }
 }
 
+void IRAM_ATTR Application::wake_loop() {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  // One datagram ends select(), further wakes before the loop drained it don't need another one. This keeps interrupts
+  // that fire at a high rate from flooding the timer task queue.
+  if (this->wake_socket_fd_ >= 0 && !this->wake_datagram_pending_) {
+    this->wake_datagram_pending_ = true;
+#ifdef USE_ESP32
+    if (xPortInIsrContext()) {
+      // Sockets can't be used from interrupts, send the datagram from the timer task instead
+      BaseType_t higher_priority_task_woken = pdFALSE;
+      if (xTimerPendFunctionCallFromISR(
+              [](void *app, uint32_t) { static_cast<Application *>(app)->send_wake_datagram_(); }, this, 0,
+              &higher_priority_task_woken) != pdPASS) {
+        this->wake_datagram_pending_ = false;
+      }
+      if (higher_priority_task_woken)
+        portYIELD_FROM_ISR();
+    } else {
+      this->send_wake_datagram_();
+    }
+#else
+    this->send_wake_datagram_();
+#endif
+  }
+#endif
+  arch_wake_loop();
+}
+void Application::wait_for_wake_(uint32_t ms) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  if (!this->socket_fds_.empty()) {
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    int max_fd = this->wake_socket_fd_;
+    if (this->wake_socket_fd_ >= 0)
+      FD_SET(this->wake_socket_fd_, &read_fds);
+    for (int fd : this->socket_fds_) {
+      FD_SET(fd, &read_fds);
+      max_fd = std::max(max_fd, fd);
+    }
+    struct timeval tv;
+    tv.tv_sec = ms / 1000;
+    tv.tv_usec = (ms % 1000) * 1000;
+    int ret = ::select(max_fd + 1, &read_fds, nullptr, nullptr, &tv);
+    if (ret > 0 && this->wake_socket_fd_ >= 0 && FD_ISSET(this->wake_socket_fd_, &read_fds)) {
+      // Cleared before draining, so that a wake from now on sends a new datagram
+      this->wake_datagram_pending_ = false;
+      uint8_t buf[16];
+      while (::recv(this->wake_socket_fd_, buf, sizeof(buf), MSG_DONTWAIT) > 0) {
+      }
+    }
+    if (ret >= 0)
+      return;
+    ESP_LOGV(TAG, "select() failed: errno=%d", errno);
+  }
+#endif
+  arch_wait_for_wake(ms);
+}
+#ifdef USE_SOCKET_SELECT_SUPPORT
+void Application::register_socket_fd(int fd) {
+  if (fd < 0)
+    return;
+  if (this->wake_socket_fd_ < 0) {
+    // Loopback socket connected to itself, wake_loop() sends a datagram to it to interrupt select()
+    int wake_fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    if (wake_fd < 0 || ::bind(wake_fd, (struct sockaddr *) &addr, addr_len) != 0 ||
+        ::getsockname(wake_fd, (struct sockaddr *) &addr, &addr_len) != 0 ||
+        ::connect(wake_fd, (struct sockaddr *) &addr, addr_len) != 0) {
+      ESP_LOGW(TAG, "Could not create loop wake socket: errno=%d", errno);
+      if (wake_fd >= 0)
+        ::close(wake_fd);
+    } else {
+      ::fcntl(wake_fd, F_SETFL, ::fcntl(wake_fd, F_GETFL, 0) | O_NONBLOCK);
+      this->wake_socket_fd_ = wake_fd;
+    }
+  }
+  this->socket_fds_.push_back(fd);
+}
+void Application::unregister_socket_fd(int fd) {
+  auto it = std::find(this->socket_fds_.begin(), this->socket_fds_.end(), fd);
+  if (it == this->socket_fds_.end())
+    return;
+  *it = this->socket_fds_.back();
+  this->socket_fds_.pop_back();
+}
+void Application::send_wake_datagram_() {
+  // If the socket buffer is full a wake is pending already, other errors allow the next wake to try again
+  const uint8_t byte = 0;
+  if (::send(this->wake_socket_fd_, &byte, 1, MSG_DONTWAIT) < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+    this->wake_datagram_pending_ = false;
+}
+#endif
+
 void IRAM_ATTR HOT Application::feed_wdt() {
   static uint32_t last_feed = 0;
   uint32_t now = micros();
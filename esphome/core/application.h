@@ -149,10 +149,29 @@ class Application {
    * Each component can request a high frequency loop execution by using the HighFrequencyLoopRequester
    * helper in helpers.h
    *
+   * The sleep ends early when the loop is woken with wake_loop() (for example when data arrives on the API socket),
+   * so a longer interval doesn't delay reactions to such events.
+   *
    * @param loop_interval The interval in milliseconds to run the core loop at. Defaults to 16 milliseconds.
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  /** Wake the main loop if it's sleeping between iterations, or make its next sleep return immediately.
+   *
+   * Components call this when work arrives outside of the loop task so that the loop reacts right away instead of
+   * after the remainder of the loop interval. Currently that's data on the API and other sockets, bytes received by
+   * the ESP-IDF and ESP8266 software UARTs (the Arduino hardware UARTs have no receive hook and are still read on the
+   * next iteration), and the rotary encoder and touchscreen interrupts. Safe to call from other tasks and from
+   * interrupts; repeated calls before the loop woke up are cheap.
+   */
+  void wake_loop();
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  /// Wake the main loop whenever the given socket becomes readable, see socket::socket_loop_monitored().
+  void register_socket_fd(int fd);
+  void unregister_socket_fd(int fd);
+#endif
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -294,6 +313,12 @@ class Application {
 
   void feed_wdt_arch_();
 
+  /// Sleep for up to ms milliseconds, returning early when the loop is woken.
+  void wait_for_wake_(uint32_t ms);
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  void send_wake_datagram_();
+#endif
+
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
 
@@ -344,6 +369,13 @@ class Application {
   uint32_t loop_interval_{16};
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  std::vector<int> socket_fds_{};
+  /// Loopback UDP socket that wake_loop() writes to, so that it also interrupts select().
+  int wake_socket_fd_{-1};
+  /// Set when a wake datagram was sent (or pended from an interrupt) and the loop hasn't drained it yet.
+  volatile bool wake_datagram_pending_{false};
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
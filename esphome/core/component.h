@@ -3,7 +3,9 @@
 #include <string>
 #include <functional>
 #include <cmath>
+#include <cstdint>
 
+#include "esphome/core/defines.h"
 #include "esphome/core/optional.h"
 
 namespace esphome {
@@ -151,6 +153,9 @@ class Component {
 
  protected:
   friend class Application;
+#ifdef USE_PROFILER
+  friend class Profiler;
+#endif
 
   virtual void call_loop();
   virtual void call_setup();
@@ -255,6 +260,10 @@ class Component {
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_ = nullptr;
+#ifdef USE_PROFILER
+  /// First slot of this component in the profiler.
+  uint16_t profile_slot_{UINT16_MAX};
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -35,6 +35,7 @@
 #define USE_OTA_PASSWORD
 #define USE_OTA_STATE_CALLBACK
 #define USE_POWER_SUPPLY
+#define USE_PROFILER
 #define USE_QR_CODE
 #define USE_SELECT
 #define USE_SENSOR
@@ -69,7 +70,9 @@
 #define USE_ESP32_CAMERA
 #define USE_ESP32_IGNORE_EFUSE_MAC_CRC
 #define USE_IMPROV
+#define USE_OTA_DELTA
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 
 #ifdef USE_ARDUINO
 #define USE_ARDUINO_VERSION_CODE VERSION_CODE(1, 0, 6)
@@ -86,6 +89,7 @@
 #define USE_ADC_SENSOR_VCC
 #define USE_ARDUINO_VERSION_CODE VERSION_CODE(3, 0, 2)
 #define USE_ESP8266_PREFERENCES_FLASH
+#define USE_ESP8266_PREFERENCES_LOG_SECTORS 4
 #define USE_HTTP_REQUEST_ESP8266_HTTPS
 #define USE_SOCKET_IMPL_LWIP_TCP
 #endif
@@ -41,6 +41,10 @@ void delayMicroseconds(uint32_t us);  // NOLINT(readability-identifier-naming)
 void __attribute__((noreturn)) arch_restart();
 void arch_init();
 void arch_feed_wdt();
+/// Block the loop task for up to ms milliseconds, returning early once arch_wake_loop() has been called.
+void arch_wait_for_wake(uint32_t ms);
+/// Wake the loop task from arch_wait_for_wake(), safe to call from other tasks and from interrupts.
+void arch_wake_loop();
 uint32_t arch_get_cpu_cycle_count();
 uint32_t arch_get_cpu_freq_hz();
 uint8_t progmem_read_byte(const uint8_t *addr);
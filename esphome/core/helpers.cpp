@@ -21,6 +21,8 @@
 #include "esp_system.h"
 #include <freertos/FreeRTOS.h>
 #include <freertos/portmacro.h>
+#elif defined(USE_HOST)
+#include <random>
 #endif
 
 #ifdef USE_ESP32_IGNORE_EFUSE_MAC_CRC
@@ -70,12 +72,23 @@ uint32_t fnv1_hash(const std::string &str) {
   }
   return hash;
 }
+uint32_t fnv1_hash(const char *str) {
+  uint32_t hash = 2166136261UL;
+  for (; *str != '\0'; str++) {
+    hash *= 16777619UL;
+    hash ^= *str;
+  }
+  return hash;
+}
 
 uint32_t random_uint32() {
 #ifdef USE_ESP32
   return esp_random();
 #elif defined(USE_ESP8266)
   return os_random();
+#elif defined(USE_HOST)
+  std::random_device dev;
+  return dev();
 #else
 #error "No random source available for this configuration."
 #endif
@@ -87,6 +100,11 @@ bool random_bytes(uint8_t *data, size_t len) {
   return true;
 #elif defined(USE_ESP8266)
   return os_get_random(data, len) == 0;
+#elif defined(USE_HOST)
+  std::random_device dev;
+  for (size_t i = 0; i < len; i++)
+    data[i] = dev();
+  return true;
 #else
 #error "No random source available for this configuration."
 #endif
@@ -105,7 +123,7 @@ std::string str_truncate(const std::string &str, size_t length) {
   return str.length() > length ? str.substr(0, length) : str;
 }
 std::string str_until(const char *str, char ch) {
-  char *pos = strchr(str, ch);
+  const char *pos = strchr(str, ch);
   return pos == nullptr ? std::string(str) : std::string(str, pos - str);
 }
 std::string str_until(const std::string &str, char ch) { return str.substr(0, str.find(ch)); }
@@ -351,6 +369,9 @@ IRAM_ATTR InterruptLock::~InterruptLock() { xt_wsr_ps(xt_state_); }
 // so should not be used as a mutex lock, only to get accurate timing
 IRAM_ATTR InterruptLock::InterruptLock() { portDISABLE_INTERRUPTS(); }
 IRAM_ATTR InterruptLock::~InterruptLock() { portENABLE_INTERRUPTS(); }
+#elif defined(USE_HOST)
+InterruptLock::InterruptLock() {}
+InterruptLock::~InterruptLock() {}
 #endif
 
 uint8_t HighFrequencyLoopRequester::num_requests = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
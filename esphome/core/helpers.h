@@ -151,6 +151,8 @@ uint8_t crc8(uint8_t *data, uint8_t len);
 
 /// Calculate a FNV-1 hash of \p str.
 uint32_t fnv1_hash(const std::string &str);
+/// Calculate a FNV-1 hash of the null-terminated string \p str.
+uint32_t fnv1_hash(const char *str);
 
 /// Return a random 32-bit unsigned integer.
 uint32_t random_uint32();
@@ -1,5 +1,5 @@
 #include "log.h"
-#include "defines.h"
+#include "esphome/core/defines.h"
 #include "helpers.h"
 
 #ifdef USE_LOGGER
@@ -8,6 +8,20 @@
 
 namespace esphome {
 
+int esp_log_all_tags_level_ = ESPHOME_LOG_LEVEL;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+bool HOT esp_log_tag_enabled_(int level, const char *tag) {  // NOLINT
+#ifdef USE_LOGGER
+  auto *log = logger::global_logger;
+  if (log == nullptr)
+    return false;
+
+  return level <= log->level_for(tag);
+#else
+  return false;
+#endif
+}
+
 void HOT esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {  // NOLINT
   va_list arg;
   va_start(arg, format);
@@ -63,6 +63,18 @@ void esp_log_vprintf_(int level, const char *tag, int line, const __FlashStringH
 int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
+/// Messages up to this level are logged for all tags, above it the tag has a lower log level set (see Logger).
+extern int esp_log_all_tags_level_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+/// Whether a message with the given level and a tag with a lower log level set would be logged.
+bool esp_log_tag_enabled_(int level, const char *tag);  // NOLINT
+
+/** Whether a log message would be logged, checked before evaluating the arguments of the message.
+ *
+ * Costs a single compare unless a lower log level is set for some tag and the message is above that level. Those
+ * messages need a hash lookup of the tag (Logger::level_for()), there is no compile-time table of per-tag levels.
+ */
+#define ESPHOME_LOG_ENABLED(level, tag) ((level) <= esp_log_all_tags_level_ || esp_log_tag_enabled_(level, tag))
+
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 #define ESPHOME_LOG_FORMAT(format) F(format)
 #else
@@ -71,7 +83,9 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERY_VERBOSE
 #define esph_log_vv(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_VERY_VERBOSE
 #else
@@ -80,7 +94,9 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
 #define esph_log_v(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_VERBOSE, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_VERBOSE
 #else
@@ -89,9 +105,13 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_DEBUG
 #define esph_log_d(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_DEBUG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_DEBUG, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_DEBUG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 #define esph_log_config(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_CONFIG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_CONFIG, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_CONFIG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_DEBUG
 #define ESPHOME_LOG_HAS_CONFIG
@@ -102,7 +122,9 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_INFO
 #define esph_log_i(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_INFO, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_INFO, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_INFO, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_INFO
 #else
@@ -111,7 +133,9 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_WARN
 #define esph_log_w(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_WARN, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_WARN, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_WARN, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_WARN
 #else
@@ -120,7 +144,9 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_ERROR
 #define esph_log_e(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_ERROR, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_ERROR, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_ERROR, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_ERROR
 #else
@@ -0,0 +1,138 @@
+#include "esphome/core/profiler.h"
+
+#ifdef USE_PROFILER
+
+#include <algorithm>
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+
+Profiler global_profiler;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+#ifdef USE_ESP32
+class ProfilerLockGuard {
+ public:
+  explicit ProfilerLockGuard(SemaphoreHandle_t lock) : lock_(lock) { xSemaphoreTake(this->lock_, portMAX_DELAY); }
+  ~ProfilerLockGuard() { xSemaphoreGive(this->lock_); }
+
+ protected:
+  SemaphoreHandle_t lock_;
+};
+#endif
+
+void ProfileStats::record(uint32_t duration_us) {
+  this->count++;
+  this->total_us += duration_us;
+  this->max_us = std::max(this->max_us, duration_us);
+  // Bucket 0 holds everything below 16us, bucket n the durations with n + 4 significant bits
+  int bucket = duration_us < 16 ? 0 : 28 - __builtin_clz(duration_us);
+  if (bucket >= PROFILE_BUCKET_COUNT)
+    bucket = PROFILE_BUCKET_COUNT - 1;
+  this->buckets[bucket]++;
+}
+uint32_t ProfileStats::bucket_upper_us(uint8_t bucket) {
+  if (bucket >= PROFILE_BUCKET_COUNT - 1)
+    return UINT32_MAX;
+  return (16UL << bucket) - 1;
+}
+uint32_t ProfileStats::percentile_us(uint8_t percentile) const {
+  if (this->count == 0)
+    return 0;
+  // Number of calls that have to be at or below the percentile, rounded up
+  const uint64_t target = (uint64_t(this->count) * percentile + 99) / 100;
+  uint64_t seen = 0;
+  for (uint8_t i = 0; i < PROFILE_BUCKET_COUNT; i++) {
+    seen += this->buckets[i];
+    if (seen >= target && seen > 0)
+      return std::min(bucket_upper_us(i), this->max_us);
+  }
+  return this->max_us;
+}
+
+#ifdef USE_ESP32
+Profiler::Profiler() : lock_(xSemaphoreCreateMutex()) {}
+#else
+Profiler::Profiler() = default;
+#endif
+
+void Profiler::record(Component *component, ProfileSource source, uint32_t name_hash, uint32_t duration_us) {
+  if (this->reset_requested_.load(std::memory_order_acquire))
+    this->reset_();
+  Slot *slot = this->find_slot_(component, source, name_hash);
+  const uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+  slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot->entry.stats.record(duration_us);
+  slot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+Profiler::Slot *Profiler::find_slot_(Component *component, ProfileSource source, uint32_t name_hash) {
+  uint16_t &first = component != nullptr ? component->profile_slot_ : this->no_component_slot_;
+  for (uint16_t index = first; index != NO_SLOT; index = this->slots_[index].next) {
+    Slot &slot = this->slots_[index];
+    if (slot.entry.source == source && slot.entry.name_hash == name_hash)
+      return &slot;
+  }
+
+  // First call of this kind, added behind the first slot of the component, which usually is the one of loop()
+#ifdef USE_ESP32
+  ProfilerLockGuard guard(this->lock_);
+#endif
+  const uint16_t index = this->slots_.size();
+  this->slots_.emplace_back(ProfileEntry{component, source, name_hash, {}});
+  if (first == NO_SLOT) {
+    first = index;
+  } else {
+    this->slots_.back().next = this->slots_[first].next;
+    this->slots_[first].next = index;
+  }
+  return &this->slots_.back();
+}
+
+void Profiler::reset_() {
+  for (auto &slot : this->slots_) {
+    const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.entry.stats = {};
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+  }
+  this->started_.store(millis(), std::memory_order_relaxed);
+  this->reset_requested_.store(false, std::memory_order_release);
+}
+
+ProfileEntry Profiler::read_(const Slot &slot) {
+  ProfileEntry entry;
+  while (true) {
+    const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    entry = slot.entry;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ((before & 1) == 0 && slot.sequence.load(std::memory_order_relaxed) == before)
+      return entry;
+#ifdef USE_ESP32
+    // Let the main loop finish the update, this task may have preempted it
+    vTaskDelay(1);
+#endif
+  }
+}
+
+ProfileSnapshot Profiler::snapshot(bool reset) {
+  ProfileSnapshot snapshot;
+  {
+#ifdef USE_ESP32
+    ProfilerLockGuard guard(this->lock_);
+#endif
+    snapshot.entries.reserve(this->slots_.size());
+    for (const auto &slot : this->slots_)
+      snapshot.entries.push_back(read_(slot));
+  }
+  snapshot.duration_ms = millis() - this->started_.load(std::memory_order_relaxed);
+  if (reset)
+    this->reset_requested_.store(true, std::memory_order_release);
+  return snapshot;
+}
+
+}  // namespace esphome
+
+#endif  // USE_PROFILER
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_PROFILER
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "esphome/core/hal.h"
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+namespace esphome {
+
+class Component;
+
+/// Number of histogram buckets, bucket 0 counts calls below 16us and each following bucket is twice as wide.
+static const uint8_t PROFILE_BUCKET_COUNT = 16;
+
+enum class ProfileSource : uint8_t {
+  LOOP,
+  TIMEOUT,
+  INTERVAL,
+};
+
+/// Duration statistics of one kind of call.
+struct ProfileStats {
+  uint32_t count{0};
+  uint32_t max_us{0};
+  uint64_t total_us{0};
+  uint32_t buckets[PROFILE_BUCKET_COUNT]{};
+
+  void record(uint32_t duration_us);
+  /// Upper bound of the bucket the given percentile (0-100) of calls falls into.
+  uint32_t percentile_us(uint8_t percentile) const;
+  /// Upper bound of the durations counted in the given bucket.
+  static uint32_t bucket_upper_us(uint8_t bucket);
+};
+
+struct ProfileEntry {
+  Component *component;
+  ProfileSource source;
+  /// Name hash of the scheduler item, 0 for loop() calls.
+  uint32_t name_hash;
+  ProfileStats stats;
+};
+
+/// Copy of the statistics at one point in time.
+struct ProfileSnapshot {
+  /// Time in milliseconds since the statistics were last reset.
+  uint32_t duration_ms;
+  std::vector<ProfileEntry> entries;
+};
+
+/** Keeps duration histograms of all component loop() calls and scheduler callbacks.
+ *
+ * Enabled with the `profiler` option of the debug component, the statistics can be read over the native API
+ * and the /debug/profile endpoint of the web server.
+ *
+ * The statistics are only changed by the main loop, which finds the slot of a call through the component and
+ * updates it without locking. Readers in other tasks retry a slot that was changed while they copied it.
+ */
+class Profiler {
+ public:
+  /// Index of no slot.
+  static const uint16_t NO_SLOT = UINT16_MAX;
+
+  Profiler();
+
+  /// Called from the main loop only.
+  void record(Component *component, ProfileSource source, uint32_t name_hash, uint32_t duration_us);
+
+  /** Copy the statistics and optionally reset them, may be called from other tasks than the main loop.
+   *
+   * The reset is done by the main loop with its next record() call.
+   */
+  ProfileSnapshot snapshot(bool reset);
+
+ protected:
+  struct Slot {
+    explicit Slot(const ProfileEntry &entry) : entry(entry) {}
+
+    ProfileEntry entry;
+    /// Next slot of the same component.
+    uint16_t next{NO_SLOT};
+    /// Odd while the main loop changes the statistics.
+    std::atomic<uint32_t> sequence{0};
+  };
+
+  Slot *find_slot_(Component *component, ProfileSource source, uint32_t name_hash);
+  void reset_();
+  static ProfileEntry read_(const Slot &slot);
+
+  /// A deque, so that the slots don't move when more are added.
+  std::deque<Slot> slots_;
+  /// First slot of the scheduler items without a component, the others keep theirs in Component::profile_slot_.
+  uint16_t no_component_slot_{NO_SLOT};
+  std::atomic<uint32_t> started_{0};
+  std::atomic<bool> reset_requested_{false};
+#ifdef USE_ESP32
+  /// Held while slots are added or copied, the web server reads them from its own task.
+  SemaphoreHandle_t lock_;
+#endif
+};
+
+extern Profiler global_profiler;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// Record the duration of the surrounding scope.
+class ProfileGuard {
+ public:
+  ProfileGuard(Component *component, ProfileSource source, uint32_t name_hash = 0)
+      : component_(component), source_(source), name_hash_(name_hash), started_(micros()) {}
+  ~ProfileGuard() {
+    global_profiler.record(this->component_, this->source_, this->name_hash_, micros() - this->started_);
+  }
+
+ protected:
+  Component *component_;
+  ProfileSource source_;
+  uint32_t name_hash_;
+  uint32_t started_;
+};
+
+}  // namespace esphome
+
+#endif  // USE_PROFILER
@@ -2,6 +2,7 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/profiler.h"
 #include <algorithm>
 
 namespace esphome {
@@ -25,9 +26,11 @@ void HOT Scheduler::set_timeout(Component *component, const std::string &name, u
 
   ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
   item->name = name;
+  item->has_name = !name.empty();
+  item->name_hash = item->has_name ? fnv1_hash(name) : 0;
   item->type = SchedulerItem::TIMEOUT;
   item->timeout = timeout;
   item->last_execution = now;
@@ -56,9 +59,11 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
 
   ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name.c_str(), interval, offset);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
   item->name = name;
+  item->has_name = !name.empty();
+  item->name_hash = item->has_name ? fnv1_hash(name) : 0;
   item->type = SchedulerItem::INTERVAL;
   item->interval = interval;
   item->last_execution = now - offset - interval;
@@ -137,15 +142,14 @@ void HOT Scheduler::call() {
   if (now - last_print > 2000) {
     last_print = now;
     std::vector<std::unique_ptr<SchedulerItem>> old_items;
-    ESP_LOGVV(TAG, "Items: count=%u, now=%u", this->items_.size(), now);
+    ESP_LOGVV(TAG, "Items: count=%u, pooled=%u, now=%u", this->items_.size(), this->free_items_.size(), now);
     while (!this->empty_()) {
-      auto item = std::move(this->items_[0]);
+      auto &item = this->items_[0];
       ESP_LOGVV(TAG, "  %s '%s' interval=%u last_execution=%u (%u) next=%u (%u)", item->get_type_str(),
                 item->name.c_str(), item->interval, item->last_execution, item->last_execution_major,
                 item->next_execution(), item->next_execution_major());
 
-      this->pop_raw_();
-      old_items.push_back(std::move(item));
+      old_items.push_back(this->pop_raw_());
     }
     ESP_LOGVV(TAG, "\n");
     this->items_ = std::move(old_items);
@@ -158,9 +162,7 @@ void HOT Scheduler::call() {
   if (to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
     std::vector<std::unique_ptr<SchedulerItem>> valid_items;
     while (!this->empty_()) {
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      valid_items.push_back(std::move(item));
+      valid_items.push_back(this->pop_raw_());
     }
     this->items_ = std::move(valid_items);
 
@@ -187,7 +189,9 @@ void HOT Scheduler::call() {
 
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
-        this->pop_raw_();
+        auto failed = this->pop_raw_();
+        this->remove_named_(failed.get());
+        this->recycle_item_(std::move(failed));
         continue;
       }
 
@@ -201,21 +205,25 @@ void HOT Scheduler::call() {
       //  - timeouts/intervals get cancelled
       {
         WarnIfComponentBlockingGuard guard{item->component};
+#ifdef USE_PROFILER
+        ProfileGuard profile{item->component,
+                             item->type == SchedulerItem::INTERVAL ? ProfileSource::INTERVAL : ProfileSource::TIMEOUT,
+                             item->has_name ? item->name_hash : 0};
+#endif
         item->callback();
       }
     }
 
     {
       // new scope, item from before might have been moved in the vector
-      auto item = std::move(this->items_[0]);
-
       // Only pop after function call, this ensures we were reachable
       // during the function call and know if we were cancelled.
-      this->pop_raw_();
+      auto item = this->pop_raw_();
 
       if (item->remove) {
         // We were removed/cancelled in the function call, stop
         to_remove_--;
+        this->recycle_item_(std::move(item));
         continue;
       }
 
@@ -227,7 +235,12 @@ void HOT Scheduler::call() {
           if (item->last_execution < before)
             item->last_execution_major++;
         }
-        this->push_(std::move(item));
+        // Still registered in named_items_, so bypass push_()
+        this->to_add_.push_back(std::move(item));
+      } else {
+        // Timeout has fired, it can't be cancelled anymore
+        this->remove_named_(item.get());
+        this->recycle_item_(std::move(item));
       }
     }
   }
@@ -237,6 +250,8 @@ void HOT Scheduler::call() {
 void HOT Scheduler::process_to_add() {
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      to_remove_--;
+      this->recycle_item_(std::move(it));
       continue;
     }
 
@@ -252,31 +267,101 @@ void HOT Scheduler::cleanup_() {
       return;
 
     to_remove_--;
-    this->pop_raw_();
+    this->recycle_item_(this->pop_raw_());
   }
 }
-void HOT Scheduler::pop_raw_() {
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::pop_raw_() {
   std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+  auto item = std::move(this->items_.back());
   this->items_.pop_back();
+  return item;
+}
+void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
+  if (item->has_name)
+    this->add_named_(item.get());
+  this->to_add_.push_back(std::move(item));
 }
-void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) { this->to_add_.push_back(std::move(item)); }
 bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
-  bool ret = false;
-  for (auto &it : this->items_) {
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
-      to_remove_++;
-      it->remove = true;
-      ret = true;
-    }
-  }
-  for (auto &it : this->to_add_) {
-    if (it->component == component && it->name == name && it->type == type) {
-      it->remove = true;
-      ret = true;
+  if (name.empty()) {
+    // Unnamed items are not indexed, fall back to marking all matching ones
+    bool ret = false;
+    for (auto *vec : {&this->items_, &this->to_add_}) {
+      for (auto &it : *vec) {
+        if (it->component == component && !it->has_name && it->type == type && !it->remove) {
+          to_remove_++;
+          it->remove = true;
+          ret = true;
+        }
+      }
     }
+    return ret;
   }
 
-  return ret;
+  auto it = this->find_named_(component, name, fnv1_hash(name), type);
+  if (it == this->named_items_.end())
+    return false;
+  SchedulerItem *item = *it;
+  this->named_items_.erase(it);
+  // Item is still referenced by items_ or to_add_, it is dropped (and recycled) from there.
+  to_remove_++;
+  item->remove = true;
+  return true;
+}
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::acquire_item_() {
+  if (this->free_items_.empty())
+    return make_unique<SchedulerItem>();
+  auto item = std::move(this->free_items_.back());
+  this->free_items_.pop_back();
+  return item;
+}
+void HOT Scheduler::recycle_item_(std::unique_ptr<SchedulerItem> item) {
+  // Release anything captured by the callback now instead of when the item is reused
+  item->callback = nullptr;
+  this->free_items_.push_back(std::move(item));
+}
+static bool named_item_less(Component *a_component, uint32_t a_hash, uint8_t a_type, Component *b_component,
+                            uint32_t b_hash, uint8_t b_type) {
+  if (a_component != b_component)
+    return a_component < b_component;
+  if (a_hash != b_hash)
+    return a_hash < b_hash;
+  return a_type < b_type;
+}
+std::vector<Scheduler::SchedulerItem *>::iterator HOT Scheduler::find_named_(Component *component,
+                                                                             const std::string &name,
+                                                                             uint32_t name_hash,
+                                                                             SchedulerItem::Type type) {
+  auto it = std::lower_bound(this->named_items_.begin(), this->named_items_.end(), nullptr,
+                             [component, name_hash, type](SchedulerItem *item, std::nullptr_t) {
+                               return named_item_less(item->component, item->name_hash, item->type, component,
+                                                      name_hash, type);
+                             });
+  // Different names can share a hash, so check every item with the same key
+  for (; it != this->named_items_.end(); ++it) {
+    SchedulerItem *item = *it;
+    if (item->component != component || item->name_hash != name_hash || item->type != type)
+      break;
+    if (item->name == name)
+      return it;
+  }
+  return this->named_items_.end();
+}
+void HOT Scheduler::add_named_(SchedulerItem *item) {
+  // set_timeout/set_interval cancel a previous item with the same name before pushing,
+  // so there is at most one active item per name. Items whose names collide share a key and sit next to each other.
+  auto it = std::lower_bound(this->named_items_.begin(), this->named_items_.end(), item,
+                             [](SchedulerItem *a, SchedulerItem *b) {
+                               return named_item_less(a->component, a->name_hash, a->type, b->component,
+                                                      b->name_hash, b->type);
+                             });
+  this->named_items_.insert(it, item);
+}
+void HOT Scheduler::remove_named_(SchedulerItem *item) {
+  if (!item->has_name)
+    return;
+  auto it = this->find_named_(item->component, item->name, item->name_hash, item->type);
+  if (it != this->named_items_.end() && *it == item)
+    this->named_items_.erase(it);
 }
 uint32_t Scheduler::millis_() {
   const uint32_t now = millis();
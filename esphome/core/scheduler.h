@@ -29,15 +29,18 @@ class Scheduler {
   struct SchedulerItem {
     Component *component;
     std::string name;
-    enum Type { TIMEOUT, INTERVAL } type;
+    /// FNV-1 hash of the name, only meaningful if has_name is set. Equal hashes are told apart by the name.
+    uint32_t name_hash;
+    enum Type : uint8_t { TIMEOUT, INTERVAL } type;
+    bool has_name;
+    bool remove;
+    uint8_t last_execution_major;
     union {
       uint32_t interval;
       uint32_t timeout;
     };
     uint32_t last_execution;
     std::function<void()> callback;
-    bool remove;
-    uint8_t last_execution_major;
 
     inline uint32_t next_execution() { return this->last_execution + this->timeout; }
     inline uint8_t next_execution_major() {
@@ -63,7 +66,7 @@ class Scheduler {
 
   uint32_t millis_();
   void cleanup_();
-  void pop_raw_();
+  std::unique_ptr<SchedulerItem> pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
   bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
   bool empty_() {
@@ -71,8 +74,23 @@ class Scheduler {
     return this->items_.empty();
   }
 
+  /// Get an item from the pool (or allocate a new one if the pool is empty).
+  std::unique_ptr<SchedulerItem> acquire_item_();
+  /// Return a finished or cancelled item to the pool.
+  void recycle_item_(std::unique_ptr<SchedulerItem> item);
+
+  /// Find the active item with this name in named_items_, or end() if there is none.
+  std::vector<SchedulerItem *>::iterator find_named_(Component *component, const std::string &name,
+                                                     uint32_t name_hash, SchedulerItem::Type type);
+  void add_named_(SchedulerItem *item);
+  void remove_named_(SchedulerItem *item);
+
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  /// Items that have finished and can be reused, so that re-arming timeouts doesn't hit the heap.
+  std::vector<std::unique_ptr<SchedulerItem>> free_items_;
+  /// Active named items sorted by (component, name hash, type), used for O(log n) cancellation.
+  std::vector<SchedulerItem *> named_items_;
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
@@ -6,6 +6,7 @@ import sys
 import time
 import gzip
 
+from esphome import ota_delta
 from esphome.core import EsphomeError
 from esphome.helpers import is_ip_address, resolve_ip_address
 
@@ -19,6 +20,8 @@ RESPONSE_BIN_MD5_OK = 67
 RESPONSE_RECEIVE_OK = 68
 RESPONSE_UPDATE_END_OK = 69
 RESPONSE_SUPPORTS_COMPRESSION = 70
+RESPONSE_CHUNK_OK = 71
+RESPONSE_SUPPORTS_DELTA = 72
 
 RESPONSE_ERROR_MAGIC = 128
 RESPONSE_ERROR_UPDATE_PREPARE = 129
@@ -30,13 +33,19 @@ RESPONSE_ERROR_WRONG_CURRENT_FLASH_CONFIG = 134
 RESPONSE_ERROR_WRONG_NEW_FLASH_CONFIG = 135
 RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136
 RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137
+RESPONSE_ERROR_INVALID_DELTA = 139
 RESPONSE_ERROR_UNKNOWN = 255
 
 OTA_VERSION_1_0 = 1
+OTA_VERSION_2_0 = 2
 
 MAGIC_BYTES = [0x6C, 0x26, 0xF7, 0x5C, 0x45]
 
 FEATURE_SUPPORTS_COMPRESSION = 0x01
+FEATURE_SUPPORTS_DELTA = 0x02
+
+UPDATE_FULL = 0x00
+UPDATE_DELTA = 0x01
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -150,6 +159,11 @@ def check_error(data, expect):
             "Error: The OTA partition on the ESP is too small. ESPHome needs to resize "
             "this partition, please flash over USB."
         )
+    if dat == RESPONSE_ERROR_INVALID_DELTA:
+        raise OTAError(
+            "Error: Applying the delta update failed. See the MQTT/USB logs for more "
+            "information."
+        )
     if dat == RESPONSE_ERROR_UNKNOWN:
         raise OTAError("Unknown error from ESP")
     if not isinstance(expect, (list, tuple)):
@@ -172,7 +186,74 @@ def send_check(sock, data, msg):
         raise OTAError(f"Error sending {msg}: {err}") from err
 
 
-def perform_ota(sock, password, file_handle, filename):
+def send_data(sock, data):
+    try:
+        sock.sendall(data)
+    except OSError as err:
+        sys.stderr.write("\n")
+        raise OTAError(f"Error sending data: {err}") from err
+
+
+def upload_chunked(sock, upload_contents):
+    upload_size = len(upload_contents)
+    offset = 0
+    progress = ProgressBar()
+    while True:
+        chunk = upload_contents[offset : offset + 1024]
+        if not chunk:
+            break
+        offset += len(chunk)
+        send_data(sock, chunk)
+        progress.update(offset / upload_size)
+    progress.done()
+
+
+def upload_windowed(sock, upload_contents, window_size):
+    """Keep up to window_size bytes in flight, the ESP acknowledges the received data
+    in chunks while it writes the previous ones to flash."""
+    upload_size = len(upload_contents)
+    offset = 0
+    acked = 0
+    progress = ProgressBar()
+    while acked < upload_size:
+        in_flight = offset - acked
+        if offset < upload_size and in_flight < window_size:
+            chunk = upload_contents[offset : offset + window_size - in_flight]
+            offset += len(chunk)
+            send_data(sock, chunk)
+            continue
+
+        try:
+            data = receive_exactly(
+                sock, 5, "chunk acknowledgement", RESPONSE_CHUNK_OK, decode=False
+            )
+        except OTAError:
+            sys.stderr.write("\n")
+            raise
+        acked = int.from_bytes(data[1:], "big")
+        progress.update(acked / upload_size)
+    progress.done()
+
+
+def create_delta(archive_dir, running_md5, file_contents):
+    """Create a patch against the running firmware, if a copy of it has been kept."""
+    old_contents = ota_delta.load_firmware(archive_dir, running_md5)
+    if old_contents is None:
+        _LOGGER.info("Running firmware is unknown, sending a full update")
+        return None
+    if old_contents == file_contents:
+        _LOGGER.info("Firmware is already running on the device, sending it anyway")
+    start = time.monotonic()
+    patch = ota_delta.create_patch(old_contents, file_contents)
+    _LOGGER.info(
+        "Created delta update of %s bytes in %.1fs",
+        len(patch),
+        time.monotonic() - start,
+    )
+    return patch
+
+
+def perform_ota(sock, password, file_handle, filename, archive_dir=None):
     file_contents = file_handle.read()
     file_size = len(file_contents)
     _LOGGER.info("Uploading %s (%s bytes)", filename, file_size)
@@ -182,20 +263,41 @@ def perform_ota(sock, password, file_handle, filename):
     send_check(sock, MAGIC_BYTES, "magic bytes")
 
     _, version = receive_exactly(sock, 2, "version", RESPONSE_OK)
-    if version != OTA_VERSION_1_0:
+    if version not in (OTA_VERSION_1_0, OTA_VERSION_2_0):
         raise OTAError(f"Unsupported OTA version {version}")
 
     # Features
-    send_check(sock, FEATURE_SUPPORTS_COMPRESSION, "features")
+    requested_features = FEATURE_SUPPORTS_COMPRESSION
+    if version >= OTA_VERSION_2_0 and archive_dir is not None:
+        requested_features |= FEATURE_SUPPORTS_DELTA
+    send_check(sock, requested_features, "features")
     features = receive_exactly(
         sock, 1, "features", [RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_COMPRESSION]
     )[0]
 
+    upload_contents = file_contents
+    # The checksum is always the one of the firmware, a patch is verified after applying
+    upload_md5 = None
+    if requested_features & FEATURE_SUPPORTS_DELTA:
+        (delta,) = receive_exactly(
+            sock, 1, "delta", [RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_DELTA]
+        )
+        if delta == RESPONSE_SUPPORTS_DELTA:
+            running_md5 = receive_exactly(
+                sock, 32, "running firmware checksum", [], decode=False
+            ).decode()
+            _LOGGER.debug("MD5 of running firmware is %s", running_md5)
+            patch = create_delta(archive_dir, running_md5, file_contents)
+            if patch is None:
+                send_check(sock, UPDATE_FULL, "update type")
+            else:
+                send_check(sock, UPDATE_DELTA, "update type")
+                upload_contents = patch
+                upload_md5 = hashlib.md5(file_contents).hexdigest()
+
     if features == RESPONSE_SUPPORTS_COMPRESSION:
-        upload_contents = gzip.compress(file_contents, compresslevel=9)
+        upload_contents = gzip.compress(upload_contents, compresslevel=9)
         _LOGGER.info("Compressed to %s bytes", len(upload_contents))
-    else:
-        upload_contents = file_contents
 
     (auth,) = receive_exactly(
         sock, 1, "auth", [RESPONSE_REQUEST_AUTH, RESPONSE_AUTH_OK]
@@ -232,36 +334,39 @@ def perform_ota(sock, password, file_handle, filename):
     send_check(sock, upload_size_encoded, "binary size")
     receive_exactly(sock, 1, "binary size", RESPONSE_UPDATE_PREPARE_OK)
 
-    upload_md5 = hashlib.md5(upload_contents).hexdigest()
+    if upload_md5 is None:
+        upload_md5 = hashlib.md5(upload_contents).hexdigest()
     _LOGGER.debug("MD5 of upload is %s", upload_md5)
 
     send_check(sock, upload_md5, "file checksum")
     receive_exactly(sock, 1, "file checksum", RESPONSE_BIN_MD5_OK)
 
+    window_size = None
+    if version >= OTA_VERSION_2_0:
+        data = receive_exactly(sock, 4, "window size", [], decode=False)
+        window_size = int.from_bytes(data, "big")
+        _LOGGER.debug("Window size is %s bytes", window_size)
+
     # Disable nodelay for transfer
     sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 0)
     # Limit send buffer (usually around 100kB) in order to have progress bar
     # show the actual progress
-    sock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 8192)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, window_size or 8192)
     # Set higher timeout during upload
     sock.settimeout(20.0)
 
-    offset = 0
-    progress = ProgressBar()
-    while True:
-        chunk = upload_contents[offset : offset + 1024]
-        if not chunk:
-            break
-        offset += len(chunk)
-
-        try:
-            sock.sendall(chunk)
-        except OSError as err:
-            sys.stderr.write("\n")
-            raise OTAError(f"Error sending data: {err}") from err
-
-        progress.update(offset / upload_size)
-    progress.done()
+    start = time.monotonic()
+    if window_size is None:
+        upload_chunked(sock, upload_contents)
+    else:
+        upload_windowed(sock, upload_contents, window_size)
+    duration = time.monotonic() - start
+    _LOGGER.info(
+        "Uploaded %s bytes in %.1fs (%.1f kB/s)",
+        upload_size,
+        duration,
+        upload_size / 1000 / max(duration, 0.001),
+    )
 
     # Enable nodelay for last checks
     sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
@@ -278,7 +383,7 @@ def perform_ota(sock, password, file_handle, filename):
     time.sleep(1)
 
 
-def run_ota_impl_(remote_host, remote_port, password, filename):
+def run_ota_impl_(remote_host, remote_port, password, filename, archive_dir):
     if is_ip_address(remote_host):
         _LOGGER.info("Connecting to %s", remote_host)
         ip = remote_host
@@ -309,19 +414,25 @@ def run_ota_impl_(remote_host, remote_port, password, filename):
 
     with open(filename, "rb") as file_handle:
         try:
-            perform_ota(sock, password, file_handle, filename)
+            perform_ota(sock, password, file_handle, filename, archive_dir)
         except OTAError as err:
             _LOGGER.error(str(err))
             return 1
         finally:
             sock.close()
 
+        if archive_dir is not None:
+            file_handle.seek(0)
+            ota_delta.archive_firmware(archive_dir, file_handle.read())
+
     return 0
 
 
-def run_ota(remote_host, remote_port, password, filename):
+def run_ota(remote_host, remote_port, password, filename, archive_dir=None):
+    """Upload a firmware. If archive_dir is given, uploaded firmwares are kept there
+    and later updates are sent as a delta against them when the device supports it."""
     try:
-        return run_ota_impl_(remote_host, remote_port, password, filename)
+        return run_ota_impl_(remote_host, remote_port, password, filename, archive_dir)
     except OTAError as err:
         _LOGGER.error(err)
         return 1
@@ -0,0 +1,150 @@
+"""Delta updates for the native OTA protocol.
+
+The patch format is documented with DeltaOTABackend in components/ota. Patches are
+computed against a copy of a firmware that has been uploaded earlier, found by the
+MD5 the device reports for its running firmware.
+"""
+import hashlib
+import logging
+import os
+import struct
+from pathlib import Path
+from typing import Optional
+
+_LOGGER = logging.getLogger(__name__)
+
+MAGIC = b"EOD1"
+OP_COPY = 0x00
+OP_INSERT = 0x01
+
+# Length of the blocks used to find matching data in the old image, and the stride
+# in which they're indexed. Matches shorter than their sum may be missed.
+BLOCK_SIZE = 32
+INDEX_STRIDE = 16
+# A match is extended as long as at least half of the bytes are the same, and given
+# up once it's this many mismatches below its best score
+EXTEND_TOLERANCE = 32
+
+MAX_ARCHIVED_FIRMWARES = 5
+
+
+def _extend_match(old: bytes, new: bytes, old_start: int, new_start: int) -> int:
+    limit = min(len(old) - old_start, len(new) - new_start)
+    score = best_score = best_length = 0
+    for i in range(limit):
+        if old[old_start + i] == new[new_start + i]:
+            score += 1
+            if score > best_score:
+                best_score = score
+                best_length = i + 1
+        else:
+            score -= 1
+            if best_score - score > EXTEND_TOLERANCE:
+                break
+    return best_length
+
+
+def _find_operations(old: bytes, new: bytes):
+    """Yield (old_offset, new_start, new_end) for every operation, old_offset is None
+    for data that has to be inserted."""
+    index = {}
+    for offset in range(0, len(old) - BLOCK_SIZE + 1, INDEX_STRIDE):
+        index.setdefault(old[offset : offset + BLOCK_SIZE], offset)
+
+    pos = 0  # start of the new data that isn't covered by an operation yet
+    scan = 0
+    while scan <= len(new) - BLOCK_SIZE:
+        old_offset = index.get(new[scan : scan + BLOCK_SIZE])
+        if old_offset is None:
+            scan += 1
+            continue
+
+        new_start, old_start = scan, old_offset
+        while (
+            new_start > pos
+            and old_start > 0
+            and new[new_start - 1] == old[old_start - 1]
+        ):
+            new_start -= 1
+            old_start -= 1
+        new_end = new_start + _extend_match(old, new, old_start, new_start)
+
+        if new_start > pos:
+            yield None, pos, new_start
+        yield old_start, new_start, new_end
+        pos = scan = new_end
+
+    if pos < len(new):
+        yield None, pos, len(new)
+
+
+def create_patch(old: bytes, new: bytes) -> bytes:
+    patch = bytearray(MAGIC)
+    patch += struct.pack(">II", len(old), len(new))
+    patch += hashlib.md5(old).hexdigest().encode()
+
+    for old_offset, new_start, new_end in _find_operations(old, new):
+        length = new_end - new_start
+        if old_offset is None:
+            patch += struct.pack(">BI", OP_INSERT, length)
+            patch += new[new_start:new_end]
+            continue
+        # Copied data is sent as the difference to the old data, which is mostly zero
+        # and compresses well
+        patch += struct.pack(">BII", OP_COPY, length, old_offset)
+        old_data = old[old_offset : old_offset + length]
+        patch += bytes((n - o) & 0xFF for n, o in zip(new[new_start:new_end], old_data))
+    return bytes(patch)
+
+
+def apply_patch(old: bytes, patch: bytes) -> bytes:
+    """Reference implementation of DeltaOTABackend."""
+    if patch[:4] != MAGIC:
+        raise ValueError("Invalid patch header")
+    old_size, new_size = struct.unpack(">II", patch[4:12])
+    if old_size != len(old) or patch[12:44].decode() != hashlib.md5(old).hexdigest():
+        raise ValueError("Patch doesn't apply to this image")
+
+    new = bytearray()
+    pos = 44
+    while len(new) < new_size:
+        op_type, length = struct.unpack(">BI", patch[pos : pos + 5])
+        pos += 5
+        if op_type == OP_INSERT:
+            new += patch[pos : pos + length]
+        elif op_type == OP_COPY:
+            (old_offset,) = struct.unpack(">I", patch[pos : pos + 4])
+            pos += 4
+            new += bytes(
+                (d + o) & 0xFF
+                for d, o in zip(
+                    patch[pos : pos + length], old[old_offset : old_offset + length]
+                )
+            )
+        else:
+            raise ValueError(f"Invalid operation {op_type}")
+        pos += length
+    return bytes(new)
+
+
+def archive_firmware(directory: str, contents: bytes) -> None:
+    """Keep a copy of an uploaded firmware, so later updates can be sent as a patch
+    against it."""
+    path = Path(directory)
+    path.mkdir(parents=True, exist_ok=True)
+    (path / f"{hashlib.md5(contents).hexdigest()}.bin").write_bytes(contents)
+
+    archived = sorted(path.glob("*.bin"), key=os.path.getmtime, reverse=True)
+    for old in archived[MAX_ARCHIVED_FIRMWARES:]:
+        old.unlink()
+
+
+def load_firmware(directory: str, md5: str) -> Optional[bytes]:
+    path = Path(directory) / f"{md5}.bin"
+    if not path.is_file():
+        return None
+    contents = path.read_bytes()
+    if hashlib.md5(contents).hexdigest() != md5:
+        _LOGGER.warning("Archived firmware %s is corrupted", path)
+        return None
+    return contents
@@ -181,6 +181,22 @@ class TypeInfo:
 
     encode_func = None
 
+    @property
+    def field_id_size(self):
+        # Size of the varint containing the field id and wire type
+        tag = self.number << 3
+        return max(1, (tag.bit_length() + 6) // 7)
+
+    @property
+    def calculate_size_content(self):
+        return self.get_size_calculation(f"this->{self.field_name}")
+
+    def get_size_calculation(self, name, force=False):
+        force_str = "true" if force else "false"
+        return f"ProtoSize::{self.size_func}(total_size, {self.field_id_size}, {name}, {force_str});"
+
+    size_func = None
+
     @property
     def dump_content(self):
         o = f'out.append("  {self.name}: ");\n'
@@ -209,6 +225,10 @@ class DoubleType(TypeInfo):
     decode_64bit = "value.as_double()"
     encode_func = "encode_double"
 
+    def get_size_calculation(self, name, force=False):
+        force_str = "true" if force else "false"
+        return f"ProtoSize::add_fixed_field<8>(total_size, {self.field_id_size}, {name} != 0.0, {force_str});"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%g", {name});\n'
         o += f"out.append(buffer);"
@@ -222,6 +242,10 @@ class FloatType(TypeInfo):
     decode_32bit = "value.as_float()"
     encode_func = "encode_float"
 
+    def get_size_calculation(self, name, force=False):
+        force_str = "true" if force else "false"
+        return f"ProtoSize::add_fixed_field<4>(total_size, {self.field_id_size}, {name} != 0.0f, {force_str});"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%g", {name});\n'
         o += f"out.append(buffer);"
@@ -234,6 +258,7 @@ class Int64Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_int64()"
     encode_func = "encode_int64"
+    size_func = "add_int64_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
@@ -247,6 +272,7 @@ class UInt64Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_uint64()"
     encode_func = "encode_uint64"
+    size_func = "add_uint64_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%llu", {name});\n'
@@ -260,6 +286,7 @@ class Int32Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_int32()"
     encode_func = "encode_int32"
+    size_func = "add_int32_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%d", {name});\n'
@@ -274,6 +301,10 @@ class Fixed64Type(TypeInfo):
     decode_64bit = "value.as_fixed64()"
     encode_func = "encode_fixed64"
 
+    def get_size_calculation(self, name, force=False):
+        force_str = "true" if force else "false"
+        return f"ProtoSize::add_fixed_field<8>(total_size, {self.field_id_size}, {name} != 0, {force_str});"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%llu", {name});\n'
         o += f"out.append(buffer);"
@@ -287,6 +318,10 @@ class Fixed32Type(TypeInfo):
     decode_32bit = "value.as_fixed32()"
     encode_func = "encode_fixed32"
 
+    def get_size_calculation(self, name, force=False):
+        force_str = "true" if force else "false"
+        return f"ProtoSize::add_fixed_field<4>(total_size, {self.field_id_size}, {name} != 0, {force_str});"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%u", {name});\n'
         o += f"out.append(buffer);"
@@ -299,6 +334,7 @@ class BoolType(TypeInfo):
     default_value = "false"
     decode_varint = "value.as_bool()"
     encode_func = "encode_bool"
+    size_func = "add_bool_field"
 
     def dump(self, name):
         o = f"out.append(YESNO({name}));"
@@ -313,6 +349,7 @@ class StringType(TypeInfo):
     const_reference_type = "const std::string &"
     decode_length = "value.as_string()"
     encode_func = "encode_string"
+    size_func = "add_string_field"
 
     def dump(self, name):
         o = f'out.append("\'").append({name}).append("\'");'
@@ -339,6 +376,8 @@ class MessageType(TypeInfo):
     def encode_func(self):
         return f"encode_message<{self.cpp_type}>"
 
+    size_func = "add_message_object"
+
     @property
     def decode_length(self):
         return f"value.as_message<{self.cpp_type}>()"
@@ -356,6 +395,7 @@ class BytesType(TypeInfo):
     const_reference_type = "const std::string &"
     decode_length = "value.as_string()"
     encode_func = "encode_string"
+    size_func = "add_string_field"
 
     def dump(self, name):
         o = f'out.append("\'").append({name}).append("\'");'
@@ -368,6 +408,7 @@ class UInt32Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_uint32()"
     encode_func = "encode_uint32"
+    size_func = "add_uint32_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%u", {name});\n'
@@ -391,6 +432,10 @@ class EnumType(TypeInfo):
     def encode_func(self):
         return f"encode_enum<{self.cpp_type}>"
 
+    def get_size_calculation(self, name, force=False):
+        force_str = "true" if force else "false"
+        return f"ProtoSize::add_enum_field(total_size, {self.field_id_size}, static_cast<uint32_t>({name}), {force_str});"
+
     def dump(self, name):
         o = f"out.append(proto_enum_to_string<{self.cpp_type}>({name}));"
         return o
@@ -403,6 +448,10 @@ class SFixed32Type(TypeInfo):
     decode_32bit = "value.as_sfixed32()"
     encode_func = "encode_sfixed32"
 
+    def get_size_calculation(self, name, force=False):
+        force_str = "true" if force else "false"
+        return f"ProtoSize::add_fixed_field<4>(total_size, {self.field_id_size}, {name} != 0, {force_str});"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%d", {name});\n'
         o += f"out.append(buffer);"
@@ -416,6 +465,10 @@ class SFixed64Type(TypeInfo):
     decode_64bit = "value.as_sfixed64()"
     encode_func = "encode_sfixed64"
 
+    def get_size_calculation(self, name, force=False):
+        force_str = "true" if force else "false"
+        return f"ProtoSize::add_fixed_field<8>(total_size, {self.field_id_size}, {name} != 0, {force_str});"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
         o += f"out.append(buffer);"
@@ -428,6 +481,7 @@ class SInt32Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_sint32()"
     encode_func = "encode_sint32"
+    size_func = "add_sint32_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%d", {name});\n'
@@ -441,6 +495,7 @@ class SInt64Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_sint64()"
     encode_func = "encode_sint64"
+    size_func = "add_sint64_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
@@ -529,6 +584,13 @@ class RepeatedTypeInfo(TypeInfo):
         o += f"}}"
         return o
 
+    @property
+    def calculate_size_content(self):
+        o = f"for (auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{\n"
+        o += f"  {self._ti.get_size_calculation('it', True)}\n"
+        o += f"}}"
+        return o
+
     @property
     def dump_content(self):
         o = f'for (const auto {"" if self._ti_is_bool else "&"}it : this->{self.field_name}) {{\n'
@@ -559,6 +621,12 @@ def build_enum_type(desc):
     return out, cpp
 
 
+def get_opt(desc, opt, default=None):
+    if not desc.options.HasExtension(opt):
+        return default
+    return desc.options.Extensions[opt]
+
+
 def build_message_type(desc):
     public_content = []
     protected_content = []
@@ -567,6 +635,7 @@ def build_message_type(desc):
     decode_32bit = []
     decode_64bit = []
     encode = []
+    calculate_size = []
     dump = []
 
     for field in desc.field:
@@ -577,6 +646,7 @@ def build_message_type(desc):
         protected_content.extend(ti.protected_content)
         public_content.extend(ti.public_content)
         encode.append(ti.encode_content)
+        calculate_size.append(ti.calculate_size_content)
 
         if ti.decode_varint_content:
             decode_varint.append(ti.decode_varint_content)
@@ -643,6 +713,18 @@ def build_message_type(desc):
     prot = "void encode(ProtoWriteBuffer buffer) const override;"
     public_content.append(prot)
 
+    o = f"void {desc.name}::calculate_size(uint32_t &total_size) const {{"
+    if calculate_size:
+        if len(calculate_size) == 1 and len(calculate_size[0]) + len(o) + 3 < 120:
+            o += f" {calculate_size[0]} "
+        else:
+            o += "\n"
+            o += indent("\n".join(calculate_size)) + "\n"
+    o += "}\n"
+    cpp += o
+    prot = "void calculate_size(uint32_t &total_size) const override;"
+    public_content.append(prot)
+
     o = f"void {desc.name}::dump_to(std::string &out) const {{"
     if dump:
         if len(dump) == 1 and len(dump[0]) + len(o) + 3 < 120:
@@ -669,6 +751,10 @@ def build_message_type(desc):
     prot += "#endif\n"
     public_content.append(prot)
 
+    message_id = get_opt(desc, pb.id)
+    if message_id is not None:
+        public_content.insert(0, f"static constexpr uint16_t MESSAGE_TYPE = {message_id};")
+
     out = f"class {desc.name} : public ProtoMessage {{\n"
     out += " public:\n"
     out += indent("\n".join(public_content)) + "\n"
@@ -747,12 +833,6 @@ class_name = "APIServerConnectionBase"
 ifdefs = {}
 
 
-def get_opt(desc, opt, default=None):
-    if not desc.options.HasExtension(opt):
-        return default
-    return desc.options.Extensions[opt]
-
-
 def build_service_message_type(mt):
     snake = camel_to_snake(mt.name)
     id_ = get_opt(mt, pb.id)
@@ -0,0 +1,154 @@
+// Component profiler: the calls are recorded in one slot per component and kind of call, a reset is applied by the
+// next recorded call, recording doesn't allocate once the slots exist, and snapshots taken by another thread while
+// the main loop records never see a half updated slot.
+
+#include "esphome/core/component.h"
+#include "esphome/core/profiler.h"
+#include "heap_counter.h"
+#include "test_helpers.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace esphome;
+
+namespace {
+
+const ProfileEntry *find(const ProfileSnapshot &snapshot, const Component *component, ProfileSource source,
+                         uint32_t name_hash = 0) {
+  for (const auto &entry : snapshot.entries) {
+    if (entry.component == component && entry.source == source && entry.name_hash == name_hash)
+      return &entry;
+  }
+  return nullptr;
+}
+
+uint32_t bucket_sum(const ProfileStats &stats) {
+  uint32_t sum = 0;
+  for (uint32_t bucket : stats.buckets)
+    sum += bucket;
+  return sum;
+}
+
+void test_slots() {
+  Profiler profiler;
+  Component first, second;
+  for (int i = 0; i < 3; i++) {
+    profiler.record(&first, ProfileSource::LOOP, 0, 10);
+    profiler.record(&first, ProfileSource::INTERVAL, 0x1234, 100);
+    profiler.record(&second, ProfileSource::LOOP, 0, 1000);
+  }
+  profiler.record(&first, ProfileSource::TIMEOUT, 0x1234, 20);
+  profiler.record(&first, ProfileSource::INTERVAL, 0x5678, 30);
+  profiler.record(nullptr, ProfileSource::TIMEOUT, 0, 40);
+  profiler.record(nullptr, ProfileSource::TIMEOUT, 0, 50);
+
+  const auto snapshot = profiler.snapshot(false);
+  EXPECT_EQ(snapshot.entries.size(), size_t(6));
+  const struct {
+    const Component *component;
+    ProfileSource source;
+    uint32_t name_hash;
+    uint32_t count;
+    uint64_t total_us;
+  } expected[] = {
+      {&first, ProfileSource::LOOP, 0, 3, 30},          {&first, ProfileSource::INTERVAL, 0x1234, 3, 300},
+      {&second, ProfileSource::LOOP, 0, 3, 3000},       {&first, ProfileSource::TIMEOUT, 0x1234, 1, 20},
+      {&first, ProfileSource::INTERVAL, 0x5678, 1, 30}, {nullptr, ProfileSource::TIMEOUT, 0, 2, 90},
+  };
+  for (const auto &e : expected) {
+    const ProfileEntry *entry = find(snapshot, e.component, e.source, e.name_hash);
+    EXPECT_TRUE(entry != nullptr);
+    if (entry == nullptr)
+      continue;
+    EXPECT_EQ(entry->stats.count, e.count);
+    EXPECT_EQ(entry->stats.total_us, e.total_us);
+  }
+}
+
+void test_reset() {
+  Profiler profiler;
+  Component component;
+  testing::set_millis(1000);
+  profiler.record(&component, ProfileSource::LOOP, 0, 10);
+  profiler.record(&component, ProfileSource::LOOP, 0, 10);
+
+  testing::set_millis(3000);
+  auto snapshot = profiler.snapshot(true);
+  EXPECT_EQ(snapshot.duration_ms, 3000u);
+  EXPECT_EQ(find(snapshot, &component, ProfileSource::LOOP)->stats.count, 2u);
+
+  // The reset happens with the next call
+  testing::set_millis(4000);
+  profiler.record(&component, ProfileSource::LOOP, 0, 7);
+  testing::set_millis(4500);
+  snapshot = profiler.snapshot(false);
+  EXPECT_EQ(snapshot.duration_ms, 500u);
+  const ProfileEntry *entry = find(snapshot, &component, ProfileSource::LOOP);
+  EXPECT_EQ(entry->stats.count, 1u);
+  EXPECT_EQ(entry->stats.total_us, uint64_t(7));
+  EXPECT_EQ(entry->stats.max_us, 7u);
+  EXPECT_EQ(bucket_sum(entry->stats), 1u);
+}
+
+void test_no_allocations_per_call() {
+  Profiler profiler;
+  Component components[20];
+  for (auto &component : components) {
+    profiler.record(&component, ProfileSource::LOOP, 0, 10);
+    profiler.record(&component, ProfileSource::INTERVAL, 0x1234, 10);
+  }
+
+  auto &heap = testing::heap;
+  heap.reset_peak();
+  for (int i = 0; i < 100; i++) {
+    for (auto &component : components) {
+      profiler.record(&component, ProfileSource::LOOP, 0, 10);
+      profiler.record(&component, ProfileSource::INTERVAL, 0x1234, 10);
+    }
+  }
+  EXPECT_EQ(heap.allocations, size_t(0));
+}
+
+void test_concurrent_snapshots() {
+  Profiler profiler;
+  Component components[4];
+  // Every call takes the same time, so the statistics of a slot only agree with each other if it was copied whole
+  const uint32_t duration_us = 100;
+  for (auto &component : components)
+    profiler.record(&component, ProfileSource::LOOP, 0, duration_us);
+
+  std::atomic<bool> done{false};
+  std::thread main_loop([&]() {
+    for (int i = 0; i < 2000000; i++)
+      profiler.record(&components[i % 4], ProfileSource::LOOP, 0, duration_us);
+    done = true;
+  });
+
+  uint32_t snapshots = 0;
+  uint32_t inconsistent = 0;
+  while (!done) {
+    const auto snapshot = profiler.snapshot(false);
+    snapshots++;
+    for (const auto &entry : snapshot.entries) {
+      const uint32_t count = entry.stats.count;
+      if (entry.stats.total_us != uint64_t(count) * duration_us || bucket_sum(entry.stats) != count)
+        inconsistent++;
+    }
+  }
+  main_loop.join();
+
+  EXPECT_TRUE(snapshots > 0);
+  EXPECT_EQ(inconsistent, 0u);
+  EXPECT_EQ(find(profiler.snapshot(false), &components[0], ProfileSource::LOOP)->stats.count, 500001u);
+}
+
+}  // namespace
+
+int main() {
+  test_slots();
+  test_reset();
+  test_no_allocations_per_call();
+  test_concurrent_snapshots();
+  return esphome::testing::finish("core/profiler_test");
+}
@@ -0,0 +1,63 @@
+// Glyphs per second of measuring and printing a clock text on a 240x135 display, with the glyph index, the measure
+// cache and the run drawing, and with the bisection and pixel by pixel drawing from before them.
+// Unrotated text that is fully on the display was blitted before too, rotated and clipped text was not.
+
+#include "test_display.h"
+#include "test_helpers.h"
+
+#include <cstdio>
+#include <functional>
+
+using namespace esphome;
+using namespace esphome::display;
+using namespace esphome::display::testing;
+
+static const size_t RUNS = 20000;
+static const char *const TEXT = "12:34 5\xC2\xB0";
+
+static double mglyphs_per_s(const std::function<void()> &op) {
+  double ns = esphome::testing::time_ns(RUNS, op);
+  return 8 / ns * 1000.0;
+}
+
+int main() {
+  TestGlyphs glyphs({" ", "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", ":", "A", "g", "\xC2\xB0"});
+  ReferenceFont font(glyphs.data.data(), glyphs.data.size(), 12, 16);
+  TestDisplay display(240, 135);
+  const Color color(0xFF, 0x80, 0x00);
+
+  printf("'%s' (8 glyphs) on a 240x135 display:\n", TEXT);
+  printf("%-22s %16s %16s\n", "operation", "before Mglyph/s", "after Mglyph/s");
+
+  int width, x_offset, baseline, height;
+  const double measure_before = mglyphs_per_s([&]() {
+    font.reference_measure(TEXT, &width, &x_offset);
+    esphome::testing::do_not_optimize(width);
+  });
+  const double measure_after = mglyphs_per_s([&]() {
+    font.measure(TEXT, &width, &x_offset, &baseline, &height);
+    esphome::testing::do_not_optimize(width);
+  });
+  printf("%-22s %16.2f %16.2f\n", "measure", measure_before, measure_after);
+
+  const struct {
+    const char *name;
+    DisplayRotation rotation;
+    int x, y;
+  } prints[] = {
+      {"print 0 deg", DISPLAY_ROTATION_0_DEGREES, 100, 60},
+      {"print 90 deg", DISPLAY_ROTATION_90_DEGREES, 60, 100},
+      {"print 180 deg", DISPLAY_ROTATION_180_DEGREES, 100, 60},
+      {"print 0 deg, clipped", DISPLAY_ROTATION_0_DEGREES, -20, 125},
+  };
+  for (const auto &print : prints) {
+    display.set_rotation(print.rotation);
+    const double before = mglyphs_per_s(
+        [&]() { display.reference_print(print.x, print.y, &font, color, TextAlign::TOP_LEFT, TEXT); });
+    const double after =
+        mglyphs_per_s([&]() { display.print(print.x, print.y, &font, color, TextAlign::TOP_LEFT, TEXT); });
+    esphome::testing::do_not_optimize(display.get_pixels()[0]);
+    printf("%-22s %16.2f %16.2f\n", print.name, before, after);
+  }
+  return 0;
+}
@@ -0,0 +1,114 @@
+// Glyph lookup, measuring and drawing of text: the index finds the same glyphs as the bisection, measure() with its
+// cache gives the same bounds, and text is rendered exactly like before in all four rotations, also when clipped.
+
+#include "test_display.h"
+#include "test_helpers.h"
+
+#include <string>
+
+using namespace esphome;
+using namespace esphome::display;
+using namespace esphome::display::testing;
+
+namespace {
+
+const std::vector<const char *> CHARS = {" ", "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", ":", "A", "g",
+                                         "\xC2\xB0", "\xE2\x82\xAC"};
+
+/// Known, unknown, multi byte, invalid and truncated UTF-8 characters.
+const std::vector<const char *> TEXTS = {"12:34", "A\xC2\xB0g\xE2\x82\xAC", "9\xFF" "0", "x?A", "0\xE2\x82", "",
+                                         "g g g g g", "\xC2\xB0\xC2\xB0"};
+
+void test_index_matches_bisection() {
+  TestGlyphs glyphs(CHARS);
+  ReferenceFont font(glyphs.data.data(), glyphs.data.size(), 12, 16);
+  std::vector<std::string> strings;
+  for (int b = 1; b < 256; b++)
+    strings.push_back(std::string(1, char(b)) + "1");
+  for (const char *c : CHARS)
+    strings.push_back(std::string(c) + "1");
+  strings.push_back("\xE2\x82\xAD");
+  strings.push_back("\xC2");
+  for (const auto &str : strings) {
+    int index_length, bisect_length;
+    const int index_glyph = font.match_next_glyph(str.c_str(), &index_length);
+    const int bisect_glyph = font.bisect_glyph(str.c_str(), &bisect_length);
+    EXPECT_EQ(index_glyph, bisect_glyph);
+    if (index_glyph >= 0)
+      EXPECT_EQ(index_length, bisect_length);
+  }
+}
+
+void test_measure() {
+  TestGlyphs glyphs(CHARS);
+  ReferenceFont font(glyphs.data.data(), glyphs.data.size(), 12, 16);
+  // More texts than the cache holds, twice, so that cached, evicted and new texts are measured
+  std::vector<std::string> texts(TEXTS.begin(), TEXTS.end());
+  for (int i = 0; i < 10; i++)
+    texts.push_back(std::to_string(i * 37) + ":" + std::to_string(i));
+  for (int round = 0; round < 2; round++) {
+    for (const auto &text : texts) {
+      int width, x_offset, baseline, height;
+      font.measure(text.c_str(), &width, &x_offset, &baseline, &height);
+      int reference_width, reference_x_offset;
+      font.reference_measure(text.c_str(), &reference_width, &reference_x_offset);
+      EXPECT_EQ(width, reference_width);
+      EXPECT_EQ(x_offset, reference_x_offset);
+      EXPECT_EQ(baseline, 12);
+      EXPECT_EQ(height, 16);
+    }
+  }
+}
+
+void expect_same_rendering(ReferenceFont *font, const std::vector<const char *> &texts) {
+  const Color color(0x12, 0x34, 0x56);
+  TestDisplay display(37, 29);
+  TestDisplay reference(37, 29);
+  // Fully inside, and clipped at every edge
+  const int positions[][2] = {{5, 6}, {-7, 3}, {-30, -9}, {20, -5}, {30, 20}, {3, 25}, {-2, -2}, {36, 28}};
+  const TextAlign aligns[] = {TextAlign::TOP_LEFT, TextAlign::CENTER, TextAlign::BASELINE_RIGHT};
+  for (auto rotation : {DISPLAY_ROTATION_0_DEGREES, DISPLAY_ROTATION_90_DEGREES, DISPLAY_ROTATION_180_DEGREES,
+                        DISPLAY_ROTATION_270_DEGREES}) {
+    display.set_rotation(rotation);
+    reference.set_rotation(rotation);
+    for (const char *text : texts) {
+      for (const auto &position : positions) {
+        for (auto align : aligns) {
+          display.clear_pixels();
+          reference.clear_pixels();
+          display.print(position[0], position[1], font, color, align, text);
+          reference.reference_print(position[0], position[1], font, color, align, text);
+          if (display.get_pixels() != reference.get_pixels()) {
+            std::cerr << "'" << text << "' at " << position[0] << "," << position[1] << " rotated by " << rotation
+                      << " differs" << std::endl;
+            EXPECT_TRUE(display.get_pixels() == reference.get_pixels());
+          }
+        }
+      }
+    }
+  }
+  EXPECT_EQ(display.get_blocks_outside(), 0u);
+}
+
+void test_rendering() {
+  TestGlyphs glyphs(CHARS);
+  ReferenceFont font(glyphs.data.data(), glyphs.data.size(), 12, 16);
+  expect_same_rendering(&font, TEXTS);
+}
+
+void test_rendering_multi_character_glyph() {
+  // A ligature can't be indexed, so this font keeps using the bisection
+  TestGlyphs glyphs({"a", "f", "fi", "i"});
+  ReferenceFont font(glyphs.data.data(), glyphs.data.size(), 12, 16);
+  expect_same_rendering(&font, {"fifa", "aif", "ffi"});
+}
+
+}  // namespace
+
+int main() {
+  test_index_matches_bisection();
+  test_measure();
+  test_rendering();
+  test_rendering_multi_character_glyph();
+  return esphome::testing::finish("display/font_test");
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+// Display that keeps its pixels in memory, and the text measuring and drawing from before the glyph index and the
+// run drawing, to compare the rendered text with.
+
+#include "esphome/components/display/display_buffer.h"
+
+#include <random>
+#include <vector>
+
+namespace esphome {
+namespace display {
+namespace testing {
+
+/// Glyphs of the given characters (sorted like the font generator does) with pseudo random bitmaps of varying sizes
+/// and offsets. Widths cross byte boundaries and the rows are padded with zeros like the generated fonts.
+struct TestGlyphs {
+  std::vector<std::vector<uint8_t>> bitmaps;
+  std::vector<GlyphData> data;
+
+  explicit TestGlyphs(const std::vector<const char *> &chars) {
+    std::mt19937 rng(1);
+    for (size_t i = 0; i < chars.size(); i++) {
+      const int width = 1 + (i * 5) % 13;
+      const int height = 6 + (i * 3) % 8;
+      const int stride = (width + 7) / 8;
+      std::vector<uint8_t> bitmap(stride * height);
+      for (int row = 0; row < height; row++) {
+        for (int col = 0; col < width; col++) {
+          if (rng() % 3 != 0)
+            bitmap[row * stride + col / 8] |= 0x80 >> (col % 8);
+        }
+      }
+      this->bitmaps.push_back(std::move(bitmap));
+      this->data.push_back(GlyphData{chars[i], nullptr, int(i % 4) - 1, int(i % 3), width, height});
+    }
+    for (size_t i = 0; i < chars.size(); i++)
+      this->data[i].data = this->bitmaps[i].data();
+  }
+};
+
+/// Exposes the glyph lookup by bisection, the only one there was before the index.
+class ReferenceFont : public Font {
+ public:
+  ReferenceFont(const GlyphData *data, int data_nr, int baseline, int bottom)
+      : Font(data, data_nr, baseline, bottom), data_(data) {}
+  const GlyphData &get_glyph_data(int glyph_n) const { return this->data_[glyph_n]; }
+  int bisect_glyph(const char *str, int *match_length) { return this->bisect_glyph_(str, match_length); }
+
+  /// Font::measure() without the index and the cache.
+  void reference_measure(const char *str, int *width, int *x_offset) {
+    int i = 0;
+    int min_x = 0;
+    bool has_char = false;
+    int x = 0;
+    while (str[i] != '\0') {
+      int match_length;
+      int glyph_n = this->bisect_glyph(str + i, &match_length);
+      if (glyph_n < 0) {
+        if (!this->get_glyphs().empty())
+          x += this->glyph_width_(0);
+        i++;
+        continue;
+      }
+      int offset_x, offset_y, glyph_width, glyph_height;
+      this->get_glyphs()[glyph_n].scan_area(&offset_x, &offset_y, &glyph_width, &glyph_height);
+      if (!has_char) {
+        min_x = offset_x;
+      } else {
+        min_x = std::min(min_x, x + offset_x);
+      }
+      x += glyph_width + offset_x;
+      i += match_length;
+      has_char = true;
+    }
+    *x_offset = min_x;
+    *width = x - min_x;
+  }
+
+ protected:
+  const GlyphData *data_;
+
+  int glyph_width_(int glyph_n) const {
+    int offset_x, offset_y, width, height;
+    this->get_glyphs()[glyph_n].scan_area(&offset_x, &offset_y, &width, &height);
+    return width;
+  }
+};
+
+class TestDisplay : public DisplayBuffer {
+ public:
+  TestDisplay(int width, int height) : width_(width), height_(height), pixels_(width * height) {}
+
+  int get_width_internal() override { return this->width_; }
+  int get_height_internal() override { return this->height_; }
+  DisplayType get_display_type() override { return DisplayType::DISPLAY_TYPE_COLOR; }
+  const std::vector<uint32_t> &get_pixels() const { return this->pixels_; }
+  void clear_pixels() { std::fill(this->pixels_.begin(), this->pixels_.end(), 0); }
+  /// Number of block primitive calls with an area that isn't fully on the display, which they may assume.
+  uint32_t get_blocks_outside() const { return this->blocks_outside_; }
+
+  /// DisplayBuffer::print() before the index and the run drawing: unrotated glyphs that are fully on the display are
+  /// blitted, rotated and clipped ones are drawn pixel by pixel.
+  void reference_print(int x, int y, ReferenceFont *font, Color color, TextAlign align, const char *text) {
+    int x_start, y_start;
+    int width, height;
+    this->get_text_bounds(x, y, text, font, align, &x_start, &y_start, &width, &height);
+
+    int i = 0;
+    int x_at = x_start;
+    while (text[i] != '\0') {
+      int match_length;
+      int glyph_n = font->bisect_glyph(text + i, &match_length);
+      if (glyph_n < 0) {
+        if (!font->get_glyphs().empty()) {
+          int offset_x, offset_y, glyph_width, glyph_height;
+          font->get_glyphs()[0].scan_area(&offset_x, &offset_y, &glyph_width, &glyph_height);
+          this->filled_rectangle(x_at, y_start, uint8_t(glyph_width), height, color);
+          x_at += uint8_t(glyph_width);
+        }
+        i++;
+        continue;
+      }
+
+      const Glyph &glyph = font->get_glyphs()[glyph_n];
+      int scan_x1, scan_y1, scan_width, scan_height;
+      glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
+
+      const int glyph_x1 = x_at + scan_x1;
+      const int glyph_y1 = y_start + scan_y1;
+      if (this->rotation_ == DISPLAY_ROTATION_0_DEGREES &&
+          this->is_inside_(glyph_x1, glyph_y1, scan_width, scan_height)) {
+        if (scan_width > 0 && scan_height > 0) {
+          this->mark_dirty_(glyph_x1, glyph_y1, glyph_x1 + scan_width - 1, glyph_y1 + scan_height - 1);
+          this->blit_bitmap_1bpp_internal(glyph_x1, glyph_y1, scan_width, scan_height,
+                                          font->get_glyph_data(glyph_n).data, color, COLOR_OFF, true);
+        }
+        x_at += scan_width + scan_x1;
+        i += match_length;
+        continue;
+      }
+
+      for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
+        for (int glyph_y = scan_y1; glyph_y < scan_y1 + scan_height; glyph_y++) {
+          if (glyph.get_pixel(glyph_x, glyph_y))
+            this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
+        }
+      }
+      x_at += scan_width + scan_x1;
+      i += match_length;
+    }
+  }
+
+ protected:
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    // draw_pixel_at() leaves clipping to the displays
+    if (x < 0 || y < 0 || x >= this->width_ || y >= this->height_)
+      return;
+    this->pixels_[y * this->width_ + x] = color.raw_32;
+  }
+
+  void fill_span_internal(int x, int y, int width, Color color) override {
+    this->check_block_(x, y, width, 1);
+    DisplayBuffer::fill_span_internal(x, y, width, color);
+  }
+  void blit_bitmap_1bpp_internal(int x, int y, int width, int height, const uint8_t *data, Color color_on,
+                                 Color color_off, bool transparent) override {
+    this->check_block_(x, y, width, height);
+    DisplayBuffer::blit_bitmap_1bpp_internal(x, y, width, height, data, color_on, color_off, transparent);
+  }
+  void check_block_(int x, int y, int width, int height) {
+    if (x < 0 || y < 0 || x + width > this->width_ || y + height > this->height_)
+      this->blocks_outside_++;
+  }
+
+  int width_;
+  int height_;
+  std::vector<uint32_t> pixels_;
+  uint32_t blocks_outside_{0};
+};
+
+}  // namespace testing
+}  // namespace display
+}  // namespace esphome
@@ -0,0 +1,91 @@
+// Throughput and peak heap of writing the MQTT discovery payloads of 100 sensors with the JsonWriter.
+//
+// The payloads have the fields MQTTSensorComponent and MQTTComponent::send_discovery_() write. The previous
+// ArduinoJson document path can't be built on the host, so it isn't compared here: it allocated a document of at
+// least 512 bytes for every payload, plus the serialized string.
+
+#include "esphome/components/json/json_writer.h"
+#include "heap_counter.h"
+#include "test_helpers.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+
+static const int ENTITIES = 100;
+static const size_t ROUNDS = 2000;
+
+struct Entity {
+  std::string name;
+  std::string unique_id;
+  std::string state_topic;
+  std::string object_id;
+};
+
+static void write_discovery(json::JsonWriter &root, const Entity &entity) {
+  // MQTTSensorComponent::send_discovery()
+  root.add("dev_cla", "temperature");
+  root.add("unit_of_meas", "°C");
+  root.add("exp_aft", 600u);
+  root.add("stat_cla", "measurement");
+  // MQTTComponent::send_discovery_()
+  root.add("name", entity.name);
+  root.add("ic", "mdi:thermometer");
+  root.add("stat_t", entity.state_topic);
+  root.add("avty_t", "livingroom/status");
+  root.add("uniq_id", entity.unique_id);
+  root.add("obj_id", entity.object_id);
+  root.begin_object("dev");
+  root.add("ids", "24a160c3d2e1");
+  root.add("name", "livingroom");
+  root.add("sw", "esphome v2022.2.0 Feb 17 2022, 10:12:33");
+  root.add("mdl", "esp32dev");
+  root.add("mf", "espressif");
+  root.end_object();
+}
+
+int main() {
+  std::vector<Entity> entities;
+  for (int i = 0; i < ENTITIES; i++) {
+    std::string index = std::to_string(i);
+    entities.push_back({"Temperature " + index, "24a160c3d2e1-sensor-" + index,
+                        "livingroom/sensor/temperature_" + index + "/state", "livingroom_temperature_" + index});
+  }
+
+  size_t bytes = 0;
+  for (const auto &entity : entities)
+    bytes += json::write_json([&entity](json::JsonWriter &root) { write_discovery(root, entity); }).size();
+  printf("Discovery of %d sensors, %zu bytes of JSON:\n", ENTITIES, bytes);
+  printf("%-28s %10s %16s %12s\n", "", "MB/s", "allocs/payload", "peak heap");
+
+  // A new string for every payload, which is what write_json(f) returns
+  esphome::testing::heap.reset_peak();
+  size_t base = esphome::testing::heap.current;
+  double ns = esphome::testing::time_ns(ROUNDS, [&]() {
+    for (const auto &entity : entities) {
+      std::string payload = json::write_json([&entity](json::JsonWriter &root) { write_discovery(root, entity); });
+      esphome::testing::do_not_optimize(payload);
+    }
+  });
+  printf("%-28s %10.1f %16.2f %12zu\n", "new string per payload", bytes / ns * 1e3,
+         double(esphome::testing::heap.allocations) / (ROUNDS * ENTITIES), esphome::testing::heap.peak - base);
+
+  // One buffer for all payloads, like MQTTComponent::send_discovery_()
+  std::string buffer;
+  json::write_json(buffer, [&](json::JsonWriter &root) { write_discovery(root, entities.back()); });
+  esphome::testing::heap.reset_peak();
+  base = esphome::testing::heap.current;
+  ns = esphome::testing::time_ns(ROUNDS, [&]() {
+    for (const auto &entity : entities) {
+      json::write_json(buffer, [&entity](json::JsonWriter &root) { write_discovery(root, entity); });
+      esphome::testing::do_not_optimize(buffer);
+    }
+  });
+  // The buffer is held all the time, so it counts towards the peak
+  printf("%-28s %10.1f %16.2f %12zu\n", "reused buffer", bytes / ns * 1e3,
+         double(esphome::testing::heap.allocations) / (ROUNDS * ENTITIES),
+         esphome::testing::heap.peak - base + buffer.capacity());
+  return 0;
+}
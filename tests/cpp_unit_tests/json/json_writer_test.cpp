@@ -0,0 +1,80 @@
+// Output of the streaming JsonWriter: nesting, escaping, numbers and writing into a reused buffer.
+
+#include "esphome/components/json/json_writer.h"
+#include "test_helpers.h"
+
+#include <cmath>
+#include <string>
+
+using namespace esphome;
+
+static void test_nesting() {
+  std::string out = json::write_json([](json::JsonWriter &root) {
+    root.add("id", "sensor-temperature");
+    root.begin_array("options");
+    root.add_value("a");
+    root.add_value(std::string("b"));
+    root.end_array();
+    root.begin_array("empty");
+    root.end_array();
+    root.begin_object("device");
+    root.add("on", true);
+    root.add("off", false);
+    root.end_object();
+    root.add("last", 1);
+  });
+  EXPECT_EQ(out, std::string(R"({"id":"sensor-temperature","options":["a","b"],"empty":[],)"
+                             R"("device":{"on":true,"off":false},"last":1})"));
+}
+
+static void test_escaping() {
+  std::string out = json::write_json([](json::JsonWriter &root) {
+    root.add("quote\"", std::string("back\\slash\n\r\t\x01 °C"));
+  });
+  EXPECT_EQ(out, std::string(R"({"quote\"":"back\\slash\n\r\t\u0001 °C"})"));
+}
+
+static void test_numbers() {
+  std::string out = json::write_json([](json::JsonWriter &root) {
+    root.add("float", 23.5f);
+    root.add("tenth", 0.1f);
+    root.add("double", 0.1);
+    root.add("nan", NAN);
+    root.add("inf", INFINITY);
+    root.add("negative", int8_t(-5));
+    root.add("unsigned", uint32_t(4000000000u));
+    root.add("big", uint64_t(18446744073709551615ull));
+  });
+  EXPECT_EQ(out, std::string(R"({"float":23.5,"tenth":0.1,"double":0.1,"nan":null,"inf":null,"negative":-5,)"
+                             R"("unsigned":4000000000,"big":18446744073709551615})"));
+}
+
+static void test_raw_members() {
+  std::string out = json::write_json([](json::JsonWriter &root) {
+    root.add_raw_members("{}");
+    root.add("a", 1);
+    root.add_raw_members(R"({"b":2,"c":[3]})");
+  });
+  EXPECT_EQ(out, std::string(R"({"a":1,"b":2,"c":[3]})"));
+}
+
+static void test_reused_buffer() {
+  std::string buffer;
+  json::write_json(buffer, [](json::JsonWriter &root) { root.add("long", std::string(200, 'x')); });
+  size_t capacity = buffer.capacity();
+  const char *data = buffer.data();
+  // A shorter document replaces the previous one in place
+  json::write_json(buffer, [](json::JsonWriter &root) { root.add("short", 1); });
+  EXPECT_EQ(buffer, std::string(R"({"short":1})"));
+  EXPECT_EQ(buffer.capacity(), capacity);
+  EXPECT_TRUE(buffer.data() == data);
+}
+
+int main() {
+  test_nesting();
+  test_escaping();
+  test_numbers();
+  test_raw_members();
+  test_reused_buffer();
+  return esphome::testing::finish("json/json_writer_test");
+}
@@ -0,0 +1,55 @@
+// LEDs per second of the range operations on a 1000 LED RGB strip with gamma 2.8 and a local brightness of 180,
+// through the pixel buffer and through the per-LED path that outputs without a pixel buffer still take.
+// Effects run these operations on the whole strip in every frame, so their cost scales with the LED count.
+
+#include "test_light.h"
+#include "test_helpers.h"
+
+#include <cstdio>
+#include <functional>
+
+using namespace esphome;
+using namespace esphome::light;
+using esphome::light::testing::TestLight;
+
+static const int32_t LEDS = 1000;
+static const size_t RUNS = 2000;
+
+static double mleds_per_s(bool use_buffer, const std::function<void(TestLight &, size_t)> &op) {
+  TestLight light(LEDS, false, use_buffer);
+  light.set_gamma(2.8f);
+  light.set_local_brightness(180);
+  int32_t i = 0;
+  for (auto led : light)
+    led = ESPHSVColor(i++ * 3, 255, 255);
+  size_t run = 0;
+  double ns = esphome::testing::time_ns(RUNS, [&]() { op(light, run++); });
+  esphome::testing::do_not_optimize(light.get_pixels()[0]);
+  return LEDS / ns * 1000.0;
+}
+
+int main() {
+  const struct {
+    const char *name;
+    std::function<void(TestLight &, size_t)> op;
+  } ops[] = {
+      {"fill", [](TestLight &light, size_t run) { light.all() = Color(run, 128, 255 - run); }},
+      {"fade_to_black", [](TestLight &light, size_t run) { light.all().fade_to_black(250); }},
+      {"lighten", [](TestLight &light, size_t run) { light.all().lighten(run & 1 ? 3 : 0); }},
+      {"darken", [](TestLight &light, size_t run) { light.all().darken(run & 1 ? 3 : 0); }},
+      {"lerp (transition)", [](TestLight &light, size_t run) { light.all().lerp(Color(255, 64, 0), 20); }},
+      {"iterate (rainbow)",
+       [](TestLight &light, size_t run) {
+         uint16_t hue = run * 7;
+         for (auto led : light)
+           led = ESPHSVColor(hue++, 255, 255);
+       }},
+      {"shift_left", [](TestLight &light, size_t run) { light.shift_left(1); }},
+  };
+
+  printf("%u RGB LEDs, gamma 2.8, local brightness 180:\n", LEDS);
+  printf("%-18s %16s %16s\n", "operation", "per LED MLED/s", "buffer MLED/s");
+  for (const auto &op : ops)
+    printf("%-18s %16.1f %16.1f\n", op.name, mleds_per_s(false, op.op), mleds_per_s(true, op.op));
+  return 0;
+}
@@ -0,0 +1,122 @@
+// Range operations of addressable lights: the packed 32-bit fade, lighten, darken and lerp give exactly the results of
+// the Color operators for every channel value and amount, and the pixel buffer path writes the same LED bytes as the
+// per-LED path.
+
+#include "test_light.h"
+#include "test_helpers.h"
+
+#include <functional>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::light;
+using esphome::light::testing::TestLight;
+
+namespace {
+
+/// 256 LEDs, every channel takes every value once (73 and 151 are odd, so the products cycle through all bytes).
+std::vector<Color> all_values() {
+  std::vector<Color> colors;
+  for (uint32_t i = 0; i < 256; i++)
+    colors.emplace_back(i, i * 73, 255 - i, i * 151);
+  return colors;
+}
+
+void load(TestLight *light, const std::vector<Color> &colors) {
+  for (size_t i = 0; i < colors.size(); i++)
+    (*light)[i] = colors[i];
+}
+
+/// Apply op with every amount to LEDs of every value and count the channels that differ from the reference.
+void expect_exhaustive(const char *name, const std::function<void(ESPRangeView &, uint8_t)> &op,
+                       const std::function<Color(Color, uint8_t)> &reference) {
+  const auto colors = all_values();
+  TestLight light(colors.size(), true, true);
+  uint32_t mismatches = 0;
+  for (uint32_t amount = 0; amount < 256; amount++) {
+    load(&light, colors);
+    auto range = light.all();
+    op(range, amount);
+    for (size_t i = 0; i < colors.size(); i++) {
+      const Color expected = reference(colors[i], amount);
+      const Color actual = light[i].get();
+      if (actual.raw_32 == expected.raw_32)
+        continue;
+      if (mismatches++ == 0) {
+        std::cerr << name << "(" << amount << ") of LED " << i << ": got " << std::hex << actual.raw_32 << ", expected "
+                  << expected.raw_32 << std::dec << std::endl;
+      }
+    }
+  }
+  EXPECT_EQ(mismatches, 0u);
+}
+
+void test_fade_to_black() {
+  expect_exhaustive(
+      "fade_to_black", [](ESPRangeView &range, uint8_t amount) { range.fade_to_black(amount); },
+      [](Color color, uint8_t amount) { return color.fade_to_black(amount); });
+}
+
+void test_fade_to_white() {
+  expect_exhaustive(
+      "fade_to_white", [](ESPRangeView &range, uint8_t amount) { range.fade_to_white(amount); },
+      [](Color color, uint8_t amount) { return color.fade_to_white(amount); });
+}
+
+void test_lighten() {
+  expect_exhaustive(
+      "lighten", [](ESPRangeView &range, uint8_t delta) { range.lighten(delta); },
+      [](Color color, uint8_t delta) { return color.lighten(delta); });
+}
+
+void test_darken() {
+  expect_exhaustive(
+      "darken", [](ESPRangeView &range, uint8_t delta) { range.darken(delta); },
+      [](Color color, uint8_t delta) { return color.darken(delta); });
+}
+
+void test_lerp() {
+  // Every combination of current value, target value and amount in each channel
+  for (uint32_t t = 0; t < 256; t++) {
+    const Color target(t, t * 73, 255 - t, t * 151);
+    expect_exhaustive(
+        "lerp", [target](ESPRangeView &range, uint8_t amount) { range.lerp(target, amount); },
+        [target](Color color, uint8_t amount) { return color * uint8_t(255 - amount) + target * amount; });
+  }
+}
+
+/// With gamma and brightness correction, both paths must still write the same bytes.
+void test_buffer_matches_per_led_path() {
+  const int32_t size = 300;
+  std::vector<TestLight> lights;
+  lights.emplace_back(size, false, true);
+  lights.emplace_back(size, false, false);
+  for (auto &light : lights) {
+    light.set_gamma(2.8f);
+    light.set_local_brightness(180);
+    int32_t i = 0;
+    for (auto led : light)
+      led = ESPHSVColor(i++ * 5, 240, 200);
+    light.range(10, 100) = Color(200, 50, 10);
+    light.range(50, 250).fade_to_black(200);
+    light.range(0, 150).lighten(30);
+    light.range(100, 300).darken(25);
+    light.range(20, 280).fade_to_white(240);
+    light.all().lerp(Color(0, 255, 128), 77);
+    for (auto led : light.range(5, 15))
+      led.set_red(led.get_red() / 2);
+  }
+  EXPECT_TRUE(lights[0].get_pixels() == lights[1].get_pixels());
+}
+
+}  // namespace
+
+int main() {
+  test_fade_to_black();
+  test_fade_to_white();
+  test_lighten();
+  test_darken();
+  test_lerp();
+  test_buffer_matches_per_led_path();
+  return esphome::testing::finish("light/esp_range_view_test");
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// Addressable light that keeps its LEDs in memory, for the range tests and benchmarks. It can hide its pixel buffer,
+// so that ranges take the per-LED path through ESPColorView and the Color operators instead.
+
+#include "esphome/components/light/addressable_light.h"
+
+#include <vector>
+
+namespace esphome {
+namespace light {
+namespace testing {
+
+class TestLight : public AddressableLight {
+ public:
+  /// GRB(W) byte order like most LED chips, so that the channel offsets are exercised.
+  TestLight(int32_t size, bool has_white, bool use_buffer)
+      : pixels_(size * (has_white ? 4 : 3)), effect_data_(size), stride_(has_white ? 4 : 3), use_buffer_(use_buffer) {
+    this->set_correction(1.0f, 1.0f, 1.0f, 1.0f);
+    this->set_gamma(0.0f);
+  }
+
+  /// Gamma 0 turns the correction into the identity, so the LED bytes are the uncorrected colors.
+  void set_gamma(float gamma) { this->correction_.calculate_gamma_table(gamma); }
+  void set_local_brightness(uint8_t brightness) { this->correction_.set_local_brightness(brightness); }
+  const std::vector<uint8_t> &get_pixels() const { return this->pixels_; }
+
+  int32_t size() const override { return this->effect_data_.size(); }
+  void clear_effect_data() override { std::fill(this->effect_data_.begin(), this->effect_data_.end(), 0); }
+  LightTraits get_traits() override { return {}; }
+  void write_state(LightState *state) override {}
+
+ protected:
+  ESPColorView get_view_internal(int32_t index) const override {
+    ESPPixelBuffer buffer;
+    this->fill_pixel_buffer_(&buffer);
+    return buffer.get_view(index);
+  }
+  bool get_pixel_buffer_(ESPPixelBuffer *buffer) const override {
+    if (!this->use_buffer_)
+      return false;
+    this->fill_pixel_buffer_(buffer);
+    return true;
+  }
+  void fill_pixel_buffer_(ESPPixelBuffer *buffer) const {
+    const uint8_t offsets[4] = {1, 0, 2, 3};
+    buffer->data = const_cast<uint8_t *>(this->pixels_.data());
+    buffer->stride = this->stride_;
+    std::copy(offsets, offsets + 4, buffer->offsets);
+    buffer->effect_data = const_cast<uint8_t *>(this->effect_data_.data());
+    buffer->correction = &this->correction_;
+  }
+
+  std::vector<uint8_t> pixels_;
+  std::vector<uint8_t> effect_data_;
+  uint8_t stride_;
+  bool use_buffer_;
+};
+
+}  // namespace testing
+}  // namespace light
+}  // namespace esphome
@@ -0,0 +1,72 @@
+// Time of a log statement that is suppressed by a per-tag log level, before and after ESP_LOGx checked the level
+// ahead of evaluating its arguments.
+//
+// Before, the arguments were evaluated and passed to esp_log_printf_(), where level_for() compared the tag with
+// every override in turn. Now ESPHOME_LOG_ENABLED() hashes the tag and looks it up before the arguments are
+// evaluated. Statements at levels that no tag filters cost a single compare, those aren't suppressed though.
+
+#include "esphome/components/logger/logger.h"
+#include "esphome/core/log.h"
+#include "test_helpers.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace esphome;
+
+static const size_t RUNS = 2000000;
+static const int OVERRIDES = 8;
+
+static const char *const QUIET_TAG = "tag7";
+
+/// The previous Logger::level_for(): a string compare with every override.
+struct PreviousLevels {
+  std::vector<std::pair<std::string, int>> levels;
+  int level_for(const char *tag) {
+    for (auto &it : this->levels) {
+      if (it.first == tag)
+        return it.second;
+    }
+    return ESPHOME_LOG_LEVEL;
+  }
+};
+static PreviousLevels previous_levels;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// The previous esp_log_printf_() path up to the level check in Logger::log_vprintf_().
+static void __attribute__((noinline)) previous_log_printf(int level, const char *tag, int line, const char *format,
+                                                          ...) {
+  va_list args;
+  va_start(args, format);
+  if (level <= previous_levels.level_for(tag))
+    vprintf(format, args);
+  va_end(args);
+}
+#define PREVIOUS_LOGVV(tag, format, ...) \
+  previous_log_printf(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, __LINE__, format, ##__VA_ARGS__)
+
+static std::string __attribute__((noinline)) describe(uint32_t value) { return "value " + std::to_string(value); }
+
+int main() {
+  logger::Logger logger(0, 512, logger::UART_SELECTION_UART0);
+  logger.pre_setup();
+  for (int i = 0; i < OVERRIDES; i++) {
+    std::string tag = "tag" + std::to_string(i);
+    logger.set_log_level(tag, ESPHOME_LOG_LEVEL_DEBUG);
+    previous_levels.levels.emplace_back(tag, ESPHOME_LOG_LEVEL_DEBUG);
+  }
+
+  uint32_t value = 0;
+  printf("Suppressed ESP_LOGVV of a tag with a DEBUG level, %d overrides:\n", OVERRIDES);
+  double before = esphome::testing::time_ns(RUNS, [&]() { PREVIOUS_LOGVV(QUIET_TAG, "value %u", value++); });
+  double after = esphome::testing::time_ns(RUNS, [&]() { ESP_LOGVV(QUIET_TAG, "value %u", value++); });
+  printf("  integer argument: %6.1f ns before, %6.1f ns after\n", before, after);
+
+  before = esphome::testing::time_ns(RUNS, [&]() { PREVIOUS_LOGVV(QUIET_TAG, "%s", describe(value++).c_str()); });
+  after = esphome::testing::time_ns(RUNS, [&]() { ESP_LOGVV(QUIET_TAG, "%s", describe(value++).c_str()); });
+  printf("  string argument:  %6.1f ns before, %6.1f ns after\n", before, after);
+  esphome::testing::do_not_optimize(value);
+  return 0;
+}
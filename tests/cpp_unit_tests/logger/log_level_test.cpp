@@ -0,0 +1,55 @@
+// Per-tag log levels: the lookup in Logger::level_for() and the check before the arguments are evaluated.
+
+#include "esphome/components/logger/logger.h"
+#include "esphome/core/log.h"
+#include "test_helpers.h"
+
+#include <string>
+
+using namespace esphome;
+
+static const char *const TAG = "test";
+
+static int evaluations = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static int count_evaluation() { return ++evaluations; }
+
+static void test_level_for(logger::Logger *logger) {
+  // Without overrides every tag has the compile-time level
+  EXPECT_EQ(logger->level_for("anything"), ESPHOME_LOG_LEVEL);
+  EXPECT_EQ(esp_log_all_tags_level_, ESPHOME_LOG_LEVEL);
+
+  // Enough overrides to grow the hash table a few times
+  for (int i = 0; i < 40; i++)
+    logger->set_log_level("tag" + std::to_string(i), i % 2 ? ESPHOME_LOG_LEVEL_DEBUG : ESPHOME_LOG_LEVEL_WARN);
+  for (int i = 0; i < 40; i++) {
+    std::string tag = "tag" + std::to_string(i);
+    EXPECT_EQ(logger->level_for(tag.c_str()), i % 2 ? ESPHOME_LOG_LEVEL_DEBUG : ESPHOME_LOG_LEVEL_WARN);
+  }
+  EXPECT_EQ(logger->level_for("tag40"), ESPHOME_LOG_LEVEL);
+  EXPECT_EQ(esp_log_all_tags_level_, ESPHOME_LOG_LEVEL_WARN);
+
+  // Setting a level again replaces the override
+  logger->set_log_level("tag0", ESPHOME_LOG_LEVEL_VERBOSE);
+  EXPECT_EQ(logger->level_for("tag0"), ESPHOME_LOG_LEVEL_VERBOSE);
+  EXPECT_EQ(esp_log_all_tags_level_, ESPHOME_LOG_LEVEL_WARN);
+}
+
+static void test_arguments_not_evaluated(logger::Logger *logger) {
+  logger->set_log_level(TAG, ESPHOME_LOG_LEVEL_INFO);
+  evaluations = 0;
+  ESP_LOGD(TAG, "%d", count_evaluation());
+  ESP_LOGVV(TAG, "%d", count_evaluation());
+  EXPECT_EQ(evaluations, 0);
+
+  ESP_LOGI(TAG, "%d", count_evaluation());
+  ESP_LOGD("other", "%d", count_evaluation());
+  EXPECT_EQ(evaluations, 2);
+}
+
+int main() {
+  logger::Logger logger(0, 512, logger::UART_SELECTION_UART0);
+  logger.pre_setup();
+  test_level_for(&logger);
+  test_arguments_not_evaluated(&logger);
+  return esphome::testing::finish("logger/log_level_test");
+}
@@ -0,0 +1,152 @@
+// Routing of MQTT messages through the topic trie: wildcard matching as specified by MQTT 3.1.1, callbacks that add
+// or remove subscriptions while a message is routed, and no heap allocations per routed message.
+
+#include "esphome/components/mqtt/mqtt_topic_router.h"
+#include "heap_counter.h"
+#include "test_helpers.h"
+
+#include <map>
+#include <string>
+
+using namespace esphome;
+using namespace esphome::mqtt;
+
+namespace {
+
+/// Counts the calls of the callbacks per filter.
+struct Calls {
+  std::map<std::string, int> count;
+
+  mqtt_callback_t callback(const std::string &filter) {
+    return [this, filter](const std::string &topic, const std::string &payload) { this->count[filter]++; };
+  }
+  int get(const std::string &filter) { return this->count[filter]; }
+};
+
+void test_matching() {
+  const char *filters[] = {"a/b/c", "a/+/c", "a/#", "+/b/#", "#", "+", "a/b", "$SYS/#", "+/+/+/+", "a//c", "a/+"};
+  MQTTTopicRouter router;
+  Calls calls;
+  for (const char *filter : filters)
+    router.add(filter, calls.callback(filter));
+
+  const struct {
+    const char *topic;
+    std::vector<const char *> matches;
+  } cases[] = {
+      {"a/b/c", {"a/b/c", "a/+/c", "a/#", "+/b/#", "#"}},
+      {"a", {"a/#", "#", "+"}},
+      {"a/b", {"a/#", "+/b/#", "#", "a/b", "a/+"}},
+      {"x/b", {"+/b/#", "#"}},
+      {"a//c", {"a/+/c", "a/#", "#", "a//c"}},
+      {"a/b/c/d", {"a/#", "+/b/#", "#", "+/+/+/+"}},
+      {"/b", {"+/b/#", "#"}},
+      // Wildcards on the first level don't match topics starting with '$'
+      {"$SYS/broker", {"$SYS/#"}},
+      // but on the other levels
+      {"b/$x", {"#"}},
+  };
+  for (const auto &c : cases) {
+    calls.count.clear();
+    router.route(c.topic, "payload");
+    int total = 0;
+    for (const auto &it : calls.count)
+      total += it.second;
+    EXPECT_EQ(total, int(c.matches.size()));
+    for (const char *match : c.matches) {
+      if (calls.get(match) != 1)
+        std::cerr << "'" << c.topic << "' didn't match '" << match << "' once" << std::endl;
+      EXPECT_EQ(calls.get(match), 1);
+    }
+  }
+}
+
+void test_remove() {
+  MQTTTopicRouter router;
+  Calls calls;
+  router.add("a/+/c", calls.callback("a/+/c"));
+  router.add("a/+/c", calls.callback("a/+/c second"));
+  router.add("a/b/#", calls.callback("a/b/#"));
+  router.add("a/b/c", calls.callback("a/b/c"));
+
+  router.remove("a/+/c");
+  router.remove("a/x");
+  router.remove("a/b/c/d");
+  router.route("a/b/c", "");
+  EXPECT_EQ(calls.get("a/+/c"), 0);
+  EXPECT_EQ(calls.get("a/+/c second"), 0);
+  EXPECT_EQ(calls.get("a/b/#"), 1);
+  EXPECT_EQ(calls.get("a/b/c"), 1);
+
+  router.remove("a/b/#");
+  router.remove("a/b/c");
+  router.route("a/b/c", "");
+  EXPECT_EQ(calls.get("a/b/#"), 1);
+  EXPECT_EQ(calls.get("a/b/c"), 1);
+
+  // Pruned branches can be added again
+  router.add("a/b/c", calls.callback("a/b/c"));
+  router.route("a/b/c", "");
+  EXPECT_EQ(calls.get("a/b/c"), 2);
+}
+
+void test_subscriptions_changed_while_routing() {
+  MQTTTopicRouter router;
+  Calls calls;
+  std::string seen;
+  // Called first, removes its own filter and the one of the next callback, and adds more callbacks for the topic
+  router.add("a/#", [&](const std::string &topic, const std::string &payload) {
+    seen += "1";
+    router.remove("a/#");
+    router.remove("a/b");
+    for (int i = 0; i < 20; i++)
+      router.add("a/+", calls.callback("added"));
+  });
+  router.add("a/b", [&](const std::string &topic, const std::string &payload) {
+    seen += "2";
+    // A message routed from a callback
+    router.route("c", payload);
+  });
+  router.add("c", [&](const std::string &topic, const std::string &payload) { seen += "c"; });
+
+  router.route("a/b", "");
+  // The removed callbacks are still called for this message, the added ones aren't
+  EXPECT_EQ(seen, std::string("12c"));
+  EXPECT_EQ(calls.get("added"), 0);
+
+  seen.clear();
+  router.route("a/b", "");
+  EXPECT_EQ(seen, std::string(""));
+  EXPECT_EQ(calls.get("added"), 20);
+}
+
+void test_no_allocations_per_message() {
+  MQTTTopicRouter router;
+  Calls calls;
+  for (int i = 0; i < 50; i++)
+    router.add("home/sensor_" + std::to_string(i) + "/command", calls.callback("command"));
+  router.add("home/+/command", calls.callback("any command"));
+  router.add("home/#", calls.callback("home"));
+  router.add("#", calls.callback("all"));
+  const std::string topic = "home/sensor_7/command";
+  const std::string payload = "ON";
+  router.route(topic, payload);
+
+  auto &heap = esphome::testing::heap;
+  heap.reset_peak();
+  for (int i = 0; i < 100; i++)
+    router.route(topic, payload);
+  EXPECT_EQ(heap.allocations, size_t(0));
+  EXPECT_EQ(calls.get("command"), 101);
+  EXPECT_EQ(calls.get("all"), 101);
+}
+
+}  // namespace
+
+int main() {
+  test_matching();
+  test_remove();
+  test_subscriptions_changed_while_routing();
+  test_no_allocations_per_message();
+  return esphome::testing::finish("mqtt/mqtt_topic_router_test");
+}
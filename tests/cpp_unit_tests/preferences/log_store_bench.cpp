@@ -0,0 +1,65 @@
+// Flash wear and write volume of the preferences log compared with the single sector it replaced on ESP8266, and the
+// CPU time of a sync on the host (without the time the flash itself takes).
+//
+// Every sync changes one of 8 preferences of 16 bytes, like a light that is switched now and then. The single sector
+// layout erased its sector and rewrote all 512 bytes of it on every sync that had a change.
+
+#include "esphome/components/preferences/log_store.h"
+#include "sim_flash.h"
+#include "test_helpers.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::preferences;
+using esphome::preferences::testing::SimFlash;
+
+static const uint32_t SECTOR_SIZE = 4096;
+static const uint32_t SYNCS = 100000;
+static const uint32_t KEYS = 8;
+static const uint32_t VALUE_SIZE = 16;
+/// Erase cycles NOR flash is usually specified for, to put the erase counts into perspective.
+static const uint32_t RATED_ERASE_CYCLES = 100000;
+static const uint32_t SINGLE_SECTOR_WORDS = 128;
+
+static void print_row(const char *layout, const SimFlash &flash, double ns) {
+  const double erases_per_1000 = flash.get_max_erases() * 1000.0 / SYNCS;
+  printf("%-16s %12.1f %14.1f %16.2e %12.2f\n", layout, erases_per_1000, flash.get_words_written() * 4.0 / SYNCS,
+         RATED_ERASE_CYCLES * 1000.0 / erases_per_1000, ns / 1000.0);
+}
+
+int main() {
+  printf("%u syncs changing one of %u preferences of %u bytes:\n", SYNCS, KEYS, VALUE_SIZE);
+  printf("%-16s %12s %14s %16s %12s\n", "layout", "erases/1000", "bytes/sync", "syncs to wear", "us/sync");
+
+  {
+    SimFlash flash(SECTOR_SIZE, 1);
+    std::vector<uint32_t> storage(SINGLE_SECTOR_WORDS, 0);
+    uint32_t i = 0;
+    double ns = esphome::testing::time_ns(SYNCS, [&]() {
+      storage[i % SINGLE_SECTOR_WORDS] = i;
+      i++;
+      flash.erase_sector(0);
+      flash.write(0, storage.data(), storage.size());
+    });
+    print_row("single sector", flash, ns);
+  }
+
+  for (uint32_t sectors : {2, 4, 8, 16}) {
+    SimFlash flash(SECTOR_SIZE, sectors);
+    LogStore store(&flash, SECTOR_SIZE, sectors);
+    store.load();
+    uint8_t value[VALUE_SIZE] = {};
+    uint32_t i = 0;
+    double ns = esphome::testing::time_ns(SYNCS, [&]() {
+      value[0] = i;
+      store.set(i++ % KEYS, value, sizeof(value));
+      store.sync();
+    });
+    char layout[20];
+    snprintf(layout, sizeof(layout), "log, %u sectors", sectors);
+    print_row(layout, flash, ns);
+  }
+  return 0;
+}
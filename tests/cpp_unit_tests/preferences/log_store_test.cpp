@@ -0,0 +1,210 @@
+// LogStore on a simulated flash: loading, appending, wear spread, and recovery from a power loss at every erase or
+// word write of an append and of a rollover.
+
+#include "esphome/components/preferences/log_store.h"
+#include "sim_flash.h"
+#include "test_helpers.h"
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::preferences;
+using esphome::preferences::testing::SimFlash;
+
+namespace {
+
+const uint32_t SECTOR_SIZE = 4096;
+const uint32_t SECTORS = 4;
+const uint32_t KEYS = 8;
+
+using Values = std::map<uint32_t, uint32_t>;
+
+/// Exposes the position in the active sector, to drive the store up to a rollover.
+class TestLogStore : public LogStore {
+ public:
+  using LogStore::LogStore;
+  bool next_append_rolls_over() const { return this->active_offset_ + record_size(4) > this->sector_size_; }
+};
+
+void set(LogStore *store, uint32_t key, uint32_t value) {
+  store->set(key, reinterpret_cast<const uint8_t *>(&value), sizeof(value));
+}
+
+/// Load the store from flash like after a reboot and return all values.
+Values reboot(SimFlash *flash) {
+  TestLogStore store(flash, SECTOR_SIZE, SECTORS);
+  store.load();
+  Values values;
+  for (uint32_t key = 0; key < KEYS; key++) {
+    uint32_t value;
+    if (store.get(key, reinterpret_cast<uint8_t *>(&value), sizeof(value)))
+      values[key] = value;
+  }
+  return values;
+}
+
+/// After a recovery, the store must accept and persist new values again.
+void expect_usable(SimFlash *flash) {
+  TestLogStore store(flash, SECTOR_SIZE, SECTORS);
+  store.load();
+  set(&store, 7, 0x600D);
+  EXPECT_TRUE(store.sync());
+  EXPECT_EQ(reboot(flash)[7], 0x600Du);
+}
+
+void test_round_trip() {
+  SimFlash flash(SECTOR_SIZE, SECTORS);
+  {
+    LogStore store(&flash, SECTOR_SIZE, SECTORS);
+    EXPECT_TRUE(!store.load());
+    set(&store, 1, 42);
+    const uint8_t text[] = "odd length";
+    store.set(2, text, sizeof(text));
+    EXPECT_TRUE(store.has_pending());
+    EXPECT_TRUE(store.sync());
+    EXPECT_TRUE(!store.has_pending());
+  }
+  LogStore store(&flash, SECTOR_SIZE, SECTORS);
+  EXPECT_TRUE(store.load());
+  uint32_t value = 0;
+  EXPECT_TRUE(store.get(1, reinterpret_cast<uint8_t *>(&value), sizeof(value)));
+  EXPECT_EQ(value, 42u);
+  uint8_t text[11] = {};
+  EXPECT_TRUE(store.get(2, text, sizeof(text)));
+  EXPECT_EQ(std::string(reinterpret_cast<char *>(text)), std::string("odd length"));
+  // A different length is a different preference
+  EXPECT_TRUE(!store.get(1, reinterpret_cast<uint8_t *>(&value), 2));
+  EXPECT_TRUE(!store.get(3, reinterpret_cast<uint8_t *>(&value), sizeof(value)));
+  // Setting the stored value again doesn't write anything
+  set(&store, 1, 42);
+  EXPECT_TRUE(!store.has_pending());
+}
+
+void test_wear_spread() {
+  SimFlash flash(SECTOR_SIZE, SECTORS);
+  TestLogStore store(&flash, SECTOR_SIZE, SECTORS);
+  store.load();
+  std::mt19937 rng(1);
+  Values expected;
+  for (int i = 0; i < 20000; i++) {
+    uint32_t key = rng() % KEYS;
+    uint32_t value = rng();
+    set(&store, key, value);
+    expected[key] = value;
+    if (i % 3 == 0)
+      EXPECT_TRUE(store.sync());
+  }
+  EXPECT_TRUE(store.sync());
+  EXPECT_TRUE(reboot(&flash) == expected);
+  // The ring wrapped around many times, and every sector was erased about as often
+  EXPECT_TRUE(flash.get_erases(0) > 10);
+  for (uint32_t sector = 1; sector < SECTORS; sector++) {
+    EXPECT_TRUE(flash.get_erases(sector) <= flash.get_erases(0));
+    EXPECT_TRUE(flash.get_erases(sector) + 1 >= flash.get_erases(0));
+  }
+}
+
+/// Cut the power at every operation of a sync that writes the given changes, and check what a reboot recovers.
+template<typename Check> void cut_power_during_sync(const SimFlash &committed, const Values &changes, Check check) {
+  // Count the operations of the complete sync first
+  SimFlash reference = committed;
+  {
+    TestLogStore store(&reference, SECTOR_SIZE, SECTORS);
+    store.load();
+    for (const auto &it : changes)
+      set(&store, it.first, it.second);
+    uint32_t before = reference.get_operations();
+    EXPECT_TRUE(store.sync());
+    check(reference.get_operations() - before, reference.get_operations() - before, reboot(&reference));
+  }
+  const uint32_t operations = reference.get_operations() - committed.get_operations();
+
+  for (uint32_t cut = 0; cut < operations; cut++) {
+    SimFlash flash = committed;
+    {
+      TestLogStore store(&flash, SECTOR_SIZE, SECTORS);
+      store.load();
+      for (const auto &it : changes)
+        set(&store, it.first, it.second);
+      flash.cut_power_after(cut);
+      EXPECT_TRUE(!store.sync());
+    }
+    flash.restore_power();
+    check(cut, operations, reboot(&flash));
+    expect_usable(&flash);
+  }
+}
+
+Values initial_values(TestLogStore *store) {
+  Values values;
+  for (uint32_t key = 0; key < KEYS; key++) {
+    values[key] = 0x1000 + key;
+    set(store, key, values[key]);
+  }
+  EXPECT_TRUE(store->sync());
+  return values;
+}
+
+void test_torn_append() {
+  SimFlash flash(SECTOR_SIZE, SECTORS);
+  TestLogStore store(&flash, SECTOR_SIZE, SECTORS);
+  store.load();
+  const Values committed = initial_values(&store);
+  EXPECT_TRUE(!store.next_append_rolls_over());
+
+  // Two records of 4 words each are appended: the first one is committed once its CRC is written
+  const Values changes = {{3, 0xAAAA}, {5, 0xBBBB}};
+  cut_power_during_sync(flash, changes, [&](uint32_t cut, uint32_t operations, const Values &recovered) {
+    EXPECT_EQ(operations, 8u);
+    Values expected = committed;
+    if (cut >= 4)
+      expected[3] = 0xAAAA;
+    if (cut >= 8)
+      expected[5] = 0xBBBB;
+    if (recovered != expected) {
+      std::cerr << "append cut after " << cut << " operations" << std::endl;
+      EXPECT_TRUE(recovered == expected);
+    }
+  });
+}
+
+void test_torn_rollover() {
+  SimFlash flash(SECTOR_SIZE, SECTORS);
+  TestLogStore store(&flash, SECTOR_SIZE, SECTORS);
+  store.load();
+  Values committed = initial_values(&store);
+  // Fill the active sector, so that the next sync writes a snapshot into the next one
+  for (uint32_t i = 0; !store.next_append_rolls_over(); i++) {
+    committed[i % KEYS] = i;
+    set(&store, i % KEYS, i);
+    EXPECT_TRUE(store.sync());
+  }
+
+  Values changed = committed;
+  const Values changes = {{3, 0xAAAA}, {5, 0xBBBB}};
+  for (const auto &it : changes)
+    changed[it.first] = it.second;
+  // The previous sector stays valid until the commit marker, the last write, is complete
+  cut_power_during_sync(flash, changes, [&](uint32_t cut, uint32_t operations, const Values &recovered) {
+    // Erase, sector header, a snapshot record for every key and the commit marker
+    EXPECT_EQ(operations, 1 + 2 + KEYS * 4 + 1);
+    const Values &expected = cut == operations ? changed : committed;
+    if (recovered != expected) {
+      std::cerr << "rollover cut after " << cut << " operations" << std::endl;
+      EXPECT_TRUE(recovered == expected);
+    }
+  });
+}
+
+}  // namespace
+
+int main() {
+  test_round_trip();
+  test_wear_spread();
+  test_torn_append();
+  test_torn_rollover();
+  return esphome::testing::finish("preferences/log_store_test");
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+// Simulated NOR flash for the LogStore tests: writes can only clear bits, erases set a whole sector to 0xFF, and the
+// power can be cut after a given number of operations.
+
+#include "esphome/components/preferences/log_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace esphome {
+namespace preferences {
+namespace testing {
+
+class SimFlash : public LogStoreFlash {
+ public:
+  SimFlash(uint32_t sector_size, uint32_t sector_count)
+      : memory_(sector_size * sector_count / 4, 0xFFFFFFFF), sector_size_(sector_size), erases_(sector_count, 0) {}
+
+  bool erase_sector(uint32_t sector) override {
+    if (this->powered_off_)
+      return false;
+    auto first = this->memory_.begin() + sector * this->sector_size_ / 4;
+    if (!this->consume_()) {
+      // The erase was interrupted halfway, the rest of the sector keeps its old content
+      std::fill(first, first + this->sector_size_ / 8, 0xFFFFFFFF);
+      return false;
+    }
+    std::fill(first, first + this->sector_size_ / 4, 0xFFFFFFFF);
+    this->erases_[sector]++;
+    return true;
+  }
+  bool write(uint32_t address, const uint32_t *data, size_t words) override {
+    if (this->powered_off_)
+      return false;
+    for (size_t i = 0; i < words; i++) {
+      uint32_t &word = this->memory_[address / 4 + i];
+      if (!this->consume_()) {
+        // Only some of the bits of the interrupted word were programmed
+        word &= data[i] | 0xF0F0F0F0;
+        return false;
+      }
+      word &= data[i];
+      this->words_written_++;
+    }
+    return true;
+  }
+  bool read(uint32_t address, uint32_t *data, size_t words) override {
+    memcpy(data, &this->memory_[address / 4], words * 4);
+    return true;
+  }
+
+  /// Cut the power after the given number of erase or word write operations; the next one is torn.
+  void cut_power_after(int operations) { this->operations_left_ = operations; }
+  /// Power the flash up again, after a cut or to stop a pending one.
+  void restore_power() {
+    this->operations_left_ = -1;
+    this->powered_off_ = false;
+  }
+  /// Number of erase and word write operations so far.
+  uint32_t get_operations() const { return this->operations_; }
+
+  uint32_t get_erases(uint32_t sector) const { return this->erases_[sector]; }
+  uint32_t get_max_erases() const { return *std::max_element(this->erases_.begin(), this->erases_.end()); }
+  uint32_t get_total_erases() const {
+    uint32_t total = 0;
+    for (uint32_t erases : this->erases_)
+      total += erases;
+    return total;
+  }
+  uint32_t get_words_written() const { return this->words_written_; }
+
+ protected:
+  bool consume_() {
+    if (this->operations_left_ == 0) {
+      this->powered_off_ = true;
+      return false;
+    }
+    if (this->operations_left_ > 0)
+      this->operations_left_--;
+    this->operations_++;
+    return true;
+  }
+
+  std::vector<uint32_t> memory_;
+  uint32_t sector_size_;
+  std::vector<uint32_t> erases_;
+  int operations_left_{-1};
+  bool powered_off_{false};
+  uint32_t operations_{0};
+  uint32_t words_written_{0};
+};
+
+}  // namespace testing
+}  // namespace preferences
+}  // namespace esphome
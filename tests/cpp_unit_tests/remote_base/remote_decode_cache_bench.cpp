@@ -0,0 +1,68 @@
+// Time per received signal with 8 NEC, 8 Samsung and 4 RC switch binary sensors on one receiver, with every sensor
+// decoding the signal on its own (like before RemoteDecodeCache) and with the shared decode results.
+//
+// The signals are a mix of codes of the sensors, other codes of the same protocols and noise that decodes as nothing.
+
+#include "replay.h"
+#include "test_helpers.h"
+
+#include <cstdio>
+#include <memory>
+
+using namespace esphome;
+using namespace esphome::remote_base;
+using namespace esphome::remote_base::testing;
+
+using NECSensor = CountingSensor<RemoteReceiverBinarySensor<NECProtocol, NECData>>;
+using SamsungSensor = CountingSensor<RemoteReceiverBinarySensor<SamsungProtocol, SamsungData>>;
+using RCSwitchSensor = CountingSensor<RCSwitchRawReceiver>;
+
+static const size_t RUNS = 200000;
+
+int main() {
+  const std::vector<Signal> signals = {
+      nec(0x00FF, 0x03), samsung(0xE0E00005), rc_switch(1, 0x5A5A01, 24), nec(0x00FF, 0x42),
+      samsung(0xE0E0FFFF), rc_switch(2, 0x123456, 24), {9000, -4500, 560, -560, 560, -1690, 560},
+      {300, -300, 300, -300, 300},
+  };
+
+  printf("%-9s %14s %10s\n", "decoding", "us/signal", "matches");
+  for (bool cached : {false, true}) {
+    TestReceiver receiver;
+    std::vector<std::unique_ptr<NECSensor>> nec_sensors;
+    std::vector<std::unique_ptr<SamsungSensor>> samsung_sensors;
+    std::vector<std::unique_ptr<RCSwitchSensor>> rc_switch_sensors;
+    for (uint16_t i = 0; i < 8; i++) {
+      nec_sensors.push_back(std::make_unique<NECSensor>(&receiver));
+      nec_sensors.back()->sensor.set_data(NECData{0x00FF, i});
+      samsung_sensors.push_back(std::make_unique<SamsungSensor>(&receiver));
+      samsung_sensors.back()->sensor.set_data(SamsungData{0xE0E00000 + i, 32});
+    }
+    for (uint8_t protocol = 1; protocol <= 4; protocol++) {
+      rc_switch_sensors.push_back(std::make_unique<RCSwitchSensor>(&receiver));
+      rc_switch_sensors.back()->sensor.set_protocol(RC_SWITCH_PROTOCOLS[protocol]);
+      rc_switch_sensors.back()->sensor.set_code(0x5A5A00 + protocol);
+      rc_switch_sensors.back()->sensor.set_nbits(24);
+    }
+
+    size_t i = 0;
+    double ns = esphome::testing::time_ns(RUNS, [&]() {
+      const Signal &signal = signals[i++ % signals.size()];
+      if (cached) {
+        receiver.receive(signal);
+      } else {
+        receiver.receive_uncached(signal);
+      }
+    });
+
+    uint32_t matches = 0;
+    for (const auto &sensor : nec_sensors)
+      matches += sensor->matches;
+    for (const auto &sensor : samsung_sensors)
+      matches += sensor->matches;
+    for (const auto &sensor : rc_switch_sensors)
+      matches += sensor->matches;
+    printf("%-9s %14.3f %10u\n", cached ? "shared" : "separate", ns / 1000.0, matches);
+  }
+  return 0;
+}
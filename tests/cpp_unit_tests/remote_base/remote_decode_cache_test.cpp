@@ -0,0 +1,132 @@
+// The shared decode results of RemoteDecodeCache and of the RC switch receivers: a new signal, on the same or on
+// another receiver, is always decoded again, and the matches are the same as when every listener decodes on its own.
+
+#include "replay.h"
+#include "test_helpers.h"
+
+#include <memory>
+
+using namespace esphome;
+using namespace esphome::remote_base;
+using namespace esphome::remote_base::testing;
+
+namespace {
+
+using NECSensor = CountingSensor<RemoteReceiverBinarySensor<NECProtocol, NECData>>;
+using SamsungSensor = CountingSensor<RemoteReceiverBinarySensor<SamsungProtocol, SamsungData>>;
+using RCSwitchSensor = CountingSensor<RCSwitchRawReceiver>;
+
+void test_signal_id_across_receivers() {
+  TestReceiver first;
+  TestReceiver second;
+  // A different tolerance per receiver, the results must not be shared between them anyway
+  second.set_tolerance(10);
+  NECSensor first_power(&first);
+  first_power.sensor.set_data(NECData{0x00FF, 0x10EF});
+  NECSensor second_power(&second);
+  second_power.sensor.set_data(NECData{0x00FF, 0x10EF});
+  NECSensor second_mute(&second);
+  second_mute.sensor.set_data(NECData{0x00FF, 0x20DF});
+
+  first.receive(nec(0x00FF, 0x10EF));
+  EXPECT_EQ(first_power.matches, 1u);
+  // A different code on the other receiver must not reuse the result of the first one
+  second.receive(nec(0x00FF, 0x20DF));
+  EXPECT_EQ(second_power.matches, 0u);
+  EXPECT_EQ(second_mute.matches, 1u);
+  // And back on the first receiver, whose buffer still has its previous code
+  first.receive(nec(0x00FF, 0x20DF));
+  EXPECT_EQ(first_power.matches, 1u);
+  // The same code twice in a row is two signals
+  second.receive(nec(0x00FF, 0x10EF));
+  second.receive(nec(0x00FF, 0x10EF));
+  EXPECT_EQ(second_power.matches, 2u);
+  EXPECT_EQ(second_mute.matches, 1u);
+  // A signal that doesn't decode replaces the cached result too
+  second.receive(samsung(0xE0E040BF));
+  EXPECT_EQ(second_power.matches, 2u);
+  EXPECT_EQ(second_mute.matches, 1u);
+}
+
+void test_protocols_are_cached_separately() {
+  TestReceiver receiver;
+  NECSensor nec_sensor(&receiver);
+  nec_sensor.sensor.set_data(NECData{0x00FF, 0x10EF});
+  SamsungSensor samsung_sensor(&receiver);
+  samsung_sensor.sensor.set_data(SamsungData{0xE0E040BF, 32});
+
+  for (int i = 0; i < 3; i++) {
+    receiver.receive(nec(0x00FF, 0x10EF));
+    receiver.receive(samsung(0xE0E040BF));
+  }
+  EXPECT_EQ(nec_sensor.matches, 3u);
+  EXPECT_EQ(samsung_sensor.matches, 3u);
+}
+
+void test_rc_switch_results_per_protocol() {
+  TestReceiver first;
+  TestReceiver second;
+  // More protocols than cached results, so that results are evicted while receivers still use them
+  std::vector<std::unique_ptr<RCSwitchSensor>> sensors;
+  for (uint8_t protocol = 1; protocol <= 6; protocol++) {
+    sensors.push_back(std::make_unique<RCSwitchSensor>(protocol % 2 == 0 ? &first : &second));
+    sensors.back()->sensor.set_protocol(RC_SWITCH_PROTOCOLS[protocol]);
+    sensors.back()->sensor.set_code(0x5A5A00 + protocol);
+    sensors.back()->sensor.set_nbits(24);
+  }
+  for (int round = 0; round < 2; round++) {
+    for (uint8_t protocol = 1; protocol <= 6; protocol++) {
+      TestReceiver &receiver = protocol % 2 == 0 ? first : second;
+      receiver.receive(rc_switch(protocol, 0x5A5A00 + protocol, 24));
+      // Same protocol, another code
+      receiver.receive(rc_switch(protocol, 0x5A5A00, 24));
+    }
+  }
+  for (uint8_t protocol = 1; protocol <= 6; protocol++)
+    EXPECT_EQ(sensors[protocol - 1]->matches, 2u);
+}
+
+/// Cached and uncached decoding must match the same signals.
+void test_matches_like_uncached() {
+  const std::vector<Signal> signals = {
+      nec(0x00FF, 0x10EF), samsung(0xE0E040BF), rc_switch(1, 0x5A5A01, 24), nec(0x00FF, 0x20DF),
+      samsung(0xE0E0D02F), rc_switch(2, 0x5A5A02, 24), {9000, -4500, 560, -560, 560, -1690},
+  };
+  for (int cached = 0; cached < 2; cached++) {
+    TestReceiver receiver;
+    std::vector<std::unique_ptr<NECSensor>> nec_sensors;
+    std::vector<std::unique_ptr<SamsungSensor>> samsung_sensors;
+    for (uint16_t command : {0x10EF, 0x20DF, 0x30CF}) {
+      nec_sensors.push_back(std::make_unique<NECSensor>(&receiver));
+      nec_sensors.back()->sensor.set_data(NECData{0x00FF, command});
+    }
+    for (uint64_t code : {0xE0E040BF, 0xE0E0D02F}) {
+      samsung_sensors.push_back(std::make_unique<SamsungSensor>(&receiver));
+      samsung_sensors.back()->sensor.set_data(SamsungData{code, 32});
+    }
+    for (int round = 0; round < 3; round++) {
+      for (const auto &signal : signals) {
+        if (cached == 1) {
+          receiver.receive(signal);
+        } else {
+          receiver.receive_uncached(signal);
+        }
+      }
+    }
+    EXPECT_EQ(nec_sensors[0]->matches, 3u);
+    EXPECT_EQ(nec_sensors[1]->matches, 3u);
+    EXPECT_EQ(nec_sensors[2]->matches, 0u);
+    EXPECT_EQ(samsung_sensors[0]->matches, 3u);
+    EXPECT_EQ(samsung_sensors[1]->matches, 3u);
+  }
+}
+
+}  // namespace
+
+int main() {
+  test_signal_id_across_receivers();
+  test_protocols_are_cached_separately();
+  test_rc_switch_results_per_protocol();
+  test_matches_like_uncached();
+  return esphome::testing::finish("remote_base/remote_decode_cache_test");
+}
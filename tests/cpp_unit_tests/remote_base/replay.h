@@ -0,0 +1,84 @@
+#pragma once
+
+// Receiver that replays recorded signals through the listeners and dumpers like a real one, and encoders that build
+// the signals, for the remote_base tests and benchmarks.
+
+#include "esphome/components/remote_base/nec_protocol.h"
+#include "esphome/components/remote_base/rc_switch_protocol.h"
+#include "esphome/components/remote_base/remote_base.h"
+#include "esphome/components/remote_base/samsung_protocol.h"
+
+#include <vector>
+
+namespace esphome {
+namespace remote_base {
+namespace testing {
+
+using Signal = std::vector<int32_t>;
+
+class TestReceiver : public RemoteReceiverBase {
+ public:
+  TestReceiver() : RemoteReceiverBase(nullptr) {}
+
+  /// Pass a received signal to the listeners and dumpers, like loop() of the receivers does.
+  void receive(const Signal &signal) {
+    this->temp_ = signal;
+    this->call_listeners_dumpers_();
+  }
+  /// Pass a signal without an id, so that every listener decodes it on its own like before the decode cache.
+  void receive_uncached(const Signal &signal) {
+    this->temp_ = signal;
+    this->signal_id_ = 0;
+    if (!this->call_listeners_())
+      this->call_dumpers_();
+  }
+};
+
+/// Binary sensor of a receiver that counts how often it matched.
+template<typename T> struct CountingSensor {
+  T sensor;
+  uint32_t matches{0};
+
+  explicit CountingSensor(TestReceiver *receiver) {
+    receiver->register_listener(&this->sensor);
+    this->sensor.add_on_state_callback([this](bool state) {
+      if (state)
+        this->matches++;
+    });
+  }
+};
+
+/// An IR receiver ends the signal at its last mark, the space after it is the idle time.
+inline Signal received_ir(const RemoteTransmitData &data) {
+  Signal signal = data.get_data();
+  if (!signal.empty() && signal.back() < 0)
+    signal.pop_back();
+  return signal;
+}
+
+inline Signal nec(uint16_t address, uint16_t command) {
+  RemoteTransmitData data;
+  NECProtocol().encode(&data, NECData{address, command});
+  return received_ir(data);
+}
+
+inline Signal samsung(uint64_t code) {
+  RemoteTransmitData data;
+  SamsungProtocol().encode(&data, SamsungData{code, 32});
+  return received_ir(data);
+}
+
+/// RC switch codes are repeated, the sync of the next repetition ends the space of the last bit. A receiver starts
+/// at the first mark though, which drops the leading space of the inverted protocols.
+inline Signal rc_switch(uint8_t protocol, uint64_t code, uint8_t nbits) {
+  RemoteTransmitData data;
+  RC_SWITCH_PROTOCOLS[protocol].transmit(&data, code, nbits);
+  Signal signal = data.get_data();
+  if (!signal.empty() && signal.front() < 0)
+    signal.erase(signal.begin());
+  return signal;
+}
+
+}  // namespace testing
+}  // namespace remote_base
+}  // namespace esphome
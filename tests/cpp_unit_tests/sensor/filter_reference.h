@@ -0,0 +1,89 @@
+#pragma once
+
+// The order-statistic filters before the shared sorted window, which copied and sorted (or scanned) the whole
+// window for every value they sent. Used as the reference by the filter test and benchmark.
+
+#include "esphome/components/sensor/filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace sensor {
+namespace testing {
+
+enum class Kind { MEDIAN, QUANTILE, MIN, MAX };
+
+/// The previous implementation of the filters, minus the logging.
+class ReferenceFilter {
+ public:
+  ReferenceFilter(Kind kind, size_t window_size, size_t send_every, size_t send_first_at, float quantile)
+      : kind_(kind), send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size),
+        quantile_(quantile) {}
+
+  void set_window_size(size_t window_size) { this->window_size_ = window_size; }
+
+  optional<float> new_value(float value) {
+    while (this->queue_.size() >= this->window_size_)
+      this->queue_.pop_front();
+    this->queue_.push_back(value);
+    if (++this->send_at_ < this->send_every_)
+      return {};
+    this->send_at_ = 0;
+
+    if (this->kind_ == Kind::MIN || this->kind_ == Kind::MAX) {
+      float result = NAN;
+      for (auto v : this->queue_) {
+        if (!std::isnan(v)) {
+          result = std::isnan(result) ? v : (this->kind_ == Kind::MIN ? std::min(result, v) : std::max(result, v));
+        }
+      }
+      return result;
+    }
+
+    std::vector<float> sorted;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v))
+        sorted.push_back(v);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    size_t size = sorted.size();
+    if (size == 0)
+      return NAN;
+    if (this->kind_ == Kind::QUANTILE)
+      return sorted[size_t(ceilf(size * this->quantile_) - 1)];
+    if (size % 2)
+      return sorted[size / 2];
+    return (sorted[size / 2] + sorted[(size / 2) - 1]) / 2.0f;
+  }
+
+ protected:
+  Kind kind_;
+  std::deque<float> queue_;
+  size_t send_every_;
+  size_t send_at_;
+  size_t window_size_;
+  float quantile_;
+};
+
+inline std::unique_ptr<Filter> make_filter(Kind kind, size_t window_size, size_t send_every, size_t send_first_at,
+                                    float quantile) {
+  switch (kind) {
+    case Kind::MEDIAN:
+      return std::unique_ptr<Filter>(new MedianFilter(window_size, send_every, send_first_at));
+    case Kind::QUANTILE:
+      return std::unique_ptr<Filter>(new QuantileFilter(window_size, send_every, send_first_at, quantile));
+    case Kind::MIN:
+      return std::unique_ptr<Filter>(new MinFilter(window_size, send_every, send_first_at));
+    case Kind::MAX:
+    default:
+      return std::unique_ptr<Filter>(new MaxFilter(window_size, send_every, send_first_at));
+  }
+}
+
+}  // namespace testing
+}  // namespace sensor
+}  // namespace esphome
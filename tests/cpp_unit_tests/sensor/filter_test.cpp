@@ -0,0 +1,123 @@
+// Randomized comparison of the order-statistic filters with the implementations they replaced.
+
+#include "esphome/components/sensor/filter.h"
+#include "filter_reference.h"
+#include "test_helpers.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+using namespace esphome;
+using namespace esphome::sensor;
+using esphome::sensor::testing::Kind;
+using esphome::sensor::testing::make_filter;
+using esphome::sensor::testing::ReferenceFilter;
+
+namespace {
+
+void set_window_size(Filter *filter, Kind kind, size_t window_size) {
+  switch (kind) {
+    case Kind::MEDIAN:
+      static_cast<MedianFilter *>(filter)->set_window_size(window_size);
+      break;
+    case Kind::QUANTILE:
+      static_cast<QuantileFilter *>(filter)->set_window_size(window_size);
+      break;
+    case Kind::MIN:
+      static_cast<MinFilter *>(filter)->set_window_size(window_size);
+      break;
+    case Kind::MAX:
+      static_cast<MaxFilter *>(filter)->set_window_size(window_size);
+      break;
+  }
+}
+
+bool same_float(float a, float b) {
+  // Bitwise, so that NaN equals NaN and the results have to be identical rather than close
+  return memcmp(&a, &b, sizeof(float)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+void test_random_configurations() {
+  std::mt19937 rng(12345);
+  const Kind kinds[] = {Kind::MEDIAN, Kind::QUANTILE, Kind::MIN, Kind::MAX};
+  for (int run = 0; run < 4000; run++) {
+    Kind kind = kinds[run % 4];
+    size_t window_size = 1 + rng() % (run % 10 == 0 ? 300 : 20);
+    size_t send_every = 1 + rng() % 5;
+    size_t send_first_at = 1 + rng() % send_every;
+    float quantile = float(1 + rng() % 100) / 100.0f;
+    // Few distinct values to get plenty of duplicates, or arbitrary ones
+    bool coarse = rng() % 2;
+    int nan_percent = rng() % 4 == 0 ? 0 : rng() % 60;
+
+    auto filter = make_filter(kind, window_size, send_every, send_first_at, quantile);
+    ReferenceFilter reference(kind, window_size, send_every, send_first_at, quantile);
+
+    size_t samples = 1 + rng() % 700;
+    for (size_t i = 0; i < samples; i++) {
+      if (rng() % 500 == 0) {
+        // The window can be resized at runtime, both keep the newest values
+        window_size = 1 + rng() % 50;
+        set_window_size(filter.get(), kind, window_size);
+        reference.set_window_size(window_size);
+      }
+      float value;
+      if (int(rng() % 100) < nan_percent) {
+        value = NAN;
+      } else if (coarse) {
+        value = float(int(rng() % 9) - 4) * 0.5f;
+      } else {
+        value = std::uniform_real_distribution<float>(-1e6f, 1e6f)(rng);
+      }
+
+      optional<float> expected = reference.new_value(value);
+      optional<float> actual = filter->new_value(value);
+      EXPECT_EQ(actual.has_value(), expected.has_value());
+      if (actual.has_value() && expected.has_value() && !same_float(*actual, *expected)) {
+        std::cerr << "run " << run << " sample " << i << ": " << *actual << " != " << *expected << std::endl;
+        EXPECT_TRUE(same_float(*actual, *expected));
+        return;
+      }
+    }
+  }
+}
+
+void test_sorted_sliding_window() {
+  SortedSlidingWindow window;
+  EXPECT_TRUE(window.empty());
+  EXPECT_TRUE(std::isnan(window.median()));
+
+  window.set_window_size(3);
+  window.push(3.0f);
+  window.push(NAN);
+  window.push(1.0f);
+  EXPECT_EQ(window.valid_count(), 2u);
+  EXPECT_EQ(window.min(), 1.0f);
+  EXPECT_EQ(window.max(), 3.0f);
+  EXPECT_EQ(window.median(), 2.0f);
+
+  // Evicts the 3, the NaN is evicted next without touching the sorted values
+  window.push(2.0f);
+  EXPECT_EQ(window.max(), 2.0f);
+  window.push(5.0f);
+  EXPECT_EQ(window.valid_count(), 3u);
+  EXPECT_EQ(window.median(), 2.0f);
+
+  // Out of range quantiles are clamped
+  EXPECT_EQ(window.quantile(0.0f), 1.0f);
+  EXPECT_EQ(window.quantile(2.0f), 5.0f);
+
+  // Shrinking keeps the newest values
+  window.set_window_size(1);
+  EXPECT_EQ(window.valid_count(), 1u);
+  EXPECT_EQ(window.median(), 5.0f);
+}
+
+}  // namespace
+
+int main() {
+  test_sorted_sliding_window();
+  test_random_configurations();
+  return esphome::testing::finish("sensor/filter_test");
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+// Host stand-in for the ESP-IDF SPI master driver. It records every transaction with the bytes it sent, completes
+// queued transactions in order when their result is fetched, and can fail a call to test the error paths.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+using esp_err_t = int;
+static const esp_err_t ESP_OK = 0;
+static const esp_err_t ESP_FAIL = -1;
+static const esp_err_t ESP_ERR_NOT_FOUND = 0x105;
+inline const char *esp_err_to_name(esp_err_t err) { return err == ESP_OK ? "ESP_OK" : "ESP_FAIL"; }
+
+using TickType_t = uint32_t;
+static const TickType_t portMAX_DELAY = 0xFFFFFFFF;  // NOLINT(readability-identifier-naming)
+
+#define SOC_SPI_PERIPH_NUM 3
+enum spi_host_device_t { SPI1_HOST = 0, SPI2_HOST = 1, SPI3_HOST = 2 };  // NOLINT(readability-identifier-naming)
+static const int SPI_DMA_CH_AUTO = 3;
+static const uint32_t SPI_TRANS_USE_TXDATA = 1 << 3;
+static const uint32_t SPI_DEVICE_BIT_LSBFIRST = 1 << 0;
+
+struct spi_bus_config_t {  // NOLINT(readability-identifier-naming)
+  int mosi_io_num;
+  int miso_io_num;
+  int sclk_io_num;
+  int quadwp_io_num;
+  int quadhd_io_num;
+  int max_transfer_sz;
+};
+
+struct spi_device_interface_config_t {  // NOLINT(readability-identifier-naming)
+  uint8_t mode;
+  int clock_speed_hz;
+  int spics_io_num;
+  uint32_t flags;
+  int queue_size;
+};
+
+struct spi_transaction_t {  // NOLINT(readability-identifier-naming)
+  uint32_t flags;
+  size_t length;
+  const void *tx_buffer;
+  void *rx_buffer;
+  uint8_t tx_data[4];
+};
+
+struct MockSPIDevice {
+  spi_device_interface_config_t config;
+  std::deque<spi_transaction_t *> queue;
+};
+using spi_device_handle_t = MockSPIDevice *;  // NOLINT(readability-identifier-naming)
+
+namespace esphome {
+namespace spi {
+namespace testing {
+
+struct MockTransaction {
+  bool queued;
+  std::vector<uint8_t> sent;
+};
+
+struct MockSPIBus {
+  std::vector<MockTransaction> transactions;
+  /// Most transactions that were queued at the same time.
+  size_t max_queued{0};
+  /// Fail the call after this many successful queue or polling calls, -1 never fails.
+  int fail_after{-1};
+  std::deque<MockSPIDevice> devices;
+
+  /// Forget the recorded transactions, the devices stay.
+  void reset() {
+    this->transactions.clear();
+    this->max_queued = 0;
+    this->fail_after = -1;
+  }
+  bool fail_now() {
+    if (this->fail_after == 0)
+      return true;
+    if (this->fail_after > 0)
+      this->fail_after--;
+    return false;
+  }
+  /// Record the bytes the transaction sends, only once it completes, so that the buffer has to be valid until then.
+  void complete(const spi_transaction_t *transaction, bool queued) {
+    const auto *data = (transaction->flags & SPI_TRANS_USE_TXDATA) != 0
+                           ? transaction->tx_data
+                           : static_cast<const uint8_t *>(transaction->tx_buffer);
+    this->transactions.push_back({queued, std::vector<uint8_t>(data, data + transaction->length / 8)});
+  }
+  /// All bytes sent, in order.
+  std::vector<uint8_t> sent() const {
+    std::vector<uint8_t> all;
+    for (const auto &transaction : this->transactions)
+      all.insert(all.end(), transaction.sent.begin(), transaction.sent.end());
+    return all;
+  }
+};
+inline MockSPIBus mock_bus;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace testing
+}  // namespace spi
+}  // namespace esphome
+
+inline esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *config, int dma_channel) {
+  return ESP_OK;
+}
+inline esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *config,
+                                    spi_device_handle_t *handle) {
+  auto &bus = esphome::spi::testing::mock_bus;
+  bus.devices.push_back({*config, {}});
+  *handle = &bus.devices.back();
+  return ESP_OK;
+}
+inline esp_err_t spi_bus_remove_device(spi_device_handle_t handle) { return ESP_OK; }
+inline esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *transaction,
+                                        TickType_t ticks_to_wait) {
+  auto &bus = esphome::spi::testing::mock_bus;
+  if (bus.fail_now())
+    return ESP_FAIL;
+  if (handle->queue.size() == size_t(handle->config.queue_size))
+    return ESP_FAIL;
+  handle->queue.push_back(transaction);
+  if (handle->queue.size() > bus.max_queued)
+    bus.max_queued = handle->queue.size();
+  return ESP_OK;
+}
+inline esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **transaction,
+                                             TickType_t ticks_to_wait) {
+  if (handle->queue.empty())
+    return ESP_FAIL;
+  *transaction = handle->queue.front();
+  handle->queue.pop_front();
+  esphome::spi::testing::mock_bus.complete(*transaction, true);
+  return ESP_OK;
+}
+inline esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *transaction) {
+  auto &bus = esphome::spi::testing::mock_bus;
+  if (bus.fail_now())
+    return ESP_FAIL;
+  bus.complete(transaction, false);
+  if (transaction->rx_buffer != nullptr) {
+    // Loop back what was sent, inverted
+    const auto *tx = static_cast<const uint8_t *>(transaction->tx_buffer);
+    auto *rx = static_cast<uint8_t *>(transaction->rx_buffer);
+    for (size_t i = 0; i < transaction->length / 8; i++)
+      rx[i] = ~tx[i];
+  }
+  return ESP_OK;
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+// Host stand-in for the ESP-IDF header, see driver/spi_master.h.
+
+#define ESP_IDF_VERSION_VAL(major, minor, patch) (((major) << 16) | ((minor) << 8) | (patch))
+#define ESP_IDF_VERSION ESP_IDF_VERSION_VAL(4, 4, 0)
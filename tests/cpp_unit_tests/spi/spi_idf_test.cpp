@@ -0,0 +1,213 @@
+// Transactions of the ESP-IDF SPI backend on a mock driver: how writes are split and queued, the bytes every
+// transaction sends, and that a driver error fails the bus instead of truncating the data silently.
+
+#include "esphome/components/spi/spi.h"
+#include "test_helpers.h"
+
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::spi;
+using esphome::spi::testing::mock_bus;
+
+namespace {
+
+/// Queue depth of the backend, transactions beyond that have to wait for the oldest one.
+const size_t QUEUE_SIZE = 4;
+const size_t MAX_TRANSFER_SIZE = 8192;
+
+class FakePin : public InternalGPIOPin {
+ public:
+  explicit FakePin(uint8_t pin) : pin_(pin) {}
+  void setup() override {}
+  void pin_mode(gpio::Flags flags) override {}
+  bool digital_read() override { return this->value_; }
+  void digital_write(bool value) override { this->value_ = value; }
+  std::string dump_summary() const override { return "fake"; }
+  void detach_interrupt() const override {}
+  ISRInternalGPIOPin to_isr() const override { return {}; }
+  uint8_t get_pin() const override { return this->pin_; }
+  bool is_inverted() const override { return false; }
+
+ protected:
+  void attach_interrupt(void (*func)(void *), void *arg, gpio::InterruptType type) const override {}
+
+  uint8_t pin_;
+  bool value_{false};
+};
+
+using TestDevice = SPIDevice<BIT_ORDER_MSB_FIRST, CLOCK_POLARITY_LOW, CLOCK_PHASE_LEADING, DATA_RATE_8MHZ>;
+
+/// setup() assigns the hardware SPI hosts in turn, and there are only two of them.
+struct Bus {
+  FakePin clk{18};
+  FakePin mosi{23};
+  FakePin miso{19};
+  FakePin cs{5};
+  SPIComponent spi;
+  TestDevice device{&spi, &cs};
+
+  Bus() {
+    this->spi.set_clk(&this->clk);
+    this->spi.set_mosi(&this->mosi);
+    this->spi.set_miso(&this->miso);
+    this->spi.setup();
+    this->device.spi_setup();
+  }
+};
+
+std::vector<uint8_t> pattern(size_t length, uint8_t seed) {
+  std::vector<uint8_t> data(length);
+  for (size_t i = 0; i < length; i++)
+    data[i] = uint8_t(i * 7 + seed);
+  return data;
+}
+
+std::vector<size_t> transaction_sizes() {
+  std::vector<size_t> sizes;
+  for (const auto &transaction : mock_bus.transactions)
+    sizes.push_back(transaction.sent.size());
+  return sizes;
+}
+
+bool all_queued(bool queued) {
+  for (const auto &transaction : mock_bus.transactions) {
+    if (transaction.queued != queued)
+      return false;
+  }
+  return true;
+}
+
+void test_large_write_is_split(Bus &bus) {
+  mock_bus.reset();
+  auto data = pattern(20000, 1);
+  {
+    TestDevice::Transaction transaction(&bus.device);
+    EXPECT_TRUE(!bus.cs.digital_read());
+    bus.device.write_array(data);
+  }
+  EXPECT_TRUE(bus.cs.digital_read());
+  EXPECT_TRUE(transaction_sizes() == std::vector<size_t>({MAX_TRANSFER_SIZE, MAX_TRANSFER_SIZE, 3616}));
+  EXPECT_TRUE(all_queued(true));
+  EXPECT_TRUE(mock_bus.sent() == data);
+}
+
+void test_short_writes_are_polled(Bus &bus) {
+  mock_bus.reset();
+  {
+    TestDevice::Transaction transaction(&bus.device);
+    bus.device.write_byte(0xA5);
+    bus.device.write_byte16(0x1234);
+    bus.device.write_array(std::vector<uint8_t>{1, 2, 3, 4});
+  }
+  EXPECT_TRUE(transaction_sizes() == std::vector<size_t>({1, 2, 4}));
+  EXPECT_TRUE(all_queued(false));
+  EXPECT_TRUE(mock_bus.sent() == std::vector<uint8_t>({0xA5, 0x12, 0x34, 1, 2, 3, 4}));
+}
+
+void test_write_array16_chunks(Bus &bus) {
+  mock_bus.reset();
+  std::vector<uint16_t> words(300);
+  std::vector<uint8_t> expected;
+  for (size_t i = 0; i < words.size(); i++) {
+    words[i] = uint16_t(0x0102 * i);
+    expected.push_back(words[i] >> 8);
+    expected.push_back(words[i] & 0xFF);
+  }
+  {
+    TestDevice::Transaction transaction(&bus.device);
+    bus.device.write_array16(words.data(), words.size());
+  }
+  // Swapped to MSB first through a 128 byte buffer, every buffer is one transaction
+  EXPECT_TRUE(transaction_sizes() == std::vector<size_t>({128, 128, 128, 128, 88}));
+  EXPECT_TRUE(mock_bus.sent() == expected);
+}
+
+void test_async_writes_are_queued(Bus &bus) {
+  mock_bus.reset();
+  std::vector<std::vector<uint8_t>> buffers;
+  std::vector<WriteBuffer> scatter;
+  std::vector<uint8_t> expected;
+  for (uint8_t i = 0; i < 6; i++) {
+    buffers.push_back(pattern(10000, i));
+    expected.insert(expected.end(), buffers.back().begin(), buffers.back().end());
+  }
+  for (const auto &buffer : buffers)
+    scatter.push_back({buffer.data(), buffer.size()});
+  {
+    TestDevice::Transaction transaction(&bus.device);
+    bus.device.writev(scatter.data(), scatter.size());
+  }
+  EXPECT_EQ(mock_bus.transactions.size(), 12u);
+  for (size_t size : transaction_sizes())
+    EXPECT_TRUE(size <= MAX_TRANSFER_SIZE);
+  EXPECT_EQ(mock_bus.max_queued, QUEUE_SIZE);
+  EXPECT_TRUE(mock_bus.sent() == expected);
+}
+
+void test_transfer_array(Bus &bus) {
+  mock_bus.reset();
+  auto data = pattern(100, 3);
+  auto sent = data;
+  {
+    TestDevice::Transaction transaction(&bus.device);
+    bus.device.transfer_array(data.data(), data.size());
+  }
+  // Received through a 64 byte buffer
+  EXPECT_TRUE(transaction_sizes() == std::vector<size_t>({64, 36}));
+  EXPECT_TRUE(mock_bus.sent() == sent);
+  for (size_t i = 0; i < data.size(); i++)
+    EXPECT_EQ(data[i], uint8_t(~sent[i]));
+}
+
+void test_queue_failure_fails_the_bus(Bus &bus) {
+  mock_bus.reset();
+  auto data = pattern(30000, 5);
+  mock_bus.fail_after = 2;
+  {
+    TestDevice::Transaction transaction(&bus.device);
+    bus.device.write_array(data);
+    // Nothing of the rest of the transaction is sent
+    bus.device.write_array(data);
+  }
+  EXPECT_TRUE(bus.spi.is_failed());
+  // The chunks queued before the error are sent completely
+  EXPECT_TRUE(transaction_sizes() == std::vector<size_t>({MAX_TRANSFER_SIZE, MAX_TRANSFER_SIZE}));
+  EXPECT_TRUE(mock_bus.sent() == std::vector<uint8_t>(data.begin(), data.begin() + 2 * MAX_TRANSFER_SIZE));
+
+  // Later transactions don't send anything either
+  mock_bus.fail_after = -1;
+  {
+    TestDevice::Transaction transaction(&bus.device);
+    bus.device.write_array(data);
+    bus.device.write_byte(1);
+  }
+  EXPECT_EQ(mock_bus.transactions.size(), 2u);
+}
+
+void test_polling_failure_fails_the_bus(Bus &bus) {
+  mock_bus.reset();
+  mock_bus.fail_after = 0;
+  {
+    TestDevice::Transaction transaction(&bus.device);
+    bus.device.write_byte(1);
+    bus.device.write_byte(2);
+  }
+  EXPECT_TRUE(bus.spi.is_failed());
+  EXPECT_TRUE(mock_bus.transactions.empty());
+}
+
+}  // namespace
+
+int main() {
+  Bus bus;
+  test_large_write_is_split(bus);
+  test_short_writes_are_polled(bus);
+  test_write_array16_chunks(bus);
+  test_async_writes_are_queued(bus);
+  test_transfer_array(bus);
+  test_polling_failure_fails_the_bus(bus);
+  Bus other_bus;
+  test_queue_failure_fails_the_bus(other_bus);
+  return esphome::testing::finish("spi/spi_idf_test");
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// Replaces the generated defines.h for the host builds of the C++ unit tests. Components and features a test
+// needs are enabled with -D flags in the Makefile.
+
+#include "esphome/core/macros.h"
+
+#define ESPHOME_BOARD "host"
+#define ESPHOME_VARIANT "host"
+
+#define USE_HOST
@@ -0,0 +1,54 @@
+#pragma once
+
+// Replaces the global operator new and delete to count the heap in use, for benchmarks that report their peak heap.
+// Include it in exactly one source file of a benchmark.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace esphome {
+namespace testing {
+
+struct HeapCounter {
+  size_t current{0};
+  size_t peak{0};
+  size_t allocations{0};
+
+  /// Start measuring the peak from the heap in use now.
+  void reset_peak() {
+    this->peak = this->current;
+    this->allocations = 0;
+  }
+};
+inline HeapCounter heap;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace testing
+}  // namespace esphome
+
+// The size is stored in front of every block, so that delete knows how much is freed
+static constexpr size_t HEAP_COUNTER_HEADER = alignof(std::max_align_t);
+
+void *operator new(size_t size) {
+  auto *block = static_cast<char *>(malloc(size + HEAP_COUNTER_HEADER));
+  if (block == nullptr)
+    throw std::bad_alloc();
+  *reinterpret_cast<size_t *>(block) = size;
+  auto &heap = esphome::testing::heap;
+  heap.current += size;
+  heap.allocations++;
+  if (heap.current > heap.peak)
+    heap.peak = heap.current;
+  return block + HEAP_COUNTER_HEADER;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept {
+  if (ptr == nullptr)
+    return;
+  char *block = static_cast<char *>(ptr) - HEAP_COUNTER_HEADER;
+  esphome::testing::heap.current -= *reinterpret_cast<size_t *>(block);
+  free(block);
+}
+void operator delete[](void *ptr) noexcept { operator delete(ptr); }
+void operator delete(void *ptr, size_t size) noexcept { operator delete(ptr); }
+void operator delete[](void *ptr, size_t size) noexcept { operator delete(ptr); }
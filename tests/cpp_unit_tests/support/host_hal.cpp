@@ -0,0 +1,34 @@
+#include "esphome/core/hal.h"
+#include "test_helpers.h"
+
+#include <cstdlib>
+
+namespace esphome {
+
+namespace testing {
+
+static uint32_t fake_micros = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void set_millis(uint32_t ms) { fake_micros = ms * 1000; }
+void advance_millis(uint32_t ms) { fake_micros += ms * 1000; }
+void advance_micros(uint32_t us) { fake_micros += us; }
+
+}  // namespace testing
+
+// The clock only moves when a test advances it (or something delays), so that timeouts are deterministic
+uint32_t millis() { return testing::fake_micros / 1000; }
+uint32_t micros() { return testing::fake_micros; }
+void yield() {}
+void delay(uint32_t ms) { testing::advance_millis(ms); }
+void delayMicroseconds(uint32_t us) { testing::advance_micros(us); }
+
+void arch_restart() { abort(); }
+void arch_init() {}
+void arch_feed_wdt() {}
+void arch_wait_for_wake(uint32_t ms) { testing::advance_millis(ms); }
+void arch_wake_loop() {}
+uint32_t arch_get_cpu_cycle_count() { return testing::fake_micros; }
+uint32_t arch_get_cpu_freq_hz() { return 1000000; }
+uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
+
+}  // namespace esphome
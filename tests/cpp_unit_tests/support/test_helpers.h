@@ -0,0 +1,67 @@
+#pragma once
+
+// Minimal checks for the host builds of the C++ unit tests and benchmarks, so that they don't need a test framework.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+namespace esphome {
+namespace testing {
+
+/// Set the fake clock that millis() and micros() return.
+void set_millis(uint32_t ms);
+void advance_millis(uint32_t ms);
+void advance_micros(uint32_t us);
+
+inline int failures = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+inline void fail(const char *file, int line, const char *expr) {
+  std::cerr << file << ":" << line << ": check failed: " << expr << std::endl;
+  failures++;
+}
+
+template<typename A, typename B>
+void expect_eq(const A &actual, const B &expected, const char *file, int line, const char *expr) {
+  if (actual == expected)
+    return;
+  std::cerr << file << ":" << line << ": check failed: " << expr << std::endl
+            << "  actual:   " << actual << std::endl
+            << "  expected: " << expected << std::endl;
+  failures++;
+}
+
+/// Report the result of the checks, returned from main().
+inline int finish(const char *name) {
+  if (failures != 0) {
+    std::cerr << name << ": " << failures << " checks failed" << std::endl;
+    return 1;
+  }
+  std::cout << name << ": all checks passed" << std::endl;
+  return 0;
+}
+
+/// Keep the compiler from optimizing away a result that is only computed for a benchmark.
+template<typename T> inline void do_not_optimize(const T &value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+/// Run fn() the given number of times and return the nanoseconds per run.
+template<typename F> double time_ns(size_t runs, F &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < runs; i++)
+    fn();
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / runs;
+}
+
+}  // namespace testing
+}  // namespace esphome
+
+#define EXPECT_TRUE(expr) \
+  do { \
+    if (!(expr)) \
+      ::esphome::testing::fail(__FILE__, __LINE__, #expr); \
+  } while (0)
+
+#define EXPECT_EQ(actual, expected) \
+  ::esphome::testing::expect_eq((actual), (expected), __FILE__, __LINE__, #actual " == " #expected)
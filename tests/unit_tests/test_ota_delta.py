@@ -0,0 +1,74 @@
+import hashlib
+import random
+
+import pytest
+
+from esphome import ota_delta
+
+
+def _firmware(size, seed=0):
+    rand = random.Random(seed)
+    # Repeating structure with some noise, somewhat like code
+    pattern = bytes(rand.getrandbits(8) for _ in range(4096))
+    data = bytearray(pattern * (size // len(pattern) + 1))[:size]
+    for _ in range(size // 100):
+        data[rand.randrange(size)] = rand.getrandbits(8)
+    return bytes(data)
+
+
+def _modified(data, seed=1):
+    rand = random.Random(seed)
+    data = bytearray(data)
+    data[1000:1000] = bytes(rand.getrandbits(8) for _ in range(200))
+    del data[20000:20100]
+    for _ in range(50):
+        data[rand.randrange(len(data))] = rand.getrandbits(8)
+    return bytes(data)
+
+
+@pytest.mark.parametrize(
+    "old, new",
+    (
+        (_firmware(50000), _modified(_firmware(50000))),
+        (_firmware(50000), _firmware(50000)),
+        (_firmware(50000), _firmware(30000, seed=5)),
+        (b"", _firmware(1000)),
+        (_firmware(1000), b"\x01\x02\x03"),
+    ),
+)
+def test_patch_roundtrip(old, new):
+    patch = ota_delta.create_patch(old, new)
+
+    assert ota_delta.apply_patch(old, patch) == new
+
+
+def test_patch_of_small_change_is_small():
+    old = _firmware(50000)
+    new = _modified(old)
+
+    patch = ota_delta.create_patch(old, new)
+
+    # The inserted bytes and the header of each operation
+    assert sum(1 for b in patch if b != 0) < 2000
+
+
+def test_patch_rejects_other_image():
+    old = _firmware(50000)
+    patch = ota_delta.create_patch(old, _modified(old))
+
+    with pytest.raises(ValueError):
+        ota_delta.apply_patch(_firmware(50000, seed=3), patch)
+
+
+def test_archive_firmware(tmp_path):
+    firmwares = [
+        _firmware(1000, seed=i) for i in range(ota_delta.MAX_ARCHIVED_FIRMWARES + 1)
+    ]
+    for firmware in firmwares:
+        ota_delta.archive_firmware(str(tmp_path), firmware)
+
+    assert len(list(tmp_path.glob("*.bin"))) == ota_delta.MAX_ARCHIVED_FIRMWARES
+    md5 = hashlib.md5(firmwares[-1]).hexdigest()
+    assert ota_delta.load_firmware(str(tmp_path), md5) == firmwares[-1]
+    md5 = hashlib.md5(firmwares[0]).hexdigest()
+    assert ota_delta.load_firmware(str(tmp_path), md5) is None